@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cmath>
+#include "logger.h"
+#include "redispipeline.h"
+#include "fpmsyncd/flushpolicy.h"
+
+using namespace swss;
+using namespace std;
+
+/* Length of the window used to measure the arrival rate */
+#define RATE_WINDOW_MS 100
+/* Number of recent flushes the latency percentile is computed over */
+#define LATENCY_SAMPLES 1024
+
+/* Upper bounds of the batch size histogram buckets, the last bucket is unbounded */
+static const vector<size_t> batchBuckets = { 1, 10, 100, 1000, 10000 };
+
+constexpr int FlushPolicy::DEFAULT_LATENCY_TARGET_MS;
+constexpr size_t FlushPolicy::DEFAULT_MAX_BATCH;
+constexpr int FlushPolicy::NO_TIMEOUT;
+
+FlushPolicy::FlushPolicy() :
+    m_latencyTargetMs(DEFAULT_LATENCY_TARGET_MS),
+    m_maxBatch(DEFAULT_MAX_BATCH),
+    m_rate(0),
+    m_windowArrivals(0),
+    m_windowStart(Clock::now()),
+    m_lastPending(0),
+    m_hasOldest(false),
+    m_lastReason(FLUSH_IDLE),
+    m_batchHistogram(batchBuckets.size() + 1, 0),
+    m_reasonCount{},
+    m_flushedEntries(0),
+    m_latencySampleIdx(0)
+{
+    m_latencySamples.reserve(LATENCY_SAMPLES);
+}
+
+void FlushPolicy::setLatencyTarget(int ms)
+{
+    if (ms <= 0)
+    {
+        SWSS_LOG_ERROR("Invalid flush latency target %d ms, keeping %d ms", ms, m_latencyTargetMs);
+        return;
+    }
+
+    m_latencyTargetMs = ms;
+    SWSS_LOG_NOTICE("Pipeline flush latency target set to %d ms", ms);
+}
+
+void FlushPolicy::setMaxBatch(size_t entries)
+{
+    if (entries == 0)
+    {
+        SWSS_LOG_ERROR("Invalid flush batch size 0, keeping %zu", m_maxBatch);
+        return;
+    }
+
+    m_maxBatch = entries;
+    SWSS_LOG_NOTICE("Pipeline flush batch size set to %zu", entries);
+}
+
+void FlushPolicy::applyConfig(const vector<FieldValueTuple> &fvs)
+{
+    for (const auto &fv : fvs)
+    {
+        const auto &field = fvField(fv);
+        const auto &value = fvValue(fv);
+
+        try
+        {
+            if (field == "latency_target_ms")
+            {
+                setLatencyTarget(stoi(value));
+            }
+            else if (field == "max_batch")
+            {
+                setMaxBatch(stoul(value));
+            }
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Invalid value %s for flush config field %s", value.c_str(), field.c_str());
+        }
+    }
+}
+
+void FlushPolicy::updateRate(size_t pending, Clock::time_point now)
+{
+    /* A pipeline which shrank without us flushing it was flushed because it got full */
+    if (pending < m_lastPending)
+    {
+        m_windowArrivals += pending;
+        m_oldest = now;
+    }
+    else
+    {
+        m_windowArrivals += pending - m_lastPending;
+    }
+    m_lastPending = pending;
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - m_windowStart).count();
+    if (elapsed >= RATE_WINDOW_MS)
+    {
+        /*
+         * The previous estimate decays with the time elapsed, not with the
+         * number of windows evaluated: after a long idle gap the first update
+         * must not still see the rate of the last burst.
+         */
+        double current = static_cast<double>(m_windowArrivals) / static_cast<double>(elapsed);
+        double decay = exp(-static_cast<double>(elapsed) / RATE_WINDOW_MS);
+        m_rate = m_rate * decay + current * (1 - decay);
+        m_windowArrivals = 0;
+        m_windowStart = now;
+    }
+}
+
+int FlushPolicy::evaluate(size_t pending, size_t backlog, Clock::time_point now)
+{
+    updateRate(pending, now);
+
+    if (pending == 0)
+    {
+        m_hasOldest = false;
+        return NO_TIMEOUT;
+    }
+
+    if (!m_hasOldest)
+    {
+        m_hasOldest = true;
+        m_oldest = now;
+    }
+
+    auto age = chrono::duration_cast<chrono::milliseconds>(now - m_oldest).count();
+
+    if (pending >= m_maxBatch)
+    {
+        m_lastReason = FLUSH_BATCH;
+        return 0;
+    }
+
+    /* age may also be negative in case of clock drift */
+    if (age >= m_latencyTargetMs || age < 0)
+    {
+        m_lastReason = FLUSH_DEADLINE;
+        return 0;
+    }
+
+    /*
+     * Keep batching only when more entries are expected before the deadline:
+     * either FPM messages are already waiting to be processed, or the recent
+     * arrival rate predicts at least one more entry within the remaining budget.
+     */
+    int budget = m_latencyTargetMs - static_cast<int>(age);
+    if (backlog == 0 && m_rate * budget < 1.0)
+    {
+        m_lastReason = FLUSH_IDLE;
+        return 0;
+    }
+
+    return budget;
+}
+
+int FlushPolicy::run(RedisPipeline &pipeline, size_t backlog)
+{
+    auto now = Clock::now();
+    size_t pending = pipeline.size();
+
+    int timeout = evaluate(pending, backlog, now);
+    if (timeout != 0)
+    {
+        return timeout;
+    }
+
+    pipeline.flush();
+    onFlush(pending, now);
+
+    SWSS_LOG_DEBUG("Pipeline flushed %zu entries", pending);
+
+    return NO_TIMEOUT;
+}
+
+void FlushPolicy::onFlush(size_t entries, Clock::time_point now)
+{
+    size_t bucket = 0;
+    while (bucket < batchBuckets.size() && entries > batchBuckets[bucket])
+    {
+        bucket++;
+    }
+    m_batchHistogram[bucket]++;
+    m_reasonCount[m_lastReason]++;
+    m_flushedEntries += entries;
+
+    uint32_t latency = 0;
+    if (m_hasOldest)
+    {
+        auto age = chrono::duration_cast<chrono::milliseconds>(now - m_oldest).count();
+        latency = age > 0 ? static_cast<uint32_t>(age) : 0;
+    }
+
+    if (m_latencySamples.size() < LATENCY_SAMPLES)
+    {
+        m_latencySamples.push_back(latency);
+    }
+    else
+    {
+        m_latencySamples[m_latencySampleIdx] = latency;
+        m_latencySampleIdx = (m_latencySampleIdx + 1) % LATENCY_SAMPLES;
+    }
+
+    m_hasOldest = false;
+    m_lastPending = 0;
+}
+
+void FlushPolicy::dumpStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("latency_target_ms", to_string(m_latencyTargetMs));
+    fvs.emplace_back("max_batch", to_string(m_maxBatch));
+
+    uint64_t flushes = 0;
+    for (size_t i = 0; i < m_batchHistogram.size(); i++)
+    {
+        string name = i < batchBuckets.size() ?
+            "batch_le_" + to_string(batchBuckets[i]) :
+            "batch_gt_" + to_string(batchBuckets.back());
+        fvs.emplace_back(name, to_string(m_batchHistogram[i]));
+        flushes += m_batchHistogram[i];
+    }
+
+    fvs.emplace_back("flushes", to_string(flushes));
+    fvs.emplace_back("flushed_entries", to_string(m_flushedEntries));
+    fvs.emplace_back("flush_idle", to_string(m_reasonCount[FLUSH_IDLE]));
+    fvs.emplace_back("flush_batch", to_string(m_reasonCount[FLUSH_BATCH]));
+    fvs.emplace_back("flush_deadline", to_string(m_reasonCount[FLUSH_DEADLINE]));
+
+    uint32_t p99 = 0;
+    if (!m_latencySamples.empty())
+    {
+        vector<uint32_t> samples(m_latencySamples);
+        auto nth = samples.begin() + static_cast<long>((samples.size() - 1) * 99 / 100);
+        nth_element(samples.begin(), nth, samples.end());
+        p99 = *nth;
+    }
+    fvs.emplace_back("p99_latency_ms", to_string(p99));
+}
@@ -0,0 +1,101 @@
+#ifndef __FLUSHPOLICY__
+#define __FLUSHPOLICY__
+
+#include <chrono>
+#include <vector>
+
+#include "redispipeline.h"
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Decides when fpmsyncd flushes its RedisPipeline.
+ *
+ * A single route update should reach APPL_DB right away, while a full table
+ * download should be written in large batches. The policy looks at the
+ * number of pending pipeline entries, the FPM messages still queued for
+ * processing, the recent arrival rate and the age of the oldest unflushed
+ * entry, and never lets that age exceed the configured latency target.
+ */
+class FlushPolicy
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr int DEFAULT_LATENCY_TARGET_MS = 500;
+    static constexpr size_t DEFAULT_MAX_BATCH = 10000;
+    static constexpr int NO_TIMEOUT = -1;
+
+    FlushPolicy();
+
+    void setLatencyTarget(int ms);
+    void setMaxBatch(size_t entries);
+
+    int getLatencyTarget() const
+    {
+        return m_latencyTargetMs;
+    }
+
+    size_t getMaxBatch() const
+    {
+        return m_maxBatch;
+    }
+
+    /*
+     * Flush the pipeline if the policy says so. Returns the select timeout in
+     * milliseconds after which the policy has to be evaluated again, or
+     * NO_TIMEOUT when nothing is pending.
+     */
+    int run(RedisPipeline &pipeline, size_t backlog);
+
+    /*
+     * Pure decision step, separated from run() for unit tests.
+     * Returns 0 when the pending entries should be flushed now.
+     */
+    int evaluate(size_t pending, size_t backlog, Clock::time_point now);
+
+    /* Record a flush of the given number of entries */
+    void onFlush(size_t entries, Clock::time_point now);
+
+    /* Apply FPMSYNCD|flush configuration from CONFIG_DB */
+    void applyConfig(const std::vector<FieldValueTuple> &fvs);
+
+    /* Export flush batch size distribution and latency */
+    void dumpStats(std::vector<FieldValueTuple> &fvs) const;
+
+private:
+    enum FlushReason
+    {
+        FLUSH_IDLE,
+        FLUSH_BATCH,
+        FLUSH_DEADLINE,
+        FLUSH_REASON_MAX
+    };
+
+    void updateRate(size_t pending, Clock::time_point now);
+
+    int m_latencyTargetMs;
+    size_t m_maxBatch;
+
+    /* Arrival rate in entries per millisecond, decaying with a RATE_WINDOW_MS time constant */
+    double m_rate;
+    size_t m_windowArrivals;
+    Clock::time_point m_windowStart;
+    size_t m_lastPending;
+
+    bool m_hasOldest;
+    Clock::time_point m_oldest;
+    FlushReason m_lastReason;
+
+    /* Statistics */
+    std::vector<uint64_t> m_batchHistogram;
+    uint64_t m_reasonCount[FLUSH_REASON_MAX];
+    uint64_t m_flushedEntries;
+    std::vector<uint32_t> m_latencySamples;
+    size_t m_latencySampleIdx;
+};
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include <arpa/inet.h>
+#include <assert.h>
+#include <cstring>
+#include <stdexcept>
+#include "fpm/fpm.h"
+#include "fpmsyncd/fpmcapture.h"
+
+using namespace swss;
+using namespace std;
+
+#define FPM_CAPTURE_MAGIC_LEN 8
+
+FpmCaptureWriter::FpmCaptureWriter(const string &path) :
+    m_file(path, ios::binary | ios::trunc),
+    m_start(chrono::steady_clock::now()),
+    m_records(0),
+    m_bytes(0)
+{
+    if (!m_file)
+    {
+        throw runtime_error("Failed to open FPM capture file " + path);
+    }
+
+    uint32_t version = FPM_CAPTURE_VERSION;
+    uint32_t reserved = 0;
+
+    m_file.write(FPM_CAPTURE_MAGIC, FPM_CAPTURE_MAGIC_LEN);
+    m_file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    m_file.write(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+}
+
+void FpmCaptureWriter::write(const char *buf, size_t len)
+{
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start);
+
+    write(buf, len, static_cast<uint64_t>(elapsed.count()));
+}
+
+void FpmCaptureWriter::write(const char *buf, size_t len, uint64_t timestampNs)
+{
+    uint32_t recordLen = static_cast<uint32_t>(len);
+
+    m_file.write(reinterpret_cast<const char *>(&timestampNs), sizeof(timestampNs));
+    m_file.write(reinterpret_cast<const char *>(&recordLen), sizeof(recordLen));
+    m_file.write(buf, static_cast<streamsize>(len));
+
+    if (!m_file)
+    {
+        throw runtime_error("Failed to write FPM capture file");
+    }
+
+    m_records++;
+    m_bytes += len;
+}
+
+void FpmCaptureWriter::flush()
+{
+    m_file.flush();
+}
+
+FpmCaptureReader::FpmCaptureReader(const string &path) :
+    m_file(path, ios::binary)
+{
+    if (!m_file)
+    {
+        throw runtime_error("Failed to open FPM capture file " + path);
+    }
+
+    char magic[FPM_CAPTURE_MAGIC_LEN];
+    uint32_t version = 0;
+    uint32_t reserved = 0;
+
+    m_file.read(magic, FPM_CAPTURE_MAGIC_LEN);
+    m_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    m_file.read(reinterpret_cast<char *>(&reserved), sizeof(reserved));
+
+    if (!m_file || memcmp(magic, FPM_CAPTURE_MAGIC, FPM_CAPTURE_MAGIC_LEN) != 0)
+    {
+        throw runtime_error(path + " is not an FPM capture file");
+    }
+
+    if (version != FPM_CAPTURE_VERSION)
+    {
+        throw runtime_error("Unsupported FPM capture version " + to_string(version));
+    }
+}
+
+bool FpmCaptureReader::next(Record &record)
+{
+    uint64_t timestampNs;
+    uint32_t len;
+
+    m_file.read(reinterpret_cast<char *>(&timestampNs), sizeof(timestampNs));
+    if (m_file.gcount() == 0 && m_file.eof())
+    {
+        return false;
+    }
+
+    m_file.read(reinterpret_cast<char *>(&len), sizeof(len));
+    if (!m_file)
+    {
+        throw runtime_error("Truncated FPM capture record header");
+    }
+
+    record.timestampNs = timestampNs;
+    record.data.resize(len);
+    m_file.read(record.data.data(), len);
+    if (!m_file)
+    {
+        throw runtime_error("Truncated FPM capture record");
+    }
+
+    /* Records must hold complete messages, as they are fed to FpmLink as is */
+    size_t start = 0;
+    while (start < len)
+    {
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(record.data.data() + start));
+        size_t left = len - start;
+
+        if (left < FPM_MSG_HDR_LEN || !fpm_msg_ok(hdr, left))
+        {
+            throw runtime_error("Malformed FPM message in capture record");
+        }
+
+        start += fpm_msg_len(hdr);
+    }
+
+    return true;
+}
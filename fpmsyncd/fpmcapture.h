@@ -0,0 +1,79 @@
+#ifndef __FPMCAPTURE__
+#define __FPMCAPTURE__
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace swss {
+
+/*
+ * File format used by fpmreplay to record the FPM stream sent by zebra.
+ *
+ * The file starts with an 8 byte magic and a 32 bit version followed by 32
+ * reserved bits. Each record then holds a 64 bit timestamp in nanoseconds
+ * relative to the start of the capture, a 32 bit length and that many bytes
+ * of back-to-back complete FPM messages. Integers are in host byte order, a
+ * capture is meant to be replayed on the same kind of box it was taken on.
+ */
+#define FPM_CAPTURE_MAGIC   "FPMCAP\0\0"
+#define FPM_CAPTURE_VERSION 1
+
+class FpmCaptureWriter
+{
+public:
+    FpmCaptureWriter(const std::string &path);
+
+    /* Append a chunk of complete FPM messages stamped with the current time */
+    void write(const char *buf, size_t len);
+
+    /* Append a chunk with an explicit timestamp */
+    void write(const char *buf, size_t len, uint64_t timestampNs);
+
+    void flush();
+
+    uint64_t getRecords() const
+    {
+        return m_records;
+    }
+
+    uint64_t getBytes() const
+    {
+        return m_bytes;
+    }
+
+private:
+    std::ofstream m_file;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_records;
+    uint64_t m_bytes;
+};
+
+class FpmCaptureReader
+{
+public:
+    struct Record
+    {
+        uint64_t timestampNs;
+        std::vector<char> data;
+    };
+
+    /* Throws std::runtime_error if the file is missing or not a capture */
+    FpmCaptureReader(const std::string &path);
+
+    /*
+     * Read the next record. Returns false at the end of the capture and
+     * throws std::runtime_error on a truncated record or a record which does
+     * not consist of complete, well formed FPM messages.
+     */
+    bool next(Record &record);
+
+private:
+    std::ifstream m_file;
+};
+
+}
+
+#endif
@@ -1,6 +1,9 @@
 #include <string.h>
 #include <errno.h>
 #include <system_error>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
 #include "logger.h"
 #include "netmsg.h"
 #include "netdispatcher.h"
@@ -9,6 +12,9 @@
 using namespace swss;
 using namespace std;
 
+/* How often the reader thread checks for a stop request */
+#define FPM_READER_POLL_TIMEOUT_MS 100
+
 void netlink_parse_rtattr(struct rtattr **tb, int max, struct rtattr *rta,
         int len)
 {
@@ -34,6 +40,14 @@ void netlink_parse_rtattr(struct rtattr **tb, int max, struct rtattr *rta,
     }
 }
 
+uint64_t swss::threadCpuNs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
 bool FpmLink::isRawProcessing(struct nlmsghdr *h)
 {
     int len;
@@ -170,8 +184,12 @@ FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
 
 FpmLink::~FpmLink()
 {
+    stopReader();
     m_routesync->onFpmDisconnected();
 
+    if (m_eventFd >= 0)
+        close(m_eventFd);
+
     delete[] m_messageBuffer;
     delete[] m_sendBuffer;
     if (m_connected)
@@ -198,14 +216,31 @@ void FpmLink::accept()
 
 int FpmLink::getFd()
 {
+    if (m_queue)
+    {
+        return m_eventFd;
+    }
+
     return m_connection_socket;
 }
 
 uint64_t FpmLink::readData()
 {
-    fpm_msg_hdr_t *hdr;
-    size_t msg_len;
-    size_t start = 0, left;
+    if (m_queue)
+    {
+        return drainQueue();
+    }
+
+    readSocket();
+
+    size_t len = scanMessages();
+    processFpmBuffer(m_messageBuffer, len);
+    consumeMessages(len);
+    return 0;
+}
+
+void FpmLink::readSocket()
+{
     ssize_t read;
 
     read = ::read(m_connection_socket, m_messageBuffer + m_pos, m_bufSize - m_pos);
@@ -214,6 +249,13 @@ uint64_t FpmLink::readData()
     if (read < 0)
         throw system_error(errno, system_category());
     m_pos+= (uint32_t)read;
+}
+
+size_t FpmLink::scanMessages()
+{
+    fpm_msg_hdr_t *hdr;
+    size_t msg_len;
+    size_t start = 0, left;
 
     /* Check for complete messages */
     while (true)
@@ -237,13 +279,160 @@ uint64_t FpmLink::readData()
             throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
         }
 
+        start += msg_len;
+    }
+
+    return start;
+}
+
+void FpmLink::consumeMessages(size_t len)
+{
+    memmove(m_messageBuffer, m_messageBuffer + len, m_pos - len);
+    m_pos = m_pos - (uint32_t)len;
+}
+
+void FpmLink::processFpmBuffer(char *buf, size_t len)
+{
+    size_t start = 0;
+
+    while (start < len)
+    {
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(buf + start));
+
         processFpmMessage(hdr);
 
-        start += msg_len;
+        start += fpm_msg_len(hdr);
+    }
+
+    m_routesync->flushNextHopGroups();
+}
+
+void FpmLink::startReader(size_t queueSize)
+{
+    if (m_queue)
+    {
+        return;
+    }
+
+    m_eventFd = eventfd(0, EFD_NONBLOCK);
+    if (m_eventFd < 0)
+        throw system_error(errno, system_category());
+
+    m_queue = make_unique<FpmMsgQueue>(queueSize);
+    m_readerStop = false;
+    m_readerDone = false;
+    m_readerThread = thread(&FpmLink::readerLoop, this);
+
+    SWSS_LOG_NOTICE("FPM reader thread started, queue size %zu", queueSize);
+}
+
+void FpmLink::stopReader()
+{
+    if (!m_readerThread.joinable())
+    {
+        return;
+    }
+
+    m_readerStop = true;
+    m_readerThread.join();
+}
+
+void FpmLink::notifyReader()
+{
+    uint64_t one = 1;
+
+    if (::write(m_eventFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+    {
+        SWSS_LOG_ERROR("Failed to notify FPM queue consumer: %s", strerror(errno));
+    }
+}
+
+/*
+ * Reader thread: only frames and validates the FPM stream, the netlink
+ * messages are decoded on the main thread by RouteSync. The poll timeout
+ * bounds how long stopReader() waits for the thread to notice the request.
+ */
+void FpmLink::readerLoop()
+{
+    struct pollfd pfd = {};
+    pfd.fd = m_connection_socket;
+    pfd.events = POLLIN;
+
+    try
+    {
+        while (!m_readerStop)
+        {
+            int rc = poll(&pfd, 1, FPM_READER_POLL_TIMEOUT_MS);
+            if (rc < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw system_error(errno, system_category());
+            }
+            if (rc == 0)
+            {
+                continue;
+            }
+
+            readSocket();
+
+            size_t len = scanMessages();
+            if (len == 0)
+            {
+                continue;
+            }
+
+            FpmMsgQueue::Chunk chunk(m_messageBuffer, m_messageBuffer + len);
+            consumeMessages(len);
+
+            if (!m_queue->push(std::move(chunk), m_readerStop))
+            {
+                break;
+            }
+            notifyReader();
+        }
+    }
+    catch (...)
+    {
+        m_readerError = current_exception();
+    }
+
+    m_readerDone = true;
+    notifyReader();
+}
+
+uint64_t FpmLink::drainQueue()
+{
+    uint64_t cnt;
+    FpmMsgQueue::Chunk chunk;
+
+    if (::read(m_eventFd, &cnt, sizeof(cnt)) < 0 && errno != EAGAIN)
+        throw system_error(errno, system_category());
+
+    /* Bound the work per wakeup so timers in the select loop still get served */
+    for (int i = 0; i < MSG_BATCH_SIZE && m_queue->pop(chunk); i++)
+    {
+        processFpmBuffer(chunk.data(), chunk.size());
+    }
+
+    if (!m_queue->empty())
+    {
+        notifyReader();
+        return 0;
+    }
+
+    if (m_readerDone)
+    {
+        stopReader();
+        if (m_readerError)
+        {
+            rethrow_exception(m_readerError);
+        }
+        throw FpmConnectionClosedException();
     }
 
-    memmove(m_messageBuffer, m_messageBuffer + start, m_pos - start);
-    m_pos = m_pos - (uint32_t)start;
     return 0;
 }
 
@@ -257,6 +446,13 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
     }
     nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
 
+    uint64_t stageStart = 0;
+    if (m_stageStats)
+    {
+        m_stageStats->fpmMsgs++;
+        stageStart = threadCpuNs();
+    }
+
     /* Read all netlink messages inside FPM message */
     for (; NLMSG_OK (nl_hdr, msg_len); nl_hdr = NLMSG_NEXT(nl_hdr, msg_len))
     {
@@ -276,6 +472,13 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
 
         nlmsg_set_proto(msg, NETLINK_ROUTE);
 
+        if (m_stageStats)
+        {
+            uint64_t now = threadCpuNs();
+            m_stageStats->decodeNs += now - stageStart;
+            stageStart = now;
+        }
+
         if (isRaw)
         {
             /* EVPN Type5 Add route processing */
@@ -291,6 +494,19 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
             NetDispatcher::getInstance().onNetlinkMessage(msg);
         }
         nlmsg_free(msg);
+
+        if (m_stageStats)
+        {
+            uint64_t now = threadCpuNs();
+            m_stageStats->dispatchNs += now - stageStart;
+            stageStart = now;
+
+            m_stageStats->nlMsgs++;
+            if (nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE)
+            {
+                m_stageStats->routeMsgs++;
+            }
+        }
     }
 }
 
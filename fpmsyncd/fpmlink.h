@@ -10,9 +10,13 @@
 #include <assert.h>
 #include <unistd.h>
 #include <exception>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 #include "fpm/fpm.h"
 #include "fpmsyncd/fpminterface.h"
+#include "fpmsyncd/fpmqueue.h"
 #include "fpmsyncd/routesync.h"
 
 #define RTM_NEWSRV6LOCALSID		1000
@@ -20,6 +24,26 @@
 
 namespace swss {
 
+/*
+ * Message counts and thread CPU time spent per processing stage. Only
+ * collected while attached to an FpmLink with setStageStats(), which is
+ * what fpmreplay uses to profile a captured FPM stream.
+ */
+struct FpmStageStats
+{
+    uint64_t fpmMsgs = 0;
+    uint64_t nlMsgs = 0;
+    uint64_t routeMsgs = 0;
+
+    /* FPM framing, encap inspection and conversion to nl_msg */
+    uint64_t decodeNs = 0;
+    /* libnl parsing and RouteSync handling, up to the pipeline write */
+    uint64_t dispatchNs = 0;
+};
+
+/* CPU time of the calling thread in nanoseconds, for the stage stats */
+uint64_t threadCpuNs();
+
 class FpmLink : public FpmInterface {
 public:
     const int MSG_BATCH_SIZE;
@@ -44,9 +68,43 @@ public:
 
     void processFpmMessage(fpm_msg_hdr_t* hdr);
 
+    /* Process a buffer holding back-to-back complete FPM messages */
+    void processFpmBuffer(char *buf, size_t len);
+
+    /*
+     * Move socket reads to a dedicated thread feeding a bounded queue.
+     * Afterwards getFd()/readData() operate on the queue instead of the
+     * socket, so a slow Redis flush no longer stalls reading from zebra.
+     */
+    void startReader(size_t queueSize);
+    void stopReader();
+
+    FpmMsgQueue *getQueue()
+    {
+        return m_queue.get();
+    }
+
+    void setStageStats(FpmStageStats *stats)
+    {
+        m_stageStats = stats;
+    }
+
     bool send(nlmsghdr* nl_hdr) override;
 
 private:
+    /* Read from the socket into m_messageBuffer, throws when connection is lost */
+    void readSocket();
+
+    /* Return length of the complete FPM messages at the start of m_messageBuffer */
+    size_t scanMessages();
+
+    /* Drop the first len bytes of m_messageBuffer */
+    void consumeMessages(size_t len);
+
+    void readerLoop();
+    uint64_t drainQueue();
+    void notifyReader();
+
     RouteSync *m_routesync;
     unsigned int m_bufSize;
     char *m_messageBuffer;
@@ -57,6 +115,15 @@ private:
     bool m_server_up;
     int m_server_socket;
     int m_connection_socket;
+
+    std::unique_ptr<FpmMsgQueue> m_queue;
+    std::thread m_readerThread;
+    std::atomic<bool> m_readerStop{false};
+    std::atomic<bool> m_readerDone{false};
+    std::exception_ptr m_readerError;
+    int m_eventFd{-1};
+
+    FpmStageStats *m_stageStats{nullptr};
 };
 
 }
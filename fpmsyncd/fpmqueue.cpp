@@ -0,0 +1,103 @@
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "fpmsyncd/fpmqueue.h"
+
+using namespace swss;
+using namespace std;
+
+/* Time the producer sleeps between retries while the queue is full */
+#define FPM_QUEUE_FULL_BACKOFF_US 50
+
+FpmMsgQueue::FpmMsgQueue(size_t size) :
+    m_buffer(size + 1)
+{
+    if (size == 0)
+    {
+        throw invalid_argument("FPM queue size must be greater than 0");
+    }
+}
+
+bool FpmMsgQueue::push(Chunk &&chunk, const atomic<bool> &stop)
+{
+    size_t tail = m_tail.load(memory_order_relaxed);
+    size_t next = (tail + 1) % m_buffer.size();
+
+    if (next == m_head.load(memory_order_acquire))
+    {
+        /*
+         * Consumer is behind (most likely blocked on a Redis flush). Stop
+         * reading the socket until a slot frees up, so that zebra sees TCP
+         * backpressure instead of fpmsyncd growing without bound.
+         */
+        m_fullEvents.fetch_add(1, memory_order_relaxed);
+        auto start = chrono::steady_clock::now();
+
+        while (next == m_head.load(memory_order_acquire))
+        {
+            if (stop.load(memory_order_relaxed))
+            {
+                return false;
+            }
+            this_thread::sleep_for(chrono::microseconds(FPM_QUEUE_FULL_BACKOFF_US));
+        }
+
+        auto waited = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+        m_fullWaitUs.fetch_add(static_cast<uint64_t>(waited.count()), memory_order_relaxed);
+    }
+
+    m_bytes.fetch_add(chunk.size(), memory_order_relaxed);
+    m_buffer[tail] = std::move(chunk);
+    m_tail.store(next, memory_order_release);
+    m_pushed.fetch_add(1, memory_order_relaxed);
+
+    size_t current = depth();
+    if (current > m_highWatermark.load(memory_order_relaxed))
+    {
+        m_highWatermark.store(current, memory_order_relaxed);
+    }
+
+    return true;
+}
+
+bool FpmMsgQueue::pop(Chunk &chunk)
+{
+    size_t head = m_head.load(memory_order_relaxed);
+
+    if (head == m_tail.load(memory_order_acquire))
+    {
+        return false;
+    }
+
+    chunk = std::move(m_buffer[head]);
+    m_buffer[head] = Chunk();
+    m_head.store((head + 1) % m_buffer.size(), memory_order_release);
+    m_popped.fetch_add(1, memory_order_relaxed);
+
+    return true;
+}
+
+bool FpmMsgQueue::empty() const
+{
+    return m_head.load(memory_order_acquire) == m_tail.load(memory_order_acquire);
+}
+
+size_t FpmMsgQueue::depth() const
+{
+    size_t head = m_head.load(memory_order_acquire);
+    size_t tail = m_tail.load(memory_order_acquire);
+
+    return (tail + m_buffer.size() - head) % m_buffer.size();
+}
+
+void FpmMsgQueue::dumpStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("capacity", to_string(capacity()));
+    fvs.emplace_back("depth", to_string(depth()));
+    fvs.emplace_back("high_watermark", to_string(m_highWatermark.load(memory_order_relaxed)));
+    fvs.emplace_back("pushed", to_string(m_pushed.load(memory_order_relaxed)));
+    fvs.emplace_back("popped", to_string(m_popped.load(memory_order_relaxed)));
+    fvs.emplace_back("bytes", to_string(m_bytes.load(memory_order_relaxed)));
+    fvs.emplace_back("full_events", to_string(m_fullEvents.load(memory_order_relaxed)));
+    fvs.emplace_back("full_wait_us", to_string(m_fullWaitUs.load(memory_order_relaxed)));
+}
@@ -0,0 +1,63 @@
+#ifndef __FPMQUEUE__
+#define __FPMQUEUE__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Bounded single-producer/single-consumer queue carrying chunks of complete
+ * FPM messages from the socket reader thread to the RouteSync thread.
+ *
+ * Each entry holds one or more back-to-back FPM messages exactly as received
+ * from zebra, so that the reader only frames and validates the stream and the
+ * consumer owns all netlink decoding and DB production.
+ */
+class FpmMsgQueue
+{
+public:
+    typedef std::vector<char> Chunk;
+
+    FpmMsgQueue(size_t size);
+
+    /*
+     * Push a chunk, waiting while the queue is full. Returns false without
+     * pushing if stop becomes true while waiting.
+     */
+    bool push(Chunk &&chunk, const std::atomic<bool> &stop);
+
+    bool pop(Chunk &chunk);
+
+    bool empty() const;
+    size_t depth() const;
+    size_t capacity() const
+    {
+        return m_buffer.size() - 1;
+    }
+
+    /* Export backpressure counters as field/value pairs */
+    void dumpStats(std::vector<FieldValueTuple> &fvs) const;
+
+private:
+    std::vector<Chunk> m_buffer;
+
+    /* Producer and consumer indices live on separate cache lines */
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+
+    /* Counters, written by one side and read by the stats timer */
+    std::atomic<uint64_t> m_pushed{0};
+    std::atomic<uint64_t> m_popped{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_fullEvents{0};
+    std::atomic<uint64_t> m_fullWaitUs{0};
+    std::atomic<size_t> m_highWatermark{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,331 @@
+#include <getopt.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <system_error>
+#include <thread>
+
+#include "logger.h"
+#include "dbconnector.h"
+#include "redispipeline.h"
+#include "netdispatcher.h"
+#include "fpmsyncd/flushpolicy.h"
+#include "fpmsyncd/fpmcapture.h"
+#include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/fpmsyncd.h"
+#include "fpmsyncd/routesync.h"
+
+#include <netlink/route/route.h>
+
+using namespace std;
+using namespace swss;
+
+/*
+ * fpmreplay records the FPM stream zebra sends to fpmsyncd and replays a
+ * recording through FpmLink and RouteSync into the local APPL_DB, reporting
+ * throughput, CPU time per processing stage and peak memory. It is meant to
+ * profile full table downloads offline, fpmsyncd must not run at the same
+ * time as it uses the same FPM port and APPL_DB tables.
+ */
+
+typedef chrono::steady_clock Clock;
+
+static volatile sig_atomic_t gStop = 0;
+
+static void sigHandler(int)
+{
+    gStop = 1;
+}
+
+static double toMs(uint64_t ns)
+{
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+void usage()
+{
+    cout << "Usage: fpmreplay -c <file> [-p <port>]" << endl;
+    cout << "       fpmreplay -r <file> [-s <speed>]" << endl;
+    cout << "       -c <file>: accept the zebra FPM connection and record the stream to file until interrupted" << endl;
+    cout << "       -p <port>: FPM port to listen on when recording, default " << FPM_DEFAULT_PORT << endl;
+    cout << "       -r <file>: replay a recording into APPL_DB" << endl;
+    cout << "       -s <speed>: 0 replays as fast as possible (default), 1 at the recorded pace, N at N times the recorded pace" << endl;
+}
+
+/* Length of the complete FPM messages at the start of buf */
+static size_t scanMessages(const char *buf, size_t len)
+{
+    size_t start = 0;
+
+    while (len - start >= FPM_MSG_HDR_LEN)
+    {
+        const fpm_msg_hdr_t *hdr = reinterpret_cast<const fpm_msg_hdr_t *>(static_cast<const void *>(buf + start));
+        size_t msgLen = fpm_msg_len(hdr);
+
+        if (len - start < msgLen)
+        {
+            break;
+        }
+
+        if (!fpm_msg_ok(hdr, len - start))
+        {
+            throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
+        }
+
+        start += msgLen;
+    }
+
+    return start;
+}
+
+static int capture(const string &path, unsigned short port)
+{
+    struct sockaddr_in addr = {};
+    int trueVal = 1;
+
+    int serverSocket = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (serverSocket < 0)
+        throw system_error(errno, system_category());
+
+    setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &trueVal, sizeof(trueVal));
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(serverSocket, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(serverSocket, 1) != 0)
+    {
+        close(serverSocket);
+        throw system_error(errno, system_category());
+    }
+
+    FpmCaptureWriter writer(path);
+
+    cout << "Waiting for fpm-client connection on port " << port << "..." << endl;
+    int connSocket = accept(serverSocket, NULL, NULL);
+    close(serverSocket);
+    if (connSocket < 0)
+    {
+        if (gStop)
+        {
+            return 0;
+        }
+        throw system_error(errno, system_category());
+    }
+    cout << "Connected, recording to " << path << ", interrupt to stop" << endl;
+
+    vector<char> buffer(FPM_MAX_MSG_LEN * 256);
+    size_t pos = 0;
+
+    while (!gStop)
+    {
+        ssize_t rc = read(connSocket, buffer.data() + pos, buffer.size() - pos);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc <= 0)
+        {
+            break;
+        }
+        pos += static_cast<size_t>(rc);
+
+        size_t len = scanMessages(buffer.data(), pos);
+        if (len == 0)
+        {
+            continue;
+        }
+
+        writer.write(buffer.data(), len);
+        memmove(buffer.data(), buffer.data() + len, pos - len);
+        pos -= len;
+    }
+
+    close(connSocket);
+    writer.flush();
+
+    cout << "Recorded " << writer.getRecords() << " records, " << writer.getBytes() << " bytes" << endl;
+    return 0;
+}
+
+static int replay(const string &path, double speed)
+{
+    FpmCaptureReader reader(path);
+
+    DBConnector db("APPL_DB", 0);
+    RedisPipeline pipeline(&db, ROUTE_SYNC_PPL_SIZE);
+    RouteSync sync(&pipeline);
+    FlushPolicy flushPolicy;
+
+    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+
+    rtnl_route_read_protocol_names(DefaultRtProtoPath);
+    nlmsg_set_default_size(FPM_MAX_MSG_LEN);
+
+    /* Port 0 binds an ephemeral port, the link is never connected */
+    FpmLink fpm(&sync, 0);
+    FpmStageStats stats;
+    fpm.setStageStats(&stats);
+
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    uint64_t writeCpuNs = 0;
+    uint64_t writeWallNs = 0;
+
+    /* Same flush decisions as fpmsyncd, timed as the DB write stage */
+    auto runFlush = [&](size_t backlog, bool force) {
+        auto wallStart = Clock::now();
+        uint64_t cpuStart = threadCpuNs();
+        int timeout = FlushPolicy::NO_TIMEOUT;
+
+        if (force)
+        {
+            pipeline.flush();
+        }
+        else
+        {
+            timeout = flushPolicy.run(pipeline, backlog);
+        }
+
+        writeCpuNs += threadCpuNs() - cpuStart;
+        writeWallNs += static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - wallStart).count());
+        return timeout;
+    };
+
+    FpmCaptureReader::Record record;
+    int timeout = FlushPolicy::NO_TIMEOUT;
+    auto start = Clock::now();
+    uint64_t cpuStart = threadCpuNs();
+
+    while (!gStop && reader.next(record))
+    {
+        if (speed > 0)
+        {
+            auto due = start + chrono::nanoseconds(static_cast<uint64_t>(static_cast<double>(record.timestampNs) / speed));
+
+            /* Serve the flush deadline while waiting for the next record */
+            while (!gStop && Clock::now() < due)
+            {
+                if (timeout == FlushPolicy::NO_TIMEOUT)
+                {
+                    this_thread::sleep_until(due);
+                    break;
+                }
+
+                auto wake = min(due, Clock::now() + chrono::milliseconds(timeout));
+                this_thread::sleep_until(wake);
+                if (wake < due)
+                {
+                    timeout = runFlush(0, false);
+                }
+            }
+        }
+
+        fpm.processFpmBuffer(record.data.data(), record.data.size());
+        records++;
+        bytes += record.data.size();
+
+        /* At full speed there is always more input pending, as in a table download */
+        timeout = runFlush(speed > 0 ? 0 : 1, false);
+    }
+
+    runFlush(0, true);
+
+    uint64_t totalCpuNs = threadCpuNs() - cpuStart;
+    double elapsed = chrono::duration<double>(Clock::now() - start).count();
+
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+
+    cout << fixed << setprecision(1);
+    cout << "Replayed " << records << " records, " << bytes << " bytes in " << elapsed << " s" << endl;
+    cout << "FPM messages:     " << stats.fpmMsgs << " (" << (elapsed > 0 ? static_cast<double>(stats.fpmMsgs) / elapsed : 0) << " msgs/sec)" << endl;
+    cout << "Netlink messages: " << stats.nlMsgs << endl;
+    cout << "Route messages:   " << stats.routeMsgs << " (" << (elapsed > 0 ? static_cast<double>(stats.routeMsgs) / elapsed : 0) << " routes/sec)" << endl;
+    cout << "CPU time (ms):" << endl;
+    cout << "  decode:          " << toMs(stats.decodeNs) << endl;
+    cout << "  libnl/RouteSync: " << toMs(stats.dispatchNs) << endl;
+    cout << "  DB write:        " << toMs(writeCpuNs) << " (wall " << toMs(writeWallNs) << ")" << endl;
+    cout << "  total:           " << toMs(totalCpuNs) << endl;
+    cout << "Peak RSS:         " << usage.ru_maxrss << " KB" << endl;
+
+    vector<FieldValueTuple> fvs;
+    flushPolicy.dumpStats(fvs);
+    cout << "Flush policy:" << endl;
+    for (const auto &fv : fvs)
+    {
+        cout << "  " << fvField(fv) << ": " << fvValue(fv) << endl;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    string capturePath;
+    string replayPath;
+    unsigned short port = FPM_DEFAULT_PORT;
+    double speed = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:r:p:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+                capturePath = optarg;
+                break;
+            case 'r':
+                replayPath = optarg;
+                break;
+            case 'p':
+                port = static_cast<unsigned short>(atoi(optarg));
+                break;
+            case 's':
+                speed = atof(optarg);
+                break;
+            case 'h':
+                usage();
+                return 0;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (capturePath.empty() == replayPath.empty() || speed < 0)
+    {
+        usage();
+        return 1;
+    }
+
+    /* No SA_RESTART, so a blocking accept or read returns on interrupt */
+    struct sigaction sa = {};
+    sa.sa_handler = sigHandler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    try
+    {
+        if (!capturePath.empty())
+        {
+            return capture(capturePath, port);
+        }
+
+        return replay(replayPath, speed);
+    }
+    catch (const exception &e)
+    {
+        cerr << "fpmreplay: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -8,6 +8,7 @@
 #include "notificationconsumer.h"
 #include "subscriberstatetable.h"
 #include "warmRestartHelper.h"
+#include "fpmsyncd/flushpolicy.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/fpmsyncd.h"
 #include "fpmsyncd/routesync.h"
@@ -20,22 +21,6 @@ using namespace swss;
 // gSelectTimeout specifies the maximum wait time in milliseconds (-1 == infinite)
 static int gSelectTimeout;
 #define INFINITE -1
-#define FLUSH_TIMEOUT 500  // 500 milliseconds
-static int gFlushTimeout = FLUSH_TIMEOUT;
-// consider the traffic is small if pipeline contains < 500 entries
-#define SMALL_TRAFFIC 500
-
-/**
- * @brief fpmsyncd invokes redispipeline's flush with a timer
- * 
- * redispipeline would automatically flush itself when full,
- * but fpmsyncd can invoke pipeline's flush even if it's not full yet.
- * 
- * By setting gSelectTimeout, fpmsyncd controls the flush interval.
- * 
- * @param pipeline reference to the pipeline to be flushed
- */
-void flushPipeline(RedisPipeline& pipeline);
 
 /*
  * Default warm-restart timer interval for routing-stack app. To be used only if
@@ -79,14 +64,17 @@ int main(int argc, char **argv)
     DBConnector cfgDb("CONFIG_DB", 0);
     SubscriberStateTable deviceMetadataTableSubscriber(&cfgDb, CFG_DEVICE_METADATA_TABLE_NAME);
     Table deviceMetadataTable(&cfgDb, CFG_DEVICE_METADATA_TABLE_NAME);
+    SubscriberStateTable fpmsyncdCfgSubscriber(&cfgDb, CFG_FPMSYNCD_TABLE_NAME);
     DBConnector applStateDb("APPL_STATE_DB", 0);
     std::unique_ptr<NotificationConsumer> routeResponseChannel;
 
     RedisPipeline pipeline(&db, ROUTE_SYNC_PPL_SIZE);
     RouteSync sync(&pipeline);
+    FlushPolicy flushPolicy;
 
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
+    Table fpmStatsTable(&stateDb, STATE_FPMSYNCD_STATS_TABLE_NAME);
 
     NetLink netlink;
 
@@ -120,7 +108,9 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
-           
+            // Periodically export fpmsyncd statistics to STATE_DB
+            SelectableTimer statsTimer(timespec{FPMSYNCD_STATS_INTERVAL, 0});
+
             /*
              * Pipeline should be flushed right away to deal with state pending
              * from previous try/catch iterations.
@@ -131,9 +121,15 @@ int main(int argc, char **argv)
             fpm.accept();
             cout << "Connected!" << endl;
 
+            /* Read the FPM socket on its own thread so Redis flushes do not block zebra */
+            fpm.startReader(FPM_QUEUE_SIZE);
+
             s.addSelectable(&fpm);
+            s.addSelectable(&statsTimer);
+            statsTimer.start();
             s.addSelectable(&netlink);
             s.addSelectable(&deviceMetadataTableSubscriber);
+            s.addSelectable(&fpmsyncdCfgSubscriber);
 
             if (sync.isSuppressionEnabled())
             {
@@ -240,6 +236,33 @@ int main(int argc, char **argv)
                         s.removeSelectable(&eoiuCheckTimer);
                     }
                 }
+                else if (temps == &statsTimer)
+                {
+                    vector<FieldValueTuple> fvs;
+                    fpm.getQueue()->dumpStats(fvs);
+                    fpmStatsTable.set("queue", fvs);
+
+                    fvs.clear();
+                    flushPolicy.dumpStats(fvs);
+                    fpmStatsTable.set("flush", fvs);
+
+                    fvs.clear();
+                    sync.getRouteStateCache().dumpStats(fvs);
+                    fpmStatsTable.set("route_cache", fvs);
+                }
+                else if (temps == &fpmsyncdCfgSubscriber)
+                {
+                    std::deque<KeyOpFieldsValuesTuple> keyOpFvsQueue;
+                    fpmsyncdCfgSubscriber.pops(keyOpFvsQueue);
+
+                    for (const auto& keyOpFvs: keyOpFvsQueue)
+                    {
+                        if (kfvOp(keyOpFvs) == SET_COMMAND && kfvKey(keyOpFvs) == "flush")
+                        {
+                            flushPolicy.applyConfig(kfvFieldsValues(keyOpFvs));
+                        }
+                    }
+                }
                 else if (temps == &deviceMetadataTableSubscriber)
                 {
                     std::deque<KeyOpFieldsValuesTuple> keyOpFvsQueue;
@@ -310,7 +333,7 @@ int main(int argc, char **argv)
                 }
                 else if (!warmStartEnabled || sync.getWarmStartHelper().isReconciled())
                 {
-                    flushPipeline(pipeline);
+                    gSelectTimeout = flushPolicy.run(pipeline, fpm.getQueue()->depth());
                 }
             }
         }
@@ -322,35 +345,3 @@ int main(int argc, char **argv)
 
     return 1;
 }
-
-void flushPipeline(RedisPipeline& pipeline) {
-
-    size_t remaining = pipeline.size();
-
-    if (remaining == 0) {
-        gSelectTimeout = INFINITE;
-        return;
-    }
-
-    int idle = pipeline.getIdleTime();
-
-    // flush the pipeline if
-    // 1. traffic is not scaled (only prevent fpmsyncd from flushing ppl too frequently in the scaled case)
-    // 2. the idle time since last flush has exceeded gFlushTimeout
-    // 3. idle <= 0, due to system clock drift, should not happen since we already use steady_clock for timing
-    if (remaining < SMALL_TRAFFIC || idle >= gFlushTimeout || idle <= 0) {
-
-        pipeline.flush();
-
-        gSelectTimeout = INFINITE;
-
-        SWSS_LOG_DEBUG("Pipeline flushed");
-    }
-    else
-    {
-        // skip flushing ppl and set the timeout of fpmsyncd select function to be (gFlushTimeout - idle)
-        // so that fpmsyncd select function would block at most for (gFlushTimeout - idle)
-        // by doing this, we make sure every entry eventually gets flushed
-        gSelectTimeout = gFlushTimeout - idle;
-    }
-}
@@ -5,4 +5,14 @@
 // redispipeline has a maximum capacity of 50000 entries
 #define ROUTE_SYNC_PPL_SIZE 50000
 
+// number of FPM read chunks buffered between the socket reader thread and RouteSync
+#define FPM_QUEUE_SIZE 4096
+
+// fpmsyncd configuration in CONFIG_DB
+#define CFG_FPMSYNCD_TABLE_NAME "FPMSYNCD"
+
+// fpmsyncd runtime statistics in STATE_DB
+#define STATE_FPMSYNCD_STATS_TABLE_NAME "FPMSYNCD_STATS"
+#define FPMSYNCD_STATS_INTERVAL 10  // 10 seconds
+
 #endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "logger.h"
+#include "fpmsyncd/routestatecache.h"
+
+using namespace swss;
+using namespace std;
+
+/* 64-bit FNV-1a */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME        0x100000001b3ULL
+
+static inline uint64_t fnvUpdate(uint64_t hash, const string &str)
+{
+    for (unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+
+    /* Terminate every string so that {"ab","c"} and {"a","bc"} differ */
+    hash ^= 0xff;
+    hash *= FNV_PRIME;
+
+    return hash;
+}
+
+RouteStateCache::RouteStateCache(size_t maxEntries) :
+    m_maxEntries(maxEntries),
+    m_ackRequired(false),
+    m_published(0),
+    m_suppressed(0),
+    m_untracked(0),
+    m_failed(0)
+{
+}
+
+uint64_t RouteStateCache::hashKey(const string &key)
+{
+    return fnvUpdate(FNV_OFFSET_BASIS, key);
+}
+
+uint64_t RouteStateCache::hashFields(const vector<FieldValueTuple> &fvs)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (const auto &fv : fvs)
+    {
+        hash = fnvUpdate(hash, fvField(fv));
+        hash = fnvUpdate(hash, fvValue(fv));
+    }
+
+    return hash;
+}
+
+bool RouteStateCache::insert(uint64_t key, uint64_t value)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+        if (it->second.fields == value && it->second.pending == 0)
+        {
+            return true;
+        }
+        it->second.fields = value;
+        if (m_ackRequired)
+        {
+            /* Another write while one is outstanding */
+            it->second.pending = static_cast<uint8_t>(it->second.pending ? 2 : 1);
+        }
+        return false;
+    }
+
+    if (m_entries.size() >= m_maxEntries)
+    {
+        m_untracked++;
+        return false;
+    }
+
+    m_entries.emplace(key, Entry{value, static_cast<uint8_t>(m_ackRequired ? 1 : 0)});
+    return false;
+}
+
+bool RouteStateCache::checkAndUpdate(const string &key, const vector<FieldValueTuple> &fvs)
+{
+    if (insert(hashKey(key), hashFields(fvs)))
+    {
+        m_suppressed++;
+        SWSS_LOG_DEBUG("Suppressing unchanged route update for %s", key.c_str());
+        return true;
+    }
+
+    m_published++;
+    return false;
+}
+
+void RouteStateCache::update(const string &key, const vector<FieldValueTuple> &fvs)
+{
+    insert(hashKey(key), hashFields(fvs));
+}
+
+void RouteStateCache::setAckRequired(bool required)
+{
+    if (required == m_ackRequired)
+    {
+        return;
+    }
+
+    /* States trusted without an ack are not known to be offloaded */
+    m_ackRequired = required;
+    m_entries.clear();
+}
+
+void RouteStateCache::ack(const string &key, bool success)
+{
+    auto it = m_entries.find(hashKey(key));
+    if (it == m_entries.end())
+    {
+        return;
+    }
+
+    if (!success)
+    {
+        m_failed++;
+        m_entries.erase(it);
+        return;
+    }
+
+    if (it->second.pending)
+    {
+        it->second.pending--;
+    }
+}
+
+void RouteStateCache::erase(const string &key)
+{
+    m_entries.erase(hashKey(key));
+}
+
+void RouteStateCache::clear()
+{
+    m_entries.clear();
+}
+
+void RouteStateCache::dumpStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("entries", to_string(m_entries.size()));
+    fvs.emplace_back("max_entries", to_string(m_maxEntries));
+    fvs.emplace_back("published", to_string(m_published));
+    fvs.emplace_back("suppressed", to_string(m_suppressed));
+    fvs.emplace_back("untracked", to_string(m_untracked));
+    fvs.emplace_back("failed", to_string(m_failed));
+}
@@ -0,0 +1,87 @@
+#ifndef __ROUTESTATECACHE__
+#define __ROUTESTATECACHE__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Remembers what fpmsyncd last published for each ROUTE_TABLE key, so that
+ * identical updates re-sent by zebra (e.g. after 'clear bgp soft' or a NHG
+ * re-ID) do not reach APPL_DB and trigger a full orchagent reprocess.
+ *
+ * Entries are stored as a 64-bit hash of the key mapped to a 64-bit hash of
+ * the field/value list, so each route costs a fixed few dozen bytes. A write
+ * is only suppressed when both hashes match. Once maxEntries is reached, new
+ * keys are no longer tracked and are always written.
+ *
+ * When acks are required (fib suppression), a written state is pending until
+ * orchagent confirms it through ack(). Only confirmed states are suppressed,
+ * and a failure reply forgets the key so that the next resend is written.
+ */
+class RouteStateCache
+{
+public:
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 2000000;
+
+    RouteStateCache(size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
+    /*
+     * Returns true when key was last published with exactly these fields and
+     * the write can be skipped. Otherwise records the new state and returns false.
+     */
+    bool checkAndUpdate(const std::string &key, const std::vector<FieldValueTuple> &fvs);
+
+    /* Record state without counting it as a publish, e.g. a warm-restart refresh */
+    void update(const std::string &key, const std::vector<FieldValueTuple> &fvs);
+
+    /* Written states stay pending until acked, instead of being trusted right away */
+    void setAckRequired(bool required);
+
+    /* orchagent response for a written key */
+    void ack(const std::string &key, bool success);
+
+    void erase(const std::string &key);
+    void clear();
+
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    void dumpStats(std::vector<FieldValueTuple> &fvs) const;
+
+    static uint64_t hashKey(const std::string &key);
+    static uint64_t hashFields(const std::vector<FieldValueTuple> &fvs);
+
+private:
+    /*
+     * Writes whose response is still expected: 0 once confirmed. Capped at 2,
+     * since orchagent may answer several writes of a key with one response,
+     * an entry written twice is only confirmed by a response to a later write.
+     */
+    struct Entry
+    {
+        uint64_t fields;
+        uint8_t pending;
+    };
+
+    bool insert(uint64_t key, uint64_t value);
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+    size_t m_maxEntries;
+    bool m_ackRequired;
+
+    uint64_t m_published;
+    uint64_t m_suppressed;
+    uint64_t m_untracked;
+    uint64_t m_failed;
+};
+
+}
+
+#endif
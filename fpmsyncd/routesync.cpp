@@ -163,19 +163,35 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
 }
 
-void RouteSync::setRouteWithWarmRestart(FieldValueTupleWrapperBase & fvw,
+bool RouteSync::setRouteWithWarmRestart(FieldValueTupleWrapperBase & fvw,
                                         ProducerStateTable & table )
 {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
+    bool isRouteTable = (&table == m_routeTable.get());
+    auto kfvVector = fvw.KeyOpFieldsValuesTupleVector();
 
     if (!warmRestartInProgress)
     {
-        table.set(fvw.KeyOpFieldsValuesTupleVector());
+        if (isRouteTable && m_routeStateCache.checkAndUpdate(fvw.key, kfvFieldsValues(kfvVector[1])))
+        {
+            return false;
+        }
+        table.set(kfvVector);
     }
     else
     {
-        m_warmStartHelper.insertRefreshMap(fvw.KeyOpFieldsValuesTupleVector()[1]);
+        /*
+         * Refreshed routes are what APPL_DB holds once reconciliation is done,
+         * so the cache is rebuilt from them during the warm-restart cycle.
+         */
+        if (isRouteTable)
+        {
+            m_routeStateCache.update(fvw.key, kfvFieldsValues(kfvVector[1]));
+        }
+        m_warmStartHelper.insertRefreshMap(kfvVector[1]);
     }
+
+    return true;
 }
 
 void RouteSync::setTable(FieldValueTupleWrapperBase & fvw,
@@ -188,6 +204,10 @@ void RouteSync::setTable(FieldValueTupleWrapperBase & fvw,
 void RouteSync::delWithWarmRestart(FieldValueTupleWrapperBase && fvw,
 				   ProducerStateTable & table) {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
+    if (&table == m_routeTable.get())
+    {
+        m_routeStateCache.erase(fvw.key);
+    }
     if (!warmRestartInProgress) {
         table.del(fvw.key);
     } else {
@@ -877,7 +897,11 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
     fvw.vni_label = std::move(vni_list);
     fvw.router_mac = std::move(mac_list);
 
-    setRouteWithWarmRestart(fvw, *m_routeTable);
+    if (!setRouteWithWarmRestart(fvw, *m_routeTable))
+    {
+        /* zebra was already answered when the message arrived */
+        SWSS_LOG_DEBUG("EVPN RouteTable msg: %s is unchanged", fvw.key.c_str());
+    }
     return;
 }
 
@@ -1255,7 +1279,15 @@ void RouteSync::onSrv6SteerRouteMsg(struct nlmsghdr *h, int len)
         {
             rfvw.seg_src = std::move(src_addr_str);
         }
-        setRouteWithWarmRestart(rfvw, *m_routeTable);
+        if (!setRouteWithWarmRestart(rfvw, *m_routeTable))
+        {
+            /*
+             * Written without a protocol, orchagent's response for these
+             * routes is not forwarded to zebra either, so there is nothing
+             * to answer for the skipped write.
+             */
+            SWSS_LOG_DEBUG("SRV6 RouteTable msg: %s is unchanged", rfvw.key.c_str());
+        }
     }
 
     return;
@@ -1729,7 +1761,11 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             SWSS_LOG_INFO("RouteTable set blackhole msg: %s", destipprefix);
             RouteTableFieldValueTupleWrapper fvw {std::move(destipprefix), std::move(proto_str)};
             fvw.blackhole = "true";
-            setRouteWithWarmRestart(fvw, *m_routeTable);
+            if (!setRouteWithWarmRestart(fvw, *m_routeTable) && isSuppressionEnabled())
+            {
+                /* No response will come from orchagent for an unchanged route */
+                sendOffloadReply(route_obj);
+            }
             return;
         }
         case RTN_UNICAST:
@@ -1765,13 +1801,18 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         if(nhg.group.size() == 0)
         {
         // Using route-table only for single next-hop
-        string nexthops = nhg.nexthop.empty() ? (rtnl_route_get_family(route_obj) == AF_INET ? "0.0.0.0" : "::") : nhg.nexthop;
-        string ifnames, weights;
-
-        getNextHopGroupFields(nhg, nexthops, ifnames, weights, rtnl_route_get_family(route_obj));
+        refreshNextHopGroupFields(nhg);
 
-        fvw.nexthop = std::move(nexthops);
-        fvw.ifname = std::move(ifnames);
+        // The cached fields hold the IPv4 default gateway, pick the one of the route family
+        if (nhg.nexthop.empty())
+        {
+            fvw.nexthop = rtnl_route_get_family(route_obj) == AF_INET ? "0.0.0.0" : "::";
+        }
+        else
+        {
+            fvw.nexthop = nhg.nexthopField;
+        }
+        fvw.ifname = nhg.ifnameField;
 
         SWSS_LOG_DEBUG("NextHop group id %d is a single nexthop address. Filling the route table %s with nexthop and ifname", nhg_id, destipprefix);
         }
@@ -1841,7 +1882,19 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         }
     }
 
-    setRouteWithWarmRestart(fvw, *m_routeTable);
+    if (!setRouteWithWarmRestart(fvw, *m_routeTable))
+    {
+        if (isSuppressionEnabled())
+        {
+            /*
+             * No response will come from orchagent for an unchanged route.
+             * Only routes orchagent confirmed are suppressed, so it is offloaded.
+             */
+            sendOffloadReply(route_obj);
+        }
+        return;
+    }
+
     if (nhg_id)
     {
         SWSS_LOG_INFO("RouteTable set msg with NHG: %s nhg_id:%d", destipprefix, nhg_id);
@@ -1918,15 +1971,19 @@ void RouteSync::onNextHopMsg(struct nlmsghdr *h, int len)
             if (it != m_nh_groups.end())
             {
                 NextHopGroup &nhg = it->second;
-                nhg.group = group;
-                if (nhg.installed)
+                if (nhg.group != group)
                 {
-                    updateNextHopGroupDb(nhg);
+                    setNextHopGroupMembers(nhg, group);
+                    if (nhg.installed)
+                    {
+                        queueNextHopGroupUpdate(id);
+                    }
                 }
             }
             else
             {
-                m_nh_groups.insert({id, NextHopGroup(id, group)});
+                auto res = m_nh_groups.emplace(id, NextHopGroup(id, vector<pair<uint32_t, uint8_t>>()));
+                setNextHopGroupMembers(res.first->second, group);
             }
         }
         else
@@ -1967,7 +2024,27 @@ void RouteSync::onNextHopMsg(struct nlmsghdr *h, int len)
             }
 
             SWSS_LOG_DEBUG("Received: id[%d], if[%d/%s] address[%s]", id, ifindex, ifname.c_str(), gateway);
-            m_nh_groups.insert({id, NextHopGroup(id, string(gateway), ifname)});
+            auto it = m_nh_groups.find(id);
+            if (it == m_nh_groups.end())
+            {
+                m_nh_groups.insert({id, NextHopGroup(id, string(gateway), ifname)});
+            }
+            else
+            {
+                NextHopGroup &nh = it->second;
+                if (nh.nexthop == gateway && nh.intf == ifname && nh.group.empty())
+                {
+                    return;
+                }
+                setNextHopGroupMembers(nh, {});
+                nh.nexthop = gateway;
+                nh.intf = ifname;
+                if (nh.installed)
+                {
+                    queueNextHopGroupUpdate(id);
+                }
+            }
+            onNextHopChanged(id);
         }
     }
     else if (nlmsg_type == RTM_DELNEXTHOP)
@@ -2499,6 +2576,8 @@ void RouteSync::setSuppressionEnabled(bool enabled)
     SWSS_LOG_ENTER();
 
     m_isSuppressionEnabled = enabled;
+    /* zebra is told a route is offloaded only once orchagent confirmed it */
+    m_routeStateCache.setAckRequired(enabled);
 
     SWSS_LOG_NOTICE("Pending routes suppression is %s", (m_isSuppressionEnabled ? "enabled": "disabled"));
 }
@@ -2554,6 +2633,9 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
         return;
     }
 
+    /* The written state is known to be offloaded, or must be written again */
+    m_routeStateCache.ack(key, isSuccessReply);
+
     if (!isSuccessReply)
     {
         SWSS_LOG_INFO("Received failure response for prefix %s(%s)",
@@ -2685,7 +2767,10 @@ void RouteSync::installNextHopGroup(uint32_t nh_id)
         return;
     }
     nhg.installed = true;
-    updateNextHopGroupDb(nhg);
+
+    /* The route referencing the group is written next, so the group must go first */
+    queueNextHopGroupUpdate(nh_id);
+    flushNextHopGroups();
 }
 
 /*
@@ -2710,33 +2795,175 @@ void RouteSync::deleteNextHopGroup(uint32_t nh_id)
         SWSS_LOG_DEBUG("NextHopGroup table del: key [%s]", key.c_str());
         m_nexthop_groupTable.del(key);
     }
+
+    if (m_nh_groups_pending_set.erase(nh_id))
+    {
+        m_nh_groups_pending.erase(std::remove(m_nh_groups_pending.begin(), m_nh_groups_pending.end(), nh_id),
+                                  m_nh_groups_pending.end());
+    }
+
+    setNextHopGroupMembers(nhg, {});
     m_nh_groups.erase(git);
 }
 
 /*
- * update the nexthop group table in database
+ * replace the members of a nexthop group and keep the reverse index in sync
+ * @arg nhg       the nexthop group
+ * @arg group     new list of member ids and weights
+ *
+ */
+void RouteSync::setNextHopGroupMembers(NextHopGroup& nhg, const vector<pair<uint32_t,uint8_t>>& group)
+{
+    for (const auto& nh : nhg.group)
+    {
+        auto rit = m_nh_group_refs.find(nh.first);
+        if (rit == m_nh_group_refs.end())
+        {
+            continue;
+        }
+        rit->second.erase(nhg.id);
+        if (rit->second.empty())
+        {
+            m_nh_group_refs.erase(rit);
+        }
+    }
+
+    nhg.group = group;
+    nhg.fieldsValid = false;
+
+    for (const auto& nh : nhg.group)
+    {
+        m_nh_group_refs[nh.first].insert(nhg.id);
+    }
+}
+
+/*
+ * invalidate the groups using a nexthop which was added or changed
+ * @arg nh_id     nexthop id
+ *
+ */
+void RouteSync::onNextHopChanged(uint32_t nh_id)
+{
+    auto rit = m_nh_group_refs.find(nh_id);
+    if (rit == m_nh_group_refs.end())
+    {
+        return;
+    }
+
+    for (auto group_id : rit->second)
+    {
+        auto git = m_nh_groups.find(group_id);
+        if (git == m_nh_groups.end())
+        {
+            continue;
+        }
+
+        git->second.fieldsValid = false;
+        if (git->second.installed)
+        {
+            queueNextHopGroupUpdate(group_id);
+        }
+    }
+}
+
+/*
+ * schedule a NEXTHOP_GROUP_TABLE rewrite for the next flushNextHopGroups()
+ * @arg nh_id     nexthop group id
+ *
+ */
+void RouteSync::queueNextHopGroupUpdate(uint32_t nh_id)
+{
+    if (m_nh_groups_pending_set.insert(nh_id).second)
+    {
+        m_nh_groups_pending.push_back(nh_id);
+    }
+}
+
+void RouteSync::flushNextHopGroups()
+{
+    if (m_nh_groups_pending.empty())
+    {
+        return;
+    }
+
+    vector<KeyOpFieldsValuesTuple> kfvVector;
+    kfvVector.reserve(m_nh_groups_pending.size() * 2);
+
+    for (auto nh_id : m_nh_groups_pending)
+    {
+        auto git = m_nh_groups.find(nh_id);
+        if (git == m_nh_groups.end() || !git->second.installed)
+        {
+            continue;
+        }
+
+        auto fvw = getNextHopGroupFvw(git->second);
+        for (auto& kfv : fvw.KeyOpFieldsValuesTupleVector())
+        {
+            kfvVector.push_back(std::move(kfv));
+        }
+    }
+
+    if (!kfvVector.empty())
+    {
+        SWSS_LOG_INFO("NextHopGroup table batch set: %zu groups", kfvVector.size() / 2);
+        m_nexthop_groupTable.set(kfvVector);
+    }
+
+    m_nh_groups_pending.clear();
+    m_nh_groups_pending_set.clear();
+}
+
+/*
+ * regenerate the joined fields of a group if it changed since they were
+ * generated
  * @arg nhg     the nexthop group
  *
  */
-void RouteSync::updateNextHopGroupDb(const NextHopGroup& nhg)
+void RouteSync::refreshNextHopGroupFields(const NextHopGroup& nhg)
 {
-    string nexthops;
-    string ifnames;
-    string weights;
-    string key = getNextHopGroupKeyAsString(nhg.id);
-    getNextHopGroupFields(nhg, nexthops, ifnames, weights);
+    if (!nhg.fieldsValid)
+    {
+        nhg.nexthopField.clear();
+        nhg.ifnameField.clear();
+        nhg.weightField.clear();
+        getNextHopGroupFields(nhg, nhg.nexthopField, nhg.ifnameField, nhg.weightField);
+        nhg.fieldsValid = true;
+    }
+}
 
-    SWSS_LOG_INFO("NextHopGroup table set: key [%s] nexthop[%s] ifname[%s] weight[%s]",
-                  key.c_str(), nexthops.c_str(), ifnames.c_str(),
-                  weights.empty() ? "NONE": weights.c_str());
+/*
+ * build the NEXTHOP_GROUP_TABLE entry of a group, reusing the joined fields
+ * unless the group changed since they were generated
+ * @arg nhg     the nexthop group
+ *
+ */
+NextHopGroupTableFieldValueTupleWrapper RouteSync::getNextHopGroupFvw(const NextHopGroup& nhg)
+{
+    refreshNextHopGroupFields(nhg);
 
-    NextHopGroupTableFieldValueTupleWrapper fvw{std::move(key)};
-    fvw.nexthop = std::move(nexthops);
-    fvw.ifname = std::move(ifnames);
-    if(!weights.empty())
+    SWSS_LOG_INFO("NextHopGroup table set: key [%u] nexthop[%s] ifname[%s] weight[%s]",
+                  nhg.id, nhg.nexthopField.c_str(), nhg.ifnameField.c_str(),
+                  nhg.weightField.empty() ? "NONE": nhg.weightField.c_str());
+
+    NextHopGroupTableFieldValueTupleWrapper fvw{getNextHopGroupKeyAsString(nhg.id)};
+    fvw.nexthop = nhg.nexthopField;
+    fvw.ifname = nhg.ifnameField;
+    if(!nhg.weightField.empty())
     {
-        fvw.weight = std::move(weights);
+        fvw.weight = nhg.weightField;
     }
+    return fvw;
+}
+
+/*
+ * update the nexthop group table in database
+ * @arg nhg     the nexthop group
+ *
+ */
+void RouteSync::updateNextHopGroupDb(const NextHopGroup& nhg)
+{
+    auto fvw = getNextHopGroupFvw(nhg);
     setTable(fvw, m_nexthop_groupTable);
 }
 
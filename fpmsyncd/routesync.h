@@ -8,6 +8,7 @@
 #include "netmsg.h"
 #include "linkcache.h"
 #include "fpminterface.h"
+#include "routestatecache.h"
 #include "warmRestartHelper.h"
 #include <string.h>
 #include <bits/stdc++.h>
@@ -35,6 +36,14 @@ struct NextHopGroup {
     string nexthop;
     string intf;
     bool installed;
+    /*
+     * Comma-joined NEXTHOP_GROUP_TABLE fields of a group. Regenerated only
+     * when the group or one of its member nexthops changes.
+     */
+    mutable bool fieldsValid = false;
+    mutable string nexthopField;
+    mutable string ifnameField;
+    mutable string weightField;
     NextHopGroup(uint32_t id, const string& nexthop, const string& interface) : installed(false), id(id), nexthop(nexthop), intf(interface) {};
     NextHopGroup(uint32_t id, const vector<pair<uint32_t,uint8_t>>& group) : installed(false), id(id), group(group) {};
 };
@@ -192,8 +201,12 @@ public:
         return m_isSuppressionEnabled;
     }
 
-    /* Helper method to set route table with warm restart support */
-    void setRouteWithWarmRestart(
+    /*
+     * Helper method to set route table with warm restart support.
+     * Returns false when the write was suppressed because ROUTE_TABLE
+     * already holds the same content.
+     */
+    bool setRouteWithWarmRestart(
         FieldValueTupleWrapperBase & fvw,
         ProducerStateTable & table);
 
@@ -218,9 +231,18 @@ public:
         m_fpmInterface = &fpm;
     }
 
+    /*
+     * Write the NEXTHOP_GROUP_TABLE updates accumulated while processing
+     * the current FPM read in a single batch.
+     */
+    void flushNextHopGroups();
+
     void onFpmDisconnected()
     {
         m_fpmInterface = nullptr;
+
+        /* zebra may come back with a different view, republish everything */
+        m_routeStateCache.clear();
     }
 
     WarmStartHelper& getWarmStartHelper()
@@ -228,6 +250,11 @@ public:
         return m_warmStartHelper;
     }
 
+    RouteStateCache& getRouteStateCache()
+    {
+        return m_routeStateCache;
+    }
+
 private:
     /* ZMQ client */
     shared_ptr<ZmqClient> m_zmqClient;
@@ -249,7 +276,14 @@ private:
     struct nl_sock     *m_nl_sock;
     /* nexthop group table */
     ProducerStateTable  m_nexthop_groupTable;
-    map<uint32_t,NextHopGroup> m_nh_groups;
+    unordered_map<uint32_t,NextHopGroup> m_nh_groups;
+    /* member nexthop id -> ids of the groups referencing it */
+    unordered_map<uint32_t, unordered_set<uint32_t>> m_nh_group_refs;
+    /* installed groups whose NEXTHOP_GROUP_TABLE entry must be rewritten */
+    vector<uint32_t> m_nh_groups_pending;
+    unordered_set<uint32_t> m_nh_groups_pending_set;
+    /* last published ROUTE_TABLE state, to suppress no-op writes */
+    RouteStateCache     m_routeStateCache;
 
     bool                m_isSuppressionEnabled{false};
     FpmInterface*       m_fpmInterface {nullptr};
@@ -346,6 +380,11 @@ private:
     void installNextHopGroup(uint32_t nh_id);
     void deleteNextHopGroup(uint32_t nh_id);
     void updateNextHopGroupDb(const NextHopGroup& nhg);
+    void queueNextHopGroupUpdate(uint32_t nh_id);
+    void setNextHopGroupMembers(NextHopGroup& nhg, const vector<pair<uint32_t,uint8_t>>& group);
+    void onNextHopChanged(uint32_t nh_id);
+    void refreshNextHopGroupFields(const NextHopGroup& nhg);
+    NextHopGroupTableFieldValueTupleWrapper getNextHopGroupFvw(const NextHopGroup& nhg);
     void getNextHopGroupFields(const NextHopGroup& nhg, string& nexthops, string& ifnames, string& weights, uint8_t af = AF_INET);
 };
 
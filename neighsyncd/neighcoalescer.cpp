@@ -0,0 +1,144 @@
+#include "logger.h"
+#include "neighsyncd/neighcoalescer.h"
+
+using namespace swss;
+using namespace std;
+
+NeighCoalescer::NeighCoalescer(ProducerStateTable *table, int windowMs, size_t maxPending) :
+    m_table(table),
+    m_window(windowMs),
+    m_maxPending(maxPending),
+    m_events(0),
+    m_coalesced(0),
+    m_suppressed(0),
+    m_sets(0),
+    m_dels(0),
+    m_flushes(0)
+{
+}
+
+void NeighCoalescer::set(const string &key, const vector<FieldValueTuple> &fvs)
+{
+    add(key, false, fvs);
+}
+
+void NeighCoalescer::del(const string &key)
+{
+    add(key, true, {});
+}
+
+void NeighCoalescer::add(const string &key, bool del, const vector<FieldValueTuple> &fvs)
+{
+    m_events++;
+
+    if (m_pending.empty())
+    {
+        m_windowStart = Clock::now();
+    }
+
+    auto it = m_pending.find(key);
+    if (it != m_pending.end())
+    {
+        /* Only the last update of the window is written */
+        m_coalesced++;
+        it->second.del = del;
+        it->second.fvs = fvs;
+        return;
+    }
+
+    m_pending.emplace(key, PendingNeigh{del, fvs});
+}
+
+int NeighCoalescer::run()
+{
+    return run(Clock::now());
+}
+
+int NeighCoalescer::run(Clock::time_point now)
+{
+    if (m_pending.empty())
+    {
+        return -1;
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - m_windowStart);
+    if (elapsed >= m_window || m_pending.size() >= m_maxPending)
+    {
+        flush();
+        return -1;
+    }
+
+    return static_cast<int>((m_window - elapsed).count());
+}
+
+void NeighCoalescer::flush()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    vector<KeyOpFieldsValuesTuple> sets;
+    vector<string> dels;
+
+    for (auto &entry : m_pending)
+    {
+        const string &key = entry.first;
+        PendingNeigh &neigh = entry.second;
+        auto published = m_published.find(key);
+
+        if (neigh.del)
+        {
+            /*
+             * A key that was never written may still be in APPL_DB from before
+             * neighsyncd started, so the DEL is always written.
+             */
+            if (published != m_published.end())
+            {
+                m_published.erase(published);
+            }
+            dels.push_back(key);
+            continue;
+        }
+
+        if (published != m_published.end() && published->second == neigh.fvs)
+        {
+            m_suppressed++;
+            SWSS_LOG_DEBUG("Suppressing unchanged neighbor update for %s", key.c_str());
+            continue;
+        }
+
+        sets.emplace_back(key, SET_COMMAND, neigh.fvs);
+        m_published[key] = std::move(neigh.fvs);
+    }
+
+    m_pending.clear();
+    m_flushes++;
+
+    if (!dels.empty())
+    {
+        m_table->del(dels);
+        m_dels += dels.size();
+    }
+
+    if (!sets.empty())
+    {
+        m_table->set(sets);
+        m_sets += sets.size();
+    }
+
+    SWSS_LOG_INFO("Wrote %zu neighbor updates and %zu deletions", sets.size(), dels.size());
+}
+
+void NeighCoalescer::dumpStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("window_ms", to_string(m_window.count()));
+    fvs.emplace_back("events", to_string(m_events));
+    fvs.emplace_back("coalesced", to_string(m_coalesced));
+    fvs.emplace_back("suppressed", to_string(m_suppressed));
+    fvs.emplace_back("sets", to_string(m_sets));
+    fvs.emplace_back("dels", to_string(m_dels));
+    fvs.emplace_back("flushes", to_string(m_flushes));
+    fvs.emplace_back("pending", to_string(m_pending.size()));
+    fvs.emplace_back("tracked", to_string(m_published.size()));
+}
@@ -0,0 +1,82 @@
+#ifndef __NEIGHCOALESCER__
+#define __NEIGHCOALESCER__
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "producerstatetable.h"
+
+namespace swss {
+
+/*
+ * Holds NEIGH_TABLE updates for a short window before writing them to
+ * APPL_DB. Kernel neighbor state churn (REACHABLE, STALE, DELAY, PROBE...)
+ * re-sends the same entry many times, and a flapping neighbor is deleted and
+ * added back. Within a window only the last update of each key is kept, and
+ * an update leaving a key as it was last written is dropped. The updates of
+ * a window are written with one batched SET and one batched DEL.
+ */
+class NeighCoalescer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr int DEFAULT_WINDOW_MS = 50;
+    static constexpr size_t DEFAULT_MAX_PENDING = 4096;
+
+    NeighCoalescer(ProducerStateTable *table,
+                   int windowMs = DEFAULT_WINDOW_MS,
+                   size_t maxPending = DEFAULT_MAX_PENDING);
+
+    void set(const std::string &key, const std::vector<FieldValueTuple> &fvs);
+    void del(const std::string &key);
+
+    /*
+     * Write the pending updates once the window has expired, or earlier when
+     * maxPending keys are pending. Returns the timeout in milliseconds until
+     * the next write is due, -1 when nothing is pending.
+     */
+    int run();
+    int run(Clock::time_point now);
+
+    void flush();
+
+    size_t pending() const
+    {
+        return m_pending.size();
+    }
+
+    void dumpStats(std::vector<FieldValueTuple> &fvs) const;
+
+private:
+    struct PendingNeigh
+    {
+        bool del;
+        std::vector<FieldValueTuple> fvs;
+    };
+
+    void add(const std::string &key, bool del, const std::vector<FieldValueTuple> &fvs);
+
+    ProducerStateTable *m_table;
+    std::chrono::milliseconds m_window;
+    size_t m_maxPending;
+
+    std::unordered_map<std::string, PendingNeigh> m_pending;
+    Clock::time_point m_windowStart;
+
+    /* Fields last written for each key present in APPL_DB */
+    std::unordered_map<std::string, std::vector<FieldValueTuple>> m_published;
+
+    uint64_t m_events;
+    uint64_t m_coalesced;
+    uint64_t m_suppressed;
+    uint64_t m_sets;
+    uint64_t m_dels;
+    uint64_t m_flushes;
+};
+
+}
+
+#endif
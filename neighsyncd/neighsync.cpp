@@ -21,6 +21,7 @@ using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *cfgDb) :
     m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
+    m_coalescer(&m_neighTable),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
     m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
     m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
@@ -182,10 +183,10 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     {
         if (delete_key == true)
         {
-            m_neighTable.del(key);
+            m_coalescer.del(key);
             return;
         }
-        m_neighTable.set(key, fvVector);
+        m_coalescer.set(key, fvVector);
     }
 }
 
@@ -5,6 +5,7 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
+#include "neighsyncd/neighcoalescer.h"
 
 // The timeout value (in seconds) for neighsyncd reconcilation logic
 #define DEFAULT_NEIGHSYNC_WARMSTART_TIMER 5
@@ -16,6 +17,9 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 180
 
+#define STATE_NEIGHSYNCD_STATS_TABLE_NAME "NEIGHSYNCD_STATS"
+#define NEIGHSYNCD_STATS_INTERVAL 10  // 10 seconds
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -35,9 +39,15 @@ public:
         return m_AppRestartAssist;
     }
 
+    NeighCoalescer &getCoalescer()
+    {
+        return m_coalescer;
+    }
+
 private:
     Table m_stateNeighRestoreTable, m_cfgPeerSwitchTable;
     ProducerStateTable m_neighTable;
+    NeighCoalescer m_coalescer;
     AppRestartAssist  *m_AppRestartAssist;
     Table m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
 
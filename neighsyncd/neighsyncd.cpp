@@ -4,6 +4,7 @@
 #include <chrono>
 #include "logger.h"
 #include "select.h"
+#include "selectabletimer.h"
 #include "netdispatcher.h"
 #include "netlink.h"
 #include "neighsyncd/neighsync.h"
@@ -21,6 +22,7 @@ int main(int argc, char **argv)
     DBConnector cfgDb("CONFIG_DB", 0);
 
     NeighSync sync(&pipelineAppDB, &stateDb, &cfgDb);
+    Table neighStatsTable(&stateDb, STATE_NEIGHSYNCD_STATS_TABLE_NAME);
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWNEIGH, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELNEIGH, &sync);
@@ -31,6 +33,8 @@ int main(int argc, char **argv)
         {
             NetLink netlink;
             Select s;
+            // Periodically export neighbor coalescing statistics to STATE_DB
+            SelectableTimer statsTimer(timespec{NEIGHSYNCD_STATS_INTERVAL, 0});
 
             using namespace std::chrono;
             /*
@@ -67,15 +71,20 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+            s.addSelectable(&statsTimer);
+            statsTimer.start();
+
+            /* Select returns when the pending neighbor updates are due to be written */
+            int timeout = -1;
             while (true)
             {
-                Selectable *temps;
-                s.select(&temps);
+                Selectable *temps = nullptr;
+                int ret = s.select(&temps, timeout);
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
                  */
-                if (sync.getRestartAssist()->isWarmStartInProgress())
+                if (ret == Select::OBJECT && sync.getRestartAssist()->isWarmStartInProgress())
                 {
                     if (sync.getRestartAssist()->checkReconcileTimer(temps))
                     {
@@ -83,6 +92,15 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                if (ret == Select::OBJECT && temps == &statsTimer)
+                {
+                    vector<FieldValueTuple> fvs;
+                    sync.getCoalescer().dumpStats(fvs);
+                    neighStatsTable.set("coalescer", fvs);
+                }
+
+                timeout = sync.getCoalescer().run();
             }
         }
         catch (const std::exception& e)
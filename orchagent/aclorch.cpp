@@ -2,6 +2,7 @@
 #include <limits.h>
 #include <unordered_map>
 #include <algorithm>
+#include <typeinfo>
 #include "aclorch.h"
 #include "logger.h"
 #include "schema.h"
@@ -1447,18 +1448,17 @@ bool AclRule::update(const AclRule& updatedRule)
 {
     SWSS_LOG_ENTER();
 
-    if (!m_rangeConfig.empty() || !updatedRule.m_rangeConfig.empty())
+    if (!updateCounter(updatedRule))
     {
-        SWSS_LOG_ERROR("Updating range matches is currently not implemented");
         return false;
     }
 
-    if (!updateCounter(updatedRule))
+    if (!updatePriority(updatedRule))
     {
         return false;
     }
 
-    if (!updatePriority(updatedRule))
+    if (!updateRanges(updatedRule))
     {
         return false;
     }
@@ -1473,11 +1473,40 @@ bool AclRule::update(const AclRule& updatedRule)
         return false;
     }
 
+    m_config = updatedRule.m_config;
+
+    return true;
+}
+
+bool AclRule::canUpdate(const AclRule& updatedRule) const
+{
+    if (typeid(*this) != typeid(updatedRule))
+    {
+        return false;
+    }
+
+    // Redirect targets take next hop references while the rule is parsed and
+    // release them on removal, so such rules are replaced rather than updated
+    for (const auto *rule: { this, &updatedRule })
+    {
+        if (!rule->m_redirect_target_next_hop.empty() ||
+            !rule->m_redirect_target_next_hop_group.empty() ||
+            rule->m_redirect_target_tun_nh.oid != SAI_NULL_OBJECT_ID)
+        {
+            return false;
+        }
+    }
+
     return true;
 }
 
 bool AclRule::updateCounter(const AclRule& updatedRule)
 {
+    if (m_createCounter == updatedRule.m_createCounter)
+    {
+        return true;
+    }
+
     if (updatedRule.m_createCounter)
     {
         if (!enableCounter())
@@ -1522,6 +1551,64 @@ bool AclRule::updatePriority(const AclRule& updatedRule)
     return true;
 }
 
+bool AclRule::updateRanges(const AclRule& updatedRule)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_rangeConfig == updatedRule.m_rangeConfig)
+    {
+        return true;
+    }
+
+    vector<AclRange*> ranges;
+    vector<sai_object_id_t> rangeOids;
+
+    auto releaseRanges = [&]()
+    {
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            const auto& rangeConfig = updatedRule.m_rangeConfig[i];
+            AclRange::remove(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max);
+        }
+    };
+
+    // Ranges already referenced by other rules, or by this one, are reused
+    for (const auto& rangeConfig: updatedRule.m_rangeConfig)
+    {
+        AclRange *range = AclRange::create(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max);
+        if (!range)
+        {
+            releaseRanges();
+            return false;
+        }
+
+        ranges.push_back(range);
+        rangeOids.push_back(range->getOid());
+    }
+
+    sai_attribute_t attr {};
+    attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
+    attr.value.aclfield.enable = !rangeOids.empty();
+    attr.value.aclfield.data.objlist.count = static_cast<uint32_t>(rangeOids.size());
+    attr.value.aclfield.data.objlist.list = rangeOids.data();
+    if (!setAttribute(attr))
+    {
+        releaseRanges();
+        return false;
+    }
+
+    // The entry no longer references the previous ranges
+    if (!removeRanges())
+    {
+        SWSS_LOG_WARN("Failed to release previous ranges of ACL rule %s", m_id.c_str());
+    }
+
+    m_rangeConfig = updatedRule.m_rangeConfig;
+    m_ranges = ranges;
+
+    return true;
+}
+
 bool AclRule::updateMatches(const AclRule& updatedRule)
 {
     vector<pair<sai_acl_entry_attr_t, SaiAttrWrapper>> matchesUpdated;
@@ -1755,6 +1842,16 @@ bool AclRule::hasCounter() const
     return getCounterOid() != SAI_NULL_OBJECT_ID;
 }
 
+const vector<FieldValueTuple>& AclRule::getConfig() const
+{
+    return m_config;
+}
+
+void AclRule::setConfig(const vector<FieldValueTuple>& config)
+{
+    m_config = config;
+}
+
 const vector<AclRangeConfig>& AclRule::getRangeConfig() const
 {
     return m_rangeConfig;
@@ -2394,6 +2491,11 @@ bool AclRuleMirror::update(const AclRule& rule)
     return false;
 }
 
+bool AclRuleMirror::canUpdate(const AclRule& updatedRule) const
+{
+    return false;
+}
+
 void AclRuleMirror::onUpdate(SubjectType type, void *cntx)
 {
     if (type != SUBJECT_TYPE_MIRROR_SESSION_CHANGE)
@@ -3319,6 +3421,11 @@ bool AclRuleDTelWatchListEntry::update(const AclRule& rule)
     return false;
 }
 
+bool AclRuleDTelWatchListEntry::canUpdate(const AclRule& updatedRule) const
+{
+    return false;
+}
+
 AclRange::AclRange(sai_acl_range_type_t type, sai_object_id_t oid, int min, int max):
     m_oid(oid), m_refCnt(0), m_min(min), m_max(max), m_type(type)
 {
@@ -4170,6 +4277,7 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, DBConnector* stateDb, Switc
         m_aclStageCapabilityTable(stateDb, STATE_ACL_STAGE_CAPABILITY_TABLE_NAME),
         m_aclTableStateTable(stateDb, STATE_ACL_TABLE_TABLE_NAME),
         m_aclRuleStateTable(stateDb, STATE_ACL_RULE_TABLE_NAME),
+        m_aclCounterRuleMapTable(&m_countersDb, COUNTERS_ACL_COUNTER_RULE_MAP),
         m_switchOrch(switchOrch),
         m_mirrorOrch(mirrorOrch),
         m_neighOrch(neighOrch),
@@ -4261,6 +4369,18 @@ void AclOrch::doTask(Consumer &consumer)
     {
         SWSS_LOG_ERROR("Invalid table %s", table_name.c_str());
     }
+
+    flushCounters();
+}
+
+void AclOrch::doTask()
+{
+    SWSS_LOG_ENTER();
+
+    Orch::doTask();
+
+    // Rules may also be added on behalf of other orchs, e.g. PBH and mirror sessions
+    flushCounters();
 }
 
 void AclOrch::getAddDeletePorts(AclTable    &newT,
@@ -5537,6 +5657,23 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
                 type = table_id == m_mirrorTableId[stage] ? TABLE_TYPE_MIRROR : TABLE_TYPE_MIRRORV6;
             }
 
+            // Canonical form of the rule configuration, compared against the
+            // installed rule so that re-sent rules are not parsed and programmed again
+            vector<FieldValueTuple> config;
+            for (const auto& fv : kfvFieldsValues(t))
+            {
+                config.emplace_back(to_upper(fvField(fv)), fvValue(fv));
+            }
+            sort(config.begin(), config.end());
+
+            auto existingRule = getAclRule(table_id, rule_id);
+            if (existingRule && existingRule->getConfig() == config)
+            {
+                SWSS_LOG_INFO("ACL rule %s is unchanged", key.c_str());
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
 
             try
             {
@@ -5630,7 +5767,14 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
-                if (addAclRule(newRule, table_id))
+                newRule->setConfig(config);
+
+                // Push only the changed attributes to an installed rule when possible,
+                // otherwise the rule is removed and created again
+                bool updated = existingRule && !isUsingEgrSetDscp(table_id) &&
+                    existingRule->canUpdate(*newRule) && updateAclRule(newRule);
+
+                if (updated || addAclRule(newRule, table_id))
                 {
                     setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
                     it = consumer.m_toSync.erase(it);
@@ -5957,33 +6101,53 @@ void AclOrch::registerFlexCounter(const AclRule& rule)
 {
     SWSS_LOG_ENTER();
 
-    auto ruleIdentifier = generateAclRuleIdentifierInCountersDb(rule);
-    auto counterOidStr = sai_serialize_object_id(rule.getCounterOid());
-
-    unordered_set<string> serializedCounterStatAttrs;
-    for (const auto& counterAttrPair: aclCounterLookup)
+    if (m_counterStatAttrs.empty())
     {
-        sai_acl_counter_attr_t id {};
-        tie(std::ignore, id) = counterAttrPair;
-        auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_COUNTER, id);
-        if (!meta)
+        for (const auto& counterAttrPair: aclCounterLookup)
         {
-            SWSS_LOG_THROW("SAI Bug: Failed to get metadata of attribute %d for SAI_OBJECT_TYPE_ACL_COUNTER", id);
+            sai_acl_counter_attr_t id {};
+            tie(std::ignore, id) = counterAttrPair;
+            auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_COUNTER, id);
+            if (!meta)
+            {
+                SWSS_LOG_THROW("SAI Bug: Failed to get metadata of attribute %d for SAI_OBJECT_TYPE_ACL_COUNTER", id);
+            }
+            m_counterStatAttrs.insert(sai_serialize_attr_id(*meta));
         }
-        serializedCounterStatAttrs.insert(sai_serialize_attr_id(*meta));
     }
 
-    m_flex_counter_manager.setCounterIdList(rule.getCounterOid(), CounterType::ACL_COUNTER, serializedCounterStatAttrs);
-    m_countersDb.hset(COUNTERS_ACL_COUNTER_RULE_MAP, ruleIdentifier, counterOidStr);
+    // Counters and their map entries are cached and installed together in flushCounters()
+    auto ruleIdentifier = generateAclRuleIdentifierInCountersDb(rule);
+    m_flex_counter_manager.setCounterIdList(rule.getCounterOid(), CounterType::ACL_COUNTER, m_counterStatAttrs);
+    m_pendingCounterRuleMap[ruleIdentifier] = sai_serialize_object_id(rule.getCounterOid());
 }
 
 void AclOrch::deregisterFlexCounter(const AclRule& rule)
 {
     auto ruleIdentifier = generateAclRuleIdentifierInCountersDb(rule);
-    m_countersDb.hdel(COUNTERS_ACL_COUNTER_RULE_MAP, ruleIdentifier);
+    if (!m_pendingCounterRuleMap.erase(ruleIdentifier))
+    {
+        m_countersDb.hdel(COUNTERS_ACL_COUNTER_RULE_MAP, ruleIdentifier);
+    }
     m_flex_counter_manager.clearCounterIdList(rule.getCounterOid());
 }
 
+void AclOrch::flushCounters()
+{
+    SWSS_LOG_ENTER();
+
+    m_flex_counter_manager.flush();
+
+    if (m_pendingCounterRuleMap.empty())
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> counterRuleMap(m_pendingCounterRuleMap.begin(), m_pendingCounterRuleMap.end());
+    m_aclCounterRuleMapTable.set("", counterRuleMap);
+    m_pendingCounterRuleMap.clear();
+}
+
 string AclOrch::generateAclRuleIdentifierInCountersDb(const AclRule& rule) const
 {
     return rule.getTableId() + m_countersTable.getTableNameSeparator() + rule.getId();
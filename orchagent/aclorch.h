@@ -264,6 +264,11 @@ struct AclRangeConfig
     sai_acl_range_type_t rangeType;
     uint32_t min;
     uint32_t max;
+
+    bool operator==(const AclRangeConfig& other) const
+    {
+        return rangeType == other.rangeType && min == other.min && max == other.max;
+    }
 };
 
 class AclRange
@@ -323,6 +328,7 @@ public:
 
     virtual bool create();
     virtual bool update(const AclRule& updatedRule);
+    virtual bool canUpdate(const AclRule& updatedRule) const;
     virtual bool remove();
     virtual void onUpdate(SubjectType, void *) = 0;
     virtual void updateInPorts();
@@ -338,6 +344,10 @@ public:
     vector<sai_object_id_t> getInPorts() const;
     bool getCreateCounter() const;
 
+    // Canonical (upper-cased, sorted) field/value tuples the rule was built from
+    const vector<FieldValueTuple>& getConfig() const;
+    void setConfig(const vector<FieldValueTuple>& config);
+
     const vector<AclRangeConfig>& getRangeConfig() const;
     static shared_ptr<AclRule> makeShared(AclOrch *acl,
                                         MirrorOrch *mirror,
@@ -356,6 +366,7 @@ protected:
     virtual bool removeRule();
 
     virtual bool updatePriority(const AclRule& updatedRule);
+    virtual bool updateRanges(const AclRule& updatedRule);
     virtual bool updateMatches(const AclRule& updatedRule);
     virtual bool updateActions(const AclRule& updatedRule);
     virtual bool updateCounter(const AclRule& updatedRule);
@@ -386,6 +397,7 @@ protected:
 
     vector<AclRangeConfig> m_rangeConfig;
     vector<AclRange*> m_ranges;
+    vector<FieldValueTuple> m_config;
 
 private:
     bool m_createCounter;
@@ -429,6 +441,7 @@ public:
     bool deactivate();
 
     bool update(const AclRule& updatedRule) override;
+    bool canUpdate(const AclRule& updatedRule) const override;
 protected:
     bool m_state {false};
     string m_sessionName;
@@ -449,6 +462,7 @@ public:
     bool deactivate();
 
     bool update(const AclRule& updatedRule) override;
+    bool canUpdate(const AclRule& updatedRule) const override;
 protected:
     DTelOrch *m_pDTelOrch;
     string m_intSessionId;
@@ -636,6 +650,7 @@ public:
     static bool getAclBindPortId(Port& port, sai_object_id_t& port_id);
 
     using Orch::doTask;  // Allow access to the basic doTask
+    void doTask() override;
     map<sai_object_id_t, AclTable>  getAclTables()
     {
         return m_AclTables;
@@ -681,6 +696,7 @@ private:
     void deleteDTelWatchListTables();
 
     string generateAclRuleIdentifierInCountersDb(const AclRule& rule) const;
+    void flushCounters();
 
     void setAclTableStatus(string table_name, AclObjectStatus status);
     void setAclRuleStatus(string table_name, string rule_name, AclObjectStatus status);
@@ -703,6 +719,7 @@ private:
 
     Table m_aclTableStateTable;
     Table m_aclRuleStateTable;
+    Table m_aclCounterRuleMapTable;
 
     MetaDataMgr m_metaDataMgr;
     map<acl_stage_type_t, string> m_mirrorTableId;
@@ -713,7 +730,10 @@ private:
 
     acl_capabilities_t m_aclCapabilities;
     acl_action_enum_values_capabilities_t m_aclEnumActionCapabilities;
-    FlexCounterManager m_flex_counter_manager;
+    FlexCounterTaggedCachedManager<void> m_flex_counter_manager;
+    unordered_set<string> m_counterStatAttrs;
+    // Rule to counter OID entries of ACL_COUNTER_RULE_MAP written on the next flush
+    unordered_map<string, string> m_pendingCounterRuleMap;
 };
 
 #endif /* SWSS_ACLORCH_H */
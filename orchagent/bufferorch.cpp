@@ -231,24 +231,12 @@ void BufferOrch::initBufferConstants()
 
 void BufferOrch::initFlexCounterGroupTable(void)
 {
-    string bufferPoolWmPluginName = "watermark_bufferpool.lua";
-    string bufferPoolWmSha;
-
-    try
-    {
-        string bufferPoolLuaScript = swss::loadLuaScript(bufferPoolWmPluginName);
-        bufferPoolWmSha = swss::loadRedisScript(m_countersDb.get(), bufferPoolLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_ERROR("Buffer pool watermark lua script and/or flex counter group not set successfully. Runtime error: %s", e.what());
-    }
-
+    // Watermark views are aggregated by WatermarkOrch
     setFlexCounterGroupParameter(BUFFER_POOL_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS,
                                  "", // do not touch stats_mode
                                  BUFFER_POOL_PLUGIN_FIELD,
-                                 bufferPoolWmSha);
+                                 "");
 }
 
 bool BufferOrch::isPortReady(const std::string& port_name) const
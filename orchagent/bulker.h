@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <vector>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
@@ -386,6 +387,34 @@ struct SaiBulkerTraits<sai_next_hop_api_t>
     //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_lag_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_lag_api_t;
+    using create_entry_fn = sai_create_lag_member_fn;
+    using remove_entry_fn = sai_remove_lag_member_fn;
+    using set_entry_attribute_fn = sai_set_lag_member_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_vlan_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_vlan_api_t;
+    using create_entry_fn = sai_create_vlan_member_fn;
+    using remove_entry_fn = sai_remove_vlan_member_fn;
+    using set_entry_attribute_fn = sai_set_vlan_member_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_mpls_api_t>
 {
@@ -1030,18 +1059,34 @@ public:
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
+    {
+        return create_entry(object_id, nullptr, attr_count, attr_list);
+    }
+
+    // Same as above, with the per-entry status of the bulk create reported
+    // in object_status. The entry is skipped by flush if the caller changes
+    // object_status from SAI_STATUS_NOT_EXECUTED before that.
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
     {
         assert(object_id);
         if (!object_id) throw std::invalid_argument("object_id is null");
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, object_status, std::vector<sai_attribute_t>(attr_list, attr_list + attr_count));
 
-        auto& last_attrs = std::get<1>(creating_entries.back());
+        auto& last_attrs = std::get<2>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
 
         *object_id = SAI_NULL_OBJECT_ID; // not created immediately, postponed until flush
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
         return SAI_STATUS_NOT_EXECUTED;
     }
 
@@ -1117,28 +1162,30 @@ public:
         // Creating
         if (!creating_entries.empty())
         {
-            create_statuses.clear();
             std::vector<sai_object_id_t *> rs;
+            std::vector<sai_status_t *> ss;
             std::vector<sai_attribute_t const*> tss;
             std::vector<uint32_t> cs;
 
             for (auto const& i: creating_entries)
             {
                 sai_object_id_t *pid = std::get<0>(i);
-                auto const& attrs = std::get<1>(i);
-                if (*pid == SAI_NULL_OBJECT_ID)
+                sai_status_t *object_status = std::get<1>(i);
+                auto const& attrs = std::get<2>(i);
+                if (*pid == SAI_NULL_OBJECT_ID && (!object_status || *object_status == SAI_STATUS_NOT_EXECUTED))
                 {
                     rs.push_back(pid);
+                    ss.push_back(object_status);
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_creating_entries(rs, tss, cs);
+                        flush_creating_entries(rs, ss, tss, cs);
                     }
                 }
             }
-            flush_creating_entries(rs, tss, cs);
+            flush_creating_entries(rs, ss, tss, cs);
 
             creating_entries.clear();
         }
@@ -1195,10 +1242,6 @@ public:
         return removing_entries.size();
     }
 
-    sai_status_t create_status(sai_object_id_t object) {
-        return create_statuses[object];
-    }
-
 private:
     struct object_entry
     {
@@ -1216,8 +1259,9 @@ private:
 
     size_t max_bulk_size;
 
-    std::vector<std::pair<                                  // A vector of pair of
+    std::vector<std::tuple<                                 // A vector of tuple of
             sai_object_id_t *,                              // - object_id
+            sai_status_t *,                                 // - OUT object_status, optional
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
@@ -1238,8 +1282,6 @@ private:
     // TODO: wait until available in SAI
     //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
 
-    std::unordered_map<sai_object_id_t, sai_status_t>       create_statuses;
-
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<sai_object_id_t> &rs)
     {
@@ -1274,6 +1316,7 @@ private:
 
     sai_status_t flush_creating_entries(
         _Inout_ std::vector<sai_object_id_t *> &rs,
+        _Inout_ std::vector<sai_status_t *> &ss,
         _Inout_ std::vector<sai_attribute_t const*> &tss,
         _Inout_ std::vector<uint32_t> &cs)
     {
@@ -1298,12 +1341,16 @@ private:
 
         for (size_t i = 0; i < count; i++)
         {
-            create_statuses.emplace(object_ids[i], statuses[i]);
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+            if (ss[i])
+            {
+                *ss[i] = statuses[i];
+            }
         }
 
         rs.clear();
+        ss.clear();
         tss.clear();
         cs.clear();
 
@@ -1364,6 +1411,28 @@ inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_h
     //set_entries_attribute = ;
 }
 
+template <>
+inline ObjectBulker<sai_vlan_api_t>::ObjectBulker(SaiBulkerTraits<sai_vlan_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_vlan_members;
+    remove_entries = api->remove_vlan_members;
+    // TODO: wait until available in SAI
+    //set_entries_attribute = ;
+}
+
+template <>
+inline ObjectBulker<sai_lag_api_t>::ObjectBulker(SaiBulkerTraits<sai_lag_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_lag_members;
+    remove_entries = api->remove_lag_members;
+    // TODO: wait until available in SAI
+    //set_entries_attribute = ;
+}
+
 template <>
 inline ObjectBulker<sai_dash_vnet_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_vnet_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
     switch_id(switch_id),
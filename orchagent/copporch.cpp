@@ -1367,33 +1367,6 @@ bool CoppOrch::trapGroupUpdatePolicer (string trap_group_name,
     return true;
 }
 
-void CoppOrch::initTrapRatePlugin()
-{
-    if (m_trap_rate_plugin_loaded)
-    {
-        return;
-    }
-
-    std::string trapRatePluginName = "trap_rates.lua";
-    std::string trapSha;
-    try
-    {
-        std::string trapLuaScript = swss::loadLuaScript(trapRatePluginName);
-        trapSha = swss::loadRedisScript(m_counter_db.get(), trapLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_ERROR("Trap flex counter groups were not set successfully: %s", e.what());
-    }
-
-    setFlexCounterGroupParameter(HOSTIF_TRAP_COUNTER_FLEX_COUNTER_GROUP,
-                                 "", // Do not touch poll interval
-                                 STATS_MODE_READ,
-                                 FLOW_COUNTER_PLUGIN_FIELD,
-                                 trapSha);
-    m_trap_rate_plugin_loaded = true;
-}
-
 bool CoppOrch::removeTrap(sai_object_id_t hostif_trap_id, sai_hostif_trap_type_t trap_type)
 {
     unbindTrapCounter(hostif_trap_id);
@@ -1429,8 +1402,6 @@ bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_t
         return true;
     }
 
-    initTrapRatePlugin();
-
     // Create generic counter
     sai_object_id_t counter_id;
     if (!FlowCounterHandler::createGenericCounter(counter_id))
@@ -1454,6 +1425,7 @@ bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_t
     vector<FieldValueTuple> nameMapFvs;
     nameMapFvs.emplace_back(trap_name, sai_serialize_object_id(counter_id));
     m_counter_table->set("", nameMapFvs);
+    CounterNameMapUpdater::markChanged(COUNTERS_TRAP_NAME_MAP);
 
     auto was_empty = m_pendingAddToFlexCntr.empty();
     m_pendingAddToFlexCntr[counter_id] = trap_name;
@@ -1493,6 +1465,7 @@ void CoppOrch::unbindTrapCounter(sai_object_id_t hostif_trap_id)
 
     // Remove trap from COUNTERS_TRAP_NAME_MAP
     m_counter_table->hdel("", iter->second);
+    CounterNameMapUpdater::markChanged(COUNTERS_TRAP_NAME_MAP);
 
     // Unbind generic counter to trap
     sai_attribute_t trap_attr;
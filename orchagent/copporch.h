@@ -116,14 +116,11 @@ protected:
 
     FlexCounterManager m_trap_counter_manager;
 
-    bool m_trap_rate_plugin_loaded = false;
-
     SelectableTimer* m_FlexCounterUpdTimer = nullptr;
 
     void initDefaultHostIntfTable();
     void initDefaultTrapGroup();
     void initDefaultTrapIds();
-    void initTrapRatePlugin();
     bool isTrapIdSupported(sai_hostif_trap_type_t trap_id) const;
     void updateTrapOperStatus(sai_hostif_trap_type_t trap_type, const std::string& hw_status);
     void publishTrapIdsCapability();
@@ -0,0 +1,226 @@
+#include <inttypes.h>
+#include <getopt.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "flex_counter/counter_snapshot.h"
+
+#define DEFAULT_SNAPSHOT_TABLE  "COUNTERS_PORT_NAME_MAP"
+#define READ_RETRIES            100
+
+void printUsage()
+{
+    SWSS_LOG_ENTER();
+
+    std::cout << "Usage: counter_snapshot_dump [-t table] [-o object] [-i interval]" << std::endl;
+    std::cout << "    -t --table" << std::endl;
+    std::cout << "        Counter name map of the snapshot. Default value: " << DEFAULT_SNAPSHOT_TABLE << std::endl;
+    std::cout << "    -o --object" << std::endl;
+    std::cout << "        Only print this object, read in place" << std::endl;
+    std::cout << "    -i --interval" << std::endl;
+    std::cout << "        Print again every interval seconds. Default value: 0, print once" << std::endl;
+    std::cout << "    -h --help:" << std::endl;
+    std::cout << "        Print out this message" << std::endl;
+}
+
+static void printObject(const std::string &name, uint64_t oid, const std::vector<std::string> &counters,
+                        const uint64_t *values, const uint8_t *present)
+{
+    printf("%s oid:0x%" PRIx64 "\n", name.c_str(), oid);
+    for (size_t c = 0; c < counters.size(); c++)
+    {
+        if (present[c])
+        {
+            printf("    %s: %" PRIu64 "\n", counters[c].c_str(), values[c]);
+        }
+        else
+        {
+            printf("    %s: N/A\n", counters[c].c_str());
+        }
+    }
+}
+
+static bool dumpAll(CounterSnapshotReader &reader)
+{
+    CounterSnapshotReader::Snapshot snapshot;
+    if (!reader.read(snapshot, READ_RETRIES))
+    {
+        std::cerr << "Failed to read a consistent snapshot" << std::endl;
+        return false;
+    }
+
+    printf("timestamp_us: %" PRIu64 "\n", snapshot.timestampUs);
+    for (const auto &object : snapshot.objects)
+    {
+        printObject(object.name, object.oid, snapshot.counters, object.values.data(), object.present.data());
+    }
+
+    return true;
+}
+
+/*
+ * Reads one object without copying the region out: the slot is looked up and
+ * its row copied under the seqlock, then checked against the sequence.
+ */
+static bool dumpObject(CounterSnapshotReader &reader, const std::string &table, const std::string &name)
+{
+    for (unsigned attempt = 0; attempt < READ_RETRIES; attempt++)
+    {
+        uint64_t sequence;
+        if (!reader.begin(sequence))
+        {
+            if (reader.isReplaced())
+            {
+                reader.open(table);
+            }
+            sched_yield();
+            continue;
+        }
+
+        const auto header = reader.getHeader();
+        uint32_t counterCount = header->counterCount;
+        uint32_t objectCount = header->objectCount;
+        uint64_t timestampUs = header->timestampUs;
+
+        bool found = false;
+        uint64_t oid = 0;
+        std::vector<std::string> counters;
+        std::vector<uint64_t> values;
+        std::vector<uint8_t> present;
+        for (uint32_t slot = 0; slot < objectCount; slot++)
+        {
+            auto object = reader.getObject(slot);
+            if (!object || !object->used || strncmp(object->name, name.c_str(), sizeof(object->name)) != 0)
+            {
+                continue;
+            }
+
+            auto objectValues = reader.getValues(slot);
+            auto objectPresent = reader.getPresent(slot);
+            for (uint32_t c = 0; c < counterCount && objectValues && objectPresent; c++)
+            {
+                auto counter = reader.getCounterName(c);
+                if (!counter)
+                {
+                    break;
+                }
+                counters.emplace_back(counter, strnlen(counter, CounterSnapshotHeader::NAME_SIZE));
+                values.push_back(objectValues[c]);
+                present.push_back(objectPresent[c]);
+            }
+            oid = object->oid;
+            found = true;
+            break;
+        }
+
+        if (!reader.validate(sequence))
+        {
+            continue;
+        }
+
+        if (!found)
+        {
+            std::cerr << name << " is not in the " << table << " snapshot" << std::endl;
+            return false;
+        }
+
+        printf("timestamp_us: %" PRIu64 "\n", timestampUs);
+        printObject(name, oid, counters, values.data(), present.data());
+        return true;
+    }
+
+    std::cerr << "Failed to read a consistent snapshot" << std::endl;
+    return false;
+}
+
+/*
+ * Prints the shared memory counter snapshot orchagent publishes with -S,
+ * the same counters as in COUNTERS_DB without going through redis.
+ */
+int main(int argc, char **argv)
+{
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+    SWSS_LOG_ENTER();
+
+    std::string table = DEFAULT_SNAPSHOT_TABLE;
+    std::string object;
+    int interval = 0;
+
+    const char* const optstring = "t:o:i:h";
+    while(true)
+    {
+        static struct option long_options[] =
+        {
+            { "table",     required_argument, 0, 't' },
+            { "object",    required_argument, 0, 'o' },
+            { "interval",  required_argument, 0, 'i' },
+            { "help",      no_argument,       0, 'h' },
+            { 0,           0,                 0, 0 }
+        };
+
+        int option_index = 0;
+
+        int c = getopt_long(argc, argv, optstring, long_options, &option_index);
+
+        if (c == -1)
+        {
+            break;
+        }
+
+        switch (c)
+        {
+            case 't':
+                table = optarg;
+                break;
+            case 'o':
+                object = optarg;
+                break;
+            case 'i':
+                interval = atoi(optarg);
+                break;
+            case 'h':
+                printUsage();
+                exit(EXIT_SUCCESS);
+
+            case '?':
+                SWSS_LOG_WARN("unknown option %c", optopt);
+                printUsage();
+                exit(EXIT_FAILURE);
+
+            default:
+                SWSS_LOG_ERROR("getopt_long failure");
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    CounterSnapshotReader reader;
+    if (!reader.open(table))
+    {
+        std::cerr << "No counter snapshot " << CounterSnapshotWriter::getRegionName(table)
+                  << ", is orchagent running with -S?" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    while (true)
+    {
+        bool ok = object.empty() ? dumpAll(reader) : dumpObject(reader, table, object);
+        if (!ok)
+        {
+            return EXIT_FAILURE;
+        }
+
+        if (interval <= 0)
+        {
+            return EXIT_SUCCESS;
+        }
+
+        fflush(stdout);
+        sleep(interval);
+    }
+}
@@ -14,6 +14,7 @@
 #define CRM_THRESHOLD_LOW_DEFAULT 70
 #define CRM_THRESHOLD_HIGH_DEFAULT 85
 #define CRM_EXCEEDED_MSG_MAX 10
+#define CRM_FULL_REWRITE_INTERVAL_SEC (5 * 60)
 #define CRM_ACL_RESOURCE_COUNT 256
 
 using namespace std;
@@ -399,6 +400,8 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     Orch(db, tableName),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
     m_countersCrmTable(new Table(m_countersDb.get(), COUNTERS_CRM_TABLE)),
+    m_countersPipe(new RedisPipeline(m_countersDb.get())),
+    m_countersCrmTableBatch(new Table(m_countersPipe.get(), COUNTERS_CRM_TABLE, true)),
     m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 }))
 {
     SWSS_LOG_ENTER();
@@ -504,6 +507,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                     for (auto &cnt : resource.countersMap)
                     {
                         cnt.second.exceededLogCounter = 0;
+                        cnt.second.checked = false;
                     }
                 }
             }
@@ -511,15 +515,25 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
             {
                 auto resourceType = crmThreshLowResMap.at(field);
                 auto thresholdValue = to_uint<uint32_t>(value);
+                auto &resource = m_resourcesMap.at(resourceType);
 
-                m_resourcesMap.at(resourceType).lowThreshold = thresholdValue;
+                resource.lowThreshold = thresholdValue;
+                for (auto &cnt : resource.countersMap)
+                {
+                    cnt.second.checked = false;
+                }
             }
             else if (crmThreshHighResMap.find(field) != crmThreshHighResMap.end())
             {
                 auto resourceType = crmThreshHighResMap.at(field);
                 auto thresholdValue = to_uint<uint32_t>(value);
+                auto &resource = m_resourcesMap.at(resourceType);
 
-                m_resourcesMap.at(resourceType).highThreshold = thresholdValue;
+                resource.highThreshold = thresholdValue;
+                for (auto &cnt : resource.countersMap)
+                {
+                    cnt.second.checked = false;
+                }
             }
             else
             {
@@ -764,8 +778,9 @@ bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
     sai_status_t status = SAI_STATUS_SUCCESS;
 
     sai_object_type_t objType = crmResSaiObjAttrMap.at(type);
+    bool objAvailability = (objType != SAI_OBJECT_TYPE_NULL) && !res.switchAttrAvailability;
 
-    if (objType != SAI_OBJECT_TYPE_NULL)
+    if (objAvailability)
     {
         uint32_t attrCount = 0;
 
@@ -801,12 +816,21 @@ bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
         status = sai_object_type_get_availability(gSwitchId, objType, attrCount, &attr, &availCount);
     }
 
-    if ((status != SAI_STATUS_SUCCESS) || (objType == SAI_OBJECT_TYPE_NULL))
+    if ((status != SAI_STATUS_SUCCESS) || !objAvailability)
     {
+        sai_status_t objStatus = status;
+
         if (crmResSaiAvailAttrMap.find(type) != crmResSaiAvailAttrMap.end())
         {
             attr.id = crmResSaiAvailAttrMap.at(type);
             status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            // Read along with the other switch attributes from now on
+            if (objAvailability && (status == SAI_STATUS_SUCCESS) &&
+                ((objStatus == SAI_STATUS_NOT_SUPPORTED) || (objStatus == SAI_STATUS_NOT_IMPLEMENTED)))
+            {
+                res.switchAttrAvailability = true;
+            }
         }
 
         if ((status == SAI_STATUS_NOT_SUPPORTED) ||
@@ -875,10 +899,154 @@ bool CrmOrch::getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEn
     return true;
 }
 
+bool CrmOrch::isSwitchAttrAvailability(CrmResourceType type, const CrmResourceEntry &res) const
+{
+    if (crmResSaiAvailAttrMap.find(type) == crmResSaiAvailAttrMap.end())
+    {
+        return false;
+    }
+
+    return (crmResSaiObjAttrMap.at(type) == SAI_OBJECT_TYPE_NULL) || res.switchAttrAvailability;
+}
+
+void CrmOrch::getSwitchAttrResAvailability(const vector<CrmResourceType> &types)
+{
+    SWSS_LOG_ENTER();
+
+    if (types.empty())
+    {
+        return;
+    }
+
+    vector<sai_attribute_t> attrs(types.size());
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        attrs[i].id = crmResSaiAvailAttrMap.at(types[i]);
+    }
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        for (size_t i = 0; i < types.size(); i++)
+        {
+            m_resourcesMap.at(types[i]).countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attrs[i].value.u32;
+        }
+        return;
+    }
+
+    // Read them one by one to tell which one failed
+    SWSS_LOG_INFO("Failed to get %zu CRM availability switch attributes at once, rv:%d", attrs.size(), status);
+
+    for (auto type : types)
+    {
+        getResAvailability(type, m_resourcesMap.at(type));
+    }
+}
+
+void CrmOrch::getAclTableResAvailability()
+{
+    SWSS_LOG_ENTER();
+
+    const CrmResourceType types[] = { CrmResourceType::CRM_ACL_ENTRY, CrmResourceType::CRM_ACL_COUNTER };
+
+    // Both resources are counted per ACL table, they are read in one get per table
+    map<string, sai_object_id_t> tables;
+    for (auto type : types)
+    {
+        const auto &res = m_resourcesMap.at(type);
+        if (res.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
+        {
+            continue;
+        }
+
+        for (const auto &cnt : res.countersMap)
+        {
+            tables.emplace(cnt.first, cnt.second.id);
+        }
+    }
+
+    for (const auto &table : tables)
+    {
+        sai_attribute_t attrs[2];
+        CrmResourceCounter *cnts[2];
+        uint32_t attrCount = 0;
+
+        for (auto type : types)
+        {
+            auto &res = m_resourcesMap.at(type);
+            auto cnt = res.countersMap.find(table.first);
+            if ((res.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED) || (cnt == res.countersMap.end()))
+            {
+                continue;
+            }
+
+            attrs[attrCount].id = crmResSaiAvailAttrMap.at(type);
+            cnts[attrCount] = &cnt->second;
+            attrCount++;
+        }
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(table.second, attrCount, attrs);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            // Read them one by one to tell which one failed
+            SWSS_LOG_INFO("Failed to get the CRM availability attributes of ACL table %s, rv:%d", table.first.c_str(), status);
+
+            for (auto type : types)
+            {
+                auto &res = m_resourcesMap.at(type);
+                if (res.resStatus == CrmResourceStatus::CRM_RES_SUPPORTED)
+                {
+                    getAclTableResAvailability(type, res);
+                }
+            }
+            return;
+        }
+
+        for (uint32_t i = 0; i < attrCount; i++)
+        {
+            cnts[i]->availableCounter = attrs[i].value.u32;
+        }
+    }
+}
+
+void CrmOrch::getAclTableResAvailability(CrmResourceType type, CrmResourceEntry &res)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+    attr.id = crmResSaiAvailAttrMap.at(type);
+
+    for (auto &cnt : res.countersMap)
+    {
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
+        if ((status == SAI_STATUS_NOT_SUPPORTED) ||
+            (status == SAI_STATUS_NOT_IMPLEMENTED) ||
+            SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+            SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
+        {
+            // mark unsupported resources
+            res.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
+            SWSS_LOG_NOTICE("CRM resource %s not supported", crmResTypeNameMap.at(type).c_str());
+            break;
+        }
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
+            break;
+        }
+
+        cnt.second.availableCounter = attr.value.u32;
+    }
+}
+
 void CrmOrch::getResAvailableCounters()
 {
     SWSS_LOG_ENTER();
 
+    // Resources read from a switch attribute, read in one get after the others
+    vector<CrmResourceType> switchAttrTypes;
+    bool aclTablesRead = false;
+
     for (auto &res : m_resourcesMap)
     {
         // ignore unsupported resources
@@ -908,6 +1076,12 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_SRV6_NEXTHOP:
             case CrmResourceType::CRM_TWAMP_ENTRY:
             {
+                if (isSwitchAttrAvailability(res.first, res.second))
+                {
+                    switchAttrTypes.push_back(res.first);
+                    break;
+                }
+
                 getResAvailability(res.first, res.second);
                 break;
             }
@@ -991,31 +1165,12 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_ACL_ENTRY:
             case CrmResourceType::CRM_ACL_COUNTER:
             {
-                sai_attribute_t attr;
-                attr.id = crmResSaiAvailAttrMap.at(res.first);
-
-                for (auto &cnt : res.second.countersMap)
+                // Both are read at once
+                if (!aclTablesRead)
                 {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if ((status == SAI_STATUS_NOT_SUPPORTED) ||
-                        (status == SAI_STATUS_NOT_IMPLEMENTED) ||
-                        SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-                        SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
-                    {
-                        // mark unsupported resources
-                        res.second.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
-                        SWSS_LOG_NOTICE("CRM resource %s not supported", crmResTypeNameMap.at(res.first).c_str());
-                        break;
-                    }
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
-                    }
-
-                    cnt.second.availableCounter = attr.value.u32;
+                    getAclTableResAvailability();
+                    aclTablesRead = true;
                 }
-
                 break;
             }
 
@@ -1058,12 +1213,25 @@ void CrmOrch::getResAvailableCounters()
                 return;
         }
     }
+
+    getSwitchAttrResAvailability(switchAttrTypes);
 }
 
 void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    // Fields of each CRM key, only the counters changed since they were last written
+    map<string, vector<FieldValueTuple>> updates;
+
+    // Every few minutes all counters are written, restoring any removed from COUNTERS_DB
+    auto now = chrono::steady_clock::now();
+    bool fullRewrite = (now - m_lastFullRewrite >= chrono::seconds(CRM_FULL_REWRITE_INTERVAL_SEC));
+    if (fullRewrite)
+    {
+        m_lastFullRewrite = now;
+    }
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
@@ -1077,9 +1245,12 @@ void CrmOrch::updateCrmCountersTable()
 
             for (const auto &cnt : res.countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (!fullRewrite && cnt.second.published && (cnt.second.usedCounter == cnt.second.publishedUsed))
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
             }
         }
         catch(const out_of_range &e)
@@ -1101,9 +1272,12 @@ void CrmOrch::updateCrmCountersTable()
 
             for (const auto &cnt : res.countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (!fullRewrite && cnt.second.published && (cnt.second.availableCounter == cnt.second.publishedAvailable))
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
             }
         }
         catch(const out_of_range &e)
@@ -1111,6 +1285,34 @@ void CrmOrch::updateCrmCountersTable()
             // expected when a resource is unavailable
         }
     }
+
+    for (auto &res : m_resourcesMap)
+    {
+        if (res.second.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
+        {
+            continue;
+        }
+
+        for (auto &cnt : res.second.countersMap)
+        {
+            cnt.second.publishedUsed = cnt.second.usedCounter;
+            cnt.second.publishedAvailable = cnt.second.availableCounter;
+            cnt.second.published = true;
+        }
+    }
+
+    if (updates.empty())
+    {
+        return;
+    }
+
+    for (const auto &update : updates)
+    {
+        m_countersCrmTableBatch->set(update.first, update.second);
+    }
+    m_countersPipe->flush();
+
+    SWSS_LOG_DEBUG("Updated %zu CRM counter keys", updates.size());
 }
 
 void CrmOrch::checkCrmThresholds()
@@ -1129,6 +1331,18 @@ void CrmOrch::checkCrmThresholds()
         for (auto &j : i.second.countersMap)
         {
             auto &cnt = j.second;
+
+            // Unchanged counters give the same result, unless the exceeded message is to be repeated
+            if (cnt.checked && (cnt.usedCounter == cnt.checkedUsed) && (cnt.availableCounter == cnt.checkedAvailable) &&
+                ((cnt.exceededLogCounter == 0) || (cnt.exceededLogCounter >= CRM_EXCEEDED_MSG_MAX)))
+            {
+                continue;
+            }
+
+            cnt.checkedUsed = cnt.usedCounter;
+            cnt.checkedAvailable = cnt.availableCounter;
+            cnt.checked = true;
+
             uint64_t utilization = 0;
             uint32_t percentageUtil = 0;
             string threshType = "";
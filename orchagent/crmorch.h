@@ -3,7 +3,9 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <memory>
 #include "orch.h"
+#include "redispipeline.h"
 #include "port.h"
 #include "events.h"
 
@@ -96,6 +98,8 @@ public:
 private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersCrmTable = nullptr;
+    std::unique_ptr<swss::RedisPipeline> m_countersPipe;
+    std::unique_ptr<swss::Table> m_countersCrmTableBatch;
     swss::SelectableTimer *m_timer = nullptr;
 
     struct CrmResourceCounter
@@ -104,6 +108,14 @@ private:
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
         uint32_t exceededLogCounter = 0;
+
+        // Values last written to COUNTERS_DB and last checked against the thresholds
+        uint32_t publishedUsed = 0;
+        uint32_t publishedAvailable = 0;
+        uint32_t checkedUsed = 0;
+        uint32_t checkedAvailable = 0;
+        bool published = false;
+        bool checked = false;
     };
 
     struct CrmResourceEntry
@@ -119,9 +131,14 @@ private:
         std::map<std::string, CrmResourceCounter> countersMap;
 
         CrmResourceStatus resStatus = CrmResourceStatus::CRM_RES_SUPPORTED;
+
+        // The object type availability is not supported, the switch attribute is read instead
+        bool switchAttrAvailability = false;
     };
 
     std::chrono::seconds m_pollingInterval;
+    // Last time all counters were written to COUNTERS_DB, the first poll writes them all anyway
+    std::chrono::steady_clock::time_point m_lastFullRewrite = std::chrono::steady_clock::now();
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
@@ -130,6 +147,10 @@ private:
     void doTask(swss::SelectableTimer &timer);
     bool getResAvailability(CrmResourceType type, CrmResourceEntry &res);
     bool getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEntry &res);
+    bool isSwitchAttrAvailability(CrmResourceType type, const CrmResourceEntry &res) const;
+    void getSwitchAttrResAvailability(const std::vector<CrmResourceType> &types);
+    void getAclTableResAvailability();
+    void getAclTableResAvailability(CrmResourceType type, CrmResourceEntry &res);
     void getResAvailableCounters();
     void updateCrmCountersTable();
     void checkCrmThresholds();
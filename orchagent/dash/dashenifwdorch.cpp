@@ -548,7 +548,7 @@ bool EniFwdCtx::findVnetTunnel(const string& vnet_name, string& tunnel)
     return false;
 }
 
-std::map<string, Port>& EniFwdCtx::getAllPorts() 
+const std::map<string, Port>& EniFwdCtx::getAllPorts() 
 {
     return portsorch_->getAllPorts();
 }
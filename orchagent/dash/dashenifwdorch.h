@@ -316,7 +316,7 @@ public:
 
     virtual void initialize() = 0;
     /* API's that call other orchagents */
-    virtual std::map<std::string, Port>& getAllPorts() = 0;
+    virtual const std::map<std::string, Port>& getAllPorts() = 0;
     virtual bool isNeighborResolved(const NextHopKey&) = 0;
     virtual void resolveNeighbor(const NeighborEntry &) = 0;
     virtual string getRouterIntfsAlias(const IpAddress &, const string & = "") = 0;
@@ -379,7 +379,7 @@ public:
     std::string getRouterIntfsAlias(const IpAddress &, const string & = "") override;
     bool findVnetVni(const std::string&, uint64_t&) override;
     bool findVnetTunnel(const std::string&, string&) override;
-    std::map<std::string, Port>& getAllPorts() override;
+    const std::map<std::string, Port>& getAllPorts() override;
     virtual sai_object_id_t createNextHopTunnel(string, IpAddress) override;
     virtual bool removeNextHopTunnel(string, IpAddress) override;
 
@@ -0,0 +1,141 @@
+#include "logger.h"
+#include "counter_publisher.h"
+
+using namespace std;
+using namespace swss;
+
+#define PUBLISH_MODE_FULL   "full"
+#define PUBLISH_MODE_DELTA  "delta"
+
+bool CounterPublisher::parseMode(const string &value, Mode &mode)
+{
+    if (value == PUBLISH_MODE_FULL)
+    {
+        mode = FULL;
+        return true;
+    }
+
+    if (value == PUBLISH_MODE_DELTA)
+    {
+        mode = DELTA;
+        return true;
+    }
+
+    return false;
+}
+
+string CounterPublisher::getModeName(Mode mode)
+{
+    return mode == DELTA ? PUBLISH_MODE_DELTA : PUBLISH_MODE_FULL;
+}
+
+void CounterPublisher::getStatsFields(vector<FieldValueTuple> &fvs) const
+{
+    fvs.clear();
+    fvs.emplace_back("mode", getModeName(m_mode));
+    fvs.emplace_back("full_refresh_cycles", to_string(m_fullRefreshCycles));
+    fvs.emplace_back("cycles", to_string(m_stats.cycles));
+    fvs.emplace_back("written", to_string(m_stats.written));
+    fvs.emplace_back("skipped", to_string(m_stats.skipped));
+}
+
+void CounterPublisher::setMode(Mode mode)
+{
+    if (mode == m_mode)
+    {
+        return;
+    }
+
+    m_mode = mode;
+    reset();
+}
+
+void CounterPublisher::reset()
+{
+    m_published.clear();
+    m_refreshPending = true;
+}
+
+void CounterPublisher::filter(vector<KeyOpFieldsValuesTuple> &updates)
+{
+    SWSS_LOG_ENTER();
+
+    size_t written = 0;
+    size_t skipped = 0;
+
+    bool refresh = m_refreshPending ||
+        (m_fullRefreshCycles && m_cyclesSinceRefresh + 1 >= m_fullRefreshCycles);
+
+    if (m_mode == FULL)
+    {
+        for (const auto &update : updates)
+        {
+            written += kfvFieldsValues(update).size();
+        }
+    }
+    else
+    {
+        if (refresh)
+        {
+            // Also drops objects no longer published
+            m_published.clear();
+        }
+
+        size_t out = 0;
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            auto &update = updates[i];
+            const auto &key = kfvKey(update);
+
+            if (kfvOp(update) != SET_COMMAND)
+            {
+                m_published.erase(key);
+            }
+            else
+            {
+                auto &published = m_published[key];
+                auto &fvs = kfvFieldsValues(update);
+                size_t kept = 0;
+                for (size_t f = 0; f < fvs.size(); f++)
+                {
+                    auto value = published.find(fvField(fvs[f]));
+                    if (!refresh && value != published.end() && value->second == fvValue(fvs[f]))
+                    {
+                        skipped++;
+                        continue;
+                    }
+
+                    published[fvField(fvs[f])] = fvValue(fvs[f]);
+                    if (kept != f)
+                    {
+                        fvs[kept] = move(fvs[f]);
+                    }
+                    kept++;
+                }
+                fvs.resize(kept);
+                written += kept;
+
+                if (!kept)
+                {
+                    continue;
+                }
+            }
+
+            if (out != i)
+            {
+                updates[out] = move(update);
+            }
+            out++;
+        }
+        updates.resize(out);
+    }
+
+    m_refreshPending = false;
+    m_cyclesSinceRefresh = refresh ? 0 : m_cyclesSinceRefresh + 1;
+
+    m_stats.cycles++;
+    m_stats.written += written;
+    m_stats.skipped += skipped;
+    m_stats.lastWritten = written;
+    m_stats.lastSkipped = skipped;
+}
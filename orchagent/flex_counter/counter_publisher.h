@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+// Filters the counter updates of one publication cycle. In delta mode a field
+// is only published when its value changed since it was last published, and
+// every field is published again once every fullRefreshCycles cycles. Only
+// used for the RATES orchagent publishes, see RATES_PUBLISH_MODE.
+class CounterPublisher
+{
+public:
+    enum Mode : uint8_t
+    {
+        FULL,
+        DELTA
+    };
+
+    struct Stats
+    {
+        uint64_t cycles = 0;
+        uint64_t written = 0;
+        uint64_t skipped = 0;
+        // Of the last cycle
+        size_t lastWritten = 0;
+        size_t lastSkipped = 0;
+    };
+
+    // Parses the RATES_PUBLISH_MODE value, "full" or "delta"
+    static bool parseMode(const std::string &value, Mode &mode);
+    static std::string getModeName(Mode mode);
+
+    // Switching mode starts over from a full refresh
+    void setMode(Mode mode);
+
+    Mode getMode() const
+    {
+        return m_mode;
+    }
+
+    // 0 never refreshes
+    void setFullRefreshCycles(uint32_t cycles)
+    {
+        m_fullRefreshCycles = cycles;
+    }
+
+    uint32_t getFullRefreshCycles() const
+    {
+        return m_fullRefreshCycles;
+    }
+
+    // Drops in place the fields of updates left as they were published, and
+    // the keys left with no field. Deletes are always kept.
+    void filter(std::vector<swss::KeyOpFieldsValuesTuple> &updates);
+
+    // Forgets what was published, the next cycle is a full refresh
+    void reset();
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+    // Mode and totals, as published in STATE_DB
+    void getStatsFields(std::vector<swss::FieldValueTuple> &fvs) const;
+
+private:
+    Mode m_mode = FULL;
+    uint32_t m_fullRefreshCycles = 0;
+    uint32_t m_cyclesSinceRefresh = 0;
+    bool m_refreshPending = true;
+    Stats m_stats;
+
+    // Key to field to the value last published, delta mode only
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_published;
+};
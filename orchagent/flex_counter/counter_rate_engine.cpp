@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "logger.h"
+#include "counter_rate_engine.h"
+
+using namespace std;
+using namespace swss;
+
+#define RATES_INIT_DONE_FIELD       "INIT_DONE"
+#define RATES_LAST_SUFFIX           "_last"
+
+#define FEC_CORRECTED_BITS          "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS"
+#define FEC_NOT_CORRECTABLE_FRAMES  "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES"
+#define FEC_CODEWORD_ERRORS_PREFIX  "SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S"
+#define FEC_CODEWORD_ERROR_BINS     16
+
+// Statistical average used for the post FEC BER, as in the port rate plugin
+static const double RS_AVERAGE_FRAME_BER = 1e-8;
+
+static const char *stateNames[] = { "", "COUNTERS_LAST", "DONE" };
+
+CounterRateProfile CounterRateProfile::port()
+{
+    CounterRateProfile profile;
+    profile.name = "PORT";
+    profile.counters = {
+        "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_IN_OCTETS",
+        "SAI_PORT_STAT_IF_OUT_OCTETS"
+    };
+    profile.rates = {
+        { "RX_BPS", { 4 } },
+        { "RX_PPS", { 0, 1 } },
+        { "TX_BPS", { 5 } },
+        { "TX_PPS", { 2, 3 } }
+    };
+    profile.optionalCounters = { FEC_CORRECTED_BITS, FEC_NOT_CORRECTABLE_FRAMES };
+    for (int i = 0; i < FEC_CODEWORD_ERROR_BINS; i++)
+    {
+        profile.optionalCounters.push_back(FEC_CODEWORD_ERRORS_PREFIX + to_string(i));
+    }
+    profile.fec = true;
+    return profile;
+}
+
+CounterRateProfile CounterRateProfile::rif()
+{
+    CounterRateProfile profile;
+    profile.name = "RIF";
+    profile.counters = {
+        "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS"
+    };
+    profile.rates = {
+        { "RX_BPS", { 0 } },
+        { "RX_PPS", { 1 } },
+        { "TX_BPS", { 2 } },
+        { "TX_PPS", { 3 } }
+    };
+    return profile;
+}
+
+CounterRateProfile CounterRateProfile::trap()
+{
+    CounterRateProfile profile;
+    profile.name = "TRAP";
+    profile.counters = { "SAI_COUNTER_STAT_PACKETS" };
+    profile.rates = { { "RX_PPS", { 0 } } };
+    profile.missingCountersAsZero = true;
+    return profile;
+}
+
+CounterRateProfile CounterRateProfile::tunnel()
+{
+    CounterRateProfile profile;
+    profile.name = "TUNNEL";
+    profile.counters = {
+        "SAI_TUNNEL_STAT_IN_OCTETS",
+        "SAI_TUNNEL_STAT_IN_PACKETS",
+        "SAI_TUNNEL_STAT_OUT_OCTETS",
+        "SAI_TUNNEL_STAT_OUT_PACKETS"
+    };
+    profile.rates = {
+        { "RX_BPS", { 0 } },
+        { "RX_PPS", { 1 } },
+        { "TX_BPS", { 2 } },
+        { "TX_PPS", { 3 } }
+    };
+    profile.missingCountersAsZero = true;
+    return profile;
+}
+
+CounterRateEngine::CounterRateEngine(const CounterRateProfile &profile) :
+    m_profile(profile)
+{
+    m_counterNames = m_profile.counters;
+    m_counterNames.insert(m_counterNames.end(), m_profile.optionalCounters.begin(), m_profile.optionalCounters.end());
+    m_width = m_counterNames.size();
+
+    auto column = [this](const string &name)
+    {
+        auto it = find(m_counterNames.begin(), m_counterNames.end(), name);
+        return static_cast<size_t>(it - m_counterNames.begin());
+    };
+
+    m_fecCorrected = column(FEC_CORRECTED_BITS);
+    m_fecUncorrectable = column(FEC_NOT_CORRECTABLE_FRAMES);
+    m_fecCodewordErrors = column(FEC_CODEWORD_ERRORS_PREFIX "0");
+
+    if (m_profile.fec && (m_fecCorrected == m_width || m_fecUncorrectable == m_width ||
+        m_fecCodewordErrors + FEC_CODEWORD_ERROR_BINS > m_width))
+    {
+        SWSS_LOG_ERROR("FEC counters missing from %s rate profile", m_profile.name.c_str());
+        m_profile.fec = false;
+    }
+}
+
+void CounterRateEngine::setObjects(const vector<string> &oids)
+{
+    const size_t rateCount = m_profile.rates.size();
+
+    vector<uint8_t> state(oids.size(), INIT);
+    vector<uint64_t> last(oids.size() * m_width, 0);
+    vector<uint8_t> lastPresent(oids.size() * m_width, 0);
+    vector<double> rates(oids.size() * rateCount, 0);
+    vector<double> pending(oids.size(), 0);
+    vector<double> lineRate(oids.size(), 0);
+    vector<double> fecPreBerMax(oids.size(), 0);
+    unordered_map<string, size_t> index;
+
+    for (size_t i = 0; i < oids.size(); i++)
+    {
+        index.emplace(oids[i], i);
+
+        auto it = m_index.find(oids[i]);
+        if (it == m_index.end())
+        {
+            continue;
+        }
+
+        size_t old = it->second;
+        state[i] = m_state[old];
+        copy_n(m_last.begin() + old * m_width, m_width, last.begin() + i * m_width);
+        copy_n(m_lastPresent.begin() + old * m_width, m_width, lastPresent.begin() + i * m_width);
+        copy_n(m_rates.begin() + old * rateCount, rateCount, rates.begin() + i * rateCount);
+        pending[i] = m_pending[old];
+        lineRate[i] = m_lineRate[old];
+        fecPreBerMax[i] = m_fecPreBerMax[old];
+    }
+
+    m_oids = oids;
+    m_index.swap(index);
+    m_state.swap(state);
+    m_last.swap(last);
+    m_lastPresent.swap(lastPresent);
+    m_rates.swap(rates);
+    m_pending.swap(pending);
+    m_lineRate.swap(lineRate);
+    m_fecPreBerMax.swap(fecPreBerMax);
+}
+
+void CounterRateEngine::setLineRate(const string &oid, double bitsPerSecond)
+{
+    auto it = m_index.find(oid);
+    if (it != m_index.end())
+    {
+        m_lineRate[it->second] = bitsPerSecond;
+    }
+}
+
+void CounterRateEngine::update(const vector<uint64_t> &values,
+                               const vector<uint8_t> &present,
+                               double elapsedMs,
+                               double alpha)
+{
+    SWSS_LOG_ENTER();
+
+    const size_t objects = m_oids.size();
+    const size_t required = m_profile.counters.size();
+    const size_t rateCount = m_profile.rates.size();
+    const double oneMinusAlpha = 1.0 - alpha;
+
+    if (values.size() != objects * m_width || present.size() != objects * m_width)
+    {
+        SWSS_LOG_ERROR("Invalid %s counter sample size %zu for %zu objects",
+                       m_profile.name.c_str(), values.size(), objects);
+        return;
+    }
+
+    for (size_t obj = 0; obj < objects; obj++)
+    {
+        const uint64_t *row = values.data() + obj * m_width;
+        const uint8_t *rowPresent = present.data() + obj * m_width;
+        uint64_t *last = m_last.data() + obj * m_width;
+
+        if (!m_profile.missingCountersAsZero &&
+            find(rowPresent, rowPresent + required, 0) != rowPresent + required)
+        {
+            SWSS_LOG_DEBUG("Not found some counters on %s", m_oids[obj].c_str());
+            continue;
+        }
+
+        double elapsed = m_pending[obj] + elapsedMs;
+        if (m_state[obj] != INIT && equal(row, row + required, last) &&
+            elapsed < 2.0 * m_pollIntervalMs)
+        {
+            // The counters may not have been polled again yet
+            m_pending[obj] = elapsed;
+            continue;
+        }
+        m_pending[obj] = 0;
+
+        vector<FieldValueTuple> fvs;
+        fvs.reserve(rateCount + m_width + 5);
+
+        State state = static_cast<State>(m_state[obj]);
+        if (state != INIT && elapsed > 0)
+        {
+            const double scale = 1000.0 / elapsed;
+            double *rates = m_rates.data() + obj * rateCount;
+
+            for (size_t r = 0; r < rateCount; r++)
+            {
+                double delta = 0;
+                for (auto c : m_profile.rates[r].counters)
+                {
+                    delta += static_cast<double>(row[c]) - static_cast<double>(last[c]);
+                }
+
+                double rate = delta * scale;
+                rates[r] = state == DONE ? alpha * rate + oneMinusAlpha * rates[r] : rate;
+                fvs.emplace_back(m_profile.rates[r].field, formatNumber(rates[r]));
+            }
+
+            if (state == COUNTERS_LAST)
+            {
+                m_state[obj] = DONE;
+            }
+        }
+        else if (state == INIT)
+        {
+            m_state[obj] = COUNTERS_LAST;
+        }
+
+        if (m_profile.fec)
+        {
+            computeFec(obj, row, rowPresent, state != INIT ? elapsed : 0, fvs);
+        }
+
+        for (size_t c = 0; c < required; c++)
+        {
+            fvs.emplace_back(m_counterNames[c] + RATES_LAST_SUFFIX, to_string(row[c]));
+        }
+
+        copy_n(row, m_width, last);
+        copy_n(rowPresent, m_width, m_lastPresent.data() + obj * m_width);
+
+        m_updates.emplace_back(m_oids[obj], SET_COMMAND, move(fvs));
+        if (m_state[obj] != state)
+        {
+            m_updates.emplace_back(m_oids[obj] + ":" + m_profile.name, SET_COMMAND,
+                                   vector<FieldValueTuple>{ { RATES_INIT_DONE_FIELD, stateNames[m_state[obj]] } });
+        }
+    }
+}
+
+void CounterRateEngine::computeFec(size_t obj, const uint64_t *row, const uint8_t *rowPresent,
+                                   double elapsedMs, vector<FieldValueTuple> &fvs)
+{
+    if (m_lineRate[obj] <= 0 || !rowPresent[m_fecCorrected] || !rowPresent[m_fecUncorrectable])
+    {
+        return;
+    }
+
+    if (elapsedMs > 0)
+    {
+        const uint64_t *last = m_last.data() + obj * m_width;
+        const uint8_t *lastPresent = m_lastPresent.data() + obj * m_width;
+
+        double correctedLast = lastPresent[m_fecCorrected] ? static_cast<double>(last[m_fecCorrected]) : 0;
+        double uncorrectableLast = lastPresent[m_fecUncorrectable] ? static_cast<double>(last[m_fecUncorrectable]) : 0;
+        double serdesBits = m_lineRate[obj] * elapsedMs / 1000.0;
+
+        double preBer = (static_cast<double>(row[m_fecCorrected]) - correctedLast) / serdesBits;
+        double postBer = (static_cast<double>(row[m_fecUncorrectable]) - uncorrectableLast) * RS_AVERAGE_FRAME_BER / serdesBits;
+
+        // Highest FEC histogram bin with a non-zero count
+        int maxT = -1;
+        for (int bin = 0; bin < FEC_CODEWORD_ERROR_BINS; bin++)
+        {
+            size_t c = m_fecCodewordErrors + bin;
+            if (rowPresent[c] && row[c] > 0)
+            {
+                maxT = bin;
+            }
+        }
+
+        if (preBer > m_fecPreBerMax[obj])
+        {
+            m_fecPreBerMax[obj] = preBer;
+            fvs.emplace_back("FEC_PRE_BER_MAX", formatNumber(preBer));
+        }
+        fvs.emplace_back("FEC_PRE_BER", formatNumber(preBer));
+        fvs.emplace_back("FEC_POST_BER", formatNumber(postBer));
+        fvs.emplace_back("FEC_MAX_T", to_string(maxT));
+    }
+
+    // Field names as written by the port rate plugin
+    fvs.emplace_back("SAI_PORT_STAT_IF_FEC_CORRECTED_BITS_last", to_string(row[m_fecCorrected]));
+    fvs.emplace_back("SAI_PORT_STAT_IF_FEC_NOT_CORRECTABLE_FARMES_last", to_string(row[m_fecUncorrectable]));
+}
+
+void CounterRateEngine::getUpdates(vector<KeyOpFieldsValuesTuple> &updates)
+{
+    if (updates.empty())
+    {
+        updates.swap(m_updates);
+        return;
+    }
+
+    move(m_updates.begin(), m_updates.end(), back_inserter(updates));
+    m_updates.clear();
+}
+
+CounterRateEngine::State CounterRateEngine::getState(const string &oid) const
+{
+    auto it = m_index.find(oid);
+    return it == m_index.end() ? INIT : static_cast<State>(m_state[it->second]);
+}
+
+double CounterRateEngine::getRate(const string &oid, const string &field) const
+{
+    auto it = m_index.find(oid);
+    if (it == m_index.end())
+    {
+        return 0;
+    }
+
+    for (size_t r = 0; r < m_profile.rates.size(); r++)
+    {
+        if (m_profile.rates[r].field == field)
+        {
+            return m_rates[it->second * m_profile.rates.size() + r];
+        }
+    }
+
+    return 0;
+}
+
+double CounterRateEngine::getSerdesLineRate(uint32_t lanes, uint32_t speed)
+{
+    if (lanes == 0 || speed == 0 || speed % lanes != 0)
+    {
+        return 0;
+    }
+
+    double serdes = 0;
+    switch (speed / lanes)
+    {
+        case 1000:
+            serdes = 1.25e+9;
+            break;
+        case 10000:
+            serdes = 10.3125e+9;
+            break;
+        case 25000:
+            serdes = 25.78125e+9;
+            break;
+        case 50000:
+            serdes = 53.125e+9;
+            break;
+        case 100000:
+            serdes = 106.25e+9;
+            break;
+        case 200000:
+            serdes = 212.5e+9;
+            break;
+        default:
+            break;
+    }
+
+    return serdes * lanes;
+}
+
+string CounterRateEngine::formatNumber(double value)
+{
+    // Same representation as Lua's tostring() on numbers
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.14g", value);
+    return buffer;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+// Rates of one object type, published in COUNTERS_DB under RATES:<oid> with
+// the same fields the port/rif/trap/tunnel rate plugins wrote
+struct CounterRateProfile
+{
+    struct Rate
+    {
+        std::string field;
+        // Indexes into counters, summed before the rate is computed
+        std::vector<size_t> counters;
+    };
+
+    // PORT, RIF, TRAP or TUNNEL, used for RATES:<name> and RATES:<oid>:<name>
+    std::string name;
+    std::vector<std::string> counters;
+    std::vector<Rate> rates;
+    // Read when present, never required
+    std::vector<std::string> optionalCounters;
+    // A missing counter reads as 0 instead of skipping the object
+    bool missingCountersAsZero = false;
+    // Compute FEC BER from the optional FEC counters, ports only
+    bool fec = false;
+
+    static CounterRateProfile port();
+    static CounterRateProfile rif();
+    static CounterRateProfile trap();
+    static CounterRateProfile tunnel();
+};
+
+// Does what the port/rif/trap/tunnel rate plugins did for every object of
+// one profile: the first sample only saves the counters, the second writes
+// the raw rates and later ones smooth them with alpha (EWMA). A sample with
+// unchanged counters is held back until the next one, syncd may simply not
+// have polled yet.
+class CounterRateEngine
+{
+public:
+    enum State : uint8_t
+    {
+        INIT,
+        COUNTERS_LAST,
+        DONE
+    };
+
+    explicit CounterRateEngine(const CounterRateProfile &profile);
+
+    const CounterRateProfile& getProfile() const
+    {
+        return m_profile;
+    }
+
+    // Keeps the state of objects still present, new objects start from INIT
+    void setObjects(const std::vector<std::string> &oids);
+
+    const std::vector<std::string>& getObjects() const
+    {
+        return m_oids;
+    }
+
+    // Counter fields of a sample row: the profile counters, then the optional ones
+    const std::vector<std::string>& getCounterNames() const
+    {
+        return m_counterNames;
+    }
+
+    // Total serdes bit rate of a port, needed for FEC BER
+    void setLineRate(const std::string &oid, double bitsPerSecond);
+
+    // Counter samples only consumed once they change or after two poll
+    // intervals, so that reading between two polls does not count as idle.
+    // 0 consumes every sample.
+    void setPollInterval(uint32_t intervalMs)
+    {
+        m_pollIntervalMs = intervalMs;
+    }
+
+    // values and present hold one row of getCounterNames().size() entries per
+    // object, in getObjects() order. elapsedMs is the time since the last update.
+    void update(const std::vector<uint64_t> &values,
+                const std::vector<uint8_t> &present,
+                double elapsedMs,
+                double alpha);
+
+    // RATES:<oid> rates and *_last values, and RATES:<oid>:<name> INIT_DONE
+    // state changes, of the update() calls since the last call
+    void getUpdates(std::vector<swss::KeyOpFieldsValuesTuple> &updates);
+
+    State getState(const std::string &oid) const;
+    double getRate(const std::string &oid, const std::string &field) const;
+
+    // Serdes bit rate of all lanes for a port speed in Mbps, 0 if unknown
+    static double getSerdesLineRate(uint32_t lanes, uint32_t speed);
+
+    // A number as the Lua scripts wrote it, also used by the PFC watchdog
+    static std::string formatNumber(double value);
+
+private:
+    void computeFec(size_t obj, const uint64_t *row, const uint8_t *rowPresent,
+                    double elapsedMs, std::vector<swss::FieldValueTuple> &fvs);
+
+    CounterRateProfile m_profile;
+    std::vector<std::string> m_counterNames;
+    size_t m_width;
+    size_t m_fecCorrected;
+    size_t m_fecUncorrectable;
+    size_t m_fecCodewordErrors;
+    uint32_t m_pollIntervalMs = 0;
+
+    std::vector<std::string> m_oids;
+    std::unordered_map<std::string, size_t> m_index;
+
+    // Per object, m_width or rates.size() entries per object where noted
+    std::vector<uint8_t> m_state;
+    std::vector<uint64_t> m_last;           // m_width
+    std::vector<uint8_t> m_lastPresent;     // m_width
+    std::vector<double> m_rates;            // rates.size()
+    std::vector<double> m_pending;          // time not yet consumed
+    std::vector<double> m_lineRate;
+    std::vector<double> m_fecPreBerMax;
+
+    std::vector<swss::KeyOpFieldsValuesTuple> m_updates;
+};
@@ -0,0 +1,187 @@
+#include <hiredis/hiredis.h>
+
+#include <stdexcept>
+#include <system_error>
+
+#include "logger.h"
+#include "rediscommand.h"
+#include "redisreply.h"
+
+#include "counter_reader.h"
+
+using namespace std;
+using namespace swss;
+
+// Commands sent before their replies are read, bounds the buffered replies
+#define COUNTER_READER_BATCH_SIZE 512
+
+CounterReader::CounterReader(DBConnector *db, const string &table, const vector<string> &fields) :
+    m_db(db),
+    m_table(db, table),
+    m_fields(fields)
+{
+}
+
+void CounterReader::read(const vector<string> &keys, vector<string> &values, vector<uint8_t> &present)
+{
+    SWSS_LOG_ENTER();
+
+    read({ Request{ this, &keys, &values, &present } });
+}
+
+void CounterReader::read(const vector<Request> &requests)
+{
+    SWSS_LOG_ENTER();
+
+    // (request, key) of every HMGET, in the order they are sent
+    vector<pair<size_t, size_t>> commands;
+    vector<vector<const char *>> argvs(requests.size());
+    vector<vector<size_t>> argvlens(requests.size());
+    DBConnector *db = nullptr;
+
+    for (size_t r = 0; r < requests.size(); r++)
+    {
+        const auto &request = requests[r];
+        const auto &fields = request.reader->m_fields;
+        const size_t width = fields.size();
+        request.values->assign(request.keys->size() * width, string());
+        request.present->assign(request.keys->size() * width, 0);
+
+        if (request.keys->empty() || !width)
+        {
+            continue;
+        }
+
+        if (db && db != request.reader->m_db)
+        {
+            throw invalid_argument("Counter readers of one batch must share their DB connector");
+        }
+        db = request.reader->m_db;
+
+        auto &argv = argvs[r];
+        auto &argvlen = argvlens[r];
+        argv.resize(width + 2);
+        argvlen.resize(width + 2);
+        argv[0] = "HMGET";
+        argvlen[0] = 5;
+        for (size_t j = 0; j < width; j++)
+        {
+            argv[j + 2] = fields[j].c_str();
+            argvlen[j + 2] = fields[j].size();
+        }
+
+        for (size_t i = 0; i < request.keys->size(); i++)
+        {
+            commands.emplace_back(r, i);
+        }
+    }
+
+    if (commands.empty())
+    {
+        return;
+    }
+
+    redisContext *context = db->getContext();
+
+    for (size_t start = 0; start < commands.size(); start += COUNTER_READER_BATCH_SIZE)
+    {
+        const size_t end = min(commands.size(), start + COUNTER_READER_BATCH_SIZE);
+
+        for (size_t c = start; c < end; c++)
+        {
+            const auto &request = requests[commands[c].first];
+            auto &argv = argvs[commands[c].first];
+            auto &argvlen = argvlens[commands[c].first];
+
+            string key = request.reader->m_table.getKeyName((*request.keys)[commands[c].second]);
+            argv[1] = key.c_str();
+            argvlen[1] = key.size();
+
+            RedisCommand command;
+            command.formatArgv(static_cast<int>(argv.size()), argv.data(), argvlen.data());
+            if (redisAppendFormattedCommand(context, command.c_str(), command.length()) != REDIS_OK)
+            {
+                throw system_error(make_error_code(errc::io_error), "Failed to queue HMGET of " + key);
+            }
+        }
+
+        // An error reply only loses its own key, the other replies of the
+        // batch are still read so the connection stays in sync
+        const CounterReader *failed = nullptr;
+        for (size_t c = start; c < end; c++)
+        {
+            const auto &request = requests[commands[c].first];
+            const size_t i = commands[c].second;
+
+            redisReply *raw = nullptr;
+            if (redisGetReply(context, reinterpret_cast<void **>(&raw)) != REDIS_OK || !raw)
+            {
+                throw system_error(make_error_code(errc::io_error), "Failed to read HMGET reply of " + (*request.keys)[i]);
+            }
+
+            RedisReply reply(raw);
+            if (raw->type != REDIS_REPLY_ARRAY)
+            {
+                if (raw->type == REDIS_REPLY_ERROR)
+                {
+                    failed = request.reader;
+                }
+                continue;
+            }
+
+            const size_t width = request.reader->m_fields.size();
+            for (size_t j = 0; j < width && j < raw->elements; j++)
+            {
+                const redisReply *element = raw->element[j];
+                if (element->type == REDIS_REPLY_STRING)
+                {
+                    (*request.values)[i * width + j].assign(element->str, element->len);
+                    (*request.present)[i * width + j] = 1;
+                }
+            }
+        }
+
+        if (failed)
+        {
+            SWSS_LOG_ERROR("HMGET failed on some keys of %s", failed->m_table.getTableName().c_str());
+        }
+    }
+}
+
+void CounterReader::read(const vector<string> &keys, vector<uint64_t> &values, vector<uint8_t> &present)
+{
+    SWSS_LOG_ENTER();
+
+    vector<string> strings;
+    read(keys, strings, present);
+
+    values.assign(strings.size(), 0);
+    for (size_t i = 0; i < strings.size(); i++)
+    {
+        if (!present[i])
+        {
+            continue;
+        }
+
+        if (!parseCounter(strings[i], values[i]))
+        {
+            present[i] = 0;
+            SWSS_LOG_DEBUG("Invalid counter %s of %s", m_fields[i % m_fields.size()].c_str(),
+                           keys[i / m_fields.size()].c_str());
+        }
+    }
+}
+
+bool CounterReader::parseCounter(const string &value, uint64_t &counter)
+{
+    try
+    {
+        counter = stoull(value);
+    }
+    catch (const exception &e)
+    {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "table.h"
+
+// Reads the same fields of many hashes of one table with an HMGET per hash.
+// The commands of a batch are all sent before the first reply is read, so a
+// poll of N objects costs about one round trip instead of N.
+class CounterReader
+{
+public:
+    // db is only used by this reader while read() runs, it must not have
+    // replies of other commands pending
+    CounterReader(swss::DBConnector *db, const std::string &table, const std::vector<std::string> &fields = {});
+
+    void setFields(const std::vector<std::string> &fields)
+    {
+        m_fields = fields;
+    }
+
+    const std::vector<std::string>& getFields() const
+    {
+        return m_fields;
+    }
+
+    // One row of getFields().size() entries per key, in keys order. present
+    // tells the fields the hash holds, missing ones are left empty.
+    void read(const std::vector<std::string> &keys,
+              std::vector<std::string> &values,
+              std::vector<uint8_t> &present);
+
+    // Same as above for unsigned counters, a value which is not a number
+    // reads as missing
+    void read(const std::vector<std::string> &keys,
+              std::vector<uint64_t> &values,
+              std::vector<uint8_t> &present);
+
+    // The keys of one reader in a read() of several readers
+    struct Request
+    {
+        CounterReader *reader;
+        const std::vector<std::string> *keys;
+        std::vector<std::string> *values;
+        std::vector<uint8_t> *present;
+    };
+
+    // Reads the keys of several readers in the same batches, as if each
+    // called read() on its own but without a round trip per reader. The
+    // readers must share their DBConnector. The HMGETs are still separate
+    // commands: another client may write between the hashes of one batch.
+    static void read(const std::vector<Request> &requests);
+
+    // A counter value as stored in COUNTERS_DB, false if not a number
+    static bool parseCounter(const std::string &value, uint64_t &counter);
+
+private:
+    swss::DBConnector *m_db;
+    swss::Table m_table;
+    std::vector<std::string> m_fields;
+};
@@ -0,0 +1,606 @@
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "logger.h"
+#include "counter_snapshot.h"
+
+using namespace std;
+
+#define COUNTER_SNAPSHOT_PREFIX             "/swss_counters_"
+#define COUNTER_SNAPSHOT_INITIAL_CAPACITY   64
+#define COUNTER_SNAPSHOT_ALIGNMENT          64
+#define COUNTER_SNAPSHOT_PAGE_SIZE          4096
+
+static bool g_counterSnapshotEnabled = false;
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void CounterSnapshotWriter::setEnabled(bool enabled)
+{
+    g_counterSnapshotEnabled = enabled;
+}
+
+bool CounterSnapshotWriter::isEnabled()
+{
+    return g_counterSnapshotEnabled;
+}
+
+CounterSnapshotWriter *CounterSnapshotWriter::get(const string &table)
+{
+    SWSS_LOG_ENTER();
+
+    static unordered_map<string, unique_ptr<CounterSnapshotWriter>> writers;
+
+    if (!g_counterSnapshotEnabled)
+    {
+        return nullptr;
+    }
+
+    auto it = writers.find(table);
+    if (it != writers.end())
+    {
+        return it->second.get();
+    }
+
+    unique_ptr<CounterSnapshotWriter> writer;
+    try
+    {
+        writer = make_unique<CounterSnapshotWriter>(table);
+        SWSS_LOG_NOTICE("Publishing %s counters in %s", table.c_str(), getRegionName(table).c_str());
+    }
+    catch (const runtime_error &e)
+    {
+        SWSS_LOG_ERROR("Failed to create the counter snapshot of %s: %s", table.c_str(), e.what());
+    }
+
+    // Not retried on failure
+    return writers.emplace(table, move(writer)).first->second.get();
+}
+
+string CounterSnapshotWriter::getRegionName(const string &table)
+{
+    return COUNTER_SNAPSHOT_PREFIX + table;
+}
+
+CounterSnapshotWriter::Layout CounterSnapshotWriter::getLayout(uint32_t counterCount, uint32_t objectCapacity)
+{
+    Layout layout;
+    layout.counterCount = counterCount;
+    layout.objectCapacity = objectCapacity;
+    layout.countersOffset = alignUp(sizeof(CounterSnapshotHeader), COUNTER_SNAPSHOT_ALIGNMENT);
+    layout.objectsOffset = alignUp(layout.countersOffset + counterCount * CounterSnapshotHeader::NAME_SIZE,
+                                   COUNTER_SNAPSHOT_ALIGNMENT);
+    layout.valuesOffset = alignUp(layout.objectsOffset + objectCapacity * sizeof(CounterSnapshotObject),
+                                  COUNTER_SNAPSHOT_ALIGNMENT);
+    layout.presentOffset = layout.valuesOffset + uint64_t(objectCapacity) * counterCount * sizeof(uint64_t);
+    layout.size = alignUp(layout.presentOffset + uint64_t(objectCapacity) * counterCount, COUNTER_SNAPSHOT_PAGE_SIZE);
+    return layout;
+}
+
+CounterSnapshotWriter::CounterSnapshotWriter(const string &table) :
+    m_name(getRegionName(table))
+{
+    SWSS_LOG_ENTER();
+
+    // Readers of a region left by a previous run see it unlinked and reopen
+    shm_unlink(m_name.c_str());
+
+    m_fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (m_fd < 0)
+    {
+        throw runtime_error("shm_open " + m_name + ": " + strerror(errno));
+    }
+
+    m_layout = getLayout(0, COUNTER_SNAPSHOT_INITIAL_CAPACITY);
+    if (ftruncate(m_fd, static_cast<off_t>(m_layout.size)) < 0)
+    {
+        string error = strerror(errno);
+        ::close(m_fd);
+        shm_unlink(m_name.c_str());
+        throw runtime_error("ftruncate " + m_name + ": " + error);
+    }
+
+    void *base = mmap(nullptr, m_layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (base == MAP_FAILED)
+    {
+        string error = strerror(errno);
+        ::close(m_fd);
+        shm_unlink(m_name.c_str());
+        throw runtime_error("mmap " + m_name + ": " + error);
+    }
+
+    m_base = static_cast<uint8_t*>(base);
+    m_mapped = m_layout.size;
+
+    auto hdr = new (m_base) CounterSnapshotHeader();
+    hdr->sequence.store(0, memory_order_relaxed);
+    hdr->version = CounterSnapshotHeader::VERSION;
+    hdr->size = m_mapped;
+    hdr->timestampUs = 0;
+    hdr->counterCount = m_layout.counterCount;
+    hdr->objectCapacity = m_layout.objectCapacity;
+    hdr->objectCount = 0;
+    hdr->countersOffset = m_layout.countersOffset;
+    hdr->objectsOffset = m_layout.objectsOffset;
+    hdr->valuesOffset = m_layout.valuesOffset;
+    hdr->presentOffset = m_layout.presentOffset;
+    atomic_thread_fence(memory_order_release);
+    hdr->magic = CounterSnapshotHeader::MAGIC;
+}
+
+CounterSnapshotWriter::~CounterSnapshotWriter()
+{
+    if (m_base)
+    {
+        beginWrite();
+        header()->magic = 0;
+        endWrite();
+        munmap(m_base, m_mapped);
+    }
+
+    if (m_fd >= 0)
+    {
+        // The name may already be another writer's region
+        struct stat st;
+        if (fstat(m_fd, &st) == 0 && st.st_nlink > 0)
+        {
+            shm_unlink(m_name.c_str());
+        }
+        ::close(m_fd);
+    }
+}
+
+void CounterSnapshotWriter::beginWrite()
+{
+    auto &sequence = header()->sequence;
+    sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+void CounterSnapshotWriter::endWrite()
+{
+    auto &sequence = header()->sequence;
+    sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+void CounterSnapshotWriter::relayout(uint32_t objectCapacity)
+{
+    SWSS_LOG_ENTER();
+
+    Layout layout = getLayout(static_cast<uint32_t>(m_counters.size()), objectCapacity);
+
+    beginWrite();
+
+    if (layout.size > m_mapped)
+    {
+        void *base = MAP_FAILED;
+        if (ftruncate(m_fd, static_cast<off_t>(layout.size)) == 0)
+        {
+            base = mmap(nullptr, layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        }
+
+        if (base == MAP_FAILED)
+        {
+            // Keeps the layout it has, objects beyond its capacity are not published
+            SWSS_LOG_ERROR("Failed to grow %s to %" PRIu64 " bytes: %s", m_name.c_str(), layout.size, strerror(errno));
+            endWrite();
+            return;
+        }
+
+        munmap(m_base, m_mapped);
+        m_base = static_cast<uint8_t*>(base);
+        m_mapped = layout.size;
+    }
+
+    m_layout = layout;
+
+    auto hdr = header();
+    hdr->size = m_mapped;
+    hdr->counterCount = layout.counterCount;
+    hdr->objectCapacity = layout.objectCapacity;
+    hdr->countersOffset = layout.countersOffset;
+    hdr->objectsOffset = layout.objectsOffset;
+    hdr->valuesOffset = layout.valuesOffset;
+    hdr->presentOffset = layout.presentOffset;
+
+    for (size_t c = 0; c < m_counters.size(); c++)
+    {
+        char *name = reinterpret_cast<char*>(m_base + layout.countersOffset + c * CounterSnapshotHeader::NAME_SIZE);
+        memset(name, 0, CounterSnapshotHeader::NAME_SIZE);
+        strncpy(name, m_counters[c].c_str(), CounterSnapshotHeader::NAME_SIZE - 1);
+    }
+
+    memset(m_base + layout.objectsOffset, 0, layout.objectCapacity * sizeof(CounterSnapshotObject));
+    for (uint32_t slot = 0; slot < m_objectNames.size() && slot < layout.objectCapacity; slot++)
+    {
+        writeObject(slot);
+    }
+    hdr->objectCount = static_cast<uint32_t>(min<size_t>(m_objectNames.size(), layout.objectCapacity));
+
+    memset(m_base + layout.valuesOffset, 0, layout.size - layout.valuesOffset);
+
+    endWrite();
+}
+
+void CounterSnapshotWriter::writeObject(uint32_t slot)
+{
+    auto object = reinterpret_cast<CounterSnapshotObject*>(m_base + m_layout.objectsOffset) + slot;
+    memset(object->name, 0, sizeof(object->name));
+    strncpy(object->name, m_objectNames[slot].c_str(), sizeof(object->name) - 1);
+    object->oid = m_objectOids[slot];
+    object->used = !m_objectNames[slot].empty();
+}
+
+void CounterSnapshotWriter::setCounters(const vector<string> &counters)
+{
+    SWSS_LOG_ENTER();
+
+    if (counters == m_counters)
+    {
+        return;
+    }
+
+    m_counters = counters;
+    relayout(m_layout.objectCapacity);
+}
+
+uint32_t CounterSnapshotWriter::setObject(const string &name, uint64_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_slots.find(name);
+    if (it != m_slots.end())
+    {
+        uint32_t slot = it->second;
+        if (m_objectOids[slot] != oid && slot < m_layout.objectCapacity)
+        {
+            m_objectOids[slot] = oid;
+            beginWrite();
+            writeObject(slot);
+            endWrite();
+        }
+        return slot;
+    }
+
+    uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_objectNames.size());
+        m_objectNames.emplace_back();
+        m_objectOids.push_back(0);
+    }
+
+    m_slots[name] = slot;
+    m_objectNames[slot] = name;
+    m_objectOids[slot] = oid;
+
+    if (slot >= m_layout.objectCapacity)
+    {
+        relayout(max(m_layout.objectCapacity * 2, slot + 1));
+        return slot;
+    }
+
+    const size_t width = m_layout.counterCount;
+
+    beginWrite();
+    writeObject(slot);
+    memset(m_base + m_layout.valuesOffset + slot * width * sizeof(uint64_t), 0, width * sizeof(uint64_t));
+    memset(m_base + m_layout.presentOffset + slot * width, 0, width);
+    header()->objectCount = max(header()->objectCount, slot + 1);
+    endWrite();
+
+    return slot;
+}
+
+void CounterSnapshotWriter::removeObject(const string &name)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_slots.find(name);
+    if (it == m_slots.end())
+    {
+        return;
+    }
+
+    uint32_t slot = it->second;
+    m_slots.erase(it);
+    m_objectNames[slot].clear();
+    m_objectOids[slot] = 0;
+    m_freeSlots.push_back(slot);
+
+    if (slot >= m_layout.objectCapacity)
+    {
+        return;
+    }
+
+    const size_t width = m_layout.counterCount;
+
+    beginWrite();
+    writeObject(slot);
+    memset(m_base + m_layout.presentOffset + slot * width, 0, width);
+    endWrite();
+}
+
+bool CounterSnapshotWriter::getSlot(const string &name, uint32_t &slot) const
+{
+    auto it = m_slots.find(name);
+    if (it == m_slots.end())
+    {
+        return false;
+    }
+
+    slot = it->second;
+    return true;
+}
+
+void CounterSnapshotWriter::update(const vector<uint32_t> &slots,
+                                   const vector<uint64_t> &values,
+                                   const vector<uint8_t> &present,
+                                   uint64_t timestampUs)
+{
+    SWSS_LOG_ENTER();
+
+    const size_t width = m_counters.size();
+    if (width != m_layout.counterCount)
+    {
+        // The region could not be grown for the counters
+        return;
+    }
+
+    if (values.size() != slots.size() * width || present.size() != values.size())
+    {
+        SWSS_LOG_ERROR("Expected %zu counters for %s, got %zu", slots.size() * width, m_name.c_str(), values.size());
+        return;
+    }
+
+    beginWrite();
+
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (slots[i] >= m_layout.objectCapacity || !width)
+        {
+            continue;
+        }
+
+        memcpy(m_base + m_layout.valuesOffset + slots[i] * width * sizeof(uint64_t),
+               &values[i * width], width * sizeof(uint64_t));
+        memcpy(m_base + m_layout.presentOffset + slots[i] * width, &present[i * width], width);
+    }
+    header()->timestampUs = timestampUs;
+
+    endWrite();
+}
+
+CounterSnapshotReader::~CounterSnapshotReader()
+{
+    close();
+}
+
+bool CounterSnapshotReader::open(const string &table)
+{
+    close();
+    m_table = table;
+
+    m_fd = shm_open(CounterSnapshotWriter::getRegionName(table).c_str(), O_RDONLY, 0);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) < 0 || !remap(static_cast<size_t>(st.st_size)))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void CounterSnapshotReader::close()
+{
+    if (m_base)
+    {
+        munmap(const_cast<uint8_t*>(m_base), m_mapped);
+        m_base = nullptr;
+        m_mapped = 0;
+    }
+
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool CounterSnapshotReader::isReplaced() const
+{
+    // A region replaced under the same name was unlinked first, whether its
+    // writer exited or not
+    struct stat st;
+    return m_fd >= 0 && fstat(m_fd, &st) == 0 && st.st_nlink == 0;
+}
+
+bool CounterSnapshotReader::remap(size_t size)
+{
+    if (size < sizeof(CounterSnapshotHeader))
+    {
+        return false;
+    }
+
+    void *base = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (base == MAP_FAILED)
+    {
+        return false;
+    }
+
+    if (m_base)
+    {
+        munmap(const_cast<uint8_t*>(m_base), m_mapped);
+    }
+
+    m_base = static_cast<const uint8_t*>(base);
+    m_mapped = size;
+    return true;
+}
+
+bool CounterSnapshotReader::begin(uint64_t &sequence)
+{
+    if (!m_base)
+    {
+        return false;
+    }
+
+    auto hdr = getHeader();
+    sequence = hdr->sequence.load(memory_order_acquire);
+    if ((sequence & 1) || hdr->magic != CounterSnapshotHeader::MAGIC ||
+        hdr->version != CounterSnapshotHeader::VERSION)
+    {
+        return false;
+    }
+
+    if (hdr->size > m_mapped)
+    {
+        uint64_t size = hdr->size;
+        if (!validate(sequence) || !remap(size))
+        {
+            return false;
+        }
+        hdr = getHeader();
+    }
+
+    m_counterCount = hdr->counterCount;
+    m_objectCapacity = hdr->objectCapacity;
+    m_countersOffset = hdr->countersOffset;
+    m_objectsOffset = hdr->objectsOffset;
+    m_valuesOffset = hdr->valuesOffset;
+    m_presentOffset = hdr->presentOffset;
+
+    // A torn layout must not lead outside of the mapping
+    uint64_t cells = uint64_t(m_objectCapacity) * m_counterCount;
+    return m_countersOffset + uint64_t(m_counterCount) * CounterSnapshotHeader::NAME_SIZE <= m_mapped &&
+           m_objectsOffset + uint64_t(m_objectCapacity) * sizeof(CounterSnapshotObject) <= m_mapped &&
+           m_valuesOffset + cells * sizeof(uint64_t) <= m_mapped &&
+           m_presentOffset + cells <= m_mapped;
+}
+
+bool CounterSnapshotReader::validate(uint64_t sequence) const
+{
+    atomic_thread_fence(memory_order_acquire);
+    return getHeader()->sequence.load(memory_order_relaxed) == sequence;
+}
+
+const char *CounterSnapshotReader::getCounterName(uint32_t counter) const
+{
+    if (counter >= m_counterCount)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const char*>(m_base + m_countersOffset + counter * CounterSnapshotHeader::NAME_SIZE);
+}
+
+const CounterSnapshotObject *CounterSnapshotReader::getObject(uint32_t slot) const
+{
+    if (slot >= m_objectCapacity)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const CounterSnapshotObject*>(m_base + m_objectsOffset) + slot;
+}
+
+const uint64_t *CounterSnapshotReader::getValues(uint32_t slot) const
+{
+    if (slot >= m_objectCapacity)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const uint64_t*>(m_base + m_valuesOffset) + uint64_t(slot) * m_counterCount;
+}
+
+const uint8_t *CounterSnapshotReader::getPresent(uint32_t slot) const
+{
+    if (slot >= m_objectCapacity)
+    {
+        return nullptr;
+    }
+
+    return m_base + m_presentOffset + uint64_t(slot) * m_counterCount;
+}
+
+bool CounterSnapshotReader::read(Snapshot &snapshot, unsigned retries)
+{
+    if (isReplaced())
+    {
+        open(m_table);
+    }
+
+    for (unsigned attempt = 0; attempt < retries; attempt++)
+    {
+        uint64_t sequence;
+        if (!begin(sequence))
+        {
+            // The writer went away, its next run writes a new region
+            if (!m_base || getHeader()->magic != CounterSnapshotHeader::MAGIC || isReplaced())
+            {
+                open(m_table);
+            }
+            sched_yield();
+            continue;
+        }
+
+        snapshot.timestampUs = getHeader()->timestampUs;
+        snapshot.counters.clear();
+        snapshot.objects.clear();
+
+        for (uint32_t c = 0; c < m_counterCount; c++)
+        {
+            snapshot.counters.emplace_back(getCounterName(c), strnlen(getCounterName(c), CounterSnapshotHeader::NAME_SIZE));
+        }
+
+        uint32_t objectCount = min(getHeader()->objectCount, m_objectCapacity);
+        for (uint32_t slot = 0; slot < objectCount; slot++)
+        {
+            auto object = getObject(slot);
+            if (!object->used)
+            {
+                continue;
+            }
+
+            Object copy;
+            copy.name.assign(object->name, strnlen(object->name, sizeof(object->name)));
+            copy.oid = object->oid;
+            copy.slot = slot;
+            copy.values.assign(getValues(slot), getValues(slot) + m_counterCount);
+            copy.present.assign(getPresent(slot), getPresent(slot) + m_counterCount);
+            snapshot.objects.push_back(move(copy));
+        }
+
+        if (validate(sequence))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Shared memory snapshot of the counters of one counter name map, e.g.
+// COUNTERS_PORT_NAME_MAP. Objects keep the slot they were given for as long as
+// they stay in the name map, so readers can resolve a name to a slot once and
+// read its counters in place. Every change is made under a seqlock: the
+// sequence is odd while the region is written, and a read is only consistent
+// if the sequence was even and unchanged around it. COUNTERS_DB is still
+// written as before, the snapshot is an additional transport.
+//
+// CounterRateOrch writes the regions of the groups it reads every poll, the
+// port, RIF, trap and tunnel name maps. counter_snapshot_dump prints them.
+//
+// Region layout, offsets are in the header:
+//   CounterSnapshotHeader
+//   char counterNames[counterCount][NAME_SIZE]
+//   CounterSnapshotObject objects[objectCapacity]
+//   uint64_t values[objectCapacity][counterCount]
+//   uint8_t present[objectCapacity][counterCount]
+struct CounterSnapshotHeader
+{
+    static constexpr uint32_t MAGIC = 0x53574353;   // "SWCS"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t NAME_SIZE = 64;
+
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint64_t> sequence;
+    // Only grows, a reader mapping less remaps
+    uint64_t size;
+    // Wall clock time of the last counter update
+    uint64_t timestampUs;
+    uint32_t counterCount;
+    uint32_t objectCapacity;
+    // Slots in use are below objectCount
+    uint32_t objectCount;
+    uint32_t reserved;
+    uint64_t countersOffset;
+    uint64_t objectsOffset;
+    uint64_t valuesOffset;
+    uint64_t presentOffset;
+};
+
+struct CounterSnapshotObject
+{
+    char name[CounterSnapshotHeader::NAME_SIZE];
+    uint64_t oid;
+    uint32_t used;
+    uint32_t reserved;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "seqlock needs a lock free sequence");
+
+class CounterSnapshotWriter
+{
+public:
+    // Set once from the command line, get() returns nullptr until enabled
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // The writer of the table's region, shared by every component publishing
+    // into it. nullptr if disabled or the region could not be created.
+    static CounterSnapshotWriter *get(const std::string &table);
+
+    static std::string getRegionName(const std::string &table);
+
+    // Throws runtime_error if the region cannot be created
+    explicit CounterSnapshotWriter(const std::string &table);
+    ~CounterSnapshotWriter();
+
+    CounterSnapshotWriter(const CounterSnapshotWriter&) = delete;
+    CounterSnapshotWriter& operator=(const CounterSnapshotWriter&) = delete;
+
+    // Values are dropped when the counters change
+    void setCounters(const std::vector<std::string> &counters);
+
+    const std::vector<std::string>& getCounters() const
+    {
+        return m_counters;
+    }
+
+    // Returns the slot of the object, the one it already had if any
+    uint32_t setObject(const std::string &name, uint64_t oid);
+    void removeObject(const std::string &name);
+    bool getSlot(const std::string &name, uint32_t &slot) const;
+
+    // One row of getCounters() values per slot, written in one seqlock section
+    void update(const std::vector<uint32_t> &slots,
+                const std::vector<uint64_t> &values,
+                const std::vector<uint8_t> &present,
+                uint64_t timestampUs);
+
+private:
+    struct Layout
+    {
+        uint32_t counterCount;
+        uint32_t objectCapacity;
+        uint64_t countersOffset;
+        uint64_t objectsOffset;
+        uint64_t valuesOffset;
+        uint64_t presentOffset;
+        uint64_t size;
+    };
+
+    static Layout getLayout(uint32_t counterCount, uint32_t objectCapacity);
+
+    void beginWrite();
+    void endWrite();
+    // Rewrites the region for the current counters and objects, values dropped
+    void relayout(uint32_t objectCapacity);
+    void writeObject(uint32_t slot);
+
+    CounterSnapshotHeader *header() const
+    {
+        return reinterpret_cast<CounterSnapshotHeader*>(m_base);
+    }
+
+    std::string m_name;
+    int m_fd = -1;
+    uint8_t *m_base = nullptr;
+    size_t m_mapped = 0;
+    Layout m_layout;
+
+    std::vector<std::string> m_counters;
+    std::vector<std::string> m_objectNames;
+    std::vector<uint64_t> m_objectOids;
+    std::unordered_map<std::string, uint32_t> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+class CounterSnapshotReader
+{
+public:
+    struct Object
+    {
+        std::string name;
+        uint64_t oid;
+        uint32_t slot;
+        std::vector<uint64_t> values;
+        std::vector<uint8_t> present;
+    };
+
+    struct Snapshot
+    {
+        uint64_t timestampUs = 0;
+        std::vector<std::string> counters;
+        std::vector<Object> objects;
+    };
+
+    ~CounterSnapshotReader();
+
+    // false if the region does not exist (yet)
+    bool open(const std::string &table);
+    void close();
+
+    // Copies out a consistent snapshot, false if none could be taken in retries attempts.
+    // Reopens the region if it was replaced.
+    bool read(Snapshot &snapshot, unsigned retries = 100);
+
+    // The region mapped was unlinked: its writer exited, or a new writer
+    // replaced it after a crash. Zero copy readers check it to open() again.
+    bool isReplaced() const;
+
+    // Zero copy access. Pointers returned between begin() and validate() may
+    // see a torn update, their content can only be used once validate() says
+    // the sequence did not move. begin() returns false if the region is being
+    // written or is not mapped.
+    bool begin(uint64_t &sequence);
+    bool validate(uint64_t sequence) const;
+
+    const CounterSnapshotHeader *getHeader() const
+    {
+        return reinterpret_cast<const CounterSnapshotHeader*>(m_base);
+    }
+
+    const char *getCounterName(uint32_t counter) const;
+    const CounterSnapshotObject *getObject(uint32_t slot) const;
+    const uint64_t *getValues(uint32_t slot) const;
+    const uint8_t *getPresent(uint32_t slot) const;
+
+private:
+    bool remap(size_t size);
+
+    std::string m_table;
+    int m_fd = -1;
+    const uint8_t *m_base = nullptr;
+    size_t m_mapped = 0;
+    // Layout of the last begin(), checked against the mapping
+    uint32_t m_counterCount = 0;
+    uint32_t m_objectCapacity = 0;
+    uint64_t m_countersOffset = 0;
+    uint64_t m_objectsOffset = 0;
+    uint64_t m_valuesOffset = 0;
+    uint64_t m_presentOffset = 0;
+};
@@ -0,0 +1,371 @@
+#include <tokenize.h>
+
+#include "copporch.h"
+#include "high_frequency_telemetry/counternameupdater.h"
+#include "intfsorch.h"
+#include "portsorch.h"
+#include "sai_serialize.h"
+#include "timer.h"
+#include "vxlanorch.h"
+
+#include "counter_snapshot.h"
+#include "counterrateorch.h"
+
+using namespace std;
+using namespace swss;
+
+extern PortsOrch *gPortsOrch;
+
+#define RATES_TABLE             "RATES"
+#define RATES_ALPHA_SUFFIX      "_ALPHA"
+
+#define PORT_RATES_KEY          "PORT"
+#define RIF_RATES_KEY           "RIF"
+#define TRAP_RATES_KEY          "FLOW_CNT_TRAP"
+#define TUNNEL_RATES_KEY        "TUNNEL"
+
+// Default poll interval of the HOSTIF_TRAP_FLOW_COUNTER group
+#define TRAP_RATES_POLL_INTERVAL_MS 10000
+
+// Polls between two full publications in delta mode
+#define DEFAULT_FULL_REFRESH_CYCLES 30
+
+#define RATES_PUBLISH_STATS_TABLE   "RATES_PUBLISH_STATS"
+// Polls between two updates of the publish stats in STATE_DB
+#define RATES_PUBLISH_STATS_CYCLES  10
+
+CounterRateOrch::CounterRateOrch(DBConnector *applDb) :
+    Orch(),
+    m_countersDb(make_shared<DBConnector>("COUNTERS_DB", 0)),
+    m_ratesPipe(make_unique<RedisPipeline>(m_countersDb.get())),
+    m_ratesTable(m_countersDb.get(), RATES_TABLE),
+    m_ratesTableBatch(make_unique<Table>(m_ratesPipe.get(), RATES_TABLE, true)),
+    m_appPortTable(applDb, APP_PORT_TABLE_NAME),
+    m_stateDb(make_shared<DBConnector>("STATE_DB", 0)),
+    m_publishStatsTable(m_stateDb.get(), RATES_PUBLISH_STATS_TABLE)
+{
+    SWSS_LOG_ENTER();
+
+    addGroup(PORT_RATES_KEY, CounterRateProfile::port(), COUNTERS_PORT_NAME_MAP,
+             stoi(PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS));
+    addGroup(RIF_RATES_KEY, CounterRateProfile::rif(), COUNTERS_RIF_NAME_MAP,
+             stoi(RIF_FLEX_STAT_COUNTER_POLL_MSECS));
+    addGroup(TRAP_RATES_KEY, CounterRateProfile::trap(), COUNTERS_TRAP_NAME_MAP,
+             TRAP_RATES_POLL_INTERVAL_MS);
+    addGroup(TUNNEL_RATES_KEY, CounterRateProfile::tunnel(), COUNTERS_TUNNEL_NAME_MAP,
+             TUNNEL_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS);
+}
+
+void CounterRateOrch::addGroup(const string &key, const CounterRateProfile &profile,
+                               const string &nameMap, uint32_t intervalMs)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = m_groups.emplace(piecewise_construct,
+                                   forward_as_tuple(key),
+                                   forward_as_tuple(profile, nameMap, m_countersDb.get())).first->second;
+    group.key = key;
+    group.engine.setPollInterval(intervalMs);
+    group.publisher.setFullRefreshCycles(DEFAULT_FULL_REFRESH_CYCLES);
+
+    auto interval = timespec { .tv_sec = intervalMs / 1000, .tv_nsec = (intervalMs % 1000) * 1000000 };
+    group.timer = new SelectableTimer(interval);
+    Orch::addExecutor(new ExecutableTimer(group.timer, this, key + "_RATES_TIMER"));
+}
+
+void CounterRateOrch::setGroupPollInterval(const string &key, const string &intervalMs)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_groups.find(key);
+    if (it == m_groups.end())
+    {
+        return;
+    }
+
+    uint32_t interval;
+    try
+    {
+        interval = static_cast<uint32_t>(stoul(intervalMs));
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid poll interval %s for %s rates", intervalMs.c_str(), key.c_str());
+        return;
+    }
+
+    if (interval == 0)
+    {
+        SWSS_LOG_ERROR("Invalid poll interval 0 for %s rates", key.c_str());
+        return;
+    }
+
+    auto &group = it->second;
+    group.engine.setPollInterval(interval);
+    group.timer->setInterval(timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 });
+    if (group.enabled)
+    {
+        group.timer->reset();
+    }
+}
+
+void CounterRateOrch::setGroupState(const string &key, bool enabled)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_groups.find(key);
+    if (it == m_groups.end() || it->second.enabled == enabled)
+    {
+        return;
+    }
+
+    auto &group = it->second;
+    group.enabled = enabled;
+    if (enabled)
+    {
+        group.lastUpdate = chrono::steady_clock::now();
+        group.timer->start();
+    }
+    else
+    {
+        group.timer->stop();
+        // Rates start over from the first sample once enabled again
+        group.engine.setObjects({});
+        group.namesValid = false;
+        group.publisher.reset();
+    }
+
+    SWSS_LOG_NOTICE("%s rates %s", key.c_str(), enabled ? "enabled" : "disabled");
+}
+
+void CounterRateOrch::setGroupRatesPublishMode(const string &key, const string &mode, const string &fullRefreshCycles)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_groups.find(key);
+    if (it == m_groups.end())
+    {
+        return;
+    }
+
+    auto &publisher = it->second.publisher;
+
+    if (!mode.empty())
+    {
+        CounterPublisher::Mode publishMode;
+        if (!CounterPublisher::parseMode(mode, publishMode))
+        {
+            SWSS_LOG_ERROR("Invalid publish mode %s for %s rates", mode.c_str(), key.c_str());
+        }
+        else if (publishMode != publisher.getMode())
+        {
+            publisher.setMode(publishMode);
+            SWSS_LOG_NOTICE("%s rates publish mode set to %s", key.c_str(), mode.c_str());
+        }
+    }
+
+    if (!fullRefreshCycles.empty())
+    {
+        try
+        {
+            publisher.setFullRefreshCycles(static_cast<uint32_t>(stoul(fullRefreshCycles)));
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Invalid full refresh cycles %s for %s rates", fullRefreshCycles.c_str(), key.c_str());
+        }
+    }
+}
+
+void CounterRateOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &it : m_groups)
+    {
+        if (it.second.timer == &timer)
+        {
+            updateRates(it.second);
+            return;
+        }
+    }
+}
+
+void CounterRateOrch::updateRates(RateGroup &group)
+{
+    SWSS_LOG_ENTER();
+
+    auto &engine = group.engine;
+    const auto &name = engine.getProfile().name;
+
+    string value;
+    double alpha;
+    if (!m_ratesTable.hget(name, name + RATES_ALPHA_SUFFIX, value))
+    {
+        SWSS_LOG_DEBUG("Alpha is not defined for %s rates", name.c_str());
+        return;
+    }
+
+    try
+    {
+        alpha = stod(value);
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid alpha %s for %s rates", value.c_str(), name.c_str());
+        return;
+    }
+
+    uint64_t version = CounterNameMapUpdater::getVersion(group.nameMap);
+    if (!group.namesValid || group.nameMapVersion != version)
+    {
+        group.names.clear();
+        Table(m_countersDb.get(), group.nameMap).get("", group.names);
+        group.nameMapVersion = version;
+        group.namesValid = true;
+
+        vector<string> oids;
+        oids.reserve(group.names.size());
+        for (const auto &fv : group.names)
+        {
+            oids.push_back(fvValue(fv));
+        }
+        engine.setObjects(oids);
+    }
+
+    const auto &names = group.names;
+    const auto &oids = engine.getObjects();
+
+    if (engine.getProfile().fec)
+    {
+        updateLineRates(group, names);
+    }
+
+    // One row of counters per object, in the engine's column order
+    vector<uint64_t> values;
+    vector<uint8_t> present;
+    group.reader.read(oids, values, present);
+
+    updateSnapshot(group, names, values, present);
+
+    auto now = chrono::steady_clock::now();
+    engine.update(values, present, chrono::duration<double, milli>(now - group.lastUpdate).count(), alpha);
+    group.lastUpdate = now;
+
+    vector<KeyOpFieldsValuesTuple> updates;
+    engine.getUpdates(updates);
+    group.publisher.filter(updates);
+    for (const auto &update : updates)
+    {
+        m_ratesTableBatch->set(kfvKey(update), kfvFieldsValues(update));
+    }
+    if (!updates.empty())
+    {
+        m_ratesPipe->flush();
+    }
+
+    const auto &stats = group.publisher.getStats();
+    SWSS_LOG_DEBUG("Updated %s rates of %zu objects, %zu fields written, %zu unchanged skipped",
+                   name.c_str(), oids.size(), stats.lastWritten, stats.lastSkipped);
+
+    if (stats.cycles % RATES_PUBLISH_STATS_CYCLES == 1)
+    {
+        vector<FieldValueTuple> fvs;
+        group.publisher.getStatsFields(fvs);
+        m_publishStatsTable.set(group.key, fvs);
+    }
+}
+
+void CounterRateOrch::updateSnapshot(RateGroup &group, const vector<FieldValueTuple> &names,
+                                     const vector<uint64_t> &values, const vector<uint8_t> &present)
+{
+    SWSS_LOG_ENTER();
+
+    auto snapshot = CounterSnapshotWriter::get(group.nameMap);
+    if (!snapshot)
+    {
+        return;
+    }
+
+    snapshot->setCounters(group.engine.getCounterNames());
+
+    unordered_set<string> objects;
+    vector<uint32_t> slots;
+    slots.reserve(names.size());
+    for (const auto &fv : names)
+    {
+        sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+        try
+        {
+            sai_deserialize_object_id(fvValue(fv), oid);
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_DEBUG("Invalid OID %s of %s", fvValue(fv).c_str(), fvField(fv).c_str());
+        }
+
+        slots.push_back(snapshot->setObject(fvField(fv), oid));
+        objects.insert(fvField(fv));
+    }
+
+    for (const auto &object : group.snapshotObjects)
+    {
+        if (!objects.count(object))
+        {
+            snapshot->removeObject(object);
+        }
+    }
+    group.snapshotObjects = move(objects);
+
+    auto now = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch());
+    snapshot->update(slots, values, present, static_cast<uint64_t>(now.count()));
+}
+
+void CounterRateOrch::updateLineRates(RateGroup &group, const vector<FieldValueTuple> &names)
+{
+    SWSS_LOG_ENTER();
+
+    if (!gPortsOrch)
+    {
+        return;
+    }
+
+    unordered_map<string, uint32_t> portLanes;
+
+    for (const auto &fv : names)
+    {
+        const auto &alias = fvField(fv);
+        const auto &oid = fvValue(fv);
+
+        Port port;
+        if (!gPortsOrch->getPort(alias, port))
+        {
+            continue;
+        }
+
+        // Keyed by OID, a port broken out again with other lanes gets a new one
+        uint32_t lanes = 0;
+        auto it = m_portLanes.find(oid);
+        if (it != m_portLanes.end())
+        {
+            lanes = it->second;
+        }
+        else
+        {
+            string value;
+            if (m_appPortTable.hget(alias, "lanes", value))
+            {
+                lanes = static_cast<uint32_t>(tokenize(value, ',').size());
+            }
+        }
+
+        if (lanes)
+        {
+            portLanes.emplace(oid, lanes);
+        }
+
+        group.engine.setLineRate(oid, CounterRateEngine::getSerdesLineRate(lanes, port.m_speed));
+    }
+
+    m_portLanes.swap(portLanes);
+}
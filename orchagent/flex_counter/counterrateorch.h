@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dbconnector.h"
+#include "orch.h"
+#include "redispipeline.h"
+#include "schema.h"
+#include "selectabletimer.h"
+#include "table.h"
+
+#include "counter_publisher.h"
+#include "counter_rate_engine.h"
+#include "counter_reader.h"
+
+// Publishes RATES for the PORT, RIF, FLOW_CNT_TRAP and TUNNEL flex counter
+// groups from the counters in COUNTERS_DB, in place of the rate plugins
+class CounterRateOrch : public Orch
+{
+public:
+    CounterRateOrch(swss::DBConnector *applDb);
+
+    void doTask(swss::SelectableTimer &timer) override;
+
+    bool hasGroup(const std::string &key) const
+    {
+        return m_groups.find(key) != m_groups.end();
+    }
+
+    // key is the FLEX_COUNTER_TABLE key of the group, others are ignored
+    void setGroupPollInterval(const std::string &key, const std::string &intervalMs);
+    void setGroupState(const std::string &key, bool enabled);
+    // RATES_PUBLISH_MODE and RATES_FULL_REFRESH_CYCLES of the group, only
+    // filter the RATES written here. Empty values are left as they are.
+    void setGroupRatesPublishMode(const std::string &key, const std::string &mode, const std::string &fullRefreshCycles);
+
+private:
+    struct RateGroup
+    {
+        RateGroup(const CounterRateProfile &profile, const std::string &nameMap, swss::DBConnector *countersDb) :
+            engine(profile), nameMap(nameMap), reader(countersDb, COUNTERS_TABLE, engine.getCounterNames())
+        {
+        }
+
+        std::string key;
+        CounterRateEngine engine;
+        CounterPublisher publisher;
+        std::string nameMap;
+        // Reads the engine's counter columns of every object
+        CounterReader reader;
+        // The name map as of nameMapVersion, re-read once it changes
+        std::vector<swss::FieldValueTuple> names;
+        uint64_t nameMapVersion = 0;
+        bool namesValid = false;
+        swss::SelectableTimer *timer = nullptr;
+        std::chrono::steady_clock::time_point lastUpdate;
+        // Objects published in the counter snapshot of the name map
+        std::unordered_set<std::string> snapshotObjects;
+        bool enabled = false;
+    };
+
+    void addGroup(const std::string &key, const CounterRateProfile &profile,
+                  const std::string &nameMap, uint32_t intervalMs);
+    void updateRates(RateGroup &group);
+    void updateLineRates(RateGroup &group, const std::vector<swss::FieldValueTuple> &names);
+    void updateSnapshot(RateGroup &group, const std::vector<swss::FieldValueTuple> &names,
+                        const std::vector<uint64_t> &values, const std::vector<uint8_t> &present);
+
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::unique_ptr<swss::RedisPipeline> m_ratesPipe;
+    swss::Table m_ratesTable;
+    std::unique_ptr<swss::Table> m_ratesTableBatch;
+    swss::Table m_appPortTable;
+    std::shared_ptr<swss::DBConnector> m_stateDb;
+    // Publisher mode and totals of each group
+    swss::Table m_publishStatsTable;
+
+    std::map<std::string, RateGroup> m_groups;
+    // Lane count of each port, read from APPL_DB once
+    std::unordered_map<std::string, uint32_t> m_portLanes;
+};
@@ -22,6 +22,7 @@
 #include "dash/dashorch.h"
 #include "dash/dashmeterorch.h"
 #include "flex_counter/flowcounterrouteorch.h"
+#include "flex_counter/counterrateorch.h"
 
 #include "flexcounterorch.h"
 
@@ -35,12 +36,17 @@ extern BufferOrch *gBufferOrch;
 extern Directory<Orch*> gDirectory;
 extern CoppOrch *gCoppOrch;
 extern FlowCounterRouteOrch *gFlowCounterRouteOrch;
+extern CounterRateOrch *gCounterRateOrch;
 extern Srv6Orch *gSrv6Orch;
 extern SwitchOrch *gSwitchOrch;
 extern sai_object_id_t gSwitchId;
 
 #define FLEX_COUNTER_DELAY_SEC 60
 
+// Only for the RATES orchagent publishes, not the counters syncd writes
+#define RATES_PUBLISH_MODE_FIELD          "RATES_PUBLISH_MODE"
+#define RATES_FULL_REFRESH_CYCLES_FIELD   "RATES_FULL_REFRESH_CYCLES"
+
 #define BUFFER_POOL_WATERMARK_KEY   "BUFFER_POOL_WATERMARK"
 #define PORT_KEY                    "PORT"
 #define PORT_BUFFER_DROP_KEY        "PORT_BUFFER_DROP"
@@ -183,6 +189,8 @@ void FlexCounterOrch::doTask(Consumer &consumer)
         {
             string bulk_chunk_size;
             string bulk_chunk_size_per_counter;
+            string rates_publish_mode;
+            string rates_full_refresh_cycles;
 
             for (auto valuePair:data)
             {
@@ -193,6 +201,11 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                 {
                     setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value);
 
+                    if (gCounterRateOrch)
+                    {
+                        gCounterRateOrch->setGroupPollInterval(key, value);
+                    }
+
                     if (gPortsOrch && gPortsOrch->isGearboxEnabled())
                     {
                         if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
@@ -209,6 +222,14 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                 {
                     bulk_chunk_size_per_counter = value;
                 }
+                else if (field == RATES_PUBLISH_MODE_FIELD)
+                {
+                    rates_publish_mode = value;
+                }
+                else if (field == RATES_FULL_REFRESH_CYCLES_FIELD)
+                {
+                    rates_full_refresh_cycles = value;
+                }
                 else if(field == FLEX_COUNTER_STATUS_FIELD)
                 {
                     // Currently, the counters are disabled for polling by default
@@ -325,6 +346,10 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     {
                         gSwitchOrch->generateSwitchCounterIdList();
                     }
+                    if (gCounterRateOrch)
+                    {
+                        gCounterRateOrch->setGroupState(key, (value == "enable"));
+                    }
 
                     if (gPortsOrch)
                     {
@@ -359,6 +384,20 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                 setFlexCounterGroupBulkChunkSize(flexCounterGroupMap[key], "NULL", "NULL");
                 m_groupsWithBulkChunkSize.erase(key);
             }
+
+            if (!rates_publish_mode.empty() || !rates_full_refresh_cycles.empty())
+            {
+                if (gCounterRateOrch && gCounterRateOrch->hasGroup(key))
+                {
+                    gCounterRateOrch->setGroupRatesPublishMode(key, rates_publish_mode, rates_full_refresh_cycles);
+                }
+                else
+                {
+                    // The COUNTERS of the group are written by syncd, which has no such mode
+                    SWSS_LOG_ERROR("%s and %s only apply to the RATES of PORT, RIF, FLOW_CNT_TRAP and TUNNEL, ignored for %s",
+                                   RATES_PUBLISH_MODE_FIELD, RATES_FULL_REFRESH_CYCLES_FIELD, key.c_str());
+                }
+            }
         }
 
         consumer.m_toSync.erase(it++);
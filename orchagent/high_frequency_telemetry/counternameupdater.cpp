@@ -4,21 +4,92 @@
 #include <swss/logger.h>
 #include <sai_serialize.h>
 
+#include <unordered_set>
+
 extern HFTelOrch *gHFTOrch;
 
+static bool g_counterNameMapBatching = false;
+
+static std::unordered_set<CounterNameMapUpdater *> &getUpdaters()
+{
+    static std::unordered_set<CounterNameMapUpdater *> updaters;
+    return updaters;
+}
+
+static std::unordered_map<std::string, uint64_t> &getVersions()
+{
+    static std::unordered_map<std::string, uint64_t> versions;
+    return versions;
+}
+
+void CounterNameMapUpdater::setBatching(bool batching)
+{
+    SWSS_LOG_ENTER();
+
+    if (g_counterNameMapBatching && !batching)
+    {
+        flushAll();
+    }
+    g_counterNameMapBatching = batching;
+}
+
+bool CounterNameMapUpdater::isBatching()
+{
+    return g_counterNameMapBatching;
+}
+
+void CounterNameMapUpdater::flushAll()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto updater : getUpdaters())
+    {
+        updater->flush();
+    }
+}
+
+uint64_t CounterNameMapUpdater::getVersion(const std::string &table_name)
+{
+    auto itr = getVersions().find(table_name);
+    return itr == getVersions().end() ? 0 : itr->second;
+}
+
+void CounterNameMapUpdater::markChanged(const std::string &table_name)
+{
+    getVersions()[table_name]++;
+}
+
 CounterNameMapUpdater::CounterNameMapUpdater(const std::string &db_name, const std::string &table_name)
     : m_db_name(db_name),
       m_table_name(table_name),
       m_connector(m_db_name, 0),
-      m_counters_table(&m_connector, m_table_name)
+      m_counters_table(&m_connector, m_table_name),
+      m_pipe(std::make_unique<swss::RedisPipeline>(&m_connector)),
+      m_counters_table_batch(std::make_unique<swss::Table>(m_pipe.get(), m_table_name, true))
+{
+    SWSS_LOG_ENTER();
+
+    getUpdaters().insert(this);
+}
+
+CounterNameMapUpdater::~CounterNameMapUpdater()
 {
     SWSS_LOG_ENTER();
+
+    // Only destroyed with its orch, the changes still queued are dropped
+    getUpdaters().erase(this);
 }
 
 void CounterNameMapUpdater::setCounterNameMap(const std::string &counter_name, sai_object_id_t oid)
 {
     SWSS_LOG_ENTER();
 
+    if (g_counterNameMapBatching)
+    {
+        queueChange(counter_name, OPERATION::SET, oid);
+        return;
+    }
+
     if (gHFTOrch)
     {
         std::string unified_counter_name = unify_counter_name(counter_name);
@@ -34,13 +105,14 @@ void CounterNameMapUpdater::setCounterNameMap(const std::string &counter_name, s
     }
 
     m_counters_table.hset("", counter_name, sai_serialize_object_id(oid));
+    markChanged(m_table_name);
 }
 
 void CounterNameMapUpdater::setCounterNameMap(const std::vector<swss::FieldValueTuple> &counter_name_maps)
 {
     SWSS_LOG_ENTER();
 
-    if (gHFTOrch)
+    if (gHFTOrch || g_counterNameMapBatching)
     {
         for (const auto& map : counter_name_maps)
         {
@@ -53,12 +125,23 @@ void CounterNameMapUpdater::setCounterNameMap(const std::vector<swss::FieldValue
             setCounterNameMap(counter_name, oid);
         }
     }
+    else
+    {
+        m_counters_table.set("", counter_name_maps);
+        markChanged(m_table_name);
+    }
 }
 
 void CounterNameMapUpdater::delCounterNameMap(const std::string &counter_name)
 {
     SWSS_LOG_ENTER();
 
+    if (g_counterNameMapBatching)
+    {
+        queueChange(counter_name, OPERATION::DEL, SAI_NULL_OBJECT_ID);
+        return;
+    }
+
     if (gHFTOrch)
     {
         std::string unified_counter_name = unify_counter_name(counter_name);
@@ -73,6 +156,94 @@ void CounterNameMapUpdater::delCounterNameMap(const std::string &counter_name)
     }
 
     m_counters_table.hdel("", counter_name);
+    markChanged(m_table_name);
+}
+
+void CounterNameMapUpdater::queueChange(const std::string &counter_name, OPERATION operation, sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto itr = m_pending_changes.find(counter_name);
+    if (itr == m_pending_changes.end())
+    {
+        m_pending_names.push_back(counter_name);
+        m_pending_changes.emplace(counter_name, PendingChange{ operation, oid });
+    }
+    else
+    {
+        itr->second = PendingChange{ operation, oid };
+    }
+}
+
+void CounterNameMapUpdater::flush()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pending_names.empty())
+    {
+        return;
+    }
+
+    std::vector<std::string> pending_names;
+    std::unordered_map<std::string, PendingChange> pending_changes;
+    pending_names.swap(m_pending_names);
+    pending_changes.swap(m_pending_changes);
+
+    std::vector<swss::FieldValueTuple> sets;
+    std::vector<std::string> unified_counter_names;
+    unified_counter_names.reserve(pending_names.size());
+
+    for (const auto &counter_name : pending_names)
+    {
+        const auto &change = pending_changes.at(counter_name);
+        if (change.m_operation == OPERATION::SET)
+        {
+            sets.emplace_back(counter_name, sai_serialize_object_id(change.m_oid));
+        }
+        else
+        {
+            m_counters_table_batch->hdel("", counter_name);
+        }
+
+        if (gHFTOrch)
+        {
+            unified_counter_names.push_back(unify_counter_name(counter_name));
+        }
+    }
+
+    if (!sets.empty())
+    {
+        m_counters_table_batch->set("", sets);
+    }
+    m_pipe->flush();
+    markChanged(m_table_name);
+
+    if (gHFTOrch)
+    {
+        // The names are not moved any more, the messages can point into them
+        std::vector<Message> msgs;
+        msgs.reserve(pending_names.size());
+        for (size_t i = 0; i < pending_names.size(); i++)
+        {
+            const auto &change = pending_changes.at(pending_names[i]);
+            Message msg;
+            msg.m_table_name = m_table_name.c_str();
+            msg.m_operation = change.m_operation;
+            if (change.m_operation == OPERATION::SET)
+            {
+                msg.m_set.m_counter_name = unified_counter_names[i].c_str();
+                msg.m_set.m_oid = change.m_oid;
+            }
+            else
+            {
+                msg.m_del.m_counter_name = unified_counter_names[i].c_str();
+            }
+            msgs.push_back(msg);
+        }
+        gHFTOrch->locallyNotify(msgs);
+    }
+
+    SWSS_LOG_INFO("Flushed %zu changes of the counter name map %s", pending_names.size(), m_table_name.c_str());
 }
 
 std::string CounterNameMapUpdater::unify_counter_name(const std::string &counter_name)
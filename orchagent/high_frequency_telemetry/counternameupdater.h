@@ -1,10 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <swss/rediscommand.h>
+#include <swss/redispipeline.h>
 #include <swss/table.h>
 #include <saitypes.h>
 
@@ -40,18 +42,48 @@ public:
         };
     };
 
+    // When batching, the name map changes are queued until flush(): the
+    // COUNTERS_DB table is written in one pipelined round trip and the high
+    // frequency telemetry is notified once per table. Off by default, the
+    // changes are then applied one by one as they come.
+    static void setBatching(bool batching);
+    static bool isBatching();
+    // Flushes every updater, called once per event loop iteration
+    static void flushAll();
+
+    // Bumped each time changes of a name map table are written to
+    // COUNTERS_DB, so readers can cache the table until it moves. Orchs
+    // writing a name map without an updater report it with markChanged().
+    static uint64_t getVersion(const std::string &table_name);
+    static void markChanged(const std::string &table_name);
+
     CounterNameMapUpdater(const std::string &db_name, const std::string &table_name);
-    ~CounterNameMapUpdater() = default;
+    ~CounterNameMapUpdater();
 
     void setCounterNameMap(const std::string &counter_name, sai_object_id_t oid);
     void setCounterNameMap(const std::vector<swss::FieldValueTuple> &counter_name_maps);
     void delCounterNameMap(const std::string &counter_name);
 
+    void flush();
+
 private:
+    struct PendingChange
+    {
+        OPERATION m_operation;
+        sai_object_id_t m_oid;
+    };
+
     std::string m_db_name;
     std::string m_table_name;
     swss::DBConnector m_connector;
     swss::Table m_counters_table;
+    std::unique_ptr<swss::RedisPipeline> m_pipe;
+    std::unique_ptr<swss::Table> m_counters_table_batch;
+
+    // Names in the order of their first change, the last change of a name wins
+    std::vector<std::string> m_pending_names;
+    std::unordered_map<std::string, PendingChange> m_pending_changes;
 
+    void queueChange(const std::string &counter_name, OPERATION operation, sai_object_id_t oid);
     std::string unify_counter_name(const std::string &counter_name);
 };
@@ -14,11 +14,34 @@ void HFTelGroup::updateObjects(const set<string> &object_names)
 {
     SWSS_LOG_ENTER();
 
-    m_objects.clear();
+    // Objects staying in the group keep their label, so do their counter subscriptions
+    set<sai_uint16_t> labels;
+    for (auto itr = m_objects.begin(); itr != m_objects.end();)
+    {
+        if (object_names.find(itr->first) == object_names.end())
+        {
+            itr = m_objects.erase(itr);
+        }
+        else
+        {
+            labels.insert(itr->second);
+            ++itr;
+        }
+    }
+
     sai_uint16_t lable = 1;
     for (auto &name : object_names)
     {
-        m_objects[name] = lable++;
+        if (m_objects.find(name) != m_objects.end())
+        {
+            continue;
+        }
+        while (labels.find(lable) != labels.end())
+        {
+            lable++;
+        }
+        m_objects[name] = lable;
+        labels.insert(lable);
     }
 }
 
@@ -107,26 +107,55 @@ void HFTelOrch::locallyNotify(const CounterNameMapUpdater::Message &msg)
 {
     SWSS_LOG_ENTER();
 
-    auto counter_itr = HFTelOrch::SUPPORT_COUNTER_TABLES.find(msg.m_table_name);
+    locallyNotify(vector<CounterNameMapUpdater::Message>{ msg });
+}
+
+void HFTelOrch::locallyNotify(const vector<CounterNameMapUpdater::Message> &msgs)
+{
+    SWSS_LOG_ENTER();
+
+    if (msgs.empty())
+    {
+        return;
+    }
+
+    // All messages of a batch come from the same counter table
+    const char *table_name = msgs.front().m_table_name;
+    auto counter_itr = HFTelOrch::SUPPORT_COUNTER_TABLES.find(table_name);
     if (counter_itr == HFTelOrch::SUPPORT_COUNTER_TABLES.end())
     {
-        SWSS_LOG_WARN("The counter table %s is not supported by high frequency telemetry", msg.m_table_name);
+        SWSS_LOG_WARN("The counter table %s is not supported by high frequency telemetry", table_name);
         return;
     }
 
-    SWSS_LOG_NOTICE("The counter table %s is updated, operation %d, object %s",
-                    msg.m_table_name,
-                    msg.m_operation,
-                    msg.m_operation == CounterNameMapUpdater::SET ? msg.m_set.m_counter_name : msg.m_del.m_counter_name);
+    auto counter_name = [](const CounterNameMapUpdater::Message &msg)
+    {
+        return msg.m_operation == CounterNameMapUpdater::SET ? msg.m_set.m_counter_name : msg.m_del.m_counter_name;
+    };
 
-    // Update the local cache
-    if (msg.m_operation == CounterNameMapUpdater::SET)
+    if (msgs.size() == 1)
+    {
+        SWSS_LOG_NOTICE("The counter table %s is updated, operation %d, object %s",
+                        table_name,
+                        msgs.front().m_operation,
+                        counter_name(msgs.front()));
+    }
+    else
     {
-        m_counter_name_cache[counter_itr->second][msg.m_set.m_counter_name] = msg.m_set.m_oid;
+        SWSS_LOG_NOTICE("The counter table %s is updated, %zu objects", table_name, msgs.size());
     }
-    else if (msg.m_operation == CounterNameMapUpdater::DEL)
+
+    // Update the local cache
+    for (const auto &msg : msgs)
     {
-        m_counter_name_cache[counter_itr->second].erase(msg.m_del.m_counter_name);
+        if (msg.m_operation == CounterNameMapUpdater::SET)
+        {
+            m_counter_name_cache[counter_itr->second][msg.m_set.m_counter_name] = msg.m_set.m_oid;
+        }
+        else if (msg.m_operation == CounterNameMapUpdater::DEL)
+        {
+            m_counter_name_cache[counter_itr->second].erase(msg.m_del.m_counter_name);
+        }
     }
 
     // Update the profile
@@ -138,29 +167,32 @@ void HFTelOrch::locallyNotify(const CounterNameMapUpdater::Message &msg)
     for (auto profile_itr = type_itr->second.begin(); profile_itr != type_itr->second.end(); profile_itr++)
     {
         auto profile = *profile_itr;
-        const char *counter_name = msg.m_operation == CounterNameMapUpdater::SET ? msg.m_set.m_counter_name : msg.m_del.m_counter_name;
 
         if (!profile->canBeUpdated(counter_itr->second))
         {
             // TODO: Here is a potential issue, we might need to retry the task.
             // Because the Syncd is generating the configuration(template),
             // we cannot update the monitor objects at this time.
-            SWSS_LOG_WARN("The high frequency telemetry profile %s is not ready to be updated, but the object %s want to be updated", profile->getProfileName().c_str(), counter_name);
+            SWSS_LOG_WARN("The high frequency telemetry profile %s is not ready to be updated, but %zu objects want to be updated", profile->getProfileName().c_str(), msgs.size());
             continue;
         }
 
-        if (msg.m_operation == CounterNameMapUpdater::SET)
-        {
-            profile->setObjectSAIID(counter_itr->second, counter_name, msg.m_set.m_oid);
-        }
-        else if (msg.m_operation == CounterNameMapUpdater::DEL)
+        for (const auto &msg : msgs)
         {
-            profile->delObjectSAIID(counter_itr->second, counter_name);
-        }
-        else
-        {
-            SWSS_LOG_THROW("Unknown operation type %d", msg.m_operation);
+            if (msg.m_operation == CounterNameMapUpdater::SET)
+            {
+                profile->setObjectSAIID(counter_itr->second, msg.m_set.m_counter_name, msg.m_set.m_oid);
+            }
+            else if (msg.m_operation == CounterNameMapUpdater::DEL)
+            {
+                profile->delObjectSAIID(counter_itr->second, msg.m_del.m_counter_name);
+            }
+            else
+            {
+                SWSS_LOG_THROW("Unknown operation type %d", msg.m_operation);
+            }
         }
+        // The configuration is committed once for the whole batch
         profile->tryCommitConfig(counter_itr->second);
     }
 }
@@ -275,14 +307,7 @@ task_process_status HFTelOrch::groupTableSet(const std::string &profile_name, co
         profile->setStatsIDs(group_name, object_counters);
     }
 
-    if (profile->getStreamState(type) != SAI_TAM_TEL_TYPE_STATE_STOP_STREAM)
-    {
-        SWSS_LOG_WARN("The high frequency telemetry group %s:%s is not in the stop stream state, it means no new configuration needs to be applied",
-                    profile_name.c_str(),
-                    group_name.c_str());
-        return task_process_status::task_success;
-    }
-
+    // A streaming group regenerates its templates only if its subscriptions changed
     profile->tryCommitConfig(type);
 
     m_type_profile_mapping[type].insert(profile);
@@ -427,6 +452,11 @@ void HFTelOrch::doTask(swss::NotificationConsumer &consumer)
         auto templates = profile.second->getTemplates(type);
         values.emplace_back("session_config", string(templates.begin(), templates.end()));
 
+        auto reconfig = profile.second->getReconfigStats(type);
+        values.emplace_back("reconfig_count", std::to_string(reconfig.count));
+        values.emplace_back("last_reconfig_time_us", std::to_string(reconfig.last_reconfig_us));
+        values.emplace_back("last_stream_gap_us", std::to_string(reconfig.last_stream_gap_us));
+
         m_state_telemetry_session.set(profile.first + "|" + HFTelUtils::sai_type_to_group_name(type), values);
 
         SWSS_LOG_NOTICE("The high frequency telemetry group %s with profile %s is ready",
@@ -29,6 +29,8 @@ public:
     static const std::unordered_map<std::string, sai_object_type_t> SUPPORT_COUNTER_TABLES;
 
     void locallyNotify(const CounterNameMapUpdater::Message &msg);
+    // One update of the profiles for all changes of a counter table
+    void locallyNotify(const std::vector<CounterNameMapUpdater::Message> &msgs);
     static bool isSupportedHFTel(sai_object_id_t switch_id);
 
 private:
@@ -9,6 +9,9 @@
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 using namespace std;
 using namespace swss;
 
@@ -58,6 +61,15 @@ void HFTelProfile::setStreamState(sai_tam_tel_type_state_t state)
     SWSS_LOG_ENTER();
     m_setting_state = state;
 
+    if (state == SAI_TAM_TEL_TYPE_STATE_STOP_STREAM)
+    {
+        // Stopped on purpose, not a gap of a reconfiguration
+        for (auto &reconfig : m_reconfigs)
+        {
+            reconfig.second.stream_stopped = false;
+        }
+    }
+
     for (const auto &item : m_sai_tam_tel_type_objs)
     {
         setStreamState(item.first, state);
@@ -123,8 +135,30 @@ void HFTelProfile::setStreamState(sai_object_type_t type, sai_tam_tel_type_state
             }
             else if (state == SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG)
             {
-                // TODO: Implement the transition from started to config generating in Phase2
-                SWSS_LOG_THROW("Transfer from start to create config hasn't been implemented yet");
+                if (!isMonitoringObjectReady(type))
+                {
+                    return;
+                }
+                // The stream goes on with the current templates until the new ones are read.
+                // The SAI TAM state machine only documents STOP_STREAM -> CREATE_CONFIG,
+                // a SAI rejecting this transition gets the stream stopped first.
+                sai_attribute_t attr;
+                attr.id = SAI_TAM_TEL_TYPE_ATTR_STATE;
+                attr.value.s32 = state;
+                if (sai_tam_api->set_tam_tel_type_attribute(*type_itr->second, &attr) == SAI_STATUS_SUCCESS)
+                {
+                    stats->second = state;
+                    return;
+                }
+
+                SWSS_LOG_NOTICE("The high frequency telemetry profile %s stops the stream of %s to apply the configuration",
+                                m_profile_name.c_str(),
+                                sai_serialize_object_type(type).c_str());
+                auto &reconfig = m_reconfigs[type];
+                reconfig.stream_stopped = true;
+                reconfig.stream_stopped_at = chrono::steady_clock::now();
+                setStreamState(type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
+                m_sai_tam_tel_type_templates.erase(type);
             }
             else
             {
@@ -161,6 +195,14 @@ void HFTelProfile::setStreamState(sai_object_type_t type, sai_tam_tel_type_state
         }
 
         stats->second = state;
+
+        auto reconfig = m_reconfigs.find(type);
+        if (state == SAI_TAM_TEL_TYPE_STATE_START_STREAM && reconfig != m_reconfigs.end() && reconfig->second.stream_stopped)
+        {
+            auto gap = chrono::steady_clock::now() - reconfig->second.stream_stopped_at;
+            reconfig->second.stats.last_stream_gap_us = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(gap).count());
+            reconfig->second.stream_stopped = false;
+        }
         return;
 
     } while(false);
@@ -195,6 +237,23 @@ void HFTelProfile::notifyConfigReady(sai_object_type_t object_type)
     }
 
     updateTemplates(*itr->second);
+
+    auto &reconfig = m_reconfigs[object_type];
+    if (reconfig.pending)
+    {
+        auto elapsed = chrono::steady_clock::now() - reconfig.changed_at;
+        reconfig.stats.count++;
+        reconfig.stats.last_reconfig_us = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(elapsed).count());
+        // Set when the stream is started again if it was stopped
+        reconfig.stats.last_stream_gap_us = 0;
+        reconfig.pending = false;
+
+        SWSS_LOG_NOTICE("The high frequency telemetry profile %s applied the configuration of %s in %" PRIu64 " us",
+                        m_profile_name.c_str(),
+                        sai_serialize_object_type(object_type).c_str(),
+                        reconfig.stats.last_reconfig_us);
+    }
+
     setStreamState(object_type, m_setting_state);
 }
 
@@ -292,16 +351,19 @@ void HFTelProfile::setObjectNames(const string &group_name, set<string> &&object
         {
             return;
         }
+        // Only the objects leaving the group lose their counter subscriptions
         for (const auto &obj : itr->second.getObjects())
         {
-            delObjectSAIID(sai_object_type, obj.first.c_str());
+            if (object_names.find(obj.first) == object_names.end())
+            {
+                removeObjectSAIID(sai_object_type, obj.first);
+            }
         }
         itr->second.updateObjects(object_names);
     }
-    loadCounterNameCache(sai_object_type);
 
-    // TODO: In the phase 2, we don't need to stop the stream before update the object names
-    setStreamState(sai_object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
+    // The objects joining the group get theirs, the stream goes on
+    loadCounterNameCache(sai_object_type);
 }
 
 void HFTelProfile::setStatsIDs(const string &group_name, const set<string> &object_counters)
@@ -324,12 +386,18 @@ void HFTelProfile::setStatsIDs(const string &group_name, const set<string> &obje
         {
             return;
         }
+
+        // Only the counters leaving the group are unsubscribed
+        set<sai_stat_id_t> removed_stats_ids;
+        set_difference(
+            itr->second.getStatsIDs().begin(), itr->second.getStatsIDs().end(),
+            stats_ids_set.begin(), stats_ids_set.end(),
+            inserter(removed_stats_ids, removed_stats_ids.end()));
+        undeployCounterSubscriptions(sai_object_type, removed_stats_ids);
+
         itr->second.updateStatsIDs(stats_ids_set);
     }
 
-    // TODO: In the phase 2, we don't need to stop the stream before update the stats
-    setStreamState(sai_object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
-
     deployCounterSubscriptions(sai_object_type);
 }
 
@@ -350,15 +418,14 @@ void HFTelProfile::setObjectSAIID(sai_object_type_t object_type, const char *obj
         {
             return;
         }
+        // The subscriptions of the previous object are gone with it
+        removeObjectSAIID(object_type, object_name);
     }
-    objs[object_name] = object_id;
+    m_name_sai_map[object_type][object_name] = object_id;
 
     SWSS_LOG_DEBUG("Set object %s with ID %s in the name sai map", object_name, sai_serialize_object_id(object_id).c_str());
 
-    // TODO: In the phase 2, we don't need to stop the stream before update the object
-    setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
-
-    // Update the counter subscription
+    // Update the counter subscription, the stream goes on
     deployCounterSubscriptions(object_type, object_id, m_groups.at(object_type).getObjects().at(object_name));
 }
 
@@ -371,32 +438,58 @@ void HFTelProfile::delObjectSAIID(sai_object_type_t object_type, const char *obj
         return;
     }
 
-    auto &objs = m_name_sai_map[object_type];
-    auto itr = objs.find(object_name);
-    if (itr == objs.end())
+    auto objs = m_name_sai_map.find(object_type);
+    if (objs == m_name_sai_map.end() || objs->second.find(object_name) == objs->second.end())
     {
         return;
     }
 
-    // TODO: In the phase 2, we don't need to stop the stream before removing the object
+    // The object is still in the group, no templates can be generated until it is back
+    if (getStreamState(object_type) == SAI_TAM_TEL_TYPE_STATE_START_STREAM)
+    {
+        auto &reconfig = m_reconfigs[object_type];
+        reconfig.stream_stopped = true;
+        reconfig.stream_stopped_at = chrono::steady_clock::now();
+    }
     setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
 
+    removeObjectSAIID(object_type, object_name);
+}
+
+void HFTelProfile::removeObjectSAIID(sai_object_type_t object_type, const string &object_name)
+{
+    SWSS_LOG_ENTER();
+
+    auto objs = m_name_sai_map.find(object_type);
+    if (objs == m_name_sai_map.end())
+    {
+        return;
+    }
+    auto itr = objs->second.find(object_name);
+    if (itr == objs->second.end())
+    {
+        return;
+    }
+
     // Remove all counters bounded to the object
     auto counter_itr = m_sai_tam_counter_subscription_objs.find(object_type);
     if (counter_itr != m_sai_tam_counter_subscription_objs.end())
     {
-        counter_itr->second.erase(itr->second);
+        if (counter_itr->second.erase(itr->second))
+        {
+            markConfigChanged(object_type);
+        }
         if (counter_itr->second.empty())
         {
             m_sai_tam_counter_subscription_objs.erase(counter_itr);
         }
     }
 
-    objs.erase(itr);
-    if (objs.empty())
+    objs->second.erase(itr);
+    SWSS_LOG_DEBUG("Delete object %s from the name sai map", object_name.c_str());
+    if (objs->second.empty())
     {
-        m_name_sai_map.erase(object_type);
-        SWSS_LOG_DEBUG("Delete object %s from the name sai map", object_name);
+        m_name_sai_map.erase(objs);
     }
 }
 
@@ -456,6 +549,7 @@ void HFTelProfile::clearGroup(const std::string &group_name)
     m_sai_tam_report_objs.erase(sai_object_type);
     m_sai_tam_counter_subscription_objs.erase(sai_object_type);
     m_name_sai_map.erase(sai_object_type);
+    m_reconfigs.erase(sai_object_type);
 
     SWSS_LOG_NOTICE("Cleared high frequency telemetry group %s with no objects", group_name.c_str());
 }
@@ -526,6 +620,19 @@ vector<sai_object_type_t> HFTelProfile::getObjectTypes() const
     return types;
 }
 
+HFTelProfile::ReconfigStats HFTelProfile::getReconfigStats(sai_object_type_t object_type) const
+{
+    SWSS_LOG_ENTER();
+
+    auto itr = m_reconfigs.find(object_type);
+    if (itr == m_reconfigs.end())
+    {
+        return ReconfigStats();
+    }
+
+    return itr->second.stats;
+}
+
 void HFTelProfile::loadCounterNameCache(sai_object_type_t object_type)
 {
     SWSS_LOG_ENTER();
@@ -584,6 +691,15 @@ bool HFTelProfile::tryCommitConfig(sai_object_type_t object_type)
             return false;
         }
     }
+    if (getStreamState(object_type) == SAI_TAM_TEL_TYPE_STATE_START_STREAM)
+    {
+        auto reconfig = m_reconfigs.find(object_type);
+        if (reconfig == m_reconfigs.end() || !reconfig->second.pending)
+        {
+            // The stream already runs with the current counter subscriptions
+            return true;
+        }
+    }
     setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG);
     return true;
 }
@@ -626,6 +742,18 @@ bool HFTelProfile::isMonitoringObjectReady(sai_object_type_t object_type) const
     return true;
 }
 
+void HFTelProfile::markConfigChanged(sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
+
+    auto &reconfig = m_reconfigs[object_type];
+    if (!reconfig.pending)
+    {
+        reconfig.pending = true;
+        reconfig.changed_at = chrono::steady_clock::now();
+    }
+}
+
 sai_object_id_t HFTelProfile::getTAMReportObjID(sai_object_type_t object_type)
 {
     SWSS_LOG_ENTER();
@@ -876,6 +1004,8 @@ void HFTelProfile::deployCounterSubscription(sai_object_type_t object_type, sai_
                     sai_tam_api->remove_tam_counter_subscription(*p));
                 delete p;
             }));
+
+    markConfigChanged(object_type);
 }
 
 void HFTelProfile::deployCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj, std::uint16_t label)
@@ -928,6 +1058,29 @@ void HFTelProfile::undeployCounterSubscriptions(sai_object_type_t object_type)
     m_sai_tam_counter_subscription_objs.erase(object_type);
 }
 
+void HFTelProfile::undeployCounterSubscriptions(sai_object_type_t object_type, const set<sai_stat_id_t> &stats_ids)
+{
+    SWSS_LOG_ENTER();
+
+    auto counters = m_sai_tam_counter_subscription_objs.find(object_type);
+    if (counters == m_sai_tam_counter_subscription_objs.end())
+    {
+        return;
+    }
+
+    // The subscriptions of the other counters stay as they are
+    for (auto &obj : counters->second)
+    {
+        for (const auto &stat_id : stats_ids)
+        {
+            if (obj.second.erase(stat_id))
+            {
+                markConfigChanged(object_type);
+            }
+        }
+    }
+}
+
 void HFTelProfile::updateTemplates(sai_object_id_t tam_tel_type_obj)
 {
     SWSS_LOG_ENTER();
@@ -5,6 +5,7 @@
 #include <swss/table.h>
 
 #include <string>
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <unordered_map>
@@ -34,6 +35,16 @@ public:
 
     using sai_guard_t = std::shared_ptr<sai_object_id_t>;
 
+    struct ReconfigStats
+    {
+        // Configurations applied, each one ends with new templates
+        std::uint64_t count = 0;
+        // From the first counter subscription change to the new templates
+        std::uint64_t last_reconfig_us = 0;
+        // Time the stream was stopped for the last one, 0 if it kept running
+        std::uint64_t last_stream_gap_us = 0;
+    };
+
     const std::string& getProfileName() const;
     void setStreamState(sai_tam_tel_type_state_t state);
     void setStreamState(sai_object_type_t object_type, sai_tam_tel_type_state_t state);
@@ -58,6 +69,7 @@ public:
     const std::vector<std::uint16_t> getObjectLabels(sai_object_type_t object_type) const;
     std::pair<std::vector<std::string>, std::vector<std::string>> getObjectNamesAndLabels(sai_object_type_t object_type) const;
     std::vector<sai_object_type_t> getObjectTypes() const;
+    ReconfigStats getReconfigStats(sai_object_type_t object_type) const;
 
     void loadCounterNameCache(sai_object_type_t object_type);
     bool tryCommitConfig(sai_object_type_t object_type);
@@ -96,8 +108,22 @@ private:
     std::unordered_map<sai_object_type_t, sai_guard_t> m_sai_tam_report_objs;
     std::unordered_map<sai_object_type_t, std::vector<std::uint8_t>> m_sai_tam_tel_type_templates;
 
+    struct Reconfig
+    {
+        ReconfigStats stats;
+        // The counter subscriptions changed since the templates were read
+        bool pending = false;
+        std::chrono::steady_clock::time_point changed_at;
+        // The stream was stopped until the objects are ready again
+        bool stream_stopped = false;
+        std::chrono::steady_clock::time_point stream_stopped_at;
+    };
+    std::unordered_map<sai_object_type_t, Reconfig> m_reconfigs;
+
     bool isObjectTypeInProfile(sai_object_type_t object_type, const std::string &object_name) const;
     bool isMonitoringObjectReady(sai_object_type_t object_type) const;
+    void markConfigChanged(sai_object_type_t object_type);
+    void removeObjectSAIID(sai_object_type_t object_type, const std::string &object_name);
 
     // SAI calls
     sai_object_id_t getTAMReportObjID(sai_object_type_t object_type);
@@ -107,5 +133,6 @@ private:
     void deployCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj, std::uint16_t label);
     void deployCounterSubscriptions(sai_object_type_t object_type);
     void undeployCounterSubscriptions(sai_object_type_t object_type);
+    void undeployCounterSubscriptions(sai_object_type_t object_type, const std::set<sai_stat_id_t> &stats_ids);
     void updateTemplates(sai_object_id_t tam_tel_type_obj);
 };
@@ -79,24 +79,10 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
 
-    string rifRatePluginName = "rif_rates.lua";
-    string rifRateSha;
-
-    try
-    {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
-    }
-
+    // RIF rates are computed by CounterRateOrch
     setFlexCounterGroupParameter(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  RIF_FLEX_STAT_COUNTER_POLL_MSECS,
-                                 STATS_MODE_READ,
-                                 RIF_PLUGIN_FIELD,
-                                 rifRateSha);
+                                 STATS_MODE_READ);
 
     if(gMySwitchType == "voq")
     {
@@ -1535,6 +1521,7 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
 
     m_rifNameTable->set("", rifNameVector);
     m_rifTypeTable->set("", rifTypeVector);
+    CounterNameMapUpdater::markChanged(COUNTERS_RIF_NAME_MAP);
 
     /* update RIF in FLEX_COUNTER_DB */
     string key = getRifFlexCounterTableKey(id);
@@ -1558,6 +1545,7 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     /* remove it from COUNTERS_DB maps */
     m_rifNameTable->hdel("", name);
     m_rifTypeTable->hdel("", id);
+    CounterNameMapUpdater::markChanged(COUNTERS_RIF_NAME_MAP);
 
     /* remove it from FLEX_COUNTER_DB */
     string key = getRifFlexCounterTableKey(id);
@@ -273,7 +273,7 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
 
     if (ctx.bulk_op)
     {
-        gNextHopBulker.create_entry(&ctx.next_hop_id , (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+        gNextHopBulker.create_entry(&ctx.next_hop_id, &ctx.nexthop_status, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
         return true;
     }
 
@@ -371,13 +371,19 @@ bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
     NextHopKey nexthop(nh);
     if (ctx.next_hop_id == SAI_NULL_OBJECT_ID)
     {
-        sai_status_t bulker_status = gNextHopBulker.create_status(ctx.next_hop_id);
+        sai_status_t bulker_status = ctx.nexthop_status;
         if (bulker_status == SAI_STATUS_ITEM_ALREADY_EXISTS)
         {
             SWSS_LOG_NOTICE("Next hop %s on %s already exists",
                         nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
             return true;
         }
+        if (bulker_status == SAI_STATUS_NOT_EXECUTED)
+        {
+            SWSS_LOG_INFO("Next hop %s on %s not created by bulk, retrying",
+                        nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
+            return false;
+        }
         SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
                        nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str(), bulker_status);
         task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP, bulker_status);
@@ -728,12 +734,13 @@ bool NeighOrch::removeOverlayNextHop(const NextHopKey &nexthop)
 
 sai_object_id_t NeighOrch::getLocalNextHopId(const NextHopKey& nexthop)
 {
-    if (m_syncdNextHops.find(nexthop) == m_syncdNextHops.end())
+    auto nhop = m_syncdNextHops.find(nexthop);
+    if (nhop == m_syncdNextHops.end())
     {
         return SAI_NULL_OBJECT_ID;
     }
 
-    return m_syncdNextHops[nexthop].next_hop_id;
+    return nhop->second.next_hop_id;
 }
 
 sai_object_id_t NeighOrch::getNextHopId(const NextHopKey &nexthop)
@@ -763,26 +770,28 @@ int NeighOrch::getNextHopRefCount(const NextHopKey &nexthop)
 void NeighOrch::increaseNextHopRefCount(const NextHopKey &nexthop, uint32_t count)
 {
     assert(hasNextHop(nexthop));
-    if (m_syncdNextHops.find(nexthop) != m_syncdNextHops.end())
+    auto nhop = m_syncdNextHops.find(nexthop);
+    if (nhop != m_syncdNextHops.end())
     {
-        m_syncdNextHops[nexthop].ref_count += count;
+        nhop->second.ref_count += count;
     }
 }
 
 void NeighOrch::decreaseNextHopRefCount(const NextHopKey &nexthop, uint32_t count)
 {
     assert(hasNextHop(nexthop));
-    if (m_syncdNextHops.find(nexthop) != m_syncdNextHops.end())
+    auto nhop = m_syncdNextHops.find(nexthop);
+    if (nhop != m_syncdNextHops.end())
     {
-        if ((m_syncdNextHops[nexthop].ref_count - (int)count) < 0)
+        if ((nhop->second.ref_count - (int)count) < 0)
         {
             SWSS_LOG_ERROR("Ref count cannot be negative for next_hop_id: 0x%" PRIx64 " with ip: %s and alias: %s",
-                   m_syncdNextHops[nexthop].next_hop_id, nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
+                   nhop->second.next_hop_id, nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
             // Reset refcount to 0 to match expected value
-            m_syncdNextHops[nexthop].ref_count = 0;
+            nhop->second.ref_count = 0;
             return;
         }
-        m_syncdNextHops[nexthop].ref_count -= count;
+        nhop->second.ref_count -= count;
     }
 }
 
@@ -799,6 +808,19 @@ bool NeighOrch::getNeighborEntry(const NextHopKey &nexthop, NeighborEntry &neigh
         gPortsOrch->getInbandPort(inbp);
         assert(inbp.m_alias.length());
     }
+    else
+    {
+        /* Without remote system ports the neighbor is keyed on the next hop's IP and alias */
+        auto nbr = m_syncdNeighbors.find(NeighborEntry(nexthop.ip_address, nexthop.alias));
+        if (nbr == m_syncdNeighbors.end())
+        {
+            return false;
+        }
+
+        neighborEntry = nbr->first;
+        macAddress = nbr->second.mac;
+        return true;
+    }
 
     for (const auto &entry : m_syncdNeighbors)
     {
@@ -853,6 +875,24 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    /*
+     * Neighbors and their next hops are created and removed through the bulkers.
+     * All DEL operations are processed ahead of all SET operations, so a DEL still
+     * runs before a SET for the same neighbor, and each bulk only creates or only
+     * removes objects.
+     */
+    doNeighborTask(consumer, DEL_COMMAND);
+    doNeighborTask(consumer, SET_COMMAND);
+}
+
+void NeighOrch::doNeighborTask(Consumer &consumer, const string &pass_op)
+{
+    SWSS_LOG_ENTER();
+
+    std::list<NeighborContext> bulk_ctx_list;
+    std::vector<SyncMap::iterator> bulk_tasks;
+    std::set<IpAddress> bulk_ips;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -861,6 +901,13 @@ void NeighOrch::doTask(Consumer &consumer)
         string key = kfvKey(t);
         string op = kfvOp(t);
 
+        /* Unknown operations are dropped in the DEL pass */
+        if ((op == SET_COMMAND) != (pass_op == SET_COMMAND))
+        {
+            it++;
+            continue;
+        }
+
         size_t found = key.find(':');
         if (found == string::npos)
         {
@@ -897,7 +944,18 @@ void NeighOrch::doTask(Consumer &consumer)
 
         NeighborEntry neighbor_entry = { ip_address, alias };
 
-        NeighborContext ctx = NeighborContext(neighbor_entry);
+        /*
+         * An IP address may only have one pending bulk operation, as adding a
+         * neighbor removes the same IP address learned on another VLAN, and that
+         * relies on the state left by the pending operation.
+         */
+        if (bulk_ips.find(ip_address) != bulk_ips.end())
+        {
+            processNeighborTasks(consumer, bulk_ctx_list, bulk_tasks);
+            bulk_ips.clear();
+        }
+
+        NeighborContext ctx = NeighborContext(neighbor_entry, true);
 
         if (op == SET_COMMAND)
         {
@@ -954,14 +1012,29 @@ void NeighOrch::doTask(Consumer &consumer)
                         it = consumer.m_toSync.erase(it);
                     }
                 }
-                else if (addNeighbor(ctx))
-                {
-                    it = consumer.m_toSync.erase(it);
-                }
                 else
                 {
-                    it++;
-                    continue;
+                    /* The bulkers keep pointers into the context, so it is built in place */
+                    bulk_ctx_list.push_back(ctx);
+                    NeighborContext &bulk_ctx = bulk_ctx_list.back();
+
+                    if (!addNeighbor(bulk_ctx))
+                    {
+                        bulk_ctx_list.pop_back();
+                        it++;
+                        continue;
+                    }
+
+                    if (!bulk_ctx.object_statuses.empty())
+                    {
+                        /* Queued to the bulkers, completed in processNeighborTasks */
+                        bulk_tasks.push_back(it++);
+                        bulk_ips.insert(ip_address);
+                        continue;
+                    }
+
+                    bulk_ctx_list.pop_back();
+                    it = consumer.m_toSync.erase(it);
                 }
             }
             else
@@ -985,13 +1058,23 @@ void NeighOrch::doTask(Consumer &consumer)
         {
             if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
             {
-                if (removeNeighbor(ctx))
+                bulk_ctx_list.push_back(ctx);
+                NeighborContext &bulk_ctx = bulk_ctx_list.back();
+
+                if (!removeNeighbor(bulk_ctx))
                 {
-                    it = consumer.m_toSync.erase(it);
+                    bulk_ctx_list.pop_back();
+                    it++;
+                }
+                else if (!bulk_ctx.object_statuses.empty())
+                {
+                    bulk_tasks.push_back(it++);
+                    bulk_ips.insert(ip_address);
                 }
                 else
                 {
-                    it++;
+                    bulk_ctx_list.pop_back();
+                    it = consumer.m_toSync.erase(it);
                 }
             }
             else
@@ -1004,6 +1087,65 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    processNeighborTasks(consumer, bulk_ctx_list, bulk_tasks);
+}
+
+/* Flush the bulkers and complete or keep for retry the queued neighbor tasks */
+void NeighOrch::processNeighborTasks(Consumer &consumer, std::list<NeighborContext>& bulk_ctx_list,
+                                     std::vector<SyncMap::iterator>& bulk_tasks)
+{
+    SWSS_LOG_ENTER();
+
+    if (bulk_ctx_list.empty())
+    {
+        return;
+    }
+
+    bool removal = (kfvOp(bulk_tasks.front()->second) != SET_COMMAND);
+
+    if (removal)
+    {
+        flushBulkRemoveNeighbors(bulk_ctx_list);
+    }
+    else
+    {
+        flushBulkAddNeighbors(bulk_ctx_list);
+    }
+
+    auto task = bulk_tasks.begin();
+    for (auto ctx = bulk_ctx_list.begin(); ctx != bulk_ctx_list.end(); ctx++, task++)
+    {
+        auto it = *task;
+        string key = kfvKey(it->second);
+
+        if (removal)
+        {
+            if (processBulkRemoveNeighbor(*ctx))
+            {
+                consumer.m_toSync.erase(it);
+            }
+            continue;
+        }
+
+        if (!processBulkEnableNeighbor(*ctx))
+        {
+            continue;
+        }
+
+        it = consumer.m_toSync.erase(it);
+
+        /* Same as for a synchronous SET, drop the failed DEL operations left before it */
+        auto rit = make_reverse_iterator(it);
+        while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        {
+            consumer.m_toSync.erase(next(rit).base());
+            SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+        }
+    }
+
+    bulk_ctx_list.clear();
+    bulk_tasks.clear();
 }
 
 bool NeighOrch::addNeighbor(NeighborContext& ctx)
@@ -1113,9 +1255,12 @@ bool NeighOrch::addNeighbor(NeighborContext& ctx)
         if (bulk_op)
         {
             SWSS_LOG_INFO("Adding neighbor entry %s on %s to bulker.", ip_address.to_string().c_str(), alias.c_str());
+            if (!addNextHop(ctx))
+            {
+                return false;
+            }
             object_statuses.emplace_back();
             gNeighBulker.create_entry(&object_statuses.back(), &neighbor_entry, (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
-            addNextHop(ctx);
             return true;
         }
 
@@ -1410,6 +1555,13 @@ bool NeighOrch::processBulkEnableNeighbor(NeighborContext& ctx)
                            macAddress.to_string().c_str(), alias.c_str(), sai_serialize_status(status).c_str());
                 return true;
             }
+            else if (status == SAI_STATUS_NOT_EXECUTED)
+            {
+                /* Another entry failed first in the bulk, retry */
+                SWSS_LOG_INFO("Neighbor %s on %s not created by bulk, retrying",
+                           macAddress.to_string().c_str(), alias.c_str());
+                return false;
+            }
             else
             {
                 SWSS_LOG_ERROR("Failed to create neighbor %s on %s, status:%s",
@@ -1469,11 +1621,23 @@ bool NeighOrch::processBulkEnableNeighbor(NeighborContext& ctx)
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
 
+    if(gMySwitchType == "voq")
+    {
+        //Sync the neighbor to add to the CHASSIS_APP_DB
+        voqSyncAddNeigh(alias, ip_address, macAddress, neighbor_entry);
+    }
+
     return true;
 }
 
 /* Process bulk ctx entry and disable the neigbor */
 bool NeighOrch::processBulkDisableNeighbor(NeighborContext& ctx)
+{
+    return processBulkRemoveNeighbor(ctx, true);
+}
+
+/* Process bulk ctx entry and remove the neigbor, or only disable it */
+bool NeighOrch::processBulkRemoveNeighbor(NeighborContext& ctx, bool disable)
 {
     SWSS_LOG_ENTER();
 
@@ -1509,6 +1673,13 @@ bool NeighOrch::processBulkDisableNeighbor(NeighborContext& ctx)
                 SWSS_LOG_NOTICE("Next hop %s on %s doesn't exist, rv:%d",
                                ip_address.to_string().c_str(), alias.c_str(), ctx.nexthop_status);
             }
+            else if (ctx.nexthop_status == SAI_STATUS_NOT_EXECUTED)
+            {
+                /* Another entry failed first in the bulk, retry */
+                SWSS_LOG_INFO("Next hop %s on %s not removed by bulk, retrying",
+                               ip_address.to_string().c_str(), alias.c_str());
+                return false;
+            }
             else
             {
                 SWSS_LOG_ERROR("Failed to remove next hop %s on %s, rv:%d",
@@ -1543,6 +1714,13 @@ bool NeighOrch::processBulkDisableNeighbor(NeighborContext& ctx)
                 SWSS_LOG_NOTICE("Bulk remove entry skipped, neighbor %s on %s already removed, rv:%d",
                         m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str(), status);
             }
+            else if (status == SAI_STATUS_NOT_EXECUTED)
+            {
+                /* Another entry failed first in the bulk, retry */
+                SWSS_LOG_INFO("Neighbor %s on %s not removed by bulk, retrying",
+                        m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str());
+                return false;
+            }
             else
             {
                 SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
@@ -1573,10 +1751,75 @@ bool NeighOrch::processBulkDisableNeighbor(NeighborContext& ctx)
     }
 
     /* Do not delete entry from cache for disable request */
-    m_syncdNeighbors[neighborEntry].hw_configured = false;
+    if (disable)
+    {
+        m_syncdNeighbors[neighborEntry].hw_configured = false;
+        return true;
+    }
+
+    m_syncdNeighbors.erase(neighborEntry);
+
+    NeighborUpdate update = { neighborEntry, MacAddress(), false };
+    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+    if(gMySwitchType == "voq")
+    {
+        //Sync the neighbor to delete from the CHASSIS_APP_DB
+        voqSyncDelNeigh(alias, ip_address);
+    }
+
     return true;
 }
 
+/*
+ * Flush queued neighbor and next hop creations. Neighbors are created first,
+ * and the next hop of a neighbor that failed is left out of the bulk.
+ */
+void NeighOrch::flushBulkAddNeighbors(std::list<NeighborContext>& bulk_ctx_list)
+{
+    gNeighBulker.flush();
+
+    for (auto& ctx : bulk_ctx_list)
+    {
+        if (ctx.object_statuses.empty() || ctx.nexthop_status != SAI_STATUS_NOT_EXECUTED)
+        {
+            continue;
+        }
+
+        sai_status_t status = ctx.object_statuses.front();
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            ctx.nexthop_status = (status == SAI_STATUS_NOT_EXECUTED) ? SAI_STATUS_FAILURE : status;
+        }
+    }
+
+    gNextHopBulker.flush();
+}
+
+/*
+ * Flush queued next hop and neighbor removals. Next hops are removed first,
+ * and a neighbor whose next hop is still in place is left out of the bulk.
+ */
+void NeighOrch::flushBulkRemoveNeighbors(std::list<NeighborContext>& bulk_ctx_list)
+{
+    gNextHopBulker.flush();
+
+    for (auto& ctx : bulk_ctx_list)
+    {
+        if (ctx.object_statuses.empty() || ctx.object_statuses.back() != SAI_STATUS_NOT_EXECUTED)
+        {
+            continue;
+        }
+
+        if (ctx.nexthop_status != SAI_STATUS_SUCCESS && ctx.nexthop_status != SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            ctx.object_statuses.back() = SAI_STATUS_OBJECT_IN_USE;
+        }
+    }
+
+    gNeighBulker.flush();
+}
+
 bool NeighOrch::isHwConfigured(const NeighborEntry& neighborEntry)
 {
     if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
@@ -1662,8 +1905,7 @@ bool NeighOrch::enableNeighbors(std::list<NeighborContext>& bulk_ctx_list)
         }
     }
 
-    gNeighBulker.flush();
-    gNextHopBulker.flush();
+    flushBulkAddNeighbors(bulk_ctx_list);
 
     for (auto ctx = bulk_ctx_list.begin(); ctx != bulk_ctx_list.end(); ctx++)
     {
@@ -1709,8 +1951,7 @@ bool NeighOrch::disableNeighbors(std::list<NeighborContext>& bulk_ctx_list)
         }
     }
 
-    gNextHopBulker.flush();
-    gNeighBulker.flush();
+    flushBulkRemoveNeighbors(bulk_ctx_list);
 
     for (auto ctx = bulk_ctx_list.begin(); ctx != bulk_ctx_list.end(); ctx++)
     {
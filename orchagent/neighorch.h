@@ -33,9 +33,9 @@ struct NeighborData
 };
 
 /* NeighborTable: NeighborEntry, neighbor MAC address */
-typedef map<NeighborEntry, NeighborData> NeighborTable;
+typedef unordered_map<NeighborEntry, NeighborData, NextHopKeyHash> NeighborTable;
 /* NextHopTable: NextHopKey, NextHopEntry */
-typedef map<NextHopKey, NextHopEntry> NextHopTable;
+typedef unordered_map<NextHopKey, NextHopEntry, NextHopKeyHash> NextHopTable;
 
 struct NeighborUpdate
 {
@@ -52,9 +52,9 @@ struct NeighborContext
     NeighborEntry                       neighborEntry;              // neighbor entry to process
     std::deque<sai_status_t>            object_statuses;            // entity bulk statuses for neighbors
     MacAddress                          mac;                        // neighbor mac
-    bool                                bulk_op = false;            // use bulker (only for mux use for now)
-    sai_object_id_t                     next_hop_id;                // next hop id
-    sai_status_t                        nexthop_status;             // next hop status
+    bool                                bulk_op = false;            // use bulker
+    sai_object_id_t                     next_hop_id = SAI_NULL_OBJECT_ID;           // next hop id
+    sai_status_t                        nexthop_status = SAI_STATUS_NOT_EXECUTED;   // next hop bulk status
 
     NeighborContext(NeighborEntry neighborEntry)
         : neighborEntry(neighborEntry)
@@ -133,6 +133,13 @@ private:
     bool removeNeighbor(NeighborContext& ctx, bool disable = false);
     bool processBulkEnableNeighbor(NeighborContext& ctx);
     bool processBulkDisableNeighbor(NeighborContext& ctx);
+    bool processBulkRemoveNeighbor(NeighborContext& ctx, bool disable = false);
+
+    void flushBulkAddNeighbors(std::list<NeighborContext>&);
+    void flushBulkRemoveNeighbors(std::list<NeighborContext>&);
+
+    void doNeighborTask(Consumer &consumer, const string &pass_op);
+    void processNeighborTasks(Consumer &consumer, std::list<NeighborContext>&, std::vector<SyncMap::iterator>&);
 
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
     bool clearNextHopFlag(const NextHopKey &, const uint32_t);
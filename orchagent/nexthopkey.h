@@ -221,4 +221,30 @@ struct NextHopKey
 
 std::size_t hash_value(const NextHopKey& obj);
 
+/*
+ * Hashes only the neighbor IP and the interface alias, without formatting any
+ * field to a string. Keys which share them (MPLS, overlay or SRv6 next hops)
+ * land in the same bucket and are told apart by operator==.
+ */
+struct NextHopKeyHash
+{
+    std::size_t operator()(const NextHopKey &key) const
+    {
+        std::size_t seed = 0;
+
+        if (key.ip_address.isV4())
+        {
+            boost::hash_combine(seed, key.ip_address.getV4Addr());
+        }
+        else
+        {
+            const unsigned char *addr = key.ip_address.getV6Addr();
+            boost::hash_range(seed, addr, addr + 16);
+        }
+        boost::hash_combine(seed, key.alias);
+
+        return seed;
+    }
+};
+
 #endif /* SWSS_NEXTHOPKEY_H */
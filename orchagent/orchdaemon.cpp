@@ -61,6 +61,7 @@ P4Orch *gP4Orch;
 BfdOrch *gBfdOrch;
 Srv6Orch *gSrv6Orch;
 FlowCounterRouteOrch *gFlowCounterRouteOrch;
+CounterRateOrch *gCounterRateOrch;
 DebugCounterOrch *gDebugCounterOrch;
 MonitorOrch *gMonitorOrch;
 TunnelDecapOrch *gTunneldecapOrch;
@@ -596,6 +597,9 @@ bool OrchDaemon::init()
         CFG_DEVICE_METADATA_TABLE_NAME
     };
 
+    gCounterRateOrch = new CounterRateOrch(m_applDb);
+    m_orchList.push_back(gCounterRateOrch);
+
     auto* flexCounterOrch = new FlexCounterOrch(m_configDb, flex_counter_tables);
     m_orchList.push_back(flexCounterOrch);
 
@@ -963,6 +967,8 @@ void OrchDaemon::start(long heartBeatInterval)
                 }
             }
 
+            CounterNameMapUpdater::flushAll();
+
             continue;
         }
 
@@ -985,6 +991,10 @@ void OrchDaemon::start(long heartBeatInterval)
             for (Orch *o : m_orchList)
                 o->doTask();
         }
+
+        /* Write the counter name map changes of this iteration at once */
+        CounterNameMapUpdater::flushAll();
+
         /*
          * Asked to check warm restart readiness.
          * Not doing this under Select::TIMEOUT condition because of
@@ -1015,9 +1025,9 @@ void OrchDaemon::start(long heartBeatInterval)
                     // Disable FDB learning on all bridge ports
                     if (gPortsOrch)
                     {
-                        for (auto& pair: gPortsOrch->getAllPorts())
+                        for (const auto& pair: gPortsOrch->getAllPorts())
                         {
-                            auto& port = pair.second;
+                            Port port = pair.second;
                             gPortsOrch->setBridgePortLearningFDB(port, SAI_BRIDGE_PORT_FDB_LEARNING_MODE_DISABLE);
                         }
                     }
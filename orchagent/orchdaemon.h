@@ -13,6 +13,7 @@
 #include "neighorch.h"
 #include "routeorch.h"
 #include "flowcounterrouteorch.h"
+#include "counterrateorch.h"
 #include "nhgorch.h"
 #include "cbf/cbfnhgorch.h"
 #include "cbf/nhgmaporch.h"
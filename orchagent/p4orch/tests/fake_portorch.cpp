@@ -55,9 +55,9 @@ bool PortsOrch::isPortAdminUp(const string &alias)
     return true;
 }
 
-std::map<string, Port> &PortsOrch::getAllPorts()
+const std::map<string, Port> &PortsOrch::getAllPorts()
 {
-    return m_portList;
+    return m_portList.getPorts();
 }
 
 bool PortsOrch::bake()
@@ -196,7 +196,8 @@ void PortsOrch::generateQueueMap(std::map<string, FlexCounterQueueStates> queues
 {
 }
 
-void PortsOrch::generateQueueMapPerPort(const Port &port, FlexCounterQueueStates &queuesState, bool voq)
+void PortsOrch::generateQueueMapPerPort(const Port &port, FlexCounterQueueStates &queuesState, bool voq,
+                                        CounterMapBatch &batch)
 {
 }
 
@@ -212,7 +213,8 @@ void PortsOrch::generatePriorityGroupMap(std::map<string, FlexCounterPgStates> p
 {
 }
 
-void PortsOrch::generatePriorityGroupMapPerPort(const Port &port, FlexCounterPgStates &pgsState)
+void PortsOrch::generatePriorityGroupMapPerPort(const Port &port, FlexCounterPgStates &pgsState,
+                                                CounterMapBatch &batch)
 {
 }
 
@@ -496,7 +498,7 @@ sai_status_t PortsOrch::removePort(sai_object_id_t port_id)
     return SAI_STATUS_SUCCESS;
 }
 
-bool PortsOrch::initExistingPort(const PortConfig &port)
+bool PortsOrch::initExistingPort(const PortConfig &port, std::vector<Port> &ports)
 {
     return true;
 }
@@ -0,0 +1,554 @@
+#include "logger.h"
+#include "orch.h"
+#include "pfcwddetector.h"
+#include "flex_counter/counter_rate_engine.h"
+
+using namespace std;
+using namespace swss;
+
+#define PFC_EST_PORT_STAT_PREFIX "EST_PORT_STAT_PFC_"
+
+typedef PfcWdDetectionRules Rules;
+
+// Same conditions and thresholds as the pfc_detect_<platform>.lua scripts
+static const vector<Rules> c_detectionRules = {
+    { BRCM_PLATFORM_SUBSTRING, Rules::Condition::PAUSED_WITHOUT_XON, "_RX_PAUSE_DURATION_US", false, 0,
+      Rules::PortLastOnStorm::UPDATE, false, false },
+    { VS_PLATFORM_SUBSTRING, Rules::Condition::RX_OR_PAUSED, "_RX_PAUSE_DURATION_US", false, 0.8,
+      Rules::PortLastOnStorm::RESET, false, false },
+    { BFN_PLATFORM_SUBSTRING, Rules::Condition::RX_OR_PAUSED, "_RX_PAUSE_DURATION", false, 0.8,
+      Rules::PortLastOnStorm::RESET, false, false },
+    { NPS_PLATFORM_SUBSTRING, Rules::Condition::RX_OR_PAUSED, "_RX_PAUSE_DURATION", false, 0.8,
+      Rules::PortLastOnStorm::UPDATE, false, false },
+    { MRVL_PRST_PLATFORM_SUBSTRING, Rules::Condition::RX_OR_PAUSED, "_RX_PAUSE_DURATION", true, 0.8,
+      Rules::PortLastOnStorm::UPDATE, false, false },
+    { MRVL_TL_PLATFORM_SUBSTRING, Rules::Condition::RX_AND_PAUSED, "_RX_PAUSE_DURATION", false, 0.8,
+      Rules::PortLastOnStorm::KEEP, false, false },
+    { MLNX_PLATFORM_SUBSTRING, Rules::Condition::PAUSED, "_RX_PAUSE_DURATION_US", false, 0.99,
+      Rules::PortLastOnStorm::RESET, true, true },
+    { CISCO_8000_PLATFORM_SUBSTRING, Rules::Condition::PAUSE_STATUS, "", true, 0,
+      Rules::PortLastOnStorm::UPDATE, false, false },
+};
+
+const PfcWdDetectionRules *PfcWdDetectionRules::get(const string &platform)
+{
+    // The marvell scripts were named with an underscore
+    string name = platform;
+    if (name == "marvell_prestera" || name == "marvell_teralynx")
+    {
+        name[7] = '-';
+    }
+
+    for (const auto &rules : c_detectionRules)
+    {
+        if (rules.platform == name)
+        {
+            return &rules;
+        }
+    }
+
+    return nullptr;
+}
+
+void PfcWdDetector::Samples::reset(size_t count)
+{
+    flags.assign(count, 0);
+    occupancy.assign(count, 0);
+    packets.assign(count, 0);
+    pfcRx.assign(count, 0);
+    pfcDuration.assign(count, 0);
+    pfcOn2Off.assign(count, 0);
+}
+
+PfcWdDetector::PfcWdDetector(const PfcWdDetectionRules &rules) :
+    m_rules(rules)
+{
+}
+
+void PfcWdDetector::addQueue(const QueueConfig &config)
+{
+    SWSS_LOG_ENTER();
+
+    removeQueue(config.queue);
+
+    m_index.emplace(config.queue, m_config.size());
+    m_config.push_back(config);
+    m_state.push_back(0);
+    m_alert.push_back(config.alert);
+    m_detectionTime.push_back(static_cast<double>(config.detectionTime));
+    m_restorationTime.push_back(static_cast<double>(config.restorationTime));
+    m_step.push_back(SKIP);
+    m_storm.push_back(0);
+    m_detectionLeft.push_back(static_cast<double>(config.detectionTime));
+    m_restorationLeft.push_back(static_cast<double>(config.restorationTime));
+    m_pendingUs.push_back(0);
+    m_pendingSinceUs.push_back(0);
+    m_conditionSinceUs.push_back(0);
+    m_packetsLast.push_back(0);
+    m_pfcRxLast.push_back(0);
+    m_durationLast.push_back(0);
+    m_on2OffLast.push_back(0);
+    m_recentPauseUs.push_back(0);
+    m_totalPauseUs.push_back(0);
+}
+
+template <typename T>
+static void moveLast(vector<T> &values, size_t pos)
+{
+    values[pos] = std::move(values.back());
+    values.pop_back();
+}
+
+void PfcWdDetector::removeQueue(const string &queue)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_index.find(queue);
+    if (it == m_index.end())
+    {
+        return;
+    }
+
+    // The last queue takes the place of the removed one
+    size_t q = it->second;
+    m_index.erase(it);
+    if (q != m_config.size() - 1)
+    {
+        m_index[m_config.back().queue] = q;
+    }
+
+    moveLast(m_config, q);
+    moveLast(m_state, q);
+    moveLast(m_alert, q);
+    moveLast(m_detectionTime, q);
+    moveLast(m_restorationTime, q);
+    moveLast(m_step, q);
+    moveLast(m_storm, q);
+    moveLast(m_detectionLeft, q);
+    moveLast(m_restorationLeft, q);
+    moveLast(m_pendingUs, q);
+    moveLast(m_pendingSinceUs, q);
+    moveLast(m_conditionSinceUs, q);
+    moveLast(m_packetsLast, q);
+    moveLast(m_pfcRxLast, q);
+    moveLast(m_durationLast, q);
+    moveLast(m_on2OffLast, q);
+    moveLast(m_recentPauseUs, q);
+    moveLast(m_totalPauseUs, q);
+}
+
+void PfcWdDetector::setPauseTimeEstimates(const string &queue, uint64_t recentUs, uint64_t totalUs)
+{
+    auto it = m_index.find(queue);
+    if (it == m_index.end())
+    {
+        return;
+    }
+
+    m_recentPauseUs[it->second] = recentUs;
+    m_totalPauseUs[it->second] = totalUs;
+}
+
+void PfcWdDetector::evaluate(const Samples &samples,
+                             double pollIntervalUs,
+                             uint64_t timestampUs,
+                             double counterIntervalUs,
+                             vector<Result> &results)
+{
+    SWSS_LOG_ENTER();
+
+    if (samples.flags.size() != m_config.size())
+    {
+        SWSS_LOG_ERROR("Got %zu PFC watchdog samples for %zu queues", samples.flags.size(), m_config.size());
+        return;
+    }
+
+    m_stats = Stats();
+    m_timestampUs = timestampUs;
+
+    double sinceLastUs = pollIntervalUs;
+    if (m_lastTimestampUs != 0 && timestampUs > m_lastTimestampUs)
+    {
+        sinceLastUs = static_cast<double>(timestampUs - m_lastTimestampUs);
+    }
+
+    double pollTimeUs = pollIntervalUs;
+    if (m_rules.measuredPollTime)
+    {
+        pollTimeUs = counterIntervalUs > 0 ? counterIntervalUs : sinceLastUs;
+    }
+
+    classify(samples, pollTimeUs);
+    detectStorms(samples, pollTimeUs, sinceLastUs, results);
+    // Restoration always counts the configured interval
+    detectRestores(samples, pollIntervalUs, results);
+
+    m_lastTimestampUs = timestampUs;
+}
+
+void PfcWdDetector::classify(const Samples &samples, double pollTimeUs)
+{
+    const size_t count = m_config.size();
+    const uint16_t *flags = samples.flags.data();
+    const uint8_t *state = m_state.data();
+    uint8_t *step = m_step.data();
+    uint8_t *storm = m_storm.data();
+
+    // Which state machine the queue is in
+    for (size_t q = 0; q < count; q++)
+    {
+        bool detecting = (flags[q] & OPERATIONAL) || m_alert[q];
+        bool restoring = !detecting && m_restorationTime[q] > 0;
+        step[q] = detecting ? EVALUATE : (restoring ? RESTORE_STEP : SKIP);
+    }
+
+    // Counters needed for a sample, and the last values needed to evaluate it
+    uint16_t required = 0;
+    uint8_t requiredLast = 0;
+    switch (m_rules.condition)
+    {
+        case Rules::Condition::PAUSED_WITHOUT_XON:
+            required = HAS_OCCUPANCY | HAS_PACKETS | HAS_PFC_RX | HAS_ON2OFF | HAS_PAUSE;
+            requiredLast = HAS_PACKETS_LAST | HAS_PFC_RX_LAST | HAS_ON2OFF_LAST | HAS_PAUSE_LAST;
+            break;
+        case Rules::Condition::PAUSE_STATUS:
+            required = HAS_PACKETS | HAS_PAUSE;
+            break;
+        default:
+            required = HAS_OCCUPANCY | HAS_PACKETS | HAS_PFC_RX | (m_rules.noDuration ? 0 : HAS_DURATION);
+            requiredLast = HAS_PACKETS_LAST | HAS_PFC_RX_LAST | HAS_DURATION_LAST;
+            break;
+    }
+
+    for (size_t q = 0; q < count; q++)
+    {
+        if (step[q] != EVALUATE)
+        {
+            continue;
+        }
+
+        if ((flags[q] & required) != required)
+        {
+            step[q] = SKIP;
+        }
+        else if ((state[q] & requiredLast) != requiredLast)
+        {
+            step[q] = RECORD;
+        }
+    }
+
+    if (m_deferStaleSamples && m_rules.condition != Rules::Condition::PAUSE_STATUS)
+    {
+        const bool pause = m_rules.condition == Rules::Condition::PAUSED_WITHOUT_XON;
+        for (size_t q = 0; q < count; q++)
+        {
+            bool unchanged = samples.packets[q] == m_packetsLast[q] &&
+                             samples.pfcRx[q] == m_pfcRxLast[q] &&
+                             samples.pfcDuration[q] == m_durationLast[q] &&
+                             samples.pfcOn2Off[q] == m_on2OffLast[q] &&
+                             (!pause || !(flags[q] & PAUSED) == !(state[q] & PAUSED_LAST));
+            if (step[q] == EVALUATE && unchanged && !(flags[q] & DEBUG_STORM) && m_pendingUs[q] <= 0)
+            {
+                step[q] = DEFER;
+            }
+        }
+    }
+
+    // Storm condition of the evaluated samples
+    const uint64_t *occupancy = samples.occupancy.data();
+    const uint64_t *packets = samples.packets.data();
+    const uint64_t *pfcRx = samples.pfcRx.data();
+    const uint64_t *pfcDuration = samples.pfcDuration.data();
+    const uint64_t *pfcOn2Off = samples.pfcOn2Off.data();
+    const double threshold = m_rules.durationThreshold;
+
+    for (size_t q = 0; q < count; q++)
+    {
+        bool stuck = packets[q] == m_packetsLast[q];
+        bool rx = pfcRx[q] > m_pfcRxLast[q];
+        // Without a pause duration it counts as 0 on both samples. The counters
+        // of a sample after a deferred one still cover one counter interval.
+        bool paused = !m_rules.noDuration &&
+                      static_cast<double>(pfcDuration[q]) - static_cast<double>(m_durationLast[q]) >
+                      pollTimeUs * threshold;
+        bool debug = flags[q] & DEBUG_STORM;
+        bool condition = false;
+
+        switch (m_rules.condition)
+        {
+            case Rules::Condition::PAUSED_WITHOUT_XON:
+                condition = rx && pfcOn2Off[q] == m_on2OffLast[q] &&
+                            (state[q] & PAUSED_LAST) && (flags[q] & PAUSED);
+                break;
+            case Rules::Condition::RX_OR_PAUSED:
+                condition = (occupancy[q] > 0 && stuck && rx) || (occupancy[q] == 0 && stuck && paused);
+                break;
+            case Rules::Condition::RX_AND_PAUSED:
+                condition = (occupancy[q] > 0 && stuck && rx && paused) || (occupancy[q] == 0 && rx && paused);
+                break;
+            case Rules::Condition::PAUSED:
+                condition = occupancy[q] > 0 && stuck && paused;
+                break;
+            case Rules::Condition::PAUSE_STATUS:
+                condition = flags[q] & PAUSED;
+                break;
+        }
+
+        storm[q] = condition || debug;
+    }
+}
+
+void PfcWdDetector::detectStorms(const Samples &samples, double pollTimeUs, double sinceLastUs,
+                                 vector<Result> &results)
+{
+    const size_t count = m_config.size();
+    const bool pauseStatus = m_rules.condition == Rules::Condition::PAUSE_STATUS ||
+                             m_rules.condition == Rules::Condition::PAUSED_WITHOUT_XON;
+
+    for (size_t q = 0; q < count; q++)
+    {
+        uint8_t step = m_step[q];
+        if (step == SKIP || step == RESTORE_STEP)
+        {
+            continue;
+        }
+
+        m_stats.detecting++;
+
+        if (step == DEFER)
+        {
+            m_pendingUs[q] += pollTimeUs;
+            m_pendingSinceUs[q] += sinceLastUs;
+            m_stats.deferred++;
+            continue;
+        }
+
+        const uint16_t flags = samples.flags[q];
+        const double pollUs = pollTimeUs + m_pendingUs[q];
+        const double sinceUs = sinceLastUs + m_pendingSinceUs[q];
+        m_pendingUs[q] = 0;
+        m_pendingSinceUs[q] = 0;
+
+        bool deadlock = false;
+        if (step == EVALUATE)
+        {
+            if (m_storm[q])
+            {
+                if (!(m_state[q] & IN_STORM_CONDITION))
+                {
+                    m_state[q] |= IN_STORM_CONDITION;
+                    // The condition started within the interval before the sample
+                    uint64_t intervalUs = static_cast<uint64_t>(pollUs);
+                    m_conditionSinceUs[q] = m_timestampUs > intervalUs ? m_timestampUs - intervalUs : 0;
+                }
+
+                if (m_detectionLeft[q] <= pollUs)
+                {
+                    addResult(q, STORM, results);
+                    if (m_rules.stormInfo)
+                    {
+                        auto &info = results.back().info;
+                        info.emplace_back("occupancy", to_string(samples.occupancy[q]));
+                        info.emplace_back("packets", to_string(samples.packets[q]));
+                        info.emplace_back("packets_last", to_string(m_packetsLast[q]));
+                        info.emplace_back("pfc_rx_packets", to_string(samples.pfcRx[q]));
+                        info.emplace_back("pfc_rx_packets_last", to_string(m_pfcRxLast[q]));
+                        info.emplace_back("pfc_duration", to_string(samples.pfcDuration[q]));
+                        info.emplace_back("pfc_duration_last", to_string(m_durationLast[q]));
+                        info.emplace_back("effective_poll_time", CounterRateEngine::formatNumber(pollTimeUs));
+                    }
+
+                    deadlock = true;
+                    m_state[q] &= static_cast<uint8_t>(~IN_STORM_CONDITION);
+                    m_detectionLeft[q] = m_detectionTime[q];
+                }
+                else
+                {
+                    m_detectionLeft[q] -= pollUs;
+                }
+            }
+            else
+            {
+                m_state[q] &= static_cast<uint8_t>(~IN_STORM_CONDITION);
+                if (m_alert[q] && !(flags & OPERATIONAL))
+                {
+                    addResult(q, RESTORE, results);
+                }
+                m_detectionLeft[q] = m_detectionTime[q];
+            }
+
+            if (m_rules.condition == Rules::Condition::PAUSED_WITHOUT_XON && m_config[q].statHistory)
+            {
+                updatePauseHistory(q, m_state[q] & PAUSED_LAST, flags & PAUSED,
+                                   samples.pfcRx[q] > m_pfcRxLast[q], flags & HAS_DURATION, sinceUs);
+            }
+        }
+
+        // Save values for the next sample
+        m_packetsLast[q] = samples.packets[q];
+        m_state[q] |= HAS_PACKETS_LAST;
+
+        if (pauseStatus)
+        {
+            m_state[q] = static_cast<uint8_t>((m_state[q] & ~PAUSED_LAST) | HAS_PAUSE_LAST |
+                                              ((flags & PAUSED) ? PAUSED_LAST : 0));
+        }
+
+        if (m_rules.condition == Rules::Condition::PAUSE_STATUS)
+        {
+            continue;
+        }
+
+        if (m_rules.condition == Rules::Condition::PAUSED_WITHOUT_XON)
+        {
+            m_pfcRxLast[q] = samples.pfcRx[q];
+            m_on2OffLast[q] = samples.pfcOn2Off[q];
+            m_state[q] |= HAS_PFC_RX_LAST | HAS_ON2OFF_LAST;
+        }
+        else if (!deadlock || m_rules.portLastOnStorm == Rules::PortLastOnStorm::UPDATE)
+        {
+            m_pfcRxLast[q] = samples.pfcRx[q];
+            m_durationLast[q] = samples.pfcDuration[q];
+            m_state[q] |= HAS_PFC_RX_LAST | HAS_DURATION_LAST;
+        }
+        else if (m_rules.portLastOnStorm == Rules::PortLastOnStorm::RESET)
+        {
+            m_state[q] &= static_cast<uint8_t>(~(HAS_PFC_RX_LAST | HAS_DURATION_LAST));
+        }
+    }
+}
+
+void PfcWdDetector::detectRestores(const Samples &samples, double pollTimeUs, vector<Result> &results)
+{
+    const size_t count = m_config.size();
+    const bool pauseStatus = m_rules.condition == Rules::Condition::PAUSE_STATUS;
+
+    for (size_t q = 0; q < count; q++)
+    {
+        if (m_step[q] != RESTORE_STEP)
+        {
+            continue;
+        }
+
+        const uint16_t flags = samples.flags[q];
+        m_state[q] &= static_cast<uint8_t>(~IN_STORM_CONDITION);
+        m_pendingUs[q] = 0;
+        m_pendingSinceUs[q] = 0;
+
+        bool restored;
+        if (pauseStatus)
+        {
+            restored = (flags & HAS_PAUSE) && !(flags & PAUSED);
+        }
+        else
+        {
+            if (!(flags & HAS_PFC_RX))
+            {
+                continue;
+            }
+
+            // No PFC frames since the last sample
+            bool first = !(m_state[q] & HAS_PFC_RX_LAST);
+            restored = samples.pfcRx[q] == m_pfcRxLast[q];
+
+            m_pfcRxLast[q] = samples.pfcRx[q];
+            m_state[q] |= HAS_PFC_RX_LAST;
+
+            if (first)
+            {
+                continue;
+            }
+        }
+
+        m_stats.restoring++;
+
+        if (restored && !(flags & DEBUG_STORM))
+        {
+            if (m_restorationLeft[q] <= pollTimeUs)
+            {
+                addResult(q, RESTORE, results);
+                m_restorationLeft[q] = m_restorationTime[q];
+            }
+            else
+            {
+                m_restorationLeft[q] -= pollTimeUs;
+            }
+        }
+        else
+        {
+            m_restorationLeft[q] = m_restorationTime[q];
+        }
+    }
+}
+
+void PfcWdDetector::updatePauseHistory(size_t q, bool wasPaused, bool nowPaused, bool rxIncreased,
+                                       bool saiDuration, double sinceLastUs)
+{
+    const auto &config = m_config[q];
+    const string prefix = PFC_EST_PORT_STAT_PREFIX + to_string(config.index);
+    auto &fvs = m_updates[config.port];
+
+    if (rxIncreased && !wasPaused)
+    {
+        // A new pause period starts with this interval
+        fvs.emplace_back(prefix + "_RECENT_PAUSE_TIMESTAMP", to_string(m_lastTimestampUs));
+        m_recentPauseUs[q] = 0;
+    }
+    else if (!rxIncreased && !(nowPaused && wasPaused))
+    {
+        return;
+    }
+
+    // Estimate the queue was paused for the whole interval
+    const uint64_t sinceUs = static_cast<uint64_t>(sinceLastUs);
+    m_recentPauseUs[q] += sinceUs;
+    fvs.emplace_back(prefix + "_RECENT_PAUSE_TIME_US", to_string(m_recentPauseUs[q]));
+
+    // The total is only estimated when the SAI does not count it
+    if (!saiDuration)
+    {
+        m_totalPauseUs[q] += sinceUs;
+        fvs.emplace_back(prefix + "_RX_PAUSE_DURATION_US", to_string(m_totalPauseUs[q]));
+    }
+}
+
+void PfcWdDetector::addResult(size_t q, Event event, vector<Result> &results)
+{
+    Result result;
+    result.queue = m_config[q].queue;
+    result.event = event;
+    result.latencyUs = 0;
+
+    if (event == STORM)
+    {
+        result.latencyUs = m_timestampUs - m_conditionSinceUs[q];
+        m_stats.storms++;
+    }
+    else
+    {
+        m_stats.restores++;
+    }
+
+    results.push_back(std::move(result));
+}
+
+void PfcWdDetector::getUpdates(vector<KeyOpFieldsValuesTuple> &updates)
+{
+    for (auto &it : m_updates)
+    {
+        updates.emplace_back(it.first, SET_COMMAND, std::move(it.second));
+    }
+    m_updates.clear();
+}
+
+double PfcWdDetector::getDetectionTimeLeft(const string &queue) const
+{
+    auto it = m_index.find(queue);
+    return it == m_index.end() ? 0 : m_detectionLeft[it->second];
+}
+
+double PfcWdDetector::getRestorationTimeLeft(const string &queue) const
+{
+    auto it = m_index.find(queue);
+    return it == m_index.end() ? 0 : m_restorationLeft[it->second];
+}
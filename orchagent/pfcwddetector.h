@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+// Platform specific parts of PFC storm detection, one entry per
+// pfc_detect_<platform>.lua script the detector replaces
+struct PfcWdDetectionRules
+{
+    enum class Condition : uint8_t
+    {
+        // PFC frames received without XON while the queue stays paused (broadcom)
+        PAUSED_WITHOUT_XON,
+        // Stuck queue receiving PFC frames, or empty stuck queue paused
+        // for most of the interval (vs, barefoot, nephos, marvell-prestera)
+        RX_OR_PAUSED,
+        // PFC frames received and paused for most of the interval (marvell-teralynx)
+        RX_AND_PAUSED,
+        // Stuck queue paused for the whole interval (mellanox)
+        PAUSED,
+        // Queue pause status read from the SAI (cisco-8000)
+        PAUSE_STATUS,
+    };
+
+    // What happens to the last port counters once a storm is declared
+    enum class PortLastOnStorm : uint8_t
+    {
+        UPDATE,
+        KEEP,
+        // Forgotten, the next sample only records the counters
+        RESET,
+    };
+
+    std::string platform;
+    Condition condition;
+    // SAI_PORT_STAT_PFC_<i><durationSuffix> holds the pause duration
+    std::string durationSuffix;
+    // Pause duration is not read and counts as 0
+    bool noDuration;
+    // Part of the poll interval the queue must have been paused
+    double durationThreshold;
+    PortLastOnStorm portLastOnStorm;
+    // The poll interval is measured rather than configured
+    bool measuredPollTime;
+    // Storms are reported with the counters that triggered them
+    bool stormInfo;
+
+    // nullptr if PFC storms are not detected on the platform
+    static const PfcWdDetectionRules *get(const std::string &platform);
+};
+
+// The storm detection and restoration the pfc_detect/pfc_restore Lua scripts
+// ran in syncd, run in orchagent on samples of the watched queues. Each queue
+// counts down its detection time while the platform's storm condition holds
+// and its restoration time while it no longer does, and reports an event when
+// either reaches zero.
+class PfcWdDetector
+{
+public:
+    enum Event : uint8_t
+    {
+        NONE,
+        STORM,
+        RESTORE
+    };
+
+    struct QueueConfig
+    {
+        std::string queue;
+        std::string port;
+        uint8_t index = 0;
+        // Microseconds, a restoration time of 0 leaves restoration to the action handler
+        uint64_t detectionTime = 0;
+        uint64_t restorationTime = 0;
+        bool alert = false;
+        bool statHistory = false;
+    };
+
+    // Per queue sample bits
+    enum : uint16_t
+    {
+        HAS_OCCUPANCY   = 1 << 0,
+        HAS_PACKETS     = 1 << 1,
+        HAS_PFC_RX      = 1 << 2,
+        HAS_DURATION    = 1 << 3,
+        HAS_ON2OFF      = 1 << 4,
+        HAS_PAUSE       = 1 << 5,
+        PAUSED          = 1 << 6,
+        // PFC_WD_STATUS is operational
+        OPERATIONAL     = 1 << 7,
+        // DEBUG_STORM is enabled
+        DEBUG_STORM     = 1 << 8,
+    };
+
+    // One entry per queue, in getQueues() order
+    struct Samples
+    {
+        std::vector<uint16_t> flags;
+        std::vector<uint64_t> occupancy;
+        std::vector<uint64_t> packets;
+        std::vector<uint64_t> pfcRx;
+        std::vector<uint64_t> pfcDuration;
+        std::vector<uint64_t> pfcOn2Off;
+
+        void reset(size_t count);
+    };
+
+    struct Result
+    {
+        std::string queue;
+        Event event;
+        // Time since the storm condition was first seen, storms only
+        uint64_t latencyUs;
+        std::vector<swss::FieldValueTuple> info;
+    };
+
+    struct Stats
+    {
+        size_t detecting = 0;
+        size_t restoring = 0;
+        size_t deferred = 0;
+        size_t storms = 0;
+        size_t restores = 0;
+    };
+
+    explicit PfcWdDetector(const PfcWdDetectionRules &rules);
+
+    const PfcWdDetectionRules& getRules() const
+    {
+        return m_rules;
+    }
+
+    // Starts the queue from a clean state, replacing any previous config
+    void addQueue(const QueueConfig &config);
+    void removeQueue(const std::string &queue);
+    // Seeds the pause time estimates of PFC_STAT_HISTORY with the published ones
+    void setPauseTimeEstimates(const std::string &queue, uint64_t recentUs, uint64_t totalUs);
+
+    const std::vector<QueueConfig>& getQueues() const
+    {
+        return m_config;
+    }
+
+    // A sample with no counter changed since the last one is read before the
+    // counters were polled again. When enabled it is carried over to the next
+    // cycle rather than read as an idle interval: its time counts toward the
+    // detection time, while the pause duration of the next sample is still
+    // compared against one counter interval.
+    void setDeferStaleSamples(bool enable)
+    {
+        m_deferStaleSamples = enable;
+    }
+
+    // pollIntervalUs is the configured interval. timestampUs is the wall clock
+    // time of the sample. counterIntervalUs is the time between the last two
+    // counter polls if known, 0 otherwise.
+    void evaluate(const Samples &samples,
+                  double pollIntervalUs,
+                  uint64_t timestampUs,
+                  double counterIntervalUs,
+                  std::vector<Result> &results);
+
+    // EST_PORT_STAT_PFC_* pause time estimates of the ports with PFC_STAT_HISTORY,
+    // as changed by evaluate() since the last call
+    void getUpdates(std::vector<swss::KeyOpFieldsValuesTuple> &updates);
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+    double getDetectionTimeLeft(const std::string &queue) const;
+    double getRestorationTimeLeft(const std::string &queue) const;
+
+private:
+    // Per queue state bits
+    enum : uint8_t
+    {
+        HAS_PACKETS_LAST    = 1 << 0,
+        HAS_PFC_RX_LAST     = 1 << 1,
+        HAS_DURATION_LAST   = 1 << 2,
+        HAS_ON2OFF_LAST     = 1 << 3,
+        HAS_PAUSE_LAST      = 1 << 4,
+        PAUSED_LAST         = 1 << 5,
+        IN_STORM_CONDITION  = 1 << 6,
+    };
+
+    // What a sample does to the detection state machine of its queue
+    enum Step : uint8_t
+    {
+        SKIP,
+        // Restoration state machine
+        RESTORE_STEP,
+        // Counters missing the last values, only recorded
+        RECORD,
+        DEFER,
+        EVALUATE
+    };
+
+    void classify(const Samples &samples, double pollTimeUs);
+    void detectStorms(const Samples &samples, double pollTimeUs, double sinceLastUs,
+                      std::vector<Result> &results);
+    void detectRestores(const Samples &samples, double pollTimeUs, std::vector<Result> &results);
+    void updatePauseHistory(size_t q, bool wasPaused, bool nowPaused, bool rxIncreased,
+                            bool saiDuration, double sinceLastUs);
+    void addResult(size_t q, Event event, std::vector<Result> &results);
+
+    const PfcWdDetectionRules &m_rules;
+    bool m_deferStaleSamples = false;
+    uint64_t m_timestampUs = 0;
+    uint64_t m_lastTimestampUs = 0;
+    Stats m_stats;
+
+    std::vector<QueueConfig> m_config;
+    std::unordered_map<std::string, size_t> m_index;
+
+    // Per queue
+    std::vector<uint8_t> m_state;
+    std::vector<uint8_t> m_alert;
+    std::vector<double> m_detectionTime;
+    std::vector<double> m_restorationTime;
+    std::vector<uint8_t> m_step;            // scratch, Step of the sample
+    std::vector<uint8_t> m_storm;           // scratch, storm condition of the sample
+    std::vector<double> m_detectionLeft;
+    std::vector<double> m_restorationLeft;
+    std::vector<double> m_pendingUs;        // poll time of deferred samples, detection time only
+    std::vector<double> m_pendingSinceUs;
+    std::vector<uint64_t> m_conditionSinceUs;
+    std::vector<uint64_t> m_packetsLast;
+    std::vector<uint64_t> m_pfcRxLast;
+    std::vector<uint64_t> m_durationLast;
+    std::vector<uint64_t> m_on2OffLast;
+    std::vector<uint64_t> m_recentPauseUs;
+    std::vector<uint64_t> m_totalPauseUs;
+
+    std::unordered_map<std::string, std::vector<swss::FieldValueTuple>> m_updates;
+};
@@ -1,5 +1,7 @@
 #include <limits.h>
 #include <inttypes.h>
+#include <time.h>
+#include <chrono>
 #include <unordered_map>
 #include "pfcwdorch.h"
 #include "sai_serialize.h"
@@ -27,6 +29,9 @@
 #define SAI_PORT_STAT_PFC_PREFIX        "SAI_PORT_STAT_PFC_"
 #define PFC_WD_TC_MAX 8
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC  1
+#define PFC_WD_DETECTION_STATS_TABLE    "PFC_WD_DETECTION_STATS"
+// Polls between two writes of the detection stats
+#define PFC_WD_DETECTION_STATS_POLLS    10
 
 extern sai_object_id_t gSwitchId;
 extern sai_switch_api_t* sai_switch_api;
@@ -38,6 +43,54 @@ extern event_handle_t g_events_handle;
 extern SwitchOrch *gSwitchOrch;
 extern PortsOrch *gPortsOrch;
 
+static double getThreadCpuTimeUs(void)
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1e6 + static_cast<double>(ts.tv_nsec) / 1e3;
+}
+
+// Queue counter columns read by the storm detection
+enum
+{
+    QUEUE_OCCUPANCY,
+    QUEUE_PACKETS,
+    QUEUE_PAUSE_STATUS,
+    QUEUE_WD_STATUS,
+    QUEUE_DEBUG_STORM,
+};
+
+static const vector<string> c_queueDetectionFields = {
+    "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+    "SAI_QUEUE_STAT_PACKETS",
+    "SAI_QUEUE_ATTR_PAUSE_STATUS",
+    "PFC_WD_STATUS",
+    "DEBUG_STORM",
+};
+
+// Port counter columns, PORT_PFC_FIELDS per priority
+enum
+{
+    PORT_PFC_RX,
+    PORT_PFC_DURATION,
+    PORT_PFC_ON2OFF,
+    PORT_PFC_FIELDS
+};
+
+static vector<string> getPortDetectionFields(const PfcWdDetectionRules &rules)
+{
+    vector<string> fields;
+    for (int i = 0; i < PFC_WD_TC_MAX; i++)
+    {
+        const string prefix = SAI_PORT_STAT_PFC_PREFIX + to_string(i);
+        fields.push_back(prefix + "_RX_PKTS");
+        fields.push_back(prefix + rules.durationSuffix);
+        fields.push_back(prefix + "_ON2OFF_RX_PKTS");
+    }
+
+    return fields;
+}
+
 template <typename DropHandler, typename ForwardHandler>
 PfcWdOrch<DropHandler, ForwardHandler>::PfcWdOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
@@ -353,7 +406,13 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
 
             if (field == POLL_INTERVAL_FIELD)
             {
-                this->m_pfcwdFlexCounterManager->updateGroupPollingInterval(stoi(value));
+                m_pollInterval = stoi(value);
+                this->m_pfcwdFlexCounterManager->updateGroupPollingInterval(m_pollInterval);
+                m_detectionTimer->setInterval(timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 });
+                if (m_detector)
+                {
+                    m_detectionTimer->reset();
+                }
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -560,6 +619,22 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         this->m_pfcwdFlexCounterManager->setCounterIdList(port.m_port_id, CounterType::PORT, portStatIdSet, SAI_OBJECT_TYPE_PORT);
     }
 
+    if (!m_detector)
+    {
+        auto rules = PfcWdDetectionRules::get(this->m_platform);
+        if (rules)
+        {
+            m_detector = make_unique<PfcWdDetector>(*rules);
+            m_detector->setDeferStaleSamples(true);
+            m_portReader->setFields(getPortDetectionFields(*rules));
+            m_detectionTimer->start();
+        }
+        else
+        {
+            SWSS_LOG_WARN("PFC storms are not detected on platform %s", this->m_platform.c_str());
+        }
+    }
+
     for (auto i : losslessTc)
     {
         sai_object_id_t queueId = port.m_queue_ids[i];
@@ -596,6 +671,32 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
 
+        if (m_detector)
+        {
+            PfcWdDetector::QueueConfig config;
+            config.queue = queueIdStr;
+            config.port = sai_serialize_object_id(port.m_port_id);
+            config.index = i;
+            config.detectionTime = static_cast<uint64_t>(detectionTime) * 1000;
+            config.restorationTime = static_cast<uint64_t>(restorationTime) * 1000;
+            config.alert = action == PfcWdAction::PFC_WD_ACTION_ALERT;
+            config.statHistory = pfcStatHistory == "enable";
+            m_detector->addQueue(config);
+
+            if (config.statHistory)
+            {
+                // Carry on with the pause time estimates already published
+                string prefix = "EST_PORT_STAT_PFC_" + to_string(i);
+                string recent, total;
+                this->getCountersTable()->hget(config.port, prefix + "_RECENT_PAUSE_TIME_US", recent);
+                this->getCountersTable()->hget(config.port, prefix + "_RX_PAUSE_DURATION_US", total);
+                uint64_t recentUs = 0, totalUs = 0;
+                CounterReader::parseCounter(recent, recentUs);
+                CounterReader::parseCounter(total, totalUs);
+                m_detector->setPauseTimeEstimates(queueIdStr, recentUs, totalUs);
+            }
+        }
+
         // Initialize PFC WD related counters
         PfcWdActionHandler::initWdCounters(
                 this->getCountersTable(),
@@ -663,6 +764,10 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
         }
 
         m_entryMap.erase(queueId);
+        if (m_detector)
+        {
+            m_detector->removeQueue(sai_serialize_object_id(queueId));
+        }
 
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
@@ -689,37 +794,20 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
 {
     SWSS_LOG_ENTER();
 
-    string detectSha, restoreSha;
-    string detectPluginName = "pfc_detect_" + this->m_platform + ".lua";
-    string restorePluginName;
-    string pollIntervalStr = to_string(m_pollInterval);
-    string plugins;
-    if (this->m_platform == CISCO_8000_PLATFORM_SUBSTRING) {
-        restorePluginName = "pfc_restore_" + this->m_platform + ".lua";
-    } else {
-        restorePluginName = "pfc_restore.lua";
-    }
+    // Storms are detected in orchagent, an empty plugin list also clears the
+    // detection scripts syncd ran for the group before
+    this->m_pfcwdFlexCounterManager = make_shared<FlexCounterTaggedCachedManager<sai_object_type_t>>(
+        "PFC_WD", StatsMode::READ, m_pollInterval, true, make_pair(QUEUE_PLUGIN_FIELD, ""));
 
-    try
-    {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
-
-        string restoreLuaScript = swss::loadLuaScript(restorePluginName);
-        restoreSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                restoreLuaScript);
-        plugins = detectSha + "," + restoreSha;
-    }
-    catch (...)
-    {
-        SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
-    }
+    auto detectionInterval = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+    m_detectionTimer = new SelectableTimer(detectionInterval);
+    Orch::addExecutor(new ExecutableTimer(m_detectionTimer, this, "PFC_WD_DETECTION"));
 
-    this->m_pfcwdFlexCounterManager = make_shared<FlexCounterTaggedCachedManager<sai_object_type_t>>(
-        "PFC_WD", StatsMode::READ, m_pollInterval, true, make_pair(QUEUE_PLUGIN_FIELD, plugins));
+    m_queueReader = make_unique<CounterReader>(this->getCountersDb().get(), COUNTERS_TABLE, c_queueDetectionFields);
+    m_portReader = make_unique<CounterReader>(this->getCountersDb().get(), COUNTERS_TABLE);
+    m_countersPipe = make_unique<RedisPipeline>(this->getCountersDb().get());
+    m_countersTableBatch = make_unique<Table>(m_countersPipe.get(), COUNTERS_TABLE, true);
+    m_detectionStatsTable = make_unique<Table>(m_countersPipe.get(), PFC_WD_DETECTION_STATS_TABLE, true);
 
     auto consumer = new swss::NotificationConsumer(
             this->getCountersDb().get(),
@@ -916,11 +1004,234 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(swss::NotificationConsumer
     }
 }
 
+template <typename DropHandler, typename ForwardHandler>
+bool PfcWdSwOrch<DropHandler, ForwardHandler>::updateDetectionStats(const PfcWdDetector::Stats &stats,
+                                                                   double elapsedUs, double cpuUs)
+{
+    SWSS_LOG_ENTER();
+
+    auto &totals = m_detectionStats;
+    totals.polls++;
+    totals.deferred += stats.deferred;
+    totals.storms += stats.storms;
+    totals.restores += stats.restores;
+    totals.elapsedUs += elapsedUs;
+    totals.cpuUs += cpuUs;
+    totals.maxElapsedUs = max(totals.maxElapsedUs, elapsedUs);
+    totals.maxCpuUs = max(totals.maxCpuUs, cpuUs);
+
+    if (totals.polls % PFC_WD_DETECTION_STATS_POLLS != 1)
+    {
+        return false;
+    }
+
+    vector<FieldValueTuple> fvs = {
+        { "polls", to_string(totals.polls) },
+        { "detecting", to_string(stats.detecting) },
+        { "restoring", to_string(stats.restoring) },
+        { "deferred", to_string(totals.deferred) },
+        { "storms", to_string(totals.storms) },
+        { "restores", to_string(totals.restores) },
+        { "elapsed_us", to_string(static_cast<uint64_t>(totals.elapsedUs)) },
+        { "cpu_us", to_string(static_cast<uint64_t>(totals.cpuUs)) },
+        { "max_elapsed_us", to_string(static_cast<uint64_t>(totals.maxElapsedUs)) },
+        { "max_cpu_us", to_string(static_cast<uint64_t>(totals.maxCpuUs)) },
+    };
+    m_detectionStatsTable->set("", fvs);
+
+    return true;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::detectPfcStorms(void)
+{
+    SWSS_LOG_ENTER();
+
+    // Queues are left as they are in BIG_RED_SWITCH mode
+    if (!m_detector || m_bigRedSwitchFlag)
+    {
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    double cpuStartUs = getThreadCpuTimeUs();
+
+    const auto &rules = m_detector->getRules();
+    const auto &queues = m_detector->getQueues();
+    m_samples.reset(queues.size());
+
+    // Each port is read once for all its queues
+    vector<string> queueKeys;
+    vector<string> portKeys;
+    vector<size_t> queuePorts;
+    unordered_map<string, size_t> portIndex;
+    queueKeys.reserve(queues.size());
+    queuePorts.reserve(queues.size());
+    for (const auto &queue : queues)
+    {
+        queueKeys.push_back(queue.queue);
+        auto port = portIndex.emplace(queue.port, portKeys.size());
+        if (port.second)
+        {
+            portKeys.push_back(queue.port);
+        }
+        queuePorts.push_back(port.first->second);
+    }
+
+    vector<string> queueValues, portValues;
+    vector<uint8_t> queuePresent, portPresent;
+    // Read in the same round trips, syncd can still update the counters
+    // between two hashes, as it could between the reads of the Lua scripts
+    CounterReader::read({
+        { m_queueReader.get(), &queueKeys, &queueValues, &queuePresent },
+        { m_portReader.get(), &portKeys, &portValues, &portPresent },
+    });
+
+    const size_t queueWidth = m_queueReader->getFields().size();
+    const size_t portWidth = m_portReader->getFields().size();
+
+    for (size_t q = 0; q < queues.size(); q++)
+    {
+        const string *values = &queueValues[q * queueWidth];
+        const uint8_t *present = &queuePresent[q * queueWidth];
+        uint32_t flags = 0;
+
+        if (present[QUEUE_OCCUPANCY])
+        {
+            flags |= CounterReader::parseCounter(values[QUEUE_OCCUPANCY], m_samples.occupancy[q]) ? PfcWdDetector::HAS_OCCUPANCY : 0;
+        }
+        if (present[QUEUE_PACKETS])
+        {
+            flags |= CounterReader::parseCounter(values[QUEUE_PACKETS], m_samples.packets[q]) ? PfcWdDetector::HAS_PACKETS : 0;
+        }
+        if (present[QUEUE_PAUSE_STATUS])
+        {
+            flags |= PfcWdDetector::HAS_PAUSE | (values[QUEUE_PAUSE_STATUS] == "true" ? PfcWdDetector::PAUSED : 0);
+        }
+        if (present[QUEUE_WD_STATUS] && values[QUEUE_WD_STATUS] == "operational")
+        {
+            flags |= PfcWdDetector::OPERATIONAL;
+        }
+        if (present[QUEUE_DEBUG_STORM] && values[QUEUE_DEBUG_STORM] == "enabled")
+        {
+            flags |= PfcWdDetector::DEBUG_STORM;
+        }
+
+        if (queues[q].index < PFC_WD_TC_MAX)
+        {
+            size_t column = queuePorts[q] * portWidth + queues[q].index * PORT_PFC_FIELDS;
+            values = &portValues[column];
+            present = &portPresent[column];
+
+            if (present[PORT_PFC_RX])
+            {
+                flags |= CounterReader::parseCounter(values[PORT_PFC_RX], m_samples.pfcRx[q]) ? PfcWdDetector::HAS_PFC_RX : 0;
+            }
+            if (present[PORT_PFC_DURATION] && !rules.noDuration)
+            {
+                flags |= CounterReader::parseCounter(values[PORT_PFC_DURATION], m_samples.pfcDuration[q]) ? PfcWdDetector::HAS_DURATION : 0;
+            }
+            if (present[PORT_PFC_ON2OFF])
+            {
+                flags |= CounterReader::parseCounter(values[PORT_PFC_ON2OFF], m_samples.pfcOn2Off[q]) ? PfcWdDetector::HAS_ON2OFF : 0;
+            }
+        }
+
+        m_samples.flags[q] = static_cast<uint16_t>(flags);
+    }
+
+    // Time between the last two port counter polls, when syncd records it
+    double counterIntervalUs = 0;
+    if (rules.measuredPollTime)
+    {
+        string value;
+        uint64_t timestamp = 0;
+        if (this->getCountersTable()->hget("TIME_STAMP", "PFC_WD_Port_Counter_time_stamp", value) &&
+            CounterReader::parseCounter(value, timestamp))
+        {
+            if (m_counterTimestamp != 0 && timestamp >= m_counterTimestamp)
+            {
+                counterIntervalUs = static_cast<double>(timestamp - m_counterTimestamp) / 1000;
+            }
+            m_counterTimestamp = timestamp;
+        }
+    }
+
+    auto now = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch());
+    vector<PfcWdDetector::Result> results;
+    m_detector->evaluate(m_samples, m_pollInterval * 1000.0, static_cast<uint64_t>(now.count()),
+                         counterIntervalUs, results);
+
+    vector<KeyOpFieldsValuesTuple> updates;
+    m_detector->getUpdates(updates);
+    for (const auto &update : updates)
+    {
+        m_countersTableBatch->set(kfvKey(update), kfvFieldsValues(update));
+    }
+
+    if (!updates.empty())
+    {
+        m_countersPipe->flush();
+    }
+
+    for (const auto &result : results)
+    {
+        string info;
+        for (const auto &fv : result.info)
+        {
+            info += fvField(fv) + ":" + fvValue(fv) + "|";
+        }
+        if (!info.empty())
+        {
+            info.pop_back();
+        }
+
+        sai_object_id_t queueId = SAI_NULL_OBJECT_ID;
+        sai_deserialize_object_id(result.queue, queueId);
+
+        const char *event = result.event == PfcWdDetector::STORM ? "storm" : "restore";
+        if (result.event == PfcWdDetector::STORM)
+        {
+            SWSS_LOG_INFO("PFC storm on queue %s detected %" PRIu64 " ms after it started",
+                          result.queue.c_str(), result.latencyUs / 1000);
+        }
+
+        if (!startWdActionOnQueue(event, queueId, info))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue %s", event, result.queue.c_str());
+        }
+    }
+
+    const auto &stats = m_detector->getStats();
+    // Wall clock, the time is mostly spent waiting for redis. The CPU time
+    // is what the poll itself costs the orchagent thread.
+    double elapsedUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    double cpuUs = getThreadCpuTimeUs() - cpuStartUs;
+    if (updateDetectionStats(stats, elapsedUs, cpuUs))
+    {
+        m_countersPipe->flush();
+    }
+
+    SWSS_LOG_DEBUG("PFC watchdog checked %zu queues for storms and %zu for restoration, %zu deferred, in %.0f us, %.0f us of CPU",
+                   stats.detecting, stats.restoring, stats.deferred, elapsedUs, cpuUs);
+    if (elapsedUs > m_pollInterval * 1000.0 / 2)
+    {
+        SWSS_LOG_WARN("PFC watchdog took %.0f us to check %zu queues, poll interval is %d ms",
+                      elapsedUs, queues.size(), m_pollInterval);
+    }
+}
+
 template <typename DropHandler, typename ForwardHandler>
 void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_detectionTimer)
+    {
+        detectPfcStorms();
+        return;
+    }
+
     for (auto& handlerPair : m_entryMap)
     {
         if (handlerPair.second.handler != nullptr)
@@ -4,6 +4,8 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetector.h"
+#include "counter_reader.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -124,6 +126,9 @@ private:
             uint32_t detectionTime, uint32_t restorationTime, PfcWdAction action, string pfcStatHistory);
     void unregisterFromWdDb(const Port& port);
     void doTask(swss::NotificationConsumer &wdNotification);
+    void detectPfcStorms(void);
+    // Adds the stats of a poll to the totals, true if they were queued for writing
+    bool updateDetectionStats(const PfcWdDetector::Stats &stats, double elapsedUs, double cpuUs);
 
     unordered_set<string> filterPfcCounters(const unordered_set<string> &counters, set<uint8_t>& losslessTc);
     string getFlexCounterTableKey(string s);
@@ -144,6 +149,34 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // Created for the platform once the first queue is watched
+    unique_ptr<PfcWdDetector> m_detector;
+    PfcWdDetector::Samples m_samples;
+    // Pipelined reads of the queue and port counters the detector uses
+    unique_ptr<CounterReader> m_queueReader;
+    unique_ptr<CounterReader> m_portReader;
+    // PFC_STAT_HISTORY estimates are written in one round trip
+    unique_ptr<RedisPipeline> m_countersPipe;
+    unique_ptr<Table> m_countersTableBatch;
+
+    // Totals of every poll since orchagent started, written to
+    // COUNTERS_DB PFC_WD_DETECTION_STATS every few polls
+    struct DetectionStats
+    {
+        uint64_t polls = 0;
+        uint64_t deferred = 0;
+        uint64_t storms = 0;
+        uint64_t restores = 0;
+        double elapsedUs = 0;
+        double cpuUs = 0;
+        double maxElapsedUs = 0;
+        double maxCpuUs = 0;
+    };
+    DetectionStats m_detectionStats;
+    unique_ptr<Table> m_detectionStatsTable;
+    SelectableTimer *m_detectionTimer = nullptr;
+    uint64_t m_counterTimestamp = 0;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../port.h"
+
+// Ports keyed by alias, in alias order for iteration, with a hashed index for lookups.
+// The index holds map iterators, which stay valid until their entry is erased,
+// so the map is only reachable through this class, or read-only through getPorts()
+class PortTable final
+{
+public:
+    typedef std::map<std::string, swss::Port> Map;
+    typedef Map::value_type value_type;
+    typedef Map::size_type size_type;
+    typedef Map::iterator iterator;
+    typedef Map::const_iterator const_iterator;
+
+    PortTable() = default;
+    ~PortTable() = default;
+
+    PortTable(const PortTable &other) : m_ports(other.m_ports)
+    {
+        reindex();
+    }
+
+    PortTable(PortTable &&other) : m_ports(std::move(other.m_ports))
+    {
+        reindex();
+        other.clear();
+    }
+
+    PortTable& operator=(const PortTable &other)
+    {
+        m_ports = other.m_ports;
+        reindex();
+        return *this;
+    }
+
+    PortTable& operator=(PortTable &&other)
+    {
+        m_ports = std::move(other.m_ports);
+        reindex();
+        other.clear();
+        return *this;
+    }
+
+    const Map& getPorts() const
+    {
+        return m_ports;
+    }
+
+    iterator begin()
+    {
+        return m_ports.begin();
+    }
+
+    const_iterator begin() const
+    {
+        return m_ports.begin();
+    }
+
+    iterator end()
+    {
+        return m_ports.end();
+    }
+
+    const_iterator end() const
+    {
+        return m_ports.end();
+    }
+
+    bool empty() const
+    {
+        return m_ports.empty();
+    }
+
+    size_type size() const
+    {
+        return m_ports.size();
+    }
+
+    iterator find(const std::string &alias)
+    {
+        auto it = m_index.find(alias);
+        return it == m_index.end() ? end() : it->second;
+    }
+
+    const_iterator find(const std::string &alias) const
+    {
+        auto it = m_index.find(alias);
+        return it == m_index.end() ? end() : const_iterator(it->second);
+    }
+
+    size_type count(const std::string &alias) const
+    {
+        return m_index.count(alias);
+    }
+
+    swss::Port& at(const std::string &alias)
+    {
+        return m_index.at(alias)->second;
+    }
+
+    const swss::Port& at(const std::string &alias) const
+    {
+        return m_index.at(alias)->second;
+    }
+
+    swss::Port& operator[](const std::string &alias)
+    {
+        auto it = m_index.find(alias);
+        if (it != m_index.end())
+        {
+            return it->second->second;
+        }
+
+        auto entry = m_ports.emplace(alias, swss::Port()).first;
+        m_index.emplace(alias, entry);
+        return entry->second;
+    }
+
+    std::pair<iterator, bool> emplace(const std::string &alias, const swss::Port &port)
+    {
+        auto result = m_ports.emplace(alias, port);
+        if (result.second)
+        {
+            m_index.emplace(alias, result.first);
+        }
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value)
+    {
+        return emplace(value.first, value.second);
+    }
+
+    iterator erase(iterator it)
+    {
+        m_index.erase(it->first);
+        return m_ports.erase(it);
+    }
+
+    size_type erase(const std::string &alias)
+    {
+        auto it = m_index.find(alias);
+        if (it == m_index.end())
+        {
+            return 0;
+        }
+
+        m_ports.erase(it->second);
+        m_index.erase(it);
+        return 1;
+    }
+
+    void clear()
+    {
+        m_index.clear();
+        m_ports.clear();
+    }
+
+private:
+    void reindex()
+    {
+        m_index.clear();
+        m_index.reserve(m_ports.size());
+        for (auto it = m_ports.begin(); it != m_ports.end(); ++it)
+        {
+            m_index.emplace(it->first, it);
+        }
+    }
+
+    Map m_ports;
+    std::unordered_map<std::string, iterator> m_index;
+};
@@ -12,6 +12,7 @@
 #include "subintf.h"
 #include "notifications.h"
 #include "stporch.h"
+#include "bulker.h"
 
 #include <inttypes.h>
 #include <cassert>
@@ -46,6 +47,7 @@ extern sai_switch_api_t *sai_switch_api;
 extern sai_bridge_api_t *sai_bridge_api;
 extern sai_port_api_t *sai_port_api;
 extern sai_vlan_api_t *sai_vlan_api;
+extern size_t gMaxBulkSize;
 extern sai_lag_api_t *sai_lag_api;
 extern sai_hostif_api_t* sai_hostif_api;
 extern sai_acl_api_t* sai_acl_api;
@@ -78,7 +80,10 @@ extern event_handle_t g_events_handle;
 #define MAX_VALID_VLAN_ID   4094
 #define DEFAULT_HOSTIF_TX_QUEUE 7
 
+#define STATE_PORT_INIT_TIMELINE_TABLE_NAME "PORT_INIT_TIMELINE"
+
 #define PORT_SPEED_LIST_DEFAULT_SIZE                     16
+#define PORT_SUPPORTED_SPEED_LIST_SIZE_GUESS             25
 #define PORT_STATE_POLLING_SEC                            5
 #define PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS     1000
 #define PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS     60000
@@ -165,6 +170,13 @@ static map<string, sai_port_internal_loopback_mode_t> loopback_mode_map =
     { "mac", SAI_PORT_INTERNAL_LOOPBACK_MODE_MAC }
 };
 
+static map<string, sai_vlan_tagging_mode_t> tagging_mode_map =
+{
+    { "untagged", SAI_VLAN_TAGGING_MODE_UNTAGGED },
+    { "tagged", SAI_VLAN_TAGGING_MODE_TAGGED },
+    { "priority_tagged", SAI_VLAN_TAGGING_MODE_PRIORITY_TAGGED }
+};
+
 static map<string, int> autoneg_mode_map =
 {
     { "on", 1 },
@@ -701,7 +713,15 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     /* Initialize port and vlan table */
     m_portTable = unique_ptr<Table>(new Table(db, APP_PORT_TABLE_NAME));
+
+    /* Initialize buffered tables for batched port state updates */
+    m_appPortStatePipe = unique_ptr<RedisPipeline>(new RedisPipeline(db));
+    m_statePortStatePipe = unique_ptr<RedisPipeline>(new RedisPipeline(stateDb));
+    m_portTableBatch = unique_ptr<Table>(new Table(m_appPortStatePipe.get(), APP_PORT_TABLE_NAME, true));
+    m_portStateTableBatch = unique_ptr<Table>(new Table(m_statePortStatePipe.get(), STATE_PORT_TABLE_NAME, true));
+    m_portOpErrTableBatch = unique_ptr<Table>(new Table(m_statePortStatePipe.get(), STATE_PORT_OPER_ERR_TABLE_NAME, true));
     m_sendToIngressPortTable = unique_ptr<Table>(new Table(db, APP_SEND_TO_INGRESS_PORT_TABLE_NAME));
+    m_portInitTimelineTable = unique_ptr<Table>(new Table(stateDb, STATE_PORT_INIT_TIMELINE_TABLE_NAME));
 
     /* Initialize gearbox */
     m_gearboxTable = unique_ptr<Table>(new Table(db, "_GEARBOX_TABLE"));
@@ -718,6 +738,17 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     m_pgPortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_PORT_MAP));
     m_pgIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_INDEX_MAP));
 
+    m_queueCounterStats = generateCounterStats(queue_stat_ids, sai_serialize_queue_stat);
+    m_voqCounterStats = m_queueCounterStats;
+    for (const auto& it: voq_stat_ids)
+    {
+        m_voqCounterStats.emplace(sai_serialize_queue_stat(it));
+    }
+    m_queueWatermarkCounterStats = generateCounterStats(queueWatermarkStatIds, sai_serialize_queue_stat);
+    m_wredQueueCounterStats = generateCounterStats(wred_queue_stat_ids, sai_serialize_queue_stat);
+    m_pgDropCounterStats = generateCounterStats(ingressPriorityGroupDropStatIds, sai_serialize_ingress_priority_group_stat);
+    m_pgWatermarkCounterStats = generateCounterStats(ingressPriorityGroupWatermarkStatIds, sai_serialize_ingress_priority_group_stat);
+
     m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateBufferMaximumValueTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE));
 
@@ -727,23 +758,11 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     initGearbox();
 
-    string queueWmSha, pgWmSha, portRateSha, nvdaPortTrimSha;
-    string queueWmPluginName = "watermark_queue.lua";
-    string pgWmPluginName = "watermark_pg.lua";
-    string portRatePluginName = "port_rates.lua";
+    string nvdaPortTrimSha;
     string nvdaPortTrimPluginName = "nvda_port_trim_drop.lua";
 
     try
     {
-        string queueLuaScript = swss::loadLuaScript(queueWmPluginName);
-        queueWmSha = swss::loadRedisScript(m_counter_db.get(), queueLuaScript);
-
-        string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
-        pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
-
-        string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
-        portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
-
         string nvdaPortTrimLuaScript = swss::loadLuaScript(nvdaPortTrimPluginName);
         nvdaPortTrimSha = swss::loadRedisScript(m_counter_db.get(), nvdaPortTrimLuaScript);
     }
@@ -752,7 +771,8 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         SWSS_LOG_ERROR("Port flex counter groups were not set successfully: %s", e.what());
     }
 
-    std::string portStatPlugins = portRateSha;
+    // Port rates are computed by CounterRateOrch
+    std::string portStatPlugins;
 
     // Nvidia custom trim stat calculation
     if (isMlnxPlatform() && \
@@ -760,20 +780,21 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         isPortStatSupported(SAI_PORT_STAT_TX_TRIM_PACKETS) && \
         !isPortStatSupported(SAI_PORT_STAT_DROPPED_TRIM_PACKETS))
     {
-        portStatPlugins += "," + nvdaPortTrimSha;
+        portStatPlugins = nvdaPortTrimSha;
     }
 
+    // Watermark views are aggregated by WatermarkOrch
     setFlexCounterGroupParameter(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS,
                                  STATS_MODE_READ_AND_CLEAR,
                                  QUEUE_PLUGIN_FIELD,
-                                 queueWmSha);
+                                 "");
 
     setFlexCounterGroupParameter(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS,
                                  STATS_MODE_READ_AND_CLEAR,
                                  PG_PLUGIN_FIELD,
-                                 pgWmSha);
+                                 "");
 
     setFlexCounterGroupParameter(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS,
@@ -1640,9 +1661,9 @@ bool PortsOrch::isPortAdminUp(const string &alias)
     return it->second.m_admin_state_up;
 }
 
-map<string, Port>& PortsOrch::getAllPorts()
+const map<string, Port>& PortsOrch::getAllPorts()
 {
-    return m_portList;
+    return m_portList.getPorts();
 }
 
 unordered_set<string>& PortsOrch::getAllVlans()
@@ -1654,13 +1675,14 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
     {
         return false;
     }
     else
     {
-        p = m_portList[alias];
+        p = it->second;
         return true;
     }
 }
@@ -1676,10 +1698,12 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
     }
     else
     {
-        if (!getPort(itr->second, port))
+        auto it = m_portList.find(itr->second);
+        if (it == m_portList.end())
         {
             SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
         }
+        port = it->second;
         return true;
     }
 
@@ -1861,7 +1885,11 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
     }
     else
     {
-        getPort(itr->second, port);
+        auto it = m_portList.find(itr->second);
+        if (it != m_portList.end())
+        {
+            port = it->second;
+        }
         return true;
     }
 
@@ -2984,9 +3012,7 @@ void PortsOrch::getPortSupportedSpeeds(const std::string& alias, sai_object_id_t
 {
     sai_attribute_t attr;
     sai_status_t status;
-    const auto size_guess = 25; // Guess the size which could be enough
-
-    PortSupportedSpeeds speeds(size_guess);
+    PortSupportedSpeeds speeds(PORT_SUPPORTED_SPEED_LIST_SIZE_GUESS); // Guess the size which could be enough
 
     // two attempts to get our value, first with the guess, other with the returned value
     for (int attempt = 0; attempt < 2; ++attempt)
@@ -3046,11 +3072,16 @@ void PortsOrch::initPortSupportedSpeeds(const std::string& alias, sai_object_id_
     }
     PortSupportedSpeeds supported_speeds;
     getPortSupportedSpeeds(alias, port_id, supported_speeds);
+    setPortSupportedSpeeds(alias, port_id, supported_speeds);
+}
+
+void PortsOrch::setPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, const PortSupportedSpeeds &supported_speeds)
+{
     m_portSupportedSpeeds[port_id] = supported_speeds;
     vector<FieldValueTuple> v;
     std::string supported_speeds_str = swss::join(',', supported_speeds.begin(), supported_speeds.end());
     v.emplace_back(std::make_pair("supported_speeds", supported_speeds_str));
-    m_portStateTable.set(alias, v);
+    portStateTable().set(alias, v);
 }
 
 
@@ -3153,19 +3184,29 @@ void PortsOrch::initPortSupportedFecModes(const std::string& alias, sai_object_i
         return;
     }
 
-    auto &obj = m_portSupportedFecModes[port_id];
-    auto &supported_fec_modes = obj.data;
+    PortSupportedFecModes supported_fec_modes;
 
     auto status = getPortSupportedFecModes(supported_fec_modes, port_id);
     if (status != SAI_STATUS_SUCCESS)
     {
+        m_portSupportedFecModes[port_id].supported = false;
+
         // Do not expose "supported_fecs" in case fetching FEC modes is not supported by the vendor
         SWSS_LOG_INFO("No supported_fecs exposed to STATE_DB for port %s since fetching supported FEC modes is not supported by the vendor",
                       alias.c_str());
         return;
     }
 
+    setPortSupportedFecModes(alias, port_id, supported_fec_modes);
+}
+
+void PortsOrch::setPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id, const PortSupportedFecModes &supported_fec_modes)
+{
+    SWSS_LOG_ENTER();
+
+    auto &obj = m_portSupportedFecModes[port_id];
     obj.supported = true;
+    obj.data = supported_fec_modes;
 
     std::vector<std::string> fecModeList;
     if (supported_fec_modes.empty())
@@ -3198,7 +3239,7 @@ void PortsOrch::initPortSupportedFecModes(const std::string& alias, sai_object_i
     std::string supported_fec_modes_str = swss::join(',', fecModeList.begin(), fecModeList.end());
     v.emplace_back(std::make_pair("supported_fecs", supported_fec_modes_str));
 
-    m_portStateTable.set(alias, v);
+    portStateTable().set(alias, v);
 }
 
 /*
@@ -3741,7 +3782,7 @@ void PortsOrch::updateDbPortFlapCount(Port& port, sai_port_oper_status_t pstatus
         FieldValueTuple tuple("last_up_time", buffer);
         tuples.push_back(tuple);
     }
-    m_portTable->set(port.m_alias, tuples);
+    portTable().set(port.m_alias, tuples);
 }
 
 void PortsOrch::updateDbPortOperError(Port& port, PortOperErrorEvent *pevent)
@@ -3764,7 +3805,7 @@ void PortsOrch::updateDbPortOperError(Port& port, PortOperErrorEvent *pevent)
     FieldValueTuple tup4(key + "_time", time);
     tuples.push_back(tup4);
 
-    m_portOpErrTable.set(port.m_alias, tuples);
+    portOpErrTable().set(port.m_alias, tuples);
 }
 
 void PortsOrch::updateDbPortOperStatus(const Port& port, sai_port_oper_status_t status) const
@@ -3781,7 +3822,36 @@ void PortsOrch::updateDbPortOperStatus(const Port& port, sai_port_oper_status_t
     vector<FieldValueTuple> tuples;
     FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
     tuples.push_back(tuple);
-    m_portTable->set(port.m_alias, tuples);
+    portTable().set(port.m_alias, tuples);
+}
+
+Table& PortsOrch::portTable() const
+{
+    return m_portStateBatch ? *m_portTableBatch : *m_portTable;
+}
+
+Table& PortsOrch::portStateTable()
+{
+    return m_portStateBatch ? *m_portStateTableBatch : m_portStateTable;
+}
+
+Table& PortsOrch::portOpErrTable()
+{
+    return m_portStateBatch ? *m_portOpErrTableBatch : m_portOpErrTable;
+}
+
+void PortsOrch::beginPortStateBatch()
+{
+    m_portStateBatch = true;
+}
+
+void PortsOrch::flushPortStateBatch()
+{
+    SWSS_LOG_ENTER();
+
+    m_appPortStatePipe->flush();
+    m_statePortStatePipe->flush();
+    m_portStateBatch = false;
 }
 
 sai_status_t PortsOrch::removePort(sai_object_id_t port_id)
@@ -3859,7 +3929,9 @@ string PortsOrch::getWredQueueFlexCounterTableKey(string key)
     return string(WRED_QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
 }
 
-bool PortsOrch::initExistingPort(const PortConfig& port)
+// Builds a port object for a port the switch already has and appends it to
+// ports, which the caller then initializes in bulk with initPortsBulk()
+bool PortsOrch::initExistingPort(const PortConfig& port, std::vector<Port>& ports)
 {
     SWSS_LOG_ENTER();
 
@@ -3904,8 +3976,8 @@ bool PortsOrch::initExistingPort(const PortConfig& port)
         return false;
     }
 
-    std::vector<Port> ports = {p};
-    return initPortsBulk(ports);
+    ports.push_back(p);
+    return true;
 }
 
 bool PortsOrch::initPortsBulk(std::vector<Port>& ports)
@@ -3916,25 +3988,46 @@ bool PortsOrch::initPortsBulk(std::vector<Port>& ports)
 
     SWSS_LOG_TIMER(__FUNCTION__);
 
+    auto start = std::chrono::steady_clock::now();
     if (!initializePorts(ports))
     {
         status = false;
     }
+    recordPortInitPhase("initialize", start, ports.size());
 
-    for (auto& p: ports)
+    if (!m_isWarmRestoreStage)
     {
-        const auto& alias = p.m_alias;
+        start = std::chrono::steady_clock::now();
+        initPortCapabilitiesBulk(ports);
+        recordPortInitPhase("capabilities", start, ports.size());
+    }
 
+    start = std::chrono::steady_clock::now();
+    for (auto& p: ports)
+    {
         registerPort(p);
+    }
+    recordPortInitPhase("register", start, ports.size());
 
-        if (!m_isWarmRestoreStage)
+    if (!m_isWarmRestoreStage)
+    {
+        start = std::chrono::steady_clock::now();
+        beginPortStateBatch();
+        for (auto& p: ports)
         {
-            postPortInit(m_portList[alias]);
+            postPortInit(m_portList[p.m_alias]);
         }
+        flushPortStateBatch();
+        recordPortInitPhase("post_init", start, ports.size());
+    }
 
-        SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
+    for (const auto& p: ports)
+    {
+        SWSS_LOG_NOTICE("Initialized port %s", p.m_alias.c_str());
     }
 
+    publishPortInitTimeline();
+
     return status;
 }
 
@@ -4361,6 +4454,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             {
                 std::vector<PortConfig> portsToAddList;
                 std::vector<sai_object_id_t> portsToRemoveList;
+                std::vector<Port> existingPorts;
 
                 // Port remove comparison logic
                 for (auto it = m_portListLaneMap.begin(); it != m_portListLaneMap.end();)
@@ -4394,7 +4488,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         continue;
                     }
 
-                    if (!initExistingPort(it->second))
+                    if (!initExistingPort(it->second, existingPorts))
                     {
                         // Failure has been recorded in initExistingPort
                         it++;
@@ -4404,14 +4498,22 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     it++;
                 }
 
+                // Bulk init of the ports the switch already has
+                if (!existingPorts.empty())
+                {
+                    initPortsBulk(existingPorts);
+                }
+
                 // Bulk port add
                 if (!portsToAddList.empty())
                 {
                     std::vector<Port> addedPorts;
+                    auto start = std::chrono::steady_clock::now();
                     if (!addPortBulk(portsToAddList, addedPorts))
                     {
                         SWSS_LOG_THROW("PortsOrch initialization failure");
                     }
+                    recordPortInitPhase("create", start, addedPorts.size());
 
                     initPortsBulk(addedPorts);
                 }
@@ -5473,6 +5575,24 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /*
+     * Members are removed in one bulk and then added in another. A DEL still
+     * runs before a SET for the same key, the only order in which the consumer
+     * keeps both of them.
+     */
+    set<string> addingPorts;
+    doVlanMemberTask(consumer, DEL_COMMAND, addingPorts);
+    doVlanMemberTask(consumer, SET_COMMAND, addingPorts);
+}
+
+void PortsOrch::doVlanMemberTask(Consumer &consumer, const string &pass_op, set<string> &addingPorts)
+{
+    SWSS_LOG_ENTER();
+
+    ObjectBulker<sai_vlan_api_t> bulker(sai_vlan_api, gSwitchId, gMaxBulkSize);
+    std::list<VlanMemberContext> members;
+    set<string> newBridgePorts;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -5528,6 +5648,13 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
+            if (pass_op != SET_COMMAND)
+            {
+                addingPorts.insert(port_alias);
+                it++;
+                continue;
+            }
+
             string tagging_mode = "untagged";
 
             for (auto i : kfvFieldsValues(t))
@@ -5536,9 +5663,8 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
                     tagging_mode = fvValue(i);
             }
 
-            if (tagging_mode != "untagged" &&
-                tagging_mode != "tagged"   &&
-                tagging_mode != "priority_tagged")
+            auto sai_tagging_mode = tagging_mode_map.find(tagging_mode);
+            if (sai_tagging_mode == tagging_mode_map.end())
             {
                 SWSS_LOG_ERROR("Wrong tagging_mode '%s' for key: %s", tagging_mode.c_str(), kfvKey(t).c_str());
                 it = consumer.m_toSync.erase(it);
@@ -5552,31 +5678,52 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addBridgePort(port) && addVlanMember(vlan, port, tagging_mode))
-                it = consumer.m_toSync.erase(it);
-            else
+            /* The bridge port is created right away, members only refer to it */
+            bool newBridgePort = port.m_bridge_port_id == SAI_NULL_OBJECT_ID;
+            if (!addBridgePort(port))
+            {
                 it++;
+                continue;
+            }
+            if (newBridgePort)
+            {
+                newBridgePorts.insert(port_alias);
+            }
+
+            members.emplace_back(it, vlan_alias, port_alias, sai_tagging_mode->second);
+            auto &ctx = members.back();
+
+            vector<sai_attribute_t> attrs;
+            getVlanMemberAttrs(vlan, port, ctx.tagging_mode, attrs);
+            bulker.create_entry(&ctx.vlan_member_id, &ctx.status, (uint32_t)attrs.size(), attrs.data());
+            it++;
         }
         else if (op == DEL_COMMAND)
         {
-            if (vlan.m_members.find(port_alias) != vlan.m_members.end())
+            if (pass_op != DEL_COMMAND)
             {
-                if (removeVlanMember(vlan, port))
-                {
-                    if (m_portVlanMember[port.m_alias].empty())
-                    {
-                        removeBridgePort(port);
-                    }
-                    it = consumer.m_toSync.erase(it);
-                }
-                else
-                {
-                    it++;
-                }
+                it++;
+                continue;
             }
-            else
+
+            if (vlan.m_members.find(port_alias) == vlan.m_members.end())
+            {
                 /* Cannot locate the VLAN */
                 it = consumer.m_toSync.erase(it);
+                continue;
+            }
+
+            auto vlan_member = m_portVlanMember[port_alias].find(vlan.m_vlan_info.vlan_id);
+
+            /* Assert the port belongs to this VLAN */
+            assert (vlan_member != m_portVlanMember[port_alias].end());
+
+            members.emplace_back(it, vlan_alias, port_alias, vlan_member->second.vlan_mode);
+            auto &ctx = members.back();
+
+            ctx.vlan_member_id = vlan_member->second.vlan_member_id;
+            bulker.remove_entry(&ctx.status, ctx.vlan_member_id);
+            it++;
         }
         else
         {
@@ -5584,6 +5731,83 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    bulker.flush();
+
+    for (auto &ctx: members)
+    {
+        if (ctx.status == SAI_STATUS_NOT_EXECUTED)
+        {
+            /* Not run because an earlier entry of the bulk failed, retry */
+            continue;
+        }
+
+        /* Members of the same VLAN or port update them, so take the current copies */
+        Port vlan, port;
+        getPort(ctx.vlan_alias, vlan);
+        getPort(ctx.port_alias, port);
+
+        if (ctx.status != SAI_STATUS_SUCCESS)
+        {
+            task_process_status handle_status;
+            if (pass_op == SET_COMMAND)
+            {
+                SWSS_LOG_ERROR("Failed to add member %s to VLAN %s vid:%hu pid:%" PRIx64,
+                        port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
+                handle_status = handleSaiCreateStatus(SAI_API_VLAN, ctx.status);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to remove member %s from VLAN %s vid:%hx vmid:%" PRIx64,
+                        port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, ctx.vlan_member_id);
+                handle_status = handleSaiRemoveStatus(SAI_API_VLAN, ctx.status);
+            }
+
+            if (handle_status != task_success)
+            {
+                if (parseHandleSaiStatusFailure(handle_status))
+                {
+                    consumer.m_toSync.erase(ctx.task);
+                }
+                continue;
+            }
+        }
+
+        if (pass_op == SET_COMMAND)
+        {
+            if (!addVlanMemberPost(vlan, port, ctx.vlan_member_id, ctx.tagging_mode))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            if (!removeVlanMemberPost(vlan, port))
+            {
+                continue;
+            }
+
+            /* Keep the bridge port of a port that joins another VLAN in this run */
+            if (!hasVlanMembership(port.m_alias) &&
+                addingPorts.find(port.m_alias) == addingPorts.end())
+            {
+                removeBridgePort(port);
+            }
+        }
+
+        consumer.m_toSync.erase(ctx.task);
+    }
+
+    /* Roll back the bridge ports created for members that all failed */
+    for (const auto &alias: newBridgePorts)
+    {
+        Port port;
+        if (getPort(alias, port) && !hasVlanMembership(alias))
+        {
+            SWSS_LOG_NOTICE("No VLAN member of %s was added, removing its bridge port", alias.c_str());
+            removeBridgePort(port);
+        }
+    }
 }
 
 void PortsOrch::doTransceiverPresenceCheck(Consumer &consumer)
@@ -5854,8 +6078,24 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /*
+     * Members are removed in one bulk and then added in another, so a port
+     * that moves to another LAG in the same drain leaves the old one first.
+     */
+    doLagMemberTask(consumer, DEL_COMMAND);
+    doLagMemberTask(consumer, SET_COMMAND);
+}
+
+void PortsOrch::doLagMemberTask(Consumer &consumer, const string &pass_op)
+{
+    SWSS_LOG_ENTER();
+
     string table_name = consumer.getTableName();
 
+    ObjectBulker<sai_lag_api_t> bulker(sai_lag_api, gSwitchId, gMaxBulkSize);
+    std::list<LagMemberContext> members;
+    set<string> addingPorts;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -5875,6 +6115,13 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
 
         string op = kfvOp(t);
 
+        /* Each pass only handles its own operation */
+        if ((op == SET_COMMAND || op == DEL_COMMAND) && op != pass_op)
+        {
+            it++;
+            continue;
+        }
+
         Port lag, port;
         if (!getPort(lag_alias, lag))
         {
@@ -5942,18 +6189,30 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
 
             if (lag.m_members.find(port_alias) == lag.m_members.end())
             {
-                if (port.m_lag_member_id != SAI_NULL_OBJECT_ID)
+                if (port.m_lag_member_id != SAI_NULL_OBJECT_ID ||
+                    addingPorts.find(port_alias) != addingPorts.end())
                 {
                     SWSS_LOG_INFO("Port %s is already a LAG member", port.m_alias.c_str());
                     it++;
                     continue;
                 }
 
-                if (!addLagMember(lag, port, status))
+                sai_uint32_t pvid;
+                if (getPortPvid(lag, pvid) && setPortPvid(port, pvid))
                 {
-                    it++;
-                    continue;
+                    m_portList[port_alias].m_port_vlan_id = port.m_port_vlan_id;
                 }
+
+                /* The member is created with its collection and distribution state */
+                addingPorts.insert(port_alias);
+                members.emplace_back(it, lag_alias, port_alias, status);
+                auto &ctx = members.back();
+
+                vector<sai_attribute_t> attrs;
+                getLagMemberAttrs(lag, port, status == "enabled", attrs);
+                bulker.create_entry(&ctx.lag_member_id, &ctx.status, (uint32_t)attrs.size(), attrs.data());
+                it++;
+                continue;
             }
 
             if ((gMySwitchType == "voq") && (port.m_type != Port::SYSTEM))
@@ -5962,39 +6221,14 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
                voqSyncAddLagMember(lag, port, status);
             }
 
-            /* Sync an enabled member */
-            if (status == "enabled")
+            /* Sync an enabled or disabled member */
+            if (setForwardingOnLagMember(port, status == "enabled"))
             {
-                /* enable collection first, distribution-only mode
-                 * is not supported on Mellanox platform
-                 */
-                if (setCollectionOnLagMember(port, true) &&
-                    setDistributionOnLagMember(port, true))
-                {
-                    it = consumer.m_toSync.erase(it);
-                }
-                else
-                {
-                    it++;
-                    continue;
-                }
+                it = consumer.m_toSync.erase(it);
             }
-            /* Sync an disabled member */
-            else /* status == "disabled" */
+            else
             {
-                /* disable distribution first, distribution-only mode
-                 * is not supported on Mellanox platform
-                 */
-                if (setDistributionOnLagMember(port, false) &&
-                    setCollectionOnLagMember(port, false))
-                {
-                    it = consumer.m_toSync.erase(it);
-                }
-                else
-                {
-                    it++;
-                    continue;
-                }
+                it++;
             }
         }
         /* Remove a LAG member */
@@ -6011,20 +6245,84 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (removeLagMember(lag, port))
+            members.emplace_back(it, lag_alias, port_alias, "");
+            auto &ctx = members.back();
+
+            ctx.lag_member_id = port.m_lag_member_id;
+            bulker.remove_entry(&ctx.status, ctx.lag_member_id);
+            it++;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+            it = consumer.m_toSync.erase(it);
+        }
+    }
+
+    bulker.flush();
+
+    for (auto &ctx: members)
+    {
+        if (ctx.status == SAI_STATUS_NOT_EXECUTED)
+        {
+            /* Not run because an earlier entry of the bulk failed, retry */
+            continue;
+        }
+
+        /* Members of the same LAG update it, so take the current copies */
+        Port lag, port;
+        getPort(ctx.lag_alias, lag);
+        getPort(ctx.port_alias, port);
+
+        if (ctx.status != SAI_STATUS_SUCCESS)
+        {
+            task_process_status handle_status;
+            if (pass_op == SET_COMMAND)
             {
-                it = consumer.m_toSync.erase(it);
+                SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
+                        port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
+                handle_status = handleSaiCreateStatus(SAI_API_LAG, ctx.status);
             }
             else
             {
-                it++;
+                SWSS_LOG_ERROR("Failed to remove member %s from LAG %s lid:%" PRIx64 " lmid:%" PRIx64,
+                        port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, ctx.lag_member_id);
+                handle_status = handleSaiRemoveStatus(SAI_API_LAG, ctx.status);
+            }
+
+            if (handle_status != task_success)
+            {
+                if (parseHandleSaiStatusFailure(handle_status))
+                {
+                    consumer.m_toSync.erase(ctx.task);
+                }
+                continue;
+            }
+        }
+
+        if (pass_op == SET_COMMAND)
+        {
+            if (!addLagMemberPost(lag, port, ctx.lag_member_id, ctx.member_status))
+            {
+                continue;
+            }
+
+            /* System port members are created without the disable attributes */
+            if (port.m_type == Port::SYSTEM &&
+                !setForwardingOnLagMember(port, ctx.member_status == "enabled"))
+            {
+                continue;
             }
         }
         else
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            if (!removeLagMemberPost(lag, port))
+            {
+                continue;
+            }
         }
+
+        consumer.m_toSync.erase(ctx.task);
     }
 }
 
@@ -6037,16 +6335,34 @@ void PortsOrch::onWarmBootEnd()
     /* Start dynamic state sync up */
     refreshPortStatus();
 
-    // Do post boot port initialization
-    for (auto& it: m_portList)
+    std::vector<Port> ports;
+    for (const auto& it: m_portList)
     {
-        Port& port = it.second;
-
-        if (port.m_type == Port::PHY)
+        if (it.second.m_type == Port::PHY)
         {
-            postPortInit(it.second);
+            ports.push_back(it.second);
         }
     }
+
+    auto start = std::chrono::steady_clock::now();
+    initPortCapabilitiesBulk(ports);
+    for (const auto& p: ports)
+    {
+        m_portList[p.m_alias].m_cap_an = p.m_cap_an;
+    }
+    recordPortInitPhase("capabilities", start, ports.size());
+
+    // Do post boot port initialization
+    start = std::chrono::steady_clock::now();
+    beginPortStateBatch();
+    for (const auto& p: ports)
+    {
+        postPortInit(m_portList[p.m_alias]);
+    }
+    flushPortStateBatch();
+    recordPortInitPhase("post_init", start, ports.size());
+
+    publishPortInitTimeline();
 }
 
 void PortsOrch::postPortInit(Port& p)
@@ -6375,7 +6691,7 @@ void PortsOrch::initializePortMtuBulk(std::vector<Port>& ports)
     }
 }
 
-void PortsOrch::initializePriorityGroupsBulk(std::vector<Port>& ports)
+void PortsOrch::initPortCapabilitiesBulk(std::vector<Port>& ports)
 {
     SWSS_LOG_ENTER();
 
@@ -6383,20 +6699,177 @@ void PortsOrch::initializePriorityGroupsBulk(std::vector<Port>& ports)
 
     const auto portCount = static_cast<uint32_t>(ports.size());
 
-    // Query number of ingress priority groups
+    // Ports the bulk get could not answer are left out of the caches here and
+    // are queried one at a time by postPortInit() and the AN config handling
+
+    // Query supported speeds
     {
         PortBulker bulker(portCount);
+        std::vector<size_t> portIdx;
+        std::vector<PortSupportedSpeeds> speeds(portCount, PortSupportedSpeeds(PORT_SUPPORTED_SPEED_LIST_SIZE_GUESS));
 
-        for (const auto& port: ports)
+        for (size_t idx = 0; idx < portCount; idx++)
         {
+            if (m_portSupportedSpeeds.count(ports[idx].m_port_id))
+            {
+                continue;
+            }
+
             sai_attribute_t attr;
-            attr.id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
-            bulker.add(port.m_port_id, attr);
+            attr.id = SAI_PORT_ATTR_SUPPORTED_SPEED;
+            attr.value.u32list.count = static_cast<uint32_t>(speeds[idx].size());
+            attr.value.u32list.list = speeds[idx].data();
+            bulker.add(ports[idx].m_port_id, attr);
+            portIdx.push_back(idx);
         }
 
         bulker.executeGet();
 
-        for (size_t idx = 0; idx < portCount; idx++)
+        for (size_t idx = 0; idx < bulker.count; idx++)
+        {
+            if (bulker.statuses[idx] != SAI_STATUS_SUCCESS)
+            {
+                continue;
+            }
+
+            const auto& port = ports[portIdx[idx]];
+            auto& supported_speeds = speeds[portIdx[idx]];
+            supported_speeds.resize(bulker.attrList[idx].value.u32list.count);
+            setPortSupportedSpeeds(port.m_alias, port.m_port_id, supported_speeds);
+        }
+    }
+
+    // Query supported FEC modes
+    {
+        PortBulker bulker(portCount);
+        std::vector<size_t> portIdx;
+        std::vector<std::vector<sai_int32_t>> fecModes(portCount, std::vector<sai_int32_t>(Port::max_fec_modes));
+
+        for (size_t idx = 0; idx < portCount; idx++)
+        {
+            if (m_portSupportedFecModes.count(ports[idx].m_port_id))
+            {
+                continue;
+            }
+
+            sai_attribute_t attr;
+            attr.id = SAI_PORT_ATTR_SUPPORTED_FEC_MODE;
+            attr.value.s32list.count = static_cast<uint32_t>(fecModes[idx].size());
+            attr.value.s32list.list = fecModes[idx].data();
+            bulker.add(ports[idx].m_port_id, attr);
+            portIdx.push_back(idx);
+        }
+
+        bulker.executeGet();
+
+        for (size_t idx = 0; idx < bulker.count; idx++)
+        {
+            if (bulker.statuses[idx] != SAI_STATUS_SUCCESS)
+            {
+                continue;
+            }
+
+            const auto& port = ports[portIdx[idx]];
+            const auto& attr = bulker.attrList[idx];
+            PortSupportedFecModes supported_fec_modes;
+            for (uint32_t i = 0; i < attr.value.s32list.count; i++)
+            {
+                supported_fec_modes.insert(static_cast<sai_port_fec_mode_t>(attr.value.s32list.list[i]));
+            }
+            setPortSupportedFecModes(port.m_alias, port.m_port_id, supported_fec_modes);
+        }
+    }
+
+    // Query AN capability
+    {
+        PortBulker bulker(portCount);
+        std::vector<size_t> portIdx;
+
+        for (size_t idx = 0; idx < portCount; idx++)
+        {
+            if (ports[idx].m_cap_an >= 0)
+            {
+                continue;
+            }
+
+            sai_attribute_t attr;
+            attr.id = SAI_PORT_ATTR_SUPPORTED_AUTO_NEG_MODE;
+            bulker.add(ports[idx].m_port_id, attr);
+            portIdx.push_back(idx);
+        }
+
+        bulker.executeGet();
+
+        for (size_t idx = 0; idx < bulker.count; idx++)
+        {
+            if (bulker.statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                ports[portIdx[idx]].m_cap_an = bulker.attrList[idx].value.booldata ? 1 : 0;
+            }
+        }
+    }
+}
+
+void PortsOrch::recordPortInitPhase(const std::string &phase, std::chrono::steady_clock::time_point start, size_t portCount)
+{
+    auto end = std::chrono::steady_clock::now();
+
+    if (m_portInitTimeline.empty())
+    {
+        m_portInitStart = start;
+    }
+
+    auto &entry = m_portInitTimeline[phase];
+    if (entry.runs == 0)
+    {
+        entry.start = start - m_portInitStart;
+    }
+    entry.duration += end - start;
+    entry.ports += portCount;
+    entry.runs++;
+}
+
+void PortsOrch::publishPortInitTimeline()
+{
+    SWSS_LOG_ENTER();
+
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+
+    for (const auto &it : m_portInitTimeline)
+    {
+        const auto &entry = it.second;
+        vector<FieldValueTuple> fvs;
+        fvs.emplace_back("start_ms", to_string(duration_cast<milliseconds>(entry.start).count()));
+        fvs.emplace_back("duration_ms", to_string(duration_cast<milliseconds>(entry.duration).count()));
+        fvs.emplace_back("ports", to_string(entry.ports));
+        fvs.emplace_back("runs", to_string(entry.runs));
+        m_portInitTimelineTable->set(it.first, fvs);
+    }
+}
+
+void PortsOrch::initializePriorityGroupsBulk(std::vector<Port>& ports)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER(__FUNCTION__);
+
+    const auto portCount = static_cast<uint32_t>(ports.size());
+
+    // Query number of ingress priority groups
+    {
+        PortBulker bulker(portCount);
+
+        for (const auto& port: ports)
+        {
+            sai_attribute_t attr;
+            attr.id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
+            bulker.add(port.m_port_id, attr);
+        }
+
+        bulker.executeGet();
+
+        for (size_t idx = 0; idx < portCount; idx++)
         {
             auto& port = ports[idx];
             const auto status = bulker.statuses[idx];
@@ -7111,20 +7584,7 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
         return addVlanFloodGroups(vlan, port, end_point_ip);
     }
 
-    sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
-
-    attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_ID;
-    attr.value.oid = vlan.m_vlan_info.vlan_oid;
-    attrs.push_back(attr);
-
-    attr.id = SAI_VLAN_MEMBER_ATTR_BRIDGE_PORT_ID;
-    attr.value.oid = port.m_bridge_port_id;
-    attrs.push_back(attr);
-
-
     sai_vlan_tagging_mode_t sai_tagging_mode = SAI_VLAN_TAGGING_MODE_TAGGED;
-    attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_TAGGING_MODE;
     if (tagging_mode == "untagged")
         sai_tagging_mode = SAI_VLAN_TAGGING_MODE_UNTAGGED;
     else if (tagging_mode == "tagged")
@@ -7132,8 +7592,9 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
     else if (tagging_mode == "priority_tagged")
         sai_tagging_mode = SAI_VLAN_TAGGING_MODE_PRIORITY_TAGGED;
     else assert(false);
-    attr.value.s32 = sai_tagging_mode;
-    attrs.push_back(attr);
+
+    vector<sai_attribute_t> attrs;
+    getVlanMemberAttrs(vlan, port, sai_tagging_mode, attrs);
 
     sai_object_id_t vlan_member_id;
     sai_status_t status = sai_vlan_api->create_vlan_member(&vlan_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
@@ -7147,6 +7608,32 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
+
+    return addVlanMemberPost(vlan, port, vlan_member_id, sai_tagging_mode);
+}
+
+void PortsOrch::getVlanMemberAttrs(const Port &vlan, const Port &port, sai_vlan_tagging_mode_t tagging_mode, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
+
+    attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_ID;
+    attr.value.oid = vlan.m_vlan_info.vlan_oid;
+    attrs.push_back(attr);
+
+    attr.id = SAI_VLAN_MEMBER_ATTR_BRIDGE_PORT_ID;
+    attr.value.oid = port.m_bridge_port_id;
+    attrs.push_back(attr);
+
+    attr.id = SAI_VLAN_MEMBER_ATTR_VLAN_TAGGING_MODE;
+    attr.value.s32 = tagging_mode;
+    attrs.push_back(attr);
+}
+
+// Completes adding a VLAN member once its SAI object has been created
+bool PortsOrch::addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t sai_tagging_mode)
+{
+    SWSS_LOG_ENTER();
+
     SWSS_LOG_NOTICE("Add member %s to VLAN %s vid:%hu pid%" PRIx64,
             port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
 
@@ -7179,6 +7666,12 @@ bool PortsOrch::getPortVlanMembers(Port &port, vlan_members_t &vlan_members)
     return true;
 }
 
+bool PortsOrch::hasVlanMembership(const string &alias) const
+{
+    auto vlan_members = m_portVlanMember.find(alias);
+    return vlan_members != m_portVlanMember.end() && !vlan_members->second.empty();
+}
+
 bool PortsOrch::addVlanFloodGroups(Port &vlan, Port &port, string end_point_ip)
 {
     SWSS_LOG_ENTER();
@@ -7458,14 +7951,11 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port, string end_point_ip)
     {
         return removeVlanEndPointIp(vlan, port, end_point_ip);
     }
-    sai_object_id_t vlan_member_id;
-    sai_vlan_tagging_mode_t sai_tagging_mode;
     auto vlan_member = m_portVlanMember[port.m_alias].find(vlan.m_vlan_info.vlan_id);
 
     /* Assert the port belongs to this VLAN */
     assert (vlan_member != m_portVlanMember[port.m_alias].end());
-    sai_tagging_mode = vlan_member->second.vlan_mode;
-    vlan_member_id = vlan_member->second.vlan_member_id;
+    sai_object_id_t vlan_member_id = vlan_member->second.vlan_member_id;
 
     sai_status_t status = sai_vlan_api->remove_vlan_member(vlan_member_id);
     if (status != SAI_STATUS_SUCCESS)
@@ -7478,6 +7968,20 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port, string end_point_ip)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
+
+    return removeVlanMemberPost(vlan, port);
+}
+
+// Completes removing a VLAN member once its SAI object has been removed
+bool PortsOrch::removeVlanMemberPost(Port &vlan, Port &port)
+{
+    SWSS_LOG_ENTER();
+
+    auto vlan_member = m_portVlanMember[port.m_alias].find(vlan.m_vlan_info.vlan_id);
+    assert (vlan_member != m_portVlanMember[port.m_alias].end());
+    sai_vlan_tagging_mode_t sai_tagging_mode = vlan_member->second.vlan_mode;
+    sai_object_id_t vlan_member_id = vlan_member->second.vlan_member_id;
+
     m_portVlanMember[port.m_alias].erase(vlan_member);
     if (m_portVlanMember[port.m_alias].empty())
     {
@@ -7725,8 +8229,29 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, string member_status)
         setPortPvid (port, pvid);
     }
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
+    getLagMemberAttrs(lag, port, enableForwarding, attrs);
+
+    sai_object_id_t lag_member_id = SAI_NULL_OBJECT_ID;
+    sai_status_t status = sai_lag_api->create_lag_member(&lag_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
+                port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_LAG, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    return addLagMemberPost(lag, port, lag_member_id, member_status);
+}
+
+void PortsOrch::getLagMemberAttrs(const Port &lag, const Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
 
     attr.id = SAI_LAG_MEMBER_ATTR_LAG_ID;
     attr.value.oid = lag.m_lag_id;
@@ -7746,21 +8271,10 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, string member_status)
         attr.value.booldata = true;
         attrs.push_back(attr);
     }
+}
 
-    sai_object_id_t lag_member_id;
-    sai_status_t status = sai_lag_api->create_lag_member(&lag_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
-                port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_LAG, status);
-        if (handle_status != task_success)
-        {
-            return parseHandleSaiStatusFailure(handle_status);
-        }
-    }
-
+bool PortsOrch::addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id, const string &member_status)
+{
     SWSS_LOG_NOTICE("Add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
             port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
 
@@ -7810,6 +8324,11 @@ bool PortsOrch::removeLagMember(Port &lag, Port &port)
         }
     }
 
+    return removeLagMemberPost(lag, port);
+}
+
+bool PortsOrch::removeLagMemberPost(Port &lag, Port &port)
+{
     SWSS_LOG_NOTICE("Remove member %s from LAG %s lid:%" PRIx64 " lmid:%" PRIx64,
             port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_lag_member_id);
 
@@ -7934,6 +8453,21 @@ bool PortsOrch::setDistributionOnLagMember(Port &lagMember, bool enableDistribut
     return true;
 }
 
+bool PortsOrch::setForwardingOnLagMember(Port &lagMember, bool enableForwarding)
+{
+    /* enable collection first and disable distribution first,
+     * distribution-only mode is not supported on Mellanox platform
+     */
+    if (enableForwarding)
+    {
+        return setCollectionOnLagMember(lagMember, true) &&
+               setDistributionOnLagMember(lagMember, true);
+    }
+
+    return setDistributionOnLagMember(lagMember, false) &&
+           setCollectionOnLagMember(lagMember, false);
+}
+
 bool PortsOrch::addTunnel(string tunnel_alias, sai_object_id_t tunnel_id, bool hwlearning)
 {
     SWSS_LOG_ENTER();
@@ -7974,7 +8508,10 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
         return;
     }
 
+    SWSS_LOG_TIMER("Generate queue counter maps");
+
     bool isCreateAllQueues = false;
+    CounterMapBatch batch;
 
     if (queuesStateVector.count(createAllAvailableBuffersStr))
     {
@@ -8000,10 +8537,10 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
                 }
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
-            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), false);
+            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), false, batch);
             if (gMySwitchType == "voq")
             {
-                generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true);
+                generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true, batch);
             }
         }
 
@@ -8015,30 +8552,19 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
                 FlexCounterQueueStates flexCounterQueueState(maxQueueNumber);
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
-            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true);
+            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true, batch);
         }
     }
 
+    writeQueueCounterMaps(batch);
+
     m_isQueueMapGenerated = true;
 }
 
-void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq)
+void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq, CounterMapBatch& batch)
 {
-    /* Create the Queue map in the Counter DB */
-    vector<FieldValueTuple> queueVector;
-    vector<FieldValueTuple> queuePortVector;
-    vector<FieldValueTuple> queueIndexVector;
-    vector<FieldValueTuple> queueTypeVector;
-    std::vector<sai_object_id_t> queue_ids;
-
-    if (voq)
-    {
-        queue_ids = m_port_voq_ids[port.m_alias];
-    }
-    else
-    {
-        queue_ids = port.m_queue_ids;
-    }
+    /* Collect the Queue map of the port, the caller writes it to the Counter DB */
+    const auto& queue_ids = voq ? m_port_voq_ids[port.m_alias] : port.m_queue_ids;
 
     for (size_t queueIndex = 0; queueIndex < queue_ids.size(); ++queueIndex)
     {
@@ -8065,18 +8591,18 @@ void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates
             {
                 continue;
             }
-            queueTypeVector.emplace_back(id, sai_queue_type_string_map[queueType]);
-            queueIndexVector.emplace_back(id, to_string(queueRealIndex));
+            batch.types.emplace_back(id, sai_queue_type_string_map[queueType]);
+            batch.indexes.emplace_back(id, to_string(queueRealIndex));
         }
 
-        queueVector.emplace_back(name.str(), id);
         if (voq)
         {
+            batch.voqNames.emplace_back(name.str(), id);
             // Install a flex counter for this voq to track stats. Voq counters do
             // not have buffer queue config. So it does not get enabled through the
             // flexcounter orch logic. Always enabled voq counters.
             addQueueFlexCountersPerPortPerQueueIndex(port, queueIndex, true, queueType);
-            queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_system_port_oid));
+            batch.ports.emplace_back(id, sai_serialize_object_id(port.m_system_port_oid));
         }
         else
         {
@@ -8086,27 +8612,44 @@ void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates
             // queuesStateVector built by getQueueConfigurations in flexcounterorch
             // never has phy ports in voq systems. So always enabled egress queue
             // counter on voq systems.
+            batch.names.emplace_back(name.str(), id);
             if (gMySwitchType == "voq")
             {
                addQueueFlexCountersPerPortPerQueueIndex(port, queueIndex, false, queueType);
             }
-            queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+            batch.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
         }
     }
 
-    if (voq)
+    if (!voq)
     {
-        m_voqTable->set("", queueVector);
-    }
-    else
-    {
-        m_queueCounterNameMapUpdater->setCounterNameMap(queueVector);
         CounterCheckOrch::getInstance().addPort(port);
     }
-    m_queuePortTable->set("", queuePortVector);
-    m_queueIndexTable->set("", queueIndexVector);
-    m_queueTypeTable->set("", queueTypeVector);
+}
 
+void PortsOrch::writeQueueCounterMaps(const CounterMapBatch& batch)
+{
+    if (!batch.voqNames.empty())
+    {
+        m_voqTable->set("", batch.voqNames);
+    }
+    if (!batch.names.empty())
+    {
+        m_queueCounterNameMapUpdater->setCounterNameMap(batch.names);
+    }
+    if (!batch.ports.empty())
+    {
+        m_queuePortTable->set("", batch.ports);
+    }
+    if (!batch.indexes.empty())
+    {
+        m_queueIndexTable->set("", batch.indexes);
+    }
+    if (!batch.types.empty())
+    {
+        m_queueTypeTable->set("", batch.types);
+        CounterNameMapUpdater::markChanged(COUNTERS_QUEUE_TYPE_MAP);
+    }
 }
 
 void PortsOrch::addQueueFlexCounters(map<string, FlexCounterQueueStates> queuesStateVector)
@@ -8116,6 +8659,8 @@ void PortsOrch::addQueueFlexCounters(map<string, FlexCounterQueueStates> queuesS
         return;
     }
 
+    SWSS_LOG_TIMER("Add queue flex counters");
+
     bool isCreateAllQueues = false;
 
     if (queuesStateVector.count(createAllAvailableBuffersStr))
@@ -8170,27 +8715,14 @@ void PortsOrch::addQueueFlexCountersPerPort(const Port& port, FlexCounterQueueSt
 
 void PortsOrch::addQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, bool voq, sai_queue_type_t queueType)
 {
-    std::unordered_set<string> counter_stats;
-    std::vector<sai_object_id_t> queue_ids;
-
-    for (const auto& it: queue_stat_ids)
-    {
-        counter_stats.emplace(sai_serialize_queue_stat(it));
-    }
     if (voq)
     {
-        for (const auto& voq_it: voq_stat_ids)
-        {
-            counter_stats.emplace(sai_serialize_queue_stat(voq_it));
-        }
-        queue_ids = m_port_voq_ids[port.m_alias];
+        queue_stat_manager.setCounterIdList(m_port_voq_ids[port.m_alias][queueIndex], CounterType::QUEUE, m_voqCounterStats, queueType);
     }
     else
     {
-        queue_ids = port.m_queue_ids;
+        queue_stat_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, m_queueCounterStats, queueType);
     }
-
-    queue_stat_manager.setCounterIdList(queue_ids[queueIndex], CounterType::QUEUE, counter_stats, queueType);
 }
 
 
@@ -8201,6 +8733,8 @@ void PortsOrch::addQueueWatermarkFlexCounters(map<string, FlexCounterQueueStates
         return;
     }
 
+    SWSS_LOG_TIMER("Add queue watermark flex counters");
+
     bool isCreateAllQueues = false;
 
     if (queuesStateVector.count(createAllAvailableBuffersStr))
@@ -8255,8 +8789,7 @@ void PortsOrch::addQueueWatermarkFlexCountersPerPort(const Port& port, FlexCount
 
 void PortsOrch::addQueueWatermarkFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, sai_queue_type_t queueType)
 {
-    auto queue_counter_stats = generateCounterStats(queueWatermarkStatIds, sai_serialize_queue_stat);
-    queue_watermark_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, queue_counter_stats, queueType);
+    queue_watermark_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, m_queueWatermarkCounterStats, queueType);
 }
 
 void PortsOrch::createPortBufferQueueCounters(const Port &port, string queues, bool skip_host_tx_queue)
@@ -8264,10 +8797,8 @@ void PortsOrch::createPortBufferQueueCounters(const Port &port, string queues, b
     SWSS_LOG_ENTER();
 
     /* Create the Queue map in the Counter DB */
-    vector<FieldValueTuple> queueVector;
-    vector<FieldValueTuple> queuePortVector;
-    vector<FieldValueTuple> queueIndexVector;
-    vector<FieldValueTuple> queueTypeVector;
+    CounterMapBatch batch;
+    auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
 
     auto toks = tokenize(queues, '-');
     auto startIndex = to_uint<uint32_t>(toks[0]);
@@ -8293,14 +8824,13 @@ void PortsOrch::createPortBufferQueueCounters(const Port &port, string queues, b
         uint8_t queueRealIndex = 0;
         if (getQueueTypeAndIndex(port.m_queue_ids[queueIndex], queueType, queueRealIndex))
         {
-            queueTypeVector.emplace_back(id, sai_queue_type_string_map[queueType]);
-            queueIndexVector.emplace_back(id, to_string(queueRealIndex));
+            batch.types.emplace_back(id, sai_queue_type_string_map[queueType]);
+            batch.indexes.emplace_back(id, to_string(queueRealIndex));
         }
 
-        queueVector.emplace_back(name.str(), id);
-        queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        batch.names.emplace_back(name.str(), id);
+        batch.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
 
-        auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
         if (flexCounterOrch->getQueueCountersState())
         {
             // Install a flex counter for this queue to track stats
@@ -8319,10 +8849,7 @@ void PortsOrch::createPortBufferQueueCounters(const Port &port, string queues, b
         }
     }
 
-    m_queueCounterNameMapUpdater->setCounterNameMap(queueVector);
-    m_queuePortTable->set("", queuePortVector);
-    m_queueIndexTable->set("", queueIndexVector);
-    m_queueTypeTable->set("", queueTypeVector);
+    writeQueueCounterMaps(batch);
 
     CounterCheckOrch::getInstance().addPort(port);
 }
@@ -8362,6 +8889,7 @@ void PortsOrch::removePortBufferQueueCounters(const Port &port, string queues, b
         {
             m_queueTypeTable->hdel("", id);
             m_queueIndexTable->hdel("", id);
+            CounterNameMapUpdater::markChanged(COUNTERS_QUEUE_TYPE_MAP);
         }
 
         auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
@@ -8393,7 +8921,10 @@ void PortsOrch::generatePriorityGroupMap(map<string, FlexCounterPgStates> pgsSta
         return;
     }
 
+    SWSS_LOG_TIMER("Generate priority group counter maps");
+
     bool isCreateAllPgs = false;
+    CounterMapBatch batch;
 
     if (pgsStateVector.count(createAllAvailableBuffersStr))
     {
@@ -8415,19 +8946,18 @@ void PortsOrch::generatePriorityGroupMap(map<string, FlexCounterPgStates> pgsSta
                 }
                 pgsStateVector.insert(make_pair(it.second.m_alias, flexCounterPgState));
             }
-            generatePriorityGroupMapPerPort(it.second, pgsStateVector.at(it.second.m_alias));
+            generatePriorityGroupMapPerPort(it.second, pgsStateVector.at(it.second.m_alias), batch);
         }
     }
 
+    writePriorityGroupCounterMaps(batch);
+
     m_isPriorityGroupMapGenerated = true;
 }
 
-void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState)
+void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState, CounterMapBatch& batch)
 {
-    /* Create the PG map in the Counter DB */
-    vector<FieldValueTuple> pgVector;
-    vector<FieldValueTuple> pgPortVector;
-    vector<FieldValueTuple> pgIndexVector;
+    /* Collect the PG map of the port, the caller writes it to the Counter DB */
 
     for (size_t pgIndex = 0; pgIndex < port.m_priority_group_ids.size(); ++pgIndex)
     {
@@ -8440,28 +8970,39 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgS
 
         const auto id = sai_serialize_object_id(port.m_priority_group_ids[pgIndex]);
 
-        pgVector.emplace_back(name.str(), id);
-        pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
-        pgIndexVector.emplace_back(id, to_string(pgIndex));
-
+        batch.names.emplace_back(name.str(), id);
+        batch.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        batch.indexes.emplace_back(id, to_string(pgIndex));
     }
 
-    m_pgCounterNameMapUpdater->setCounterNameMap(pgVector);
-    m_pgPortTable->set("", pgPortVector);
-    m_pgIndexTable->set("", pgIndexVector);
-
     CounterCheckOrch::getInstance().addPort(port);
 }
 
+void PortsOrch::writePriorityGroupCounterMaps(const CounterMapBatch& batch)
+{
+    if (!batch.names.empty())
+    {
+        m_pgCounterNameMapUpdater->setCounterNameMap(batch.names);
+    }
+    if (!batch.ports.empty())
+    {
+        m_pgPortTable->set("", batch.ports);
+    }
+    if (!batch.indexes.empty())
+    {
+        m_pgIndexTable->set("", batch.indexes);
+        CounterNameMapUpdater::markChanged(COUNTERS_PG_INDEX_MAP);
+    }
+}
+
 void PortsOrch::createPortBufferPgCounters(const Port& port, string pgs)
 {
     SWSS_LOG_ENTER();
 
     /* Create the PG map in the Counter DB */
     /* Add stat counters to flex_counter */
-    vector<FieldValueTuple> pgVector;
-    vector<FieldValueTuple> pgPortVector;
-    vector<FieldValueTuple> pgIndexVector;
+    CounterMapBatch batch;
+    auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
 
     auto toks = tokenize(pgs, '-');
     auto startIndex = to_uint<uint32_t>(toks[0]);
@@ -8478,11 +9019,10 @@ void PortsOrch::createPortBufferPgCounters(const Port& port, string pgs)
 
         const auto id = sai_serialize_object_id(port.m_priority_group_ids[pgIndex]);
 
-        pgVector.emplace_back(name.str(), id);
-        pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
-        pgIndexVector.emplace_back(id, to_string(pgIndex));
+        batch.names.emplace_back(name.str(), id);
+        batch.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        batch.indexes.emplace_back(id, to_string(pgIndex));
 
-        auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
         if (flexCounterOrch->getPgCountersState())
         {
             /* Add dropped packets counters to flex_counter */
@@ -8495,9 +9035,7 @@ void PortsOrch::createPortBufferPgCounters(const Port& port, string pgs)
         }
     }
 
-    m_pgCounterNameMapUpdater->setCounterNameMap(pgVector);
-    m_pgPortTable->set("", pgPortVector);
-    m_pgIndexTable->set("", pgIndexVector);
+    writePriorityGroupCounterMaps(batch);
 
     CounterCheckOrch::getInstance().addPort(port);
 }
@@ -8509,6 +9047,8 @@ void PortsOrch::addPriorityGroupFlexCounters(map<string, FlexCounterPgStates> pg
         return;
     }
 
+    SWSS_LOG_TIMER("Add priority group flex counters");
+
     bool isCreateAllPgs = false;
 
     if (pgsStateVector.count(createAllAvailableBuffersStr))
@@ -8552,8 +9092,7 @@ void PortsOrch::addPriorityGroupFlexCountersPerPort(const Port& port, FlexCounte
 
 void PortsOrch::addPriorityGroupFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex)
 {
-    auto pg_counter_stats = generateCounterStats(ingressPriorityGroupDropStatIds, sai_serialize_ingress_priority_group_stat);
-    pg_drop_stat_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, pg_counter_stats);
+    pg_drop_stat_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, m_pgDropCounterStats);
 }
 
 void PortsOrch::addPriorityGroupWatermarkFlexCounters(map<string, FlexCounterPgStates> pgsStateVector)
@@ -8563,6 +9102,8 @@ void PortsOrch::addPriorityGroupWatermarkFlexCounters(map<string, FlexCounterPgS
         return;
     }
 
+    SWSS_LOG_TIMER("Add priority group watermark flex counters");
+
     bool isCreateAllPgs = false;
 
     if (pgsStateVector.count(createAllAvailableBuffersStr))
@@ -8608,8 +9149,7 @@ void PortsOrch::addPriorityGroupWatermarkFlexCountersPerPort(const Port& port, F
 
 void PortsOrch::addPriorityGroupWatermarkFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex)
 {
-    auto pg_counter_stats = generateCounterStats(ingressPriorityGroupWatermarkStatIds, sai_serialize_ingress_priority_group_stat);
-    pg_watermark_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, pg_counter_stats);
+    pg_watermark_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, m_pgWatermarkCounterStats);
 }
 
 void PortsOrch::removePortBufferPgCounters(const Port& port, string pgs)
@@ -8636,6 +9176,7 @@ void PortsOrch::removePortBufferPgCounters(const Port& port, string pgs)
         m_pgCounterNameMapUpdater->delCounterNameMap(name.str());
         m_pgPortTable->hdel("", id);
         m_pgIndexTable->hdel("", id);
+        CounterNameMapUpdater::markChanged(COUNTERS_PG_INDEX_MAP);
 
         auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
         if (flexCounterOrch->getPgCountersState())
@@ -8744,6 +9285,8 @@ void PortsOrch::addWredQueueFlexCounters(map<string, FlexCounterQueueStates> que
         return;
     }
 
+    SWSS_LOG_TIMER("Add WRED queue flex counters");
+
     bool isCreateAllQueues = false;
 
     if (queuesStateVector.count(createAllAvailableBuffersStr))
@@ -8810,23 +9353,9 @@ void PortsOrch::addWredQueueFlexCountersPerPort(const Port& port, FlexCounterQue
 
 void PortsOrch::addWredQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex,  bool voq, sai_queue_type_t queueType)
 {
-    std::unordered_set<string> counter_stats;
-    std::vector<sai_object_id_t> queue_ids;
+    const auto& queue_ids = voq ? m_port_voq_ids[port.m_alias] : port.m_queue_ids;
 
-    for (const auto& it: wred_queue_stat_ids)
-    {
-        counter_stats.emplace(sai_serialize_queue_stat(it));
-    }
-    if (voq)
-    {
-        queue_ids = m_port_voq_ids[port.m_alias];
-    }
-    else
-    {
-        queue_ids = port.m_queue_ids;
-    }
-
-    wred_queue_stat_manager.setCounterIdList(queue_ids[queueIndex], CounterType::QUEUE, counter_stats, queueType);
+    wred_queue_stat_manager.setCounterIdList(queue_ids[queueIndex], CounterType::QUEUE, m_wredQueueCounterStats, queueType);
 }
 
 void PortsOrch::flushCounters()
@@ -8865,13 +9394,33 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
     std::deque<KeyOpFieldsValuesTuple> entries;
     consumer.pops(entries);
 
+    /*
+     * Handle all popped notifications as one batch: ports which came up are
+     * queried for oper speed and FEC together, and STATE_DB is written once
+     */
+    set<string> portsUp;
+    beginPortStateBatch();
+
     for (auto& entry : entries)
     {
-        handleNotification(consumer, entry);
+        handleNotification(consumer, entry, portsUp);
     }
+
+    vector<Port> ports;
+    for (const auto &alias : portsUp)
+    {
+        auto it = m_portList.find(alias);
+        if (it != m_portList.end() && it->second.m_oper_status == SAI_PORT_OPER_STATUS_UP)
+        {
+            ports.push_back(it->second);
+        }
+    }
+    updateDbPortsOperSpeedFec(ports);
+
+    flushPortStateBatch();
 }
 
-void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry)
+void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry, set<string> &portsUp)
 {
     auto op = kfvOp(entry);
     auto data = kfvKey(entry);
@@ -8904,32 +9453,8 @@ void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsVa
             updatePortOperStatus(port, status);
             if (status == SAI_PORT_OPER_STATUS_UP)
             {
-                sai_uint32_t speed;
-                if (getPortOperSpeed(port, speed))
-                {
-                    SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
-                    updateDbPortOperSpeed(port, speed);
-                }
-                else
-                {
-                    updateDbPortOperSpeed(port, 0);
-                }
-                sai_port_fec_mode_t fec_mode;
-                string fec_str;
-                if (oper_fec_sup && getPortOperFec(port, fec_mode))
-                {
-                    if (!m_portHlpr.fecToStr(fec_str, fec_mode))
-                    {
-                        SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
-                                    static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
-                        fec_str = "N/A";
-                    }
-                    updateDbPortOperFec(port,fec_str);
-                }
-                else
-                {
-                    updateDbPortOperFec(port, "N/A");
-                }
+                /* Oper speed and FEC are queried once the whole batch is handled */
+                portsUp.insert(port.m_alias);
             } else {
                 if (port_oper_err)
                 {
@@ -9091,7 +9616,7 @@ void PortsOrch::updateDbPortOperSpeed(Port &port, sai_uint32_t speed)
     vector<FieldValueTuple> tuples;
     string speedStr = speed != 0 ? to_string(speed) : "N/A";
     tuples.emplace_back(std::make_pair("speed", speedStr));
-    m_portStateTable.set(port.m_alias, tuples);
+    portStateTable().set(port.m_alias, tuples);
 
     // We don't set port.m_speed = speed here, because CONFIG_DB still hold the old
     // value. If we set it here, next time configure any attributes related port will
@@ -9104,7 +9629,7 @@ void PortsOrch::updateDbPortOperFec(Port &port, string fec_str)
 
     vector<FieldValueTuple> tuples;
     tuples.emplace_back(std::make_pair("fec", fec_str));
-    m_portStateTable.set(port.m_alias, tuples);
+    portStateTable().set(port.m_alias, tuples);
 
 }
 
@@ -9123,17 +9648,39 @@ void PortsOrch::refreshPortStatus()
 {
     SWSS_LOG_ENTER();
 
+    vector<Port *> ports;
     for (auto &it: m_portList)
     {
-        auto &port = it.second;
-        if (port.m_type != Port::PHY)
+        if (it.second.m_type == Port::PHY)
         {
-            continue;
+            ports.push_back(&it.second);
         }
+    }
+
+    PortBulker bulker(static_cast<uint32_t>(ports.size()));
+    for (const auto port : ports)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_OPER_STATUS;
+        bulker.add(port->m_port_id, attr);
+    }
+    bulker.executeGet();
+
+    beginPortStateBatch();
+
+    vector<Port> portsUp;
+    for (size_t idx = 0; idx < ports.size(); idx++)
+    {
+        auto &port = *ports[idx];
 
         sai_port_oper_status_t status;
-        if (!getPortOperStatus(port, status))
+        if (bulker.statuses[idx] == SAI_STATUS_SUCCESS)
         {
+            status = static_cast<sai_port_oper_status_t>(bulker.attrList[idx].value.u32);
+        }
+        else if (!getPortOperStatus(port, status))
+        {
+            flushPortStateBatch();
             throw runtime_error("PortsOrch get port oper status failure");
         }
 
@@ -9142,29 +9689,97 @@ void PortsOrch::refreshPortStatus()
 
         if (status == SAI_PORT_OPER_STATUS_UP)
         {
-            sai_uint32_t speed;
-            if (getPortOperSpeed(port, speed))
+            portsUp.push_back(port);
+        }
+    }
+
+    updateDbPortsOperSpeedFec(portsUp);
+
+    flushPortStateBatch();
+}
+
+/*
+ * Query oper speed and FEC of the given ports with one bulk get per attribute,
+ * and write both to STATE_DB. Ports the bulk get failed for are queried one by one.
+ */
+void PortsOrch::updateDbPortsOperSpeedFec(vector<Port> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    if (ports.empty())
+    {
+        return;
+    }
+
+    const auto portCount = static_cast<uint32_t>(ports.size());
+
+    PortBulker speedBulker(portCount);
+    PortBulker fecBulker(oper_fec_sup ? portCount : 0);
+
+    for (const auto &port : ports)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_OPER_SPEED;
+        speedBulker.add(port.m_port_id, attr);
+
+        if (oper_fec_sup)
+        {
+            attr.id = SAI_PORT_ATTR_OPER_PORT_FEC_MODE;
+            fecBulker.add(port.m_port_id, attr);
+        }
+    }
+
+    speedBulker.executeGet();
+    fecBulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        auto &port = ports[idx];
+
+        sai_uint32_t speed = 0;
+        if (speedBulker.statuses[idx] == SAI_STATUS_SUCCESS)
+        {
+            speed = speedBulker.attrList[idx].value.u32;
+            if (speed == 0)
             {
-                SWSS_LOG_INFO("%s oper speed is %d", port.m_alias.c_str(), speed);
-                updateDbPortOperSpeed(port, speed);
+                SWSS_LOG_WARN("Port %s operational speed is 0", port.m_alias.c_str());
+            }
+        }
+        else if (!getPortOperSpeed(port, speed))
+        {
+            speed = 0;
+        }
+
+        if (speed != 0)
+        {
+            SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
+        }
+
+        string fec_str = "N/A";
+        if (oper_fec_sup)
+        {
+            sai_port_fec_mode_t fec_mode;
+            bool fec_found = true;
+
+            if (fecBulker.statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                fec_mode = static_cast<sai_port_fec_mode_t>(fecBulker.attrList[idx].value.s32);
             }
             else
             {
-                updateDbPortOperSpeed(port, 0);
+                fec_found = getPortOperFec(port, fec_mode);
             }
-            sai_port_fec_mode_t fec_mode;
-            string fec_str = "N/A";
-            if (oper_fec_sup && getPortOperFec(port, fec_mode))
+
+            if (fec_found && !m_portHlpr.fecToStr(fec_str, fec_mode))
             {
-                if (!m_portHlpr.fecToStr(fec_str, fec_mode))
-                {
-                    SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
-                                   static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
-                    fec_str = "N/A";
-                }
+                SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
+                               static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
+                fec_str = "N/A";
             }
-            updateDbPortOperFec(port,fec_str);
         }
+
+        updateDbPortOperSpeed(port, speed);
+        updateDbPortOperFec(port, fec_str);
     }
 }
 
@@ -10410,7 +11025,7 @@ void PortsOrch::refreshPortStateAutoNeg(const Port &port)
         }
     }
 
-    m_portStateTable.hset(port.m_alias, "rmt_adv_speeds", adv_speeds);
+    portStateTable().hset(port.m_alias, "rmt_adv_speeds", adv_speeds);
 }
 
 /* Refresh the per-port Link-Training operational states */
@@ -10452,7 +11067,7 @@ void PortsOrch::refreshPortStateLinkTraining(const Port &port)
         }
     }
 
-    m_portStateTable.hset(port.m_alias, "link_training_status", status);
+    portStateTable().hset(port.m_alias, "link_training_status", status);
 }
 
 /* Activate/De-activate a specific port state poller task */
@@ -10782,6 +11397,8 @@ void PortsOrch::doTask(swss::SelectableTimer &timer)
 {
     Port port;
 
+    beginPortStateBatch();
+
     for (auto it = m_port_state_poll.begin(); it != m_port_state_poll.end(); )
     {
         if ((it->second == PORT_STATE_POLL_NONE) || !getPort(it->first, port))
@@ -10804,6 +11421,9 @@ void PortsOrch::doTask(swss::SelectableTimer &timer)
         }
         ++it;
     }
+
+    flushPortStateBatch();
+
     if (m_port_state_poll.size() == 0)
     {
         m_port_state_poller->stop();
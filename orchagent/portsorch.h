@@ -1,6 +1,7 @@
 #ifndef SWSS_PORTSORCH_H
 #define SWSS_PORTSORCH_H
 
+#include <chrono>
 #include <map>
 #include <unordered_set>
 
@@ -20,6 +21,7 @@
 #include "port/port_capabilities.h"
 #include "port/porthlpr.h"
 #include "port/portschema.h"
+#include "port/porttable.h"
 
 #include "high_frequency_telemetry/counternameupdater.h"
 
@@ -109,6 +111,38 @@ struct VlanMemberUpdate
     bool add;
 };
 
+struct VlanMemberContext
+{
+    SyncMap::iterator           task;                                   // consumer task of the member
+    std::string                 vlan_alias;
+    std::string                 port_alias;
+    sai_vlan_tagging_mode_t     tagging_mode;
+    sai_object_id_t             vlan_member_id = SAI_NULL_OBJECT_ID;
+    sai_status_t                status = SAI_STATUS_NOT_EXECUTED;       // bulk create or remove status
+
+    VlanMemberContext(SyncMap::iterator task, const std::string &vlan_alias, const std::string &port_alias,
+                      sai_vlan_tagging_mode_t tagging_mode)
+        : task(task), vlan_alias(vlan_alias), port_alias(port_alias), tagging_mode(tagging_mode)
+    {
+    }
+};
+
+struct LagMemberContext
+{
+    SyncMap::iterator           task;                                   // consumer task of the member
+    std::string                 lag_alias;
+    std::string                 port_alias;
+    std::string                 member_status;                          // "enabled" or "disabled"
+    sai_object_id_t             lag_member_id = SAI_NULL_OBJECT_ID;
+    sai_status_t                status = SAI_STATUS_NOT_EXECUTED;       // bulk create or remove status
+
+    LagMemberContext(SyncMap::iterator task, const std::string &lag_alias, const std::string &port_alias,
+                     const std::string &member_status)
+        : task(task), lag_alias(lag_alias), port_alias(port_alias), member_status(member_status)
+    {
+    }
+};
+
 struct queueInfo
 {
     // SAI_QUEUE_ATTR_TYPE
@@ -117,6 +151,16 @@ struct queueInfo
     sai_uint8_t index;
 };
 
+// COUNTERS_DB queue/PG map fields of a group of ports, written with one HSET per map
+struct CounterMapBatch
+{
+    std::vector<FieldValueTuple> names;
+    std::vector<FieldValueTuple> voqNames;
+    std::vector<FieldValueTuple> ports;
+    std::vector<FieldValueTuple> indexes;
+    std::vector<FieldValueTuple> types;
+};
+
 template<typename T>
 struct PortCapability
 {
@@ -126,6 +170,15 @@ struct PortCapability
 
 typedef PortCapability<PortSupportedFecModes> PortFecModeCapability_t;
 
+// Time spent in one phase of port initialization, summed over all port batches
+struct PortInitPhase
+{
+    std::chrono::steady_clock::duration start{};     // first run, relative to the first phase
+    std::chrono::steady_clock::duration duration{};
+    size_t ports = 0;
+    size_t runs = 0;
+};
+
 class PortsOrch : public Orch, public Subject
 {
 public:
@@ -137,7 +190,7 @@ public:
     bool isGearboxEnabled();
     bool isPortAdminUp(const string &alias);
 
-    map<string, Port>& getAllPorts();
+    const map<string, Port>& getAllPorts();
     bool bake() override;
     void cleanPortTable(const vector<string>& keys);
     bool getBridgePort(sai_object_id_t id, Port &port);
@@ -237,6 +290,7 @@ public:
     bool isInbandPort(const string &alias);
     bool setVoqInbandIntf(string &alias, string &type);
     bool getPortVlanMembers(Port &port, vlan_members_t &vlan_members);
+    bool hasVlanMembership(const string &alias) const;
 
     bool getRecircPort(Port &p, Port::Role role);
 
@@ -277,6 +331,32 @@ private:
     Table m_portStateTable;
     Table m_portOpErrTable;
 
+    /*
+     * Buffered views of the port state tables. While a port state batch is
+     * open, oper status, flap count, speed, FEC, error and AN/LT state writes
+     * go through them and are sent in one pipeline flush.
+     */
+    unique_ptr<RedisPipeline> m_appPortStatePipe;
+    unique_ptr<RedisPipeline> m_statePortStatePipe;
+    unique_ptr<Table> m_portTableBatch;
+    unique_ptr<Table> m_portStateTableBatch;
+    unique_ptr<Table> m_portOpErrTableBatch;
+    bool m_portStateBatch = false;
+
+    Table& portTable() const;
+    Table& portStateTable();
+    Table& portOpErrTable();
+    void beginPortStateBatch();
+    void flushPortStateBatch();
+
+    /* Per phase port initialization timeline, exported to STATE_DB PORT_INIT_TIMELINE */
+    unique_ptr<Table> m_portInitTimelineTable;
+    std::map<std::string, PortInitPhase> m_portInitTimeline;
+    std::chrono::steady_clock::time_point m_portInitStart;
+
+    void recordPortInitPhase(const std::string &phase, std::chrono::steady_clock::time_point start, size_t portCount);
+    void publishPortInitTimeline();
+
     std::string getQueueWatermarkFlexCounterTableKey(std::string s);
     std::string getPriorityGroupWatermarkFlexCounterTableKey(std::string s);
     std::string getPriorityGroupDropPacketsFlexCounterTableKey(std::string s);
@@ -340,7 +420,7 @@ private:
     sai_uint32_t m_portCount;
     map<set<uint32_t>, sai_object_id_t> m_portListLaneMap;
     map<set<uint32_t>, PortConfig> m_lanesAliasSpeedMap;
-    map<string, Port> m_portList;
+    PortTable m_portList;
     map<string, Port> m_pluggedModulesPort;
     map<string, vlan_members_t> m_portVlanMember;
     map<string, std::vector<sai_object_id_t>> m_port_voq_ids;
@@ -377,12 +457,14 @@ private:
     void doSendToIngressPortTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
     void doVlanMemberTask(Consumer &consumer);
+    void doVlanMemberTask(Consumer &consumer, const string &pass_op, set<string> &addingPorts);
     void doLagTask(Consumer &consumer);
     void doLagMemberTask(Consumer &consumer);
+    void doLagMemberTask(Consumer &consumer, const string &pass_op);
     void doTransceiverPresenceCheck(Consumer &consumer);
 
     void doTask(NotificationConsumer &consumer);
-    void handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry);
+    void handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry, set<string> &portsUp);
     void doTask(swss::SelectableTimer &timer);
 
     void removePortFromLanesMap(string alias);
@@ -415,9 +497,13 @@ private:
     bool removeLagMember(Port &lag, Port &port);
     bool setCollectionOnLagMember(Port &lagMember, bool enableCollection);
     bool setDistributionOnLagMember(Port &lagMember, bool enableDistribution);
+    bool setForwardingOnLagMember(Port &lagMember, bool enableForwarding);
+    void getLagMemberAttrs(const Port &lag, const Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs);
+    bool addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id, const string &member_status);
+    bool removeLagMemberPost(Port &lag, Port &port);
 
     sai_status_t removePort(sai_object_id_t port_id);
-    bool initExistingPort(const PortConfig &port);
+    bool initExistingPort(const PortConfig &port, std::vector<Port> &ports);
     bool initPortsBulk(std::vector<Port>& ports);
     void registerPort(Port &p);
     
@@ -425,6 +511,7 @@ private:
 
     void initPortCapAutoNeg(Port &port);
     void initPortCapLinkTraining(Port &port);
+    void initPortCapabilitiesBulk(std::vector<Port>& ports);
 
     void postPortInit(Port &p);
 
@@ -443,6 +530,10 @@ private:
 
     bool setBridgePortAdminStatus(sai_object_id_t id, bool up);
 
+    void getVlanMemberAttrs(const Port &vlan, const Port &port, sai_vlan_tagging_mode_t tagging_mode, vector<sai_attribute_t> &attrs);
+    bool addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t tagging_mode);
+    bool removeVlanMemberPost(Port &vlan, Port &port);
+
     bool setSaiHostTxSignal(const Port &port, bool enable);
 
     void setHostTxReady(Port port, const std::string &status);
@@ -450,10 +541,12 @@ private:
     bool isSpeedSupported(const std::string& alias, sai_object_id_t port_id, sai_uint32_t speed);
     void getPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, PortSupportedSpeeds &supported_speeds);
     void initPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id);
+    void setPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, const PortSupportedSpeeds &supported_speeds);
     // Get supported FEC modes on system side
     bool isFecModeSupported(const Port &port, sai_port_fec_mode_t fec_mode);
     sai_status_t getPortSupportedFecModes(PortSupportedFecModes &supported_fecmodes, sai_object_id_t port_id);
     void initPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id);
+    void setPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id, const PortSupportedFecModes &supported_fec_modes);
     task_process_status setPortSpeed(Port &port, sai_uint32_t speed);
     bool getPortSpeed(sai_object_id_t id, sai_uint32_t &speed);
     bool setGearboxPortsAttr(const Port &port, sai_port_attr_t id, void *value, bool override_fec=true);
@@ -465,8 +558,19 @@ private:
 
     bool getQueueTypeAndIndex(sai_object_id_t queue_id, sai_queue_type_t &type, uint8_t &index);
 
+    /* Serialized stat lists of queue and PG counters, built once instead of per object */
+    std::unordered_set<std::string> m_queueCounterStats;
+    std::unordered_set<std::string> m_voqCounterStats;
+    std::unordered_set<std::string> m_queueWatermarkCounterStats;
+    std::unordered_set<std::string> m_wredQueueCounterStats;
+    std::unordered_set<std::string> m_pgDropCounterStats;
+    std::unordered_set<std::string> m_pgWatermarkCounterStats;
+
+    void writeQueueCounterMaps(const CounterMapBatch& batch);
+    void writePriorityGroupCounterMaps(const CounterMapBatch& batch);
+
     bool m_isQueueMapGenerated = false;
-    void generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq);
+    void generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq, CounterMapBatch& batch);
     bool m_isQueueFlexCountersAdded = false;
     void addQueueFlexCountersPerPort(const Port& port, FlexCounterQueueStates& queuesState);
     void addQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, bool voq, sai_queue_type_t queueType);
@@ -480,7 +584,7 @@ private:
     void addWredQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, bool voq, sai_queue_type_t queueType);
 
     bool m_isPriorityGroupMapGenerated = false;
-    void generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState);
+    void generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState, CounterMapBatch& batch);
     bool m_isPriorityGroupFlexCountersAdded = false;
     void addPriorityGroupFlexCountersPerPort(const Port& port, FlexCounterPgStates& pgsState);
     void addPriorityGroupFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex);
@@ -508,6 +612,7 @@ private:
 
     bool getPortOperSpeed(const Port& port, sai_uint32_t& speed) const;
     void updateDbPortOperSpeed(Port &port, sai_uint32_t speed);
+    void updateDbPortsOperSpeedFec(vector<Port> &ports);
 
     bool getPortLinkTrainingRxStatus(const Port &port, sai_port_link_training_rx_status_t &rx_status);
     bool getPortLinkTrainingFailure(const Port &port, sai_port_link_training_failure_status_t &failure);
@@ -0,0 +1,306 @@
+#include "logger.h"
+
+#include "watermarkaggregator.h"
+
+using namespace std;
+using namespace swss;
+
+static const vector<string> queueFields = {
+    "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"
+};
+
+static const vector<string> pgFields = {
+    "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
+    "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"
+};
+
+static const vector<string> bufferPoolFields = {
+    "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
+    "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES"
+};
+
+WatermarkAggregator::WatermarkAggregator()
+{
+    for (uint8_t g = 0; g < GROUP_COUNT; g++)
+    {
+        m_groups[g].fields = getFields(static_cast<Group>(g));
+    }
+}
+
+const vector<string>& WatermarkAggregator::getFields(Group group)
+{
+    switch (group)
+    {
+        case QUEUE:
+            return queueFields;
+        case PG:
+            return pgFields;
+        default:
+            return bufferPoolFields;
+    }
+}
+
+void WatermarkAggregator::setObjects(Group group, const vector<string> &oids, vector<string> &added)
+{
+    SWSS_LOG_ENTER();
+
+    auto &old = m_groups[group];
+    GroupState state;
+    state.fields = old.fields;
+    state.pollIntervalMs = old.pollIntervalMs;
+    state.hasUpdate = old.hasUpdate;
+    state.lastUpdateMs = old.lastUpdateMs;
+    state.missedPolls = old.missedPolls;
+
+    const size_t width = state.fields.size();
+    const size_t slots = oids.size() * width;
+
+    state.oids = oids;
+    state.last.assign(slots, 0);
+    state.hasLast.assign(slots, 0);
+    for (uint8_t v = 0; v < VIEW_COUNT; v++)
+    {
+        state.value[v].assign(slots, 0);
+        state.flags[v].assign(slots, 0);
+        state.clearedAtMs[v].assign(slots, 0);
+    }
+
+    for (size_t i = 0; i < oids.size(); i++)
+    {
+        state.index[oids[i]] = i;
+
+        auto it = old.index.find(oids[i]);
+        if (it == old.index.end())
+        {
+            added.push_back(oids[i]);
+            continue;
+        }
+
+        for (size_t f = 0; f < width; f++)
+        {
+            size_t from = it->second * width + f;
+            size_t to = i * width + f;
+            state.last[to] = old.last[from];
+            state.hasLast[to] = old.hasLast[from];
+            for (uint8_t v = 0; v < VIEW_COUNT; v++)
+            {
+                state.value[v][to] = old.value[v][from];
+                state.flags[v][to] = old.flags[v][from];
+                state.clearedAtMs[v][to] = old.clearedAtMs[v][from];
+            }
+        }
+    }
+
+    old = move(state);
+}
+
+void WatermarkAggregator::setPollInterval(Group group, uint64_t intervalMs)
+{
+    m_groups[group].pollIntervalMs = intervalMs;
+}
+
+void WatermarkAggregator::seed(View view, Group group, const string &oid, const vector<FieldValueTuple> &published)
+{
+    SWSS_LOG_ENTER();
+
+    auto &state = m_groups[group];
+    auto it = state.index.find(oid);
+    if (it == state.index.end())
+    {
+        return;
+    }
+
+    const size_t width = state.fields.size();
+    for (const auto &fv : published)
+    {
+        for (size_t f = 0; f < width; f++)
+        {
+            if (fvField(fv) != state.fields[f])
+            {
+                continue;
+            }
+
+            uint64_t value;
+            try
+            {
+                value = stoull(fvValue(fv));
+            }
+            catch (const exception &e)
+            {
+                SWSS_LOG_DEBUG("Invalid watermark %s on %s", fvField(fv).c_str(), oid.c_str());
+                break;
+            }
+
+            size_t slot = it->second * width + f;
+            state.value[view][slot] = value;
+            state.flags[view][slot] |= VALID;
+            break;
+        }
+    }
+}
+
+void WatermarkAggregator::update(Group group, const vector<uint64_t> &values,
+                                 const vector<uint8_t> &present, uint64_t nowMs)
+{
+    SWSS_LOG_ENTER();
+
+    auto &state = m_groups[group];
+    const size_t slots = state.last.size();
+    if (values.size() != slots || present.size() != slots)
+    {
+        SWSS_LOG_ERROR("Expected %zu watermark values, got %zu", slots, values.size());
+        return;
+    }
+
+    if (state.hasUpdate && state.pollIntervalMs && nowMs - state.lastUpdateMs > state.pollIntervalMs)
+    {
+        state.missedPolls += (nowMs - state.lastUpdateMs - 1) / state.pollIntervalMs;
+    }
+    state.hasUpdate = true;
+    state.lastUpdateMs = nowMs;
+
+    for (uint8_t v = 0; v < VIEW_COUNT; v++)
+    {
+        auto &value = state.value[v];
+        auto &flags = state.flags[v];
+        auto &clearedAtMs = state.clearedAtMs[v];
+
+        for (size_t s = 0; s < slots; s++)
+        {
+            if (!present[s])
+            {
+                continue;
+            }
+
+            if (flags[s] & CLEARED)
+            {
+                // The reading folded before the clear, until syncd polls again
+                if (state.hasLast[s] && values[s] == state.last[s] &&
+                    nowMs - clearedAtMs[s] < state.pollIntervalMs)
+                {
+                    continue;
+                }
+                flags[s] = static_cast<uint8_t>(flags[s] & ~CLEARED);
+            }
+
+            if (!(flags[s] & VALID) || values[s] > value[s])
+            {
+                value[s] = values[s];
+                flags[s] |= VALID | DIRTY;
+            }
+        }
+    }
+
+    for (size_t s = 0; s < slots; s++)
+    {
+        if (present[s])
+        {
+            state.last[s] = values[s];
+            state.hasLast[s] = 1;
+        }
+    }
+}
+
+void WatermarkAggregator::clearSlot(GroupState &state, View view, size_t slot, uint64_t nowMs)
+{
+    state.value[view][slot] = 0;
+    state.flags[view][slot] |= VALID | DIRTY | CLEARED;
+    state.clearedAtMs[view][slot] = nowMs;
+}
+
+void WatermarkAggregator::clear(View view, Group group, const string &field,
+                                const vector<string> &oids, uint64_t nowMs)
+{
+    SWSS_LOG_ENTER();
+
+    auto &state = m_groups[group];
+    const size_t width = state.fields.size();
+
+    size_t f = 0;
+    while (f < width && state.fields[f] != field)
+    {
+        f++;
+    }
+    if (f == width)
+    {
+        SWSS_LOG_ERROR("Unknown watermark %s", field.c_str());
+        return;
+    }
+
+    for (const auto &oid : oids)
+    {
+        auto it = state.index.find(oid);
+        if (it != state.index.end())
+        {
+            clearSlot(state, view, it->second * width + f, nowMs);
+        }
+    }
+}
+
+void WatermarkAggregator::clear(View view, uint64_t nowMs)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &state : m_groups)
+    {
+        for (size_t s = 0; s < state.last.size(); s++)
+        {
+            clearSlot(state, view, s, nowMs);
+        }
+    }
+}
+
+bool WatermarkAggregator::getWatermark(View view, Group group, const string &oid,
+                                       const string &field, uint64_t &value) const
+{
+    const auto &state = m_groups[group];
+    auto it = state.index.find(oid);
+    if (it == state.index.end())
+    {
+        return false;
+    }
+
+    const size_t width = state.fields.size();
+    for (size_t f = 0; f < width; f++)
+    {
+        size_t slot = it->second * width + f;
+        if (state.fields[f] == field && (state.flags[view][slot] & VALID))
+        {
+            value = state.value[view][slot];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WatermarkAggregator::getUpdates(View view, vector<KeyOpFieldsValuesTuple> &updates)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &state : m_groups)
+    {
+        const size_t width = state.fields.size();
+        auto &value = state.value[view];
+        auto &flags = state.flags[view];
+
+        for (size_t i = 0; i < state.oids.size(); i++)
+        {
+            vector<FieldValueTuple> fvs;
+            for (size_t f = 0; f < width; f++)
+            {
+                size_t slot = i * width + f;
+                if (flags[slot] & DIRTY)
+                {
+                    fvs.emplace_back(state.fields[f], to_string(value[slot]));
+                    flags[slot] = static_cast<uint8_t>(flags[slot] & ~DIRTY);
+                }
+            }
+
+            if (!fvs.empty())
+            {
+                updates.emplace_back(state.oids[i], SET_COMMAND, move(fvs));
+            }
+        }
+    }
+}
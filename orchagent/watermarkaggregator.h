@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+// Folds the READ_AND_CLEAR watermark counters of queues, priority groups and
+// buffer pools into the user, persistent and periodic watermark views. Each
+// view keeps the highest value seen since it was last cleared, so a clear of
+// one view does not lose the peak the others still report.
+class WatermarkAggregator
+{
+public:
+    enum View : uint8_t
+    {
+        USER,
+        PERSISTENT,
+        PERIODIC,
+        VIEW_COUNT
+    };
+
+    enum Group : uint8_t
+    {
+        QUEUE,
+        PG,
+        BUFFER_POOL,
+        GROUP_COUNT
+    };
+
+    WatermarkAggregator();
+
+    // Watermark counters of the group, in sample column order
+    static const std::vector<std::string>& getFields(Group group);
+
+    // Objects already known keep their views, the others are returned in added
+    void setObjects(Group group, const std::vector<std::string> &oids, std::vector<std::string> &added);
+
+    const std::vector<std::string>& getObjects(Group group) const
+    {
+        return m_groups[group].oids;
+    }
+
+    // Poll interval of the group's flex counters, a sample unchanged since
+    // a clear is only taken as new once the counters were polled again
+    void setPollInterval(Group group, uint64_t intervalMs);
+
+    // Starts the object's view from the values published before
+    void seed(View view, Group group, const std::string &oid, const std::vector<swss::FieldValueTuple> &published);
+
+    // One row of getFields() values per object, in getObjects() order
+    void update(Group group, const std::vector<uint64_t> &values,
+                const std::vector<uint8_t> &present, uint64_t nowMs);
+
+    // Each poll of syncd overwrites the reading of the previous one. Counts
+    // the polls which may have been overwritten before an update read them,
+    // when updates were more than a poll interval apart.
+    uint64_t getMissedPolls(Group group) const
+    {
+        return m_groups[group].missedPolls;
+    }
+
+    // The next update of the group is not checked for missed polls, e.g.
+    // once the group was disabled for a while
+    void resetUpdateTime(Group group)
+    {
+        m_groups[group].hasUpdate = false;
+    }
+
+    // Resets the field of the objects to 0, unknown objects are ignored
+    void clear(View view, Group group, const std::string &field,
+               const std::vector<std::string> &oids, uint64_t nowMs);
+    // Resets every field of every object
+    void clear(View view, uint64_t nowMs);
+
+    bool getWatermark(View view, Group group, const std::string &oid,
+                      const std::string &field, uint64_t &value) const;
+
+    // Fields of the view raised or cleared since the last call, one entry per object
+    void getUpdates(View view, std::vector<swss::KeyOpFieldsValuesTuple> &updates);
+
+private:
+    // Per view and slot bits
+    enum : uint8_t
+    {
+        VALID   = 1 << 0,
+        DIRTY   = 1 << 1,
+        CLEARED = 1 << 2,
+    };
+
+    struct GroupState
+    {
+        std::vector<std::string> fields;
+        uint64_t pollIntervalMs = 0;
+        bool hasUpdate = false;
+        uint64_t lastUpdateMs = 0;
+        uint64_t missedPolls = 0;
+
+        std::vector<std::string> oids;
+        std::unordered_map<std::string, size_t> index;
+
+        // Per slot, a slot being object position * fields + field
+        std::vector<uint64_t> last;
+        std::vector<uint8_t> hasLast;
+        std::vector<uint64_t> value[VIEW_COUNT];
+        std::vector<uint8_t> flags[VIEW_COUNT];
+        std::vector<uint64_t> clearedAtMs[VIEW_COUNT];
+    };
+
+    void clearSlot(GroupState &group, View view, size_t slot, uint64_t nowMs);
+
+    GroupState m_groups[GROUP_COUNT];
+};
@@ -4,7 +4,9 @@
 #include "notifier.h"
 #include "converter.h"
 #include "bufferorch.h"
+#include "high_frequency_telemetry/counternameupdater.h"
 #include <inttypes.h>
+#include <chrono>
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
 
@@ -19,6 +21,18 @@
 extern PortsOrch *gPortsOrch;
 extern BufferOrch *gBufferOrch;
 
+static const map<string, WatermarkAggregator::Group> keyToGroup =
+{
+    { "QUEUE_WATERMARK",       WatermarkAggregator::QUEUE },
+    { "PG_WATERMARK",          WatermarkAggregator::PG },
+    { "BUFFER_POOL_WATERMARK", WatermarkAggregator::BUFFER_POOL }
+};
+
+static uint64_t getNowMs(void)
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count());
+}
 
 WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     Orch(db, tables)
@@ -32,6 +46,26 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
     m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
 
+    m_watermarksPipe = make_unique<RedisPipeline>(m_countersDb.get());
+    m_watermarksBatch[WatermarkAggregator::USER] = make_unique<Table>(m_watermarksPipe.get(), USER_WATERMARKS_TABLE, true);
+    m_watermarksBatch[WatermarkAggregator::PERSISTENT] = make_unique<Table>(m_watermarksPipe.get(), PERSISTENT_WATERMARKS_TABLE, true);
+    m_watermarksBatch[WatermarkAggregator::PERIODIC] = make_unique<Table>(m_watermarksPipe.get(), PERIODIC_WATERMARKS_TABLE, true);
+
+    for (uint8_t g = 0; g < WatermarkAggregator::GROUP_COUNT; g++)
+    {
+        auto group = static_cast<WatermarkAggregator::Group>(g);
+        m_watermarkReaders[g] = make_unique<CounterReader>(m_countersDb.get(), COUNTERS_TABLE,
+                                                            WatermarkAggregator::getFields(group));
+    }
+
+    m_pollInterval[WatermarkAggregator::QUEUE] = stoi(QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+    m_pollInterval[WatermarkAggregator::PG] = stoi(PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+    m_pollInterval[WatermarkAggregator::BUFFER_POOL] = stoi(BUFFER_POOL_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
+    for (uint8_t g = 0; g < WatermarkAggregator::GROUP_COUNT; g++)
+    {
+        m_aggregator.setPollInterval(static_cast<WatermarkAggregator::Group>(g), m_pollInterval[g]);
+    }
+
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
             "WATERMARK_CLEAR_REQUEST");
@@ -42,6 +76,10 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_telemetryTimer = new SelectableTimer(intervT);
     auto executorT = new ExecutableTimer(m_telemetryTimer, this, "WM_TELEMETRY_TIMER");
     Orch::addExecutor(executorT);
+
+    // Started once a watermark group is enabled
+    m_collectionTimer = new SelectableTimer(timespec { .tv_sec = 0, .tv_nsec = 0 });
+    Orch::addExecutor(new ExecutableTimer(m_collectionTimer, this, "WM_COLLECTION_TIMER"));
 }
 
 WatermarkOrch::~WatermarkOrch()
@@ -117,7 +155,8 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
 {
     SWSS_LOG_ENTER();
     uint8_t prevStatus = m_wmStatus;
-    if (key == "QUEUE_WATERMARK" || key == "PG_WATERMARK")
+    auto group = keyToGroup.find(key);
+    if (group != keyToGroup.end())
     {
         for (std::pair<std::basic_string<char>, std::basic_string<char> > i: fvt)
         {
@@ -130,6 +169,26 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
                 else if (i.second == "disable")
                 {
                     m_wmStatus = (uint8_t) (m_wmStatus & ~(groupToMask.at(key)));
+                    m_aggregator.resetUpdateTime(group->second);
+                }
+            }
+            else if (i.first == POLL_INTERVAL_FIELD)
+            {
+                uint32_t interval;
+                try
+                {
+                    interval = to_uint<uint32_t>(i.second.c_str());
+                }
+                catch (const exception &e)
+                {
+                    SWSS_LOG_ERROR("Invalid poll interval %s for %s", i.second.c_str(), key.c_str());
+                    continue;
+                }
+
+                if (interval)
+                {
+                    m_pollInterval[group->second] = interval;
+                    m_aggregator.setPollInterval(group->second, interval);
                 }
             }
         }
@@ -137,43 +196,69 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
         {
             m_telemetryTimer->start();
         }
+        updateCollectionTimer();
     SWSS_LOG_DEBUG("Status of WMs: %u", m_wmStatus);
     }
 }
 
-void WatermarkOrch::doTask(NotificationConsumer &consumer)
+void WatermarkOrch::updateCollectionTimer()
 {
     SWSS_LOG_ENTER();
-    if (!gPortsOrch->allPortsReady())
+
+    uint32_t interval = 0;
+    for (const auto &it : keyToGroup)
+    {
+        if ((m_wmStatus & groupToMask.at(it.first)) &&
+            (!interval || m_pollInterval[it.second] < interval))
+        {
+            interval = m_pollInterval[it.second];
+        }
+    }
+
+    // Counters are read and cleared on each poll, reading them twice as
+    // often folds every poll whatever the phase of the two timers
+    interval = interval ? max(interval / 2, 1u) : 0;
+    if (interval == m_collectionInterval)
     {
         return;
     }
 
-    if (m_pg_ids.empty())
+    m_collectionInterval = interval;
+    if (!interval)
     {
-        init_pg_ids();
+        m_collectionTimer->stop();
+        return;
     }
 
-    if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty() and m_all_queue_ids.empty())
+    m_collectionTimer->setInterval(timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 });
+    m_collectionTimer->reset();
+}
+
+void WatermarkOrch::doTask(NotificationConsumer &consumer)
+{
+    SWSS_LOG_ENTER();
+    if (!gPortsOrch->allPortsReady())
     {
-        init_queue_ids();
+        return;
     }
 
+    initObjects();
+
     std::string op;
     std::string data;
     std::vector<swss::FieldValueTuple> values;
 
     consumer.pop(op, data, values);
 
-    Table * table = NULL;
+    WatermarkAggregator::View view;
 
     if (op == "PERSISTENT")
     {
-        table = m_persistentWatermarkTable.get();
+        view = WatermarkAggregator::PERSISTENT;
     }
     else if (op == "USER")
     {
-        table = m_userWatermarkTable.get();
+        view = WatermarkAggregator::USER;
     }
     else
     {
@@ -183,43 +268,43 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
 
     if (data == CLEAR_PG_HEADROOM_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::PG,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       m_pg_ids);
     }
     else if (data == CLEAR_PG_SHARED_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::PG,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
                       m_pg_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_UNI_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_unicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_MULTI_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_multicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_ALL_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_all_queue_ids);
     }
     else if (data == CLEAR_BUFFER_POOL_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::BUFFER_POOL,
                       "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
     }
     else if (data == CLEAR_HEADROOM_POOL_REQUEST)
     {
-        clearSingleWm(table,
+        clearSingleWm(view, WatermarkAggregator::BUFFER_POOL,
                       "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
     }
@@ -228,23 +313,29 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
         SWSS_LOG_WARN("Unknown watermark clear request data: %s", data.c_str());
         return;
     }
+
+    publishWatermarks();
 }
 
 void WatermarkOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    if (m_pg_ids.empty())
-    {
-        init_pg_ids();
-    }
+    initObjects();
 
-    if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty() and m_all_queue_ids.empty())
+    if (&timer == m_collectionTimer)
     {
-        init_queue_ids();
+        uint64_t nowMs = getNowMs();
+        for (const auto &it : keyToGroup)
+        {
+            if (m_wmStatus & groupToMask.at(it.first))
+            {
+                collectWatermarks(it.first, it.second, nowMs);
+            }
+        }
+        publishWatermarks();
     }
-
-    if (&timer == m_telemetryTimer)
+    else if (&timer == m_telemetryTimer)
     {
         if (m_timerChanged)
         {
@@ -256,27 +347,28 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::PG,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::PG,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
                       m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_multicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::QUEUE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_all_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::BUFFER_POOL,
                       "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(WatermarkAggregator::PERIODIC, WatermarkAggregator::BUFFER_POOL,
                       "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
+        publishWatermarks();
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
     }
 }
@@ -320,29 +412,178 @@ void WatermarkOrch::init_queue_ids()
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkOrch::initObjects()
 {
-    /* Zero-out some WM in some table for some vector of object ids*/
     SWSS_LOG_ENTER();
-    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
 
-    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
+    // Queues and priority groups are looked up again whenever portsorch
+    // changed their maps, e.g. on port breakout
+    uint64_t pgMapsVersion = CounterNameMapUpdater::getVersion(COUNTERS_PG_NAME_MAP) +
+                             CounterNameMapUpdater::getVersion(COUNTERS_PG_INDEX_MAP);
+    if (!m_objectMapsRead || pgMapsVersion != m_pgMapsVersion)
+    {
+        m_pgMapsVersion = pgMapsVersion;
+        m_pg_ids.clear();
+        init_pg_ids();
+
+        vector<string> oids;
+        for (sai_object_id_t id : m_pg_ids)
+        {
+            oids.push_back(sai_serialize_object_id(id));
+        }
+        setObjects(WatermarkAggregator::PG, oids);
+    }
+
+    uint64_t queueMapsVersion = CounterNameMapUpdater::getVersion(COUNTERS_QUEUE_NAME_MAP) +
+                                CounterNameMapUpdater::getVersion(COUNTERS_QUEUE_TYPE_MAP);
+    if (!m_objectMapsRead || queueMapsVersion != m_queueMapsVersion)
+    {
+        m_queueMapsVersion = queueMapsVersion;
+        m_unicast_queue_ids.clear();
+        m_multicast_queue_ids.clear();
+        m_all_queue_ids.clear();
+        init_queue_ids();
+
+        vector<string> oids;
+        for (const auto *ids : { &m_unicast_queue_ids, &m_multicast_queue_ids, &m_all_queue_ids })
+        {
+            for (sai_object_id_t id : *ids)
+            {
+                oids.push_back(sai_serialize_object_id(id));
+            }
+        }
+        setObjects(WatermarkAggregator::QUEUE, oids);
+    }
+
+    m_objectMapsRead = true;
+
+    // Buffer pools come and go, only serialized again when they changed
+    const auto &pools = gBufferOrch->getBufferPoolNameOidMap();
+    bool changed = pools.size() != m_buffer_pool_ids.size();
+    size_t i = 0;
+    for (auto it = pools.begin(); !changed && it != pools.end(); ++it, ++i)
+    {
+        changed = it->second.m_saiObjectId != m_buffer_pool_ids[i];
+    }
+
+    if (changed)
+    {
+        m_buffer_pool_ids.clear();
+        vector<string> oids;
+        for (const auto &it : pools)
+        {
+            m_buffer_pool_ids.push_back(it.second.m_saiObjectId);
+            oids.push_back(sai_serialize_object_id(it.second.m_saiObjectId));
+        }
+        setObjects(WatermarkAggregator::BUFFER_POOL, oids);
+    }
+}
 
+void WatermarkOrch::setObjects(WatermarkAggregator::Group group, const vector<string> &oids)
+{
+    SWSS_LOG_ENTER();
+
+    if (oids == m_aggregator.getObjects(group))
+    {
+        return;
+    }
+
+    vector<string> added;
+    m_aggregator.setObjects(group, oids, added);
+
+    // Carry on with the watermarks published before a restart
+    const pair<WatermarkAggregator::View, Table *> views[] = {
+        { WatermarkAggregator::USER, m_userWatermarkTable.get() },
+        { WatermarkAggregator::PERSISTENT, m_persistentWatermarkTable.get() },
+        { WatermarkAggregator::PERIODIC, m_periodicWatermarkTable.get() }
+    };
+
+    vector<FieldValueTuple> published;
+    for (const auto &oid : added)
+    {
+        for (const auto &view : views)
+        {
+            published.clear();
+            if (view.second->get(oid, published))
+            {
+                m_aggregator.seed(view.first, group, oid, published);
+            }
+        }
+    }
+}
+
+void WatermarkOrch::collectWatermarks(const string &name, WatermarkAggregator::Group group, uint64_t nowMs)
+{
+    SWSS_LOG_ENTER();
+
+    vector<uint64_t> values;
+    vector<uint8_t> present;
+    m_watermarkReaders[group]->read(m_aggregator.getObjects(group), values, present);
+
+    m_aggregator.update(group, values, present, nowMs);
+
+    // Read less often than syncd polls, the peaks of the polls overwritten are lost
+    uint64_t missed = m_aggregator.getMissedPolls(group);
+    if (missed > m_missedPolls[group])
+    {
+        SWSS_LOG_WARN("%" PRIu64 " %s polls may have been overwritten before being read, %" PRIu64 " in total",
+                      missed - m_missedPolls[group], name.c_str(), missed);
+        m_missedPolls[group] = missed;
+    }
+}
+
+void WatermarkOrch::publishWatermarks()
+{
+    SWSS_LOG_ENTER();
+
+    size_t count = 0;
+    vector<KeyOpFieldsValuesTuple> updates;
+    for (uint8_t v = 0; v < WatermarkAggregator::VIEW_COUNT; v++)
+    {
+        updates.clear();
+        m_aggregator.getUpdates(static_cast<WatermarkAggregator::View>(v), updates);
+        for (const auto &update : updates)
+        {
+            m_watermarksBatch[v]->set(kfvKey(update), kfvFieldsValues(update));
+        }
+        count += updates.size();
+    }
+
+    if (count)
+    {
+        m_watermarksPipe->flush();
+    }
+
+    SWSS_LOG_DEBUG("Published watermarks of %zu objects", count);
+}
+
+void WatermarkOrch::clearSingleWm(WatermarkAggregator::View view, WatermarkAggregator::Group group,
+                                  string wm_name, vector<sai_object_id_t> &obj_ids)
+{
+    /* Zero-out some WM in some view for some vector of object ids*/
+    SWSS_LOG_ENTER();
+    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
+
+    vector<string> oids;
     for (sai_object_id_t id: obj_ids)
     {
-        table->set(sai_serialize_object_id(id), vfvt);
+        oids.push_back(sai_serialize_object_id(id));
     }
+
+    m_aggregator.clear(view, group, wm_name, oids, getNowMs());
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
+void WatermarkOrch::clearSingleWm(WatermarkAggregator::View view, WatermarkAggregator::Group group,
+                                  string wm_name, const object_reference_map &nameOidMap)
 {
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
 
-    vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
-
+    vector<string> oids;
     for (const auto &it : nameOidMap)
     {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
+        oids.push_back(sai_serialize_object_id(it.second.m_saiObjectId));
     }
+
+    m_aggregator.clear(view, group, wm_name, oids, getNowMs());
 }
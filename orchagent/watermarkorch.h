@@ -2,20 +2,26 @@
 #define WATERMARKORCH_H
 
 #include <map>
+#include <memory>
 
 #include "orch.h"
 #include "port.h"
+#include "counter_reader.h"
 
 #include "notificationconsumer.h"
+#include "redispipeline.h"
 #include "timer.h"
+#include "watermarkaggregator.h"
 
 const uint8_t queue_wm_status_mask = 1 << 0;
 const uint8_t pg_wm_status_mask = 1 << 1;
+const uint8_t buffer_pool_wm_status_mask = 1 << 2;
 
 static const std::map<std::string, const uint8_t> groupToMask =
 {
-    { "QUEUE_WATERMARK",     queue_wm_status_mask },
-    { "PG_WATERMARK",        pg_wm_status_mask }
+    { "QUEUE_WATERMARK",       queue_wm_status_mask },
+    { "PG_WATERMARK",          pg_wm_status_mask },
+    { "BUFFER_POOL_WATERMARK", buffer_pool_wm_status_mask }
 };
 
 class WatermarkOrch : public Orch
@@ -34,8 +40,10 @@ public:
     void handleWmConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
 
-    void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
-    void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
+    void clearSingleWm(WatermarkAggregator::View view, WatermarkAggregator::Group group,
+                       std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
+    void clearSingleWm(WatermarkAggregator::View view, WatermarkAggregator::Group group,
+                       std::string wm_name, const object_reference_map &nameOidMap);
 
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
@@ -48,8 +56,15 @@ public:
     }
 
 private:
+    void initObjects();
+    void setObjects(WatermarkAggregator::Group group, const std::vector<std::string> &oids);
+    void collectWatermarks(const std::string &name, WatermarkAggregator::Group group, uint64_t nowMs);
+    void publishWatermarks();
+    void updateCollectionTimer();
+
     /*
-    [7-2] - unused
+    [7-3] - unused
+    [2] - buffer pool wm status
     [1] - pg wm status
     [0] - queue wm status (least significant bit)
     */
@@ -63,13 +78,34 @@ private:
     std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
 
+    // Watermark counters of a group, read with one pipelined HMGET per object
+    std::unique_ptr<CounterReader> m_watermarkReaders[WatermarkAggregator::GROUP_COUNT];
+    // Missed polls already reported
+    uint64_t m_missedPolls[WatermarkAggregator::GROUP_COUNT] = {};
+
+    // The views are published in one pipelined write
+    std::unique_ptr<swss::RedisPipeline> m_watermarksPipe;
+    std::unique_ptr<swss::Table> m_watermarksBatch[WatermarkAggregator::VIEW_COUNT];
+
+    WatermarkAggregator m_aggregator;
+    uint32_t m_pollInterval[WatermarkAggregator::GROUP_COUNT];
+
     swss::NotificationConsumer* m_clearNotificationConsumer = nullptr;
     swss::SelectableTimer* m_telemetryTimer = nullptr;
+    swss::SelectableTimer* m_collectionTimer = nullptr;
+    uint32_t m_collectionInterval = 0;
 
     std::vector<sai_object_id_t> m_unicast_queue_ids;
     std::vector<sai_object_id_t> m_multicast_queue_ids;
     std::vector<sai_object_id_t> m_all_queue_ids;
     std::vector<sai_object_id_t> m_pg_ids;
+    std::vector<sai_object_id_t> m_buffer_pool_ids;
+
+    // Versions of the queue and PG maps the objects were read from, the sum
+    // of the name map and type/index map versions since both only grow
+    bool m_objectMapsRead = false;
+    uint64_t m_queueMapsVersion = 0;
+    uint64_t m_pgMapsVersion = 0;
 };
 
 #endif // WATERMARKORCH_H
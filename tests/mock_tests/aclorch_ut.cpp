@@ -1423,6 +1423,61 @@ namespace aclorch_test
         ASSERT_EQ(tableIt, orch->getAclTables().end());
     }
 
+    TEST_F(AclOrchTest, AclRule_Counter_Map_Flushed_Per_Batch)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        orch->doAclTableTask(deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }}));
+        ASSERT_NE(orch->getTableById(tableId), SAI_NULL_OBJECT_ID);
+
+        deque<KeyOpFieldsValuesTuple> kvfAclRules;
+        for (int i = 1; i <= 3; i++)
+        {
+            kvfAclRules.push_back({
+                tableId + "|acl_rule_" + to_string(i),
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, to_string(i) + ".2.3.4" }
+                }
+            });
+        }
+
+        orch->doAclRuleTask(kvfAclRules);
+
+        // every rule of the batch is in ACL_COUNTER_RULE_MAP once the task is done
+        Table counterRuleMap(&AclOrch::m_countersDb, "ACL_COUNTER_RULE_MAP");
+        for (int i = 1; i <= 3; i++)
+        {
+            string ruleId = "acl_rule_" + to_string(i);
+            auto rule = orch->getAclRule(tableId, ruleId);
+            ASSERT_NE(rule, nullptr);
+
+            string counterOid;
+            ASSERT_TRUE(counterRuleMap.hget("", tableId + ":" + ruleId, counterOid));
+            ASSERT_EQ(counterOid, sai_serialize_object_id(rule->getCounterOid()));
+        }
+        ASSERT_TRUE(orch->m_aclOrch->m_pendingCounterRuleMap.empty());
+
+        for (auto &kvfAclRule : kvfAclRules)
+        {
+            kfvOp(kvfAclRule) = DEL_COMMAND;
+            kfvFieldsValues(kvfAclRule).clear();
+        }
+        orch->doAclRuleTask(kvfAclRules);
+        ASSERT_EQ(orch->getAclRule(tableId, "acl_rule_1"), nullptr);
+    }
+
     TEST_F(AclOrchTest, AclTableType_Configuration)
     {
         const string aclTableTypeName = "TEST_TYPE";
@@ -1873,6 +1928,72 @@ namespace aclorch_test
         ASSERT_TRUE(orch->m_aclOrch->removeAclRule(rule->getTableId(), rule->getId()));
     }
 
+    TEST_F(AclOrchTest, AclRuleUpdateInPlace)
+    {
+        string acl_table_id = "acl_table_1";
+        string acl_rule_id = "acl_rule_1";
+
+        auto orch = createAclOrch();
+
+        orch->doAclTableTask(deque<KeyOpFieldsValuesTuple>(
+            { { acl_table_id,
+                SET_COMMAND,
+                { { ACL_TABLE_DESCRIPTION, "TEST" },
+                  { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                  { ACL_TABLE_STAGE, STAGE_INGRESS },
+                  { ACL_TABLE_PORTS, "1,2" } } } }));
+        ASSERT_NE(orch->getTableById(acl_table_id), SAI_NULL_OBJECT_ID);
+
+        auto setRule = [&](const vector<FieldValueTuple> &fvs)
+        {
+            orch->doAclRuleTask(deque<KeyOpFieldsValuesTuple>({ { acl_table_id + "|" + acl_rule_id, SET_COMMAND, fvs } }));
+        };
+        auto hasRange = [](int min, int max)
+        {
+            return AclRange::m_ranges.count(make_tuple(SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE, min, max)) != 0;
+        };
+
+        setRule({ { RULE_PRIORITY, "800" },
+                  { MATCH_SRC_IP, "1.1.1.1/32" },
+                  { MATCH_L4_SRC_PORT_RANGE, "100-200" },
+                  { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD } });
+
+        auto rule = orch->m_aclOrch->getAclRule(acl_table_id, acl_rule_id);
+        ASSERT_NE(rule, nullptr);
+        auto ruleOid = rule->getOid();
+        ASSERT_TRUE(hasRange(100, 200));
+
+        // Re-sending the same configuration in a different order keeps the installed rule
+        setRule({ { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                  { MATCH_L4_SRC_PORT_RANGE, "100-200" },
+                  { MATCH_SRC_IP, "1.1.1.1/32" },
+                  { RULE_PRIORITY, "800" } });
+        ASSERT_EQ(orch->m_aclOrch->getAclRule(acl_table_id, acl_rule_id), rule);
+        ASSERT_EQ(rule->getOid(), ruleOid);
+
+        // Changed matches, ranges and actions are set on the existing entry
+        setRule({ { RULE_PRIORITY, "800" },
+                  { MATCH_SRC_IP, "2.2.2.2/24" },
+                  { MATCH_L4_SRC_PORT_RANGE, "300-400" },
+                  { ACTION_PACKET_ACTION, PACKET_ACTION_DROP } });
+        ASSERT_EQ(orch->m_aclOrch->getAclRule(acl_table_id, acl_rule_id), rule);
+        ASSERT_EQ(rule->getOid(), ruleOid);
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP), "2.2.2.2&mask:255.255.255.0");
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_DROP");
+        ASSERT_FALSE(hasRange(100, 200));
+        ASSERT_TRUE(hasRange(300, 400));
+
+        // Dropping the range match disables it on the entry and releases the range
+        setRule({ { RULE_PRIORITY, "800" },
+                  { MATCH_SRC_IP, "2.2.2.2/24" },
+                  { ACTION_PACKET_ACTION, PACKET_ACTION_DROP } });
+        ASSERT_EQ(rule->getOid(), ruleOid);
+        ASSERT_TRUE(rule->getRangeConfig().empty());
+        ASSERT_FALSE(hasRange(300, 400));
+
+        ASSERT_TRUE(orch->m_aclOrch->removeAclRule(acl_table_id, acl_rule_id));
+    }
+
     TEST_F(AclOrchTest, deleteNonExistingRule)
     {
         string tableId = "acl_table";
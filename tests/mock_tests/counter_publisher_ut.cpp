@@ -0,0 +1,125 @@
+#include "flex_counter/counter_publisher.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace counter_publisher_test
+{
+    using namespace std;
+    using namespace swss;
+
+    vector<KeyOpFieldsValuesTuple> cycle(const string &rxBps, const string &txBps)
+    {
+        return {
+            KeyOpFieldsValuesTuple("oid:0x1000000000002", SET_COMMAND,
+                                   { { "RX_BPS", rxBps }, { "TX_BPS", txBps } }),
+            KeyOpFieldsValuesTuple("oid:0x1000000000003", SET_COMMAND,
+                                   { { "RX_BPS", "0" }, { "TX_BPS", "0" } })
+        };
+    }
+
+    TEST(CounterPublisher, FullModeKeepsEverything)
+    {
+        CounterPublisher publisher;
+        ASSERT_EQ(publisher.getMode(), CounterPublisher::FULL);
+
+        for (int i = 0; i < 3; i++)
+        {
+            auto updates = cycle("100", "200");
+            publisher.filter(updates);
+            ASSERT_EQ(updates.size(), 2);
+        }
+
+        ASSERT_EQ(publisher.getStats().cycles, 3);
+        ASSERT_EQ(publisher.getStats().written, 12);
+        ASSERT_EQ(publisher.getStats().skipped, 0);
+    }
+
+    TEST(CounterPublisher, DeltaModeDropsUnchanged)
+    {
+        CounterPublisher publisher;
+        publisher.setMode(CounterPublisher::DELTA);
+        publisher.setFullRefreshCycles(3);
+
+        /* Everything is published first */
+        auto updates = cycle("100", "200");
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 2);
+
+        /* Then only what changed, idle objects are dropped */
+        updates = cycle("150", "200");
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(kfvKey(updates[0]), "oid:0x1000000000002");
+        ASSERT_EQ(kfvFieldsValues(updates[0]).size(), 1);
+        ASSERT_EQ(fvField(kfvFieldsValues(updates[0])[0]), "RX_BPS");
+        ASSERT_EQ(publisher.getStats().lastWritten, 1);
+        ASSERT_EQ(publisher.getStats().lastSkipped, 3);
+
+        updates = cycle("150", "200");
+        publisher.filter(updates);
+        ASSERT_TRUE(updates.empty());
+
+        /* Every third cycle republishes everything */
+        updates = cycle("150", "200");
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 2);
+        ASSERT_EQ(publisher.getStats().lastSkipped, 0);
+
+        updates = cycle("150", "200");
+        publisher.filter(updates);
+        ASSERT_TRUE(updates.empty());
+
+        ASSERT_EQ(publisher.getStats().written, 4 + 1 + 4);
+        ASSERT_EQ(publisher.getStats().skipped, 3 + 4 + 4);
+
+        /* Totals exported to STATE_DB */
+        vector<FieldValueTuple> fvs;
+        publisher.getStatsFields(fvs);
+        ASSERT_EQ(fvs, vector<FieldValueTuple>({ { "mode", "delta" }, { "full_refresh_cycles", "3" },
+                                                 { "cycles", "5" }, { "written", "9" }, { "skipped", "11" } }));
+    }
+
+    TEST(CounterPublisher, NewFieldsAndDeletes)
+    {
+        CounterPublisher publisher;
+        publisher.setMode(CounterPublisher::DELTA);
+
+        vector<KeyOpFieldsValuesTuple> updates = {
+            KeyOpFieldsValuesTuple("oid:1", SET_COMMAND, { { "RX_PPS", "" } })
+        };
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+
+        /* A field never published goes out even with the value of another */
+        updates = { KeyOpFieldsValuesTuple("oid:1", SET_COMMAND, { { "RX_PPS", "" }, { "TX_PPS", "" } }) };
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(kfvFieldsValues(updates[0]).size(), 1);
+        ASSERT_EQ(fvField(kfvFieldsValues(updates[0])[0]), "TX_PPS");
+
+        /* Deletes go out and forget the key */
+        updates = { KeyOpFieldsValuesTuple("oid:1", DEL_COMMAND, {}) };
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+
+        updates = { KeyOpFieldsValuesTuple("oid:1", SET_COMMAND, { { "RX_PPS", "" } }) };
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+
+        /* Switching mode or resetting starts over from a full refresh */
+        publisher.reset();
+        updates = { KeyOpFieldsValuesTuple("oid:1", SET_COMMAND, { { "RX_PPS", "" } }) };
+        publisher.filter(updates);
+        ASSERT_EQ(updates.size(), 1);
+
+        CounterPublisher::Mode mode;
+        ASSERT_TRUE(CounterPublisher::parseMode("delta", mode));
+        ASSERT_EQ(mode, CounterPublisher::DELTA);
+        ASSERT_TRUE(CounterPublisher::parseMode("full", mode));
+        ASSERT_EQ(mode, CounterPublisher::FULL);
+        ASSERT_FALSE(CounterPublisher::parseMode("sometimes", mode));
+    }
+}
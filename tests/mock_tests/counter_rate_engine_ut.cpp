@@ -0,0 +1,229 @@
+#include "flex_counter/counter_rate_engine.h"
+#include "counter_updates.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace counter_rate_engine_test
+{
+    using namespace std;
+    using namespace swss;
+
+    typedef CountersTable RatesTable;
+
+    void apply(CounterRateEngine &engine, RatesTable &rates)
+    {
+        vector<KeyOpFieldsValuesTuple> updates;
+        engine.getUpdates(updates);
+        CounterUpdates::apply(updates, rates);
+    }
+
+    void sample(CounterRateEngine &engine, const vector<vector<uint64_t>> &rows, double elapsedMs, double alpha)
+    {
+        vector<uint64_t> values;
+        for (const auto &row : rows)
+        {
+            values.insert(values.end(), row.begin(), row.end());
+        }
+        engine.update(values, vector<uint8_t>(values.size(), 1), elapsedMs, alpha);
+    }
+
+    string num(double value)
+    {
+        return CounterRateEngine::formatNumber(value);
+    }
+
+    TEST(CounterRateEngine, RifRatesMatchPlugin)
+    {
+        CounterRateEngine engine(CounterRateProfile::rif());
+        RatesTable rates;
+
+        engine.setObjects({ "oid:0x6000000000001" });
+
+        /* First sample only records the counters */
+        sample(engine, { { 0, 0, 0, 0 } }, 1000, 0.18);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:0x6000000000001:RIF"]["INIT_DONE"], "COUNTERS_LAST");
+        ASSERT_EQ(rates["oid:0x6000000000001"].count("RX_BPS"), 0);
+        ASSERT_EQ(rates["oid:0x6000000000001"]["SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last"], "0");
+
+        /* Second sample writes the raw rates */
+        sample(engine, { { 1000, 10, 2000, 20 } }, 1000, 0.18);
+        apply(engine, rates);
+        auto &rif = rates["oid:0x6000000000001"];
+        ASSERT_EQ(rates["oid:0x6000000000001:RIF"]["INIT_DONE"], "DONE");
+        ASSERT_EQ(rif["RX_BPS"], "1000");
+        ASSERT_EQ(rif["RX_PPS"], "10");
+        ASSERT_EQ(rif["TX_BPS"], "2000");
+        ASSERT_EQ(rif["TX_PPS"], "20");
+
+        /* Then alpha * new + (1 - alpha) * old, over the elapsed time */
+        sample(engine, { { 5000, 20, 2000, 20 } }, 2000, 0.18);
+        apply(engine, rates);
+        ASSERT_EQ(rif["RX_BPS"], num(0.18 * 2000 + 0.82 * 1000));
+        ASSERT_EQ(rif["RX_PPS"], num(0.18 * 5 + 0.82 * 10));
+        ASSERT_EQ(rif["TX_BPS"], num(0.82 * 2000));
+        ASSERT_EQ(rif["TX_PPS"], num(0.82 * 20));
+        ASSERT_EQ(rif["SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last"], "5000");
+        ASSERT_DOUBLE_EQ(engine.getRate("oid:0x6000000000001", "RX_BPS"), 0.18 * 2000 + 0.82 * 1000);
+
+        /* The state is only written when it changes */
+        vector<KeyOpFieldsValuesTuple> updates;
+        sample(engine, { { 6000, 30, 3000, 30 } }, 1000, 0.18);
+        engine.getUpdates(updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(kfvKey(updates[0]), "oid:0x6000000000001");
+    }
+
+    TEST(CounterRateEngine, PortRatesAndFec)
+    {
+        CounterRateEngine engine(CounterRateProfile::port());
+        const auto &names = engine.getCounterNames();
+        const size_t width = names.size();
+        RatesTable rates;
+
+        auto row = [&](uint64_t pkts, uint64_t octets, uint64_t corrected, uint64_t uncorrectable, int maxT)
+        {
+            vector<uint64_t> values(width, 0);
+            for (size_t i = 0; i < width; i++)
+            {
+                if (names[i].find("_PKTS") != string::npos)
+                {
+                    values[i] = pkts;
+                }
+                else if (names[i].find("_OCTETS") != string::npos)
+                {
+                    values[i] = octets;
+                }
+                else if (names[i] == "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS")
+                {
+                    values[i] = corrected;
+                }
+                else if (names[i] == "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES")
+                {
+                    values[i] = uncorrectable;
+                }
+                else if (names[i] == "SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S" + to_string(maxT))
+                {
+                    values[i] = 1;
+                }
+            }
+            return values;
+        };
+
+        /* 100G on 4 lanes */
+        const double lineRate = CounterRateEngine::getSerdesLineRate(4, 100000);
+        ASSERT_DOUBLE_EQ(lineRate, 4 * 25.78125e+9);
+        ASSERT_DOUBLE_EQ(CounterRateEngine::getSerdesLineRate(3, 100000), 0);
+        ASSERT_DOUBLE_EQ(CounterRateEngine::getSerdesLineRate(0, 100000), 0);
+
+        engine.setObjects({ "oid:0x1000000000002", "oid:0x1000000000003" });
+        engine.setLineRate("oid:0x1000000000002", lineRate);
+
+        sample(engine, { row(100, 1000, 0, 0, 0), row(100, 1000, 0, 0, 0) }, 1000, 0.5);
+        apply(engine, rates);
+        auto &port = rates["oid:0x1000000000002"];
+        ASSERT_EQ(port["SAI_PORT_STAT_IF_FEC_CORRECTED_BITS_last"], "0");
+        ASSERT_EQ(port.count("FEC_PRE_BER"), 0);
+
+        sample(engine, { row(300, 5000, 2062500, 10, 3), row(300, 5000, 2062500, 10, 3) }, 2000, 0.5);
+        apply(engine, rates);
+
+        /* Packets are summed over unicast and non unicast */
+        ASSERT_EQ(port["RX_PPS"], "200");
+        ASSERT_EQ(port["TX_PPS"], "200");
+        ASSERT_EQ(port["RX_BPS"], "2000");
+        ASSERT_EQ(port["TX_BPS"], "2000");
+
+        ASSERT_EQ(port["FEC_PRE_BER"], num(2062500 / (lineRate * 2)));
+        ASSERT_EQ(port["FEC_POST_BER"], num(10 * 1e-8 / (lineRate * 2)));
+        ASSERT_EQ(port["FEC_PRE_BER_MAX"], port["FEC_PRE_BER"]);
+        ASSERT_EQ(port["FEC_MAX_T"], "3");
+        ASSERT_EQ(port["SAI_PORT_STAT_IF_FEC_CORRECTED_BITS_last"], "2062500");
+        ASSERT_EQ(port["SAI_PORT_STAT_IF_FEC_NOT_CORRECTABLE_FARMES_last"], "10");
+
+        /* No line rate, no FEC fields */
+        ASSERT_EQ(rates["oid:0x1000000000003"].count("FEC_PRE_BER"), 0);
+        ASSERT_EQ(rates["oid:0x1000000000003"]["RX_PPS"], "200");
+
+        /* The max only moves up */
+        rates.clear();
+        sample(engine, { row(400, 6000, 2062501, 10, 0), row(400, 6000, 0, 0, 0) }, 1000, 0.5);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:0x1000000000002"].count("FEC_PRE_BER_MAX"), 0);
+        ASSERT_EQ(rates["oid:0x1000000000002"]["FEC_MAX_T"], "0");
+    }
+
+    TEST(CounterRateEngine, MissingCounters)
+    {
+        /* RIF skips objects missing a counter */
+        CounterRateEngine rif(CounterRateProfile::rif());
+        rif.setObjects({ "oid:1", "oid:2" });
+        rif.update({ 1, 1, 1, 1, 1, 1, 1, 1 }, { 1, 1, 1, 1, 1, 0, 1, 1 }, 1000, 0.5);
+        ASSERT_EQ(rif.getState("oid:1"), CounterRateEngine::COUNTERS_LAST);
+        ASSERT_EQ(rif.getState("oid:2"), CounterRateEngine::INIT);
+
+        /* Trap reads a missing counter as 0 */
+        CounterRateEngine trap(CounterRateProfile::trap());
+        RatesTable rates;
+        trap.setObjects({ "oid:3" });
+        trap.update({ 0 }, { 0 }, 10000, 0.5);
+        trap.update({ 100 }, { 1 }, 10000, 0.5);
+        apply(trap, rates);
+        ASSERT_EQ(rates["oid:3"]["RX_PPS"], "10");
+        ASSERT_EQ(rates["oid:3:TRAP"]["INIT_DONE"], "DONE");
+    }
+
+    TEST(CounterRateEngine, ObjectsKeepState)
+    {
+        CounterRateEngine engine(CounterRateProfile::tunnel());
+        RatesTable rates;
+
+        engine.setObjects({ "oid:1" });
+        sample(engine, { { 0, 0, 0, 0 } }, 1000, 0.5);
+
+        /* oid:1 moves to another position and keeps its last counters */
+        engine.setObjects({ "oid:2", "oid:1" });
+        ASSERT_EQ(engine.getState("oid:1"), CounterRateEngine::COUNTERS_LAST);
+        ASSERT_EQ(engine.getState("oid:2"), CounterRateEngine::INIT);
+
+        sample(engine, { { 0, 0, 0, 0 }, { 1000, 10, 0, 0 } }, 1000, 0.5);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:1"]["RX_BPS"], "1000");
+        ASSERT_EQ(rates["oid:2"].count("RX_BPS"), 0);
+
+        engine.setObjects({ "oid:2" });
+        ASSERT_EQ(engine.getState("oid:1"), CounterRateEngine::INIT);
+        ASSERT_EQ(engine.getObjects().size(), 1);
+    }
+
+    TEST(CounterRateEngine, UnchangedSampleDeferred)
+    {
+        CounterRateEngine engine(CounterRateProfile::rif());
+        RatesTable rates;
+
+        engine.setObjects({ "oid:1" });
+        engine.setPollInterval(1000);
+        sample(engine, { { 0, 0, 0, 0 } }, 1000, 0.5);
+        apply(engine, rates);
+
+        /* Read before the counters were polled again */
+        sample(engine, { { 0, 0, 0, 0 } }, 1000, 0.5);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:1"].count("RX_BPS"), 0);
+
+        /* The change covers both intervals */
+        sample(engine, { { 2000, 0, 0, 0 } }, 1000, 0.5);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:1"]["RX_BPS"], "1000");
+
+        /* Idle for two intervals reads as idle */
+        sample(engine, { { 2000, 0, 0, 0 } }, 1000, 0.5);
+        sample(engine, { { 2000, 0, 0, 0 } }, 1000, 0.5);
+        apply(engine, rates);
+        ASSERT_EQ(rates["oid:1"]["RX_BPS"], "500");
+    }
+}
@@ -0,0 +1,128 @@
+#include "flex_counter/counter_reader.h"
+#include "mock_table.h"
+#include "schema.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace counter_reader_test
+{
+    using namespace std;
+    using namespace swss;
+
+    class CounterReaderTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_counters_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+            m_counters = make_unique<Table>(m_counters_db.get(), COUNTERS_TABLE);
+        }
+
+        void TearDown() override
+        {
+            ::testing_db::reset();
+        }
+
+        shared_ptr<DBConnector> m_counters_db;
+        unique_ptr<Table> m_counters;
+    };
+
+    TEST_F(CounterReaderTest, ReadsFieldsInKeyOrder)
+    {
+        m_counters->set("oid:0x1", { { "A", "10" }, { "B", "20" } });
+        m_counters->set("oid:0x2", { { "B", "40" }, { "C", "50" } });
+
+        CounterReader reader(m_counters_db.get(), COUNTERS_TABLE, { "A", "B" });
+        vector<string> values;
+        vector<uint8_t> present;
+        reader.read({ "oid:0x2", "oid:0x3", "oid:0x1" }, values, present);
+
+        /* A missing field or key is left empty */
+        ASSERT_EQ(values, vector<string>({ "", "40", "", "", "10", "20" }));
+        ASSERT_EQ(present, vector<uint8_t>({ 0, 1, 0, 0, 1, 1 }));
+    }
+
+    TEST_F(CounterReaderTest, NonNumericCountersReadAsMissing)
+    {
+        m_counters->set("oid:0x1", { { "A", "18446744073709551615" }, { "B", "N/A" }, { "C", "" } });
+
+        CounterReader reader(m_counters_db.get(), COUNTERS_TABLE, { "A", "B", "C", "D" });
+        vector<uint64_t> values;
+        vector<uint8_t> present;
+        reader.read({ "oid:0x1" }, values, present);
+
+        ASSERT_EQ(values.size(), 4u);
+        ASSERT_EQ(values[0], 18446744073709551615ULL);
+        ASSERT_EQ(present, vector<uint8_t>({ 1, 0, 0, 0 }));
+
+        uint64_t counter;
+        ASSERT_TRUE(CounterReader::parseCounter("0", counter));
+        ASSERT_EQ(counter, 0u);
+        ASSERT_FALSE(CounterReader::parseCounter("abc", counter));
+    }
+
+    TEST_F(CounterReaderTest, ReadsMoreKeysThanOneBatch)
+    {
+        vector<string> keys;
+        for (uint32_t i = 0; i < 1200; i++)
+        {
+            keys.push_back("oid:0x" + to_string(i));
+            if (i != 700)
+            {
+                m_counters->set(keys.back(), { { "A", to_string(i) } });
+            }
+        }
+
+        CounterReader reader(m_counters_db.get(), COUNTERS_TABLE, { "A" });
+        vector<uint64_t> values;
+        vector<uint8_t> present;
+        reader.read(keys, values, present);
+
+        ASSERT_EQ(values.size(), keys.size());
+        for (uint32_t i = 0; i < keys.size(); i++)
+        {
+            ASSERT_EQ(present[i], i != 700) << keys[i];
+            ASSERT_EQ(values[i], i != 700 ? i : 0u) << keys[i];
+        }
+    }
+
+    TEST_F(CounterReaderTest, ReadsSeveralReadersInOneBatch)
+    {
+        m_counters->set("oid:0x1", { { "A", "1" }, { "B", "2" } });
+        m_counters->set("oid:0x2", { { "C", "3" } });
+
+        CounterReader queues(m_counters_db.get(), COUNTERS_TABLE, { "A", "B" });
+        CounterReader ports(m_counters_db.get(), COUNTERS_TABLE, { "C" });
+        CounterReader unused(m_counters_db.get(), COUNTERS_TABLE, { "A" });
+        vector<string> queueKeys = { "oid:0x1", "oid:0x2" };
+        vector<string> portKeys = { "oid:0x2" };
+        vector<string> noKeys;
+        vector<string> queueValues, portValues, unusedValues;
+        vector<uint8_t> queuePresent, portPresent, unusedPresent;
+
+        CounterReader::read({
+            { &queues, &queueKeys, &queueValues, &queuePresent },
+            { &unused, &noKeys, &unusedValues, &unusedPresent },
+            { &ports, &portKeys, &portValues, &portPresent }
+        });
+
+        ASSERT_EQ(queueValues, vector<string>({ "1", "2", "", "" }));
+        ASSERT_EQ(queuePresent, vector<uint8_t>({ 1, 1, 0, 0 }));
+        ASSERT_EQ(portValues, vector<string>({ "3" }));
+        ASSERT_EQ(portPresent, vector<uint8_t>({ 1 }));
+        ASSERT_TRUE(unusedValues.empty());
+
+        /* Readers of one batch share their connector */
+        DBConnector other("COUNTERS_DB", 0);
+        CounterReader otherPorts(&other, COUNTERS_TABLE, { "C" });
+        ASSERT_THROW(CounterReader::read({
+            { &queues, &queueKeys, &queueValues, &queuePresent },
+            { &otherPorts, &portKeys, &portValues, &portPresent }
+        }), invalid_argument);
+    }
+}
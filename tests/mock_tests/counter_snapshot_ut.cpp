@@ -0,0 +1,244 @@
+#include "flex_counter/counter_snapshot.h"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace counter_snapshot_test
+{
+    using namespace std;
+
+    class CounterSnapshotTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_table = "UT_COUNTERS_NAME_MAP_" + to_string(getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+            CounterSnapshotWriter::setEnabled(true);
+        }
+
+        void TearDown() override
+        {
+            CounterSnapshotWriter::setEnabled(false);
+        }
+
+        string m_table;
+    };
+
+    TEST_F(CounterSnapshotTest, DisabledHasNoWriter)
+    {
+        CounterSnapshotWriter::setEnabled(false);
+        ASSERT_EQ(CounterSnapshotWriter::get(m_table), nullptr);
+
+        CounterSnapshotReader reader;
+        ASSERT_FALSE(reader.open(m_table));
+    }
+
+    TEST_F(CounterSnapshotTest, RoundTrip)
+    {
+        auto writer = CounterSnapshotWriter::get(m_table);
+        ASSERT_NE(writer, nullptr);
+        ASSERT_EQ(CounterSnapshotWriter::get(m_table), writer);
+
+        writer->setCounters({ "SAI_PORT_STAT_IF_IN_OCTETS", "SAI_PORT_STAT_IF_OUT_OCTETS" });
+        auto eth0 = writer->setObject("Ethernet0", 0x1000000000002);
+        auto eth4 = writer->setObject("Ethernet4", 0x1000000000003);
+        ASSERT_NE(eth0, eth4);
+        writer->update({ eth0, eth4 }, { 10, 20, 30, 0 }, { 1, 1, 1, 0 }, 1234);
+
+        CounterSnapshotReader reader;
+        ASSERT_TRUE(reader.open(m_table));
+
+        CounterSnapshotReader::Snapshot snapshot;
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.timestampUs, 1234);
+        ASSERT_EQ(snapshot.counters.size(), 2);
+        ASSERT_EQ(snapshot.counters[1], "SAI_PORT_STAT_IF_OUT_OCTETS");
+        ASSERT_EQ(snapshot.objects.size(), 2);
+
+        for (const auto &object : snapshot.objects)
+        {
+            if (object.name == "Ethernet0")
+            {
+                ASSERT_EQ(object.oid, 0x1000000000002);
+                ASSERT_EQ(object.values, vector<uint64_t>({ 10, 20 }));
+            }
+            else
+            {
+                ASSERT_EQ(object.name, "Ethernet4");
+                ASSERT_EQ(object.values[0], 30);
+                ASSERT_EQ(object.present, vector<uint8_t>({ 1, 0 }));
+            }
+        }
+
+        /* Zero copy access of a slot resolved once */
+        uint64_t sequence;
+        ASSERT_TRUE(reader.begin(sequence));
+        uint64_t inOctets = reader.getValues(eth4)[0];
+        ASSERT_STREQ(reader.getObject(eth4)->name, "Ethernet4");
+        ASSERT_TRUE(reader.validate(sequence));
+        ASSERT_EQ(inOctets, 30);
+
+        /* Any write moves the sequence */
+        writer->update({ eth4 }, { 31, 1 }, { 1, 1 }, 1235);
+        ASSERT_FALSE(reader.validate(sequence));
+        ASSERT_TRUE(reader.begin(sequence));
+        ASSERT_EQ(reader.getValues(eth4)[0], 31);
+        ASSERT_TRUE(reader.validate(sequence));
+    }
+
+    TEST_F(CounterSnapshotTest, StableSlots)
+    {
+        auto writer = CounterSnapshotWriter::get(m_table);
+        ASSERT_NE(writer, nullptr);
+        writer->setCounters({ "SAI_QUEUE_STAT_PACKETS" });
+
+        auto q0 = writer->setObject("Ethernet0:0", 0x15000000000001);
+        auto q1 = writer->setObject("Ethernet0:1", 0x15000000000002);
+        ASSERT_EQ(writer->setObject("Ethernet0:0", 0x15000000000001), q0);
+
+        writer->update({ q0, q1 }, { 5, 6 }, { 1, 1 }, 1);
+
+        /* A removed object frees its slot for the next one */
+        writer->removeObject("Ethernet0:0");
+        uint32_t slot;
+        ASSERT_FALSE(writer->getSlot("Ethernet0:0", slot));
+        ASSERT_EQ(writer->setObject("Ethernet0:2", 0x15000000000003), q0);
+        ASSERT_TRUE(writer->getSlot("Ethernet0:1", slot));
+        ASSERT_EQ(slot, q1);
+
+        CounterSnapshotReader reader;
+        ASSERT_TRUE(reader.open(m_table));
+        CounterSnapshotReader::Snapshot snapshot;
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.objects.size(), 2);
+        ASSERT_EQ(snapshot.objects[0].name, "Ethernet0:2");
+        ASSERT_EQ(snapshot.objects[0].present[0], 0);
+        ASSERT_EQ(snapshot.objects[1].values[0], 6);
+    }
+
+    TEST_F(CounterSnapshotTest, GrowAndChangeCounters)
+    {
+        auto writer = CounterSnapshotWriter::get(m_table);
+        ASSERT_NE(writer, nullptr);
+        writer->setCounters({ "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS" });
+
+        CounterSnapshotReader reader;
+        ASSERT_TRUE(reader.open(m_table));
+
+        /* Beyond the initial capacity, the reader remaps the grown region */
+        vector<uint32_t> slots;
+        vector<uint64_t> values;
+        vector<uint8_t> present;
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            slots.push_back(writer->setObject("Vlan" + to_string(i), 0x6000000000000 + i));
+            values.push_back(i);
+            present.push_back(1);
+        }
+        writer->update(slots, values, present, 2);
+
+        CounterSnapshotReader::Snapshot snapshot;
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.objects.size(), 1000);
+        ASSERT_EQ(snapshot.objects[999].name, "Vlan999");
+        ASSERT_EQ(snapshot.objects[999].values[0], 999);
+        ASSERT_GE(reader.getHeader()->objectCapacity, 1000);
+
+        /* New counters drop the values, the objects stay */
+        writer->setCounters({ "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS", "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS" });
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.counters.size(), 2);
+        ASSERT_EQ(snapshot.objects.size(), 1000);
+        ASSERT_EQ(snapshot.objects[999].values, vector<uint64_t>({ 0, 0 }));
+        ASSERT_EQ(snapshot.objects[999].present, vector<uint8_t>({ 0, 0 }));
+
+        /* Rows of the wrong width are rejected */
+        writer->update({ slots[0] }, { 1 }, { 1 }, 3);
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.timestampUs, 2);
+    }
+
+    TEST_F(CounterSnapshotTest, ReaderReopens)
+    {
+        auto writer = make_unique<CounterSnapshotWriter>(m_table);
+        writer->setCounters({ "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES" });
+        auto slot = writer->setObject("ingress_lossless_pool", 0x18000000000001);
+        writer->update({ slot }, { 100 }, { 1 }, 1);
+
+        CounterSnapshotReader reader;
+        ASSERT_TRUE(reader.open(m_table));
+        CounterSnapshotReader::Snapshot snapshot;
+        ASSERT_TRUE(reader.read(snapshot));
+
+        /* The region of a writer gone is closed */
+        writer.reset();
+        ASSERT_FALSE(reader.read(snapshot, 3));
+
+        /* The next writer's region is picked up */
+        writer = make_unique<CounterSnapshotWriter>(m_table);
+        writer->setCounters({ "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES" });
+        slot = writer->setObject("egress_lossy_pool", 0x18000000000002);
+        writer->update({ slot }, { 200 }, { 1 }, 2);
+
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.objects.size(), 1);
+        ASSERT_EQ(snapshot.objects[0].name, "egress_lossy_pool");
+        ASSERT_EQ(snapshot.objects[0].values[0], 200);
+    }
+
+    TEST_F(CounterSnapshotTest, ReaderReopensReplacedRegion)
+    {
+        /* A writer that crashed: its destructor never runs, the region stays valid */
+        auto crashed = make_unique<CounterSnapshotWriter>(m_table);
+        crashed->setCounters({ "SAI_PORT_STAT_IF_IN_OCTETS" });
+        auto slot = crashed->setObject("Ethernet0", 0x1000000000002);
+        crashed->update({ slot }, { 100 }, { 1 }, 1);
+
+        CounterSnapshotReader reader;
+        ASSERT_TRUE(reader.open(m_table));
+        CounterSnapshotReader::Snapshot snapshot;
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_FALSE(reader.isReplaced());
+
+        /* Unlinked and created again by the next run */
+        shm_unlink(CounterSnapshotWriter::getRegionName(m_table).c_str());
+        ASSERT_TRUE(reader.isReplaced());
+        auto writer = make_unique<CounterSnapshotWriter>(m_table);
+        writer->setCounters({ "SAI_PORT_STAT_IF_IN_OCTETS" });
+        slot = writer->setObject("Ethernet4", 0x1000000000003);
+        writer->update({ slot }, { 200 }, { 1 }, 2);
+
+        /* Still written, but no longer read */
+        crashed->update({ slot }, { 101 }, { 1 }, 3);
+
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_FALSE(reader.isReplaced());
+        ASSERT_EQ(snapshot.timestampUs, 2);
+        ASSERT_EQ(snapshot.objects.size(), 1);
+        ASSERT_EQ(snapshot.objects[0].name, "Ethernet4");
+        ASSERT_EQ(snapshot.objects[0].values[0], 200);
+
+        /* A new writer replacing the region on its own is seen the same way */
+        auto next = make_unique<CounterSnapshotWriter>(m_table);
+        ASSERT_TRUE(reader.isReplaced());
+        next->setCounters({ "SAI_PORT_STAT_IF_IN_OCTETS" });
+        slot = next->setObject("Ethernet8", 0x1000000000004);
+        next->update({ slot }, { 300 }, { 1 }, 4);
+
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.objects[0].name, "Ethernet8");
+
+        /* Writers replaced leave the region of the last one */
+        crashed.reset();
+        writer.reset();
+        ASSERT_FALSE(reader.isReplaced());
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_EQ(snapshot.objects[0].name, "Ethernet8");
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "table.h"
+
+// Hashes rebuilt from counter updates, key to field to value
+typedef std::map<std::string, std::map<std::string, std::string>> CountersTable;
+
+struct CounterUpdates
+{
+    // Writes the updates the way they land in COUNTERS_DB, only SET is expected
+    static void apply(const std::vector<swss::KeyOpFieldsValuesTuple> &updates, CountersTable &table)
+    {
+        for (const auto &update : updates)
+        {
+            ASSERT_EQ(kfvOp(update), SET_COMMAND);
+            for (const auto &fv : kfvFieldsValues(update))
+            {
+                table[kfvKey(update)][fvField(fv)] = fvValue(fv);
+            }
+        }
+    }
+};
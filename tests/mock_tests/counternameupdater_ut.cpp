@@ -0,0 +1,104 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+#include <memory>
+#include <string>
+
+namespace counternameupdater_test
+{
+    using namespace std;
+
+    class CounterNameMapUpdaterTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_hftOrch = gHFTOrch;
+            gHFTOrch = nullptr;
+
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            m_table = make_unique<swss::Table>(m_counters_db.get(), "COUNTERS_UT_NAME_MAP");
+        }
+
+        void TearDown() override
+        {
+            CounterNameMapUpdater::setBatching(false);
+            gHFTOrch = m_hftOrch;
+            ::testing_db::reset();
+        }
+
+        bool hasName(const string &name, string &oid)
+        {
+            return m_table->hget("", name, oid);
+        }
+
+        HFTelOrch *m_hftOrch;
+        shared_ptr<swss::DBConnector> m_counters_db;
+        unique_ptr<swss::Table> m_table;
+    };
+
+    TEST_F(CounterNameMapUpdaterTest, UnbatchedWritesImmediately)
+    {
+        CounterNameMapUpdater updater("COUNTERS_DB", "COUNTERS_UT_NAME_MAP");
+
+        updater.setCounterNameMap("Ethernet0", 0x1000000000002);
+
+        string oid;
+        ASSERT_TRUE(hasName("Ethernet0", oid));
+        ASSERT_EQ(oid, "oid:0x1000000000002");
+    }
+
+    TEST_F(CounterNameMapUpdaterTest, BatchedWritesOnFlush)
+    {
+        CounterNameMapUpdater::setBatching(true);
+        CounterNameMapUpdater updater("COUNTERS_DB", "COUNTERS_UT_NAME_MAP");
+
+        updater.setCounterNameMap("Ethernet0", 0x1000000000002);
+        updater.setCounterNameMap({ { "Ethernet4", "oid:0x1000000000003" }, { "Ethernet8", "oid:0x1000000000004" } });
+        updater.setCounterNameMap("Ethernet4", 0x1000000000005);
+
+        /* Nothing is written until the end of the iteration */
+        string oid;
+        ASSERT_FALSE(hasName("Ethernet0", oid));
+        ASSERT_FALSE(hasName("Ethernet4", oid));
+
+        CounterNameMapUpdater::flushAll();
+
+        ASSERT_TRUE(hasName("Ethernet0", oid));
+        ASSERT_EQ(oid, "oid:0x1000000000002");
+        /* The last change of a name wins */
+        ASSERT_TRUE(hasName("Ethernet4", oid));
+        ASSERT_EQ(oid, "oid:0x1000000000005");
+        ASSERT_TRUE(hasName("Ethernet8", oid));
+        ASSERT_EQ(oid, "oid:0x1000000000004");
+
+        /* Turning batching off flushes what is still queued */
+        updater.setCounterNameMap("Ethernet12", 0x1000000000006);
+        ASSERT_FALSE(hasName("Ethernet12", oid));
+        CounterNameMapUpdater::setBatching(false);
+        ASSERT_TRUE(hasName("Ethernet12", oid));
+    }
+
+    TEST_F(CounterNameMapUpdaterTest, VersionMovesOnceWritten)
+    {
+        CounterNameMapUpdater updater("COUNTERS_DB", "COUNTERS_UT_NAME_MAP");
+        auto version = CounterNameMapUpdater::getVersion("COUNTERS_UT_NAME_MAP");
+
+        updater.setCounterNameMap("Ethernet0", 0x1000000000002);
+        ASSERT_NE(CounterNameMapUpdater::getVersion("COUNTERS_UT_NAME_MAP"), version);
+
+        /* Queued changes are not visible to readers yet */
+        CounterNameMapUpdater::setBatching(true);
+        version = CounterNameMapUpdater::getVersion("COUNTERS_UT_NAME_MAP");
+        updater.setCounterNameMap("Ethernet4", 0x1000000000003);
+        ASSERT_EQ(CounterNameMapUpdater::getVersion("COUNTERS_UT_NAME_MAP"), version);
+        CounterNameMapUpdater::flushAll();
+        ASSERT_NE(CounterNameMapUpdater::getVersion("COUNTERS_UT_NAME_MAP"), version);
+
+        version = CounterNameMapUpdater::getVersion("COUNTERS_UT_OTHER_NAME_MAP");
+        CounterNameMapUpdater::markChanged("COUNTERS_UT_OTHER_NAME_MAP");
+        ASSERT_NE(CounterNameMapUpdater::getVersion("COUNTERS_UT_OTHER_NAME_MAP"), version);
+    }
+}
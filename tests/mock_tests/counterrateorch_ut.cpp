@@ -0,0 +1,300 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "mock_orch_test.h"
+#include "copporch.h"
+#include "flex_counter/counterrateorch.h"
+#include "high_frequency_telemetry/counternameupdater.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace counterrateorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    const string rif1 = "oid:0x6000000000001";
+    const string rif2 = "oid:0x6000000000002";
+    const string trap1 = "oid:0x22000000000001";
+
+    class CounterRateOrchTest : public MockOrchTest
+    {
+    protected:
+        void PostSetUp() override
+        {
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            for (const auto &table : { COUNTERS_TABLE, "RATES", COUNTERS_RIF_NAME_MAP,
+                                       COUNTERS_TRAP_NAME_MAP, COUNTERS_TUNNEL_NAME_MAP })
+            {
+                swss::Table t(m_counters_db.get(), table);
+                vector<string> keys;
+                t.getKeys(keys);
+                for (const auto &key : keys)
+                {
+                    t.del(key);
+                }
+            }
+
+            m_rateOrch = new CounterRateOrch(m_app_db.get());
+        }
+
+        void PreTearDown() override
+        {
+            delete m_rateOrch;
+            m_rateOrch = nullptr;
+        }
+
+        void setAlpha(const string &name, const string &alpha)
+        {
+            swss::Table(m_counters_db.get(), "RATES").hset(name, name + "_ALPHA", alpha);
+        }
+
+        /* Written the way the orchs write them */
+        void addName(const string &nameMap, const string &name, const string &oid)
+        {
+            swss::Table(m_counters_db.get(), nameMap).hset("", name, oid);
+            CounterNameMapUpdater::markChanged(nameMap);
+        }
+
+        void setRifCounters(const string &oid, uint64_t octets, uint64_t packets)
+        {
+            swss::Table(m_counters_db.get(), COUNTERS_TABLE).set(oid, {
+                { "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS", to_string(octets) },
+                { "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS", to_string(packets) },
+                { "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS", to_string(octets) },
+                { "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS", to_string(packets) }
+            });
+        }
+
+        void setTrapCounters(const string &oid, uint64_t packets)
+        {
+            swss::Table(m_counters_db.get(), COUNTERS_TABLE).set(oid, { { "SAI_COUNTER_STAT_PACKETS", to_string(packets) } });
+        }
+
+        void poll(const string &key)
+        {
+            Portal::CounterRateOrchInternal::poll(*m_rateOrch, key);
+        }
+
+        vector<string> objects(const string &key)
+        {
+            return Portal::CounterRateOrchInternal::getEngine(*m_rateOrch, key).getObjects();
+        }
+
+        string rate(const string &key, const string &field)
+        {
+            string value;
+            swss::Table(m_counters_db.get(), "RATES").hget(key, field, value);
+            return value;
+        }
+
+        string state(const string &oid, const string &name)
+        {
+            return rate(oid + ":" + name, "INIT_DONE");
+        }
+
+        CounterRateOrch *m_rateOrch = nullptr;
+        shared_ptr<swss::DBConnector> m_counters_db;
+    };
+
+    TEST_F(CounterRateOrchTest, NoRatesWithoutAlpha)
+    {
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet0", rif1);
+        setRifCounters(rif1, 100, 1);
+
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "");
+        ASSERT_EQ(rate(rif1, "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last"), "");
+
+        /* Invalid alpha is the same as none */
+        setAlpha("RIF", "fast");
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "");
+
+        setAlpha("RIF", "0.5");
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "COUNTERS_LAST");
+        ASSERT_EQ(rate(rif1, "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last"), "100");
+    }
+
+    TEST_F(CounterRateOrchTest, AlphaReadEveryPoll)
+    {
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet0", rif1);
+        setAlpha("RIF", "0");
+
+        setRifCounters(rif1, 100, 1);
+        poll("RIF");
+        setRifCounters(rif1, 200, 2);
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "DONE");
+        string firstRate = rate(rif1, "RX_BPS");
+        ASSERT_NE(firstRate, "");
+
+        /* Alpha 0 keeps the smoothed rate */
+        setRifCounters(rif1, 100000, 1000);
+        poll("RIF");
+        ASSERT_EQ(rate(rif1, "RX_BPS"), firstRate);
+        ASSERT_EQ(rate(rif1, "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last"), "100000");
+
+        /* Alpha 1 takes the last rate as is */
+        setAlpha("RIF", "1");
+        setRifCounters(rif1, 100000000, 1000000);
+        poll("RIF");
+        ASSERT_NE(rate(rif1, "RX_BPS"), firstRate);
+    }
+
+    TEST_F(CounterRateOrchTest, MissingAndInvalidCounters)
+    {
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet0", rif1);
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet4", rif2);
+        addName(COUNTERS_TRAP_NAME_MAP, "bgp", trap1);
+        setAlpha("RIF", "0.5");
+        setAlpha("TRAP", "0.5");
+
+        /* A RIF without all of its counters is skipped */
+        setRifCounters(rif1, 100, 1);
+        swss::Table(m_counters_db.get(), COUNTERS_TABLE).set(rif2, {
+            { "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS", "N/A" },
+            { "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS", "1" },
+            { "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS", "1" }
+        });
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "COUNTERS_LAST");
+        ASSERT_EQ(state(rif2, "RIF"), "");
+
+        /* A trap counter not polled yet reads as 0 */
+        poll("FLOW_CNT_TRAP");
+        ASSERT_EQ(state(trap1, "TRAP"), "COUNTERS_LAST");
+        ASSERT_EQ(rate(trap1, "SAI_COUNTER_STAT_PACKETS_last"), "0");
+    }
+
+    TEST_F(CounterRateOrchTest, TimersUpdateOnlyTheirGroup)
+    {
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet0", rif1);
+        addName(COUNTERS_TRAP_NAME_MAP, "bgp", trap1);
+        setRifCounters(rif1, 100, 1);
+        setTrapCounters(trap1, 10);
+        setAlpha("RIF", "0.5");
+        setAlpha("TRAP", "0.5");
+
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "COUNTERS_LAST");
+        ASSERT_EQ(state(trap1, "TRAP"), "");
+        ASSERT_TRUE(objects("FLOW_CNT_TRAP").empty());
+
+        poll("FLOW_CNT_TRAP");
+        ASSERT_EQ(state(trap1, "TRAP"), "COUNTERS_LAST");
+        ASSERT_EQ(objects("FLOW_CNT_TRAP"), vector<string>({ trap1 }));
+
+        setRifCounters(rif1, 200, 2);
+        setTrapCounters(trap1, 20);
+        poll("RIF");
+        ASSERT_EQ(state(rif1, "RIF"), "DONE");
+        ASSERT_EQ(state(trap1, "TRAP"), "COUNTERS_LAST");
+
+        /* Another timer does nothing */
+        swss::SelectableTimer timer(timespec { .tv_sec = 1, .tv_nsec = 0 });
+        m_rateOrch->doTask(timer);
+        ASSERT_EQ(state(trap1, "TRAP"), "COUNTERS_LAST");
+
+        /* Disabling a group only starts that group over */
+        m_rateOrch->setGroupState("RIF", true);
+        m_rateOrch->setGroupState("RIF", false);
+        ASSERT_TRUE(objects("RIF").empty());
+        ASSERT_EQ(objects("FLOW_CNT_TRAP"), vector<string>({ trap1 }));
+    }
+
+    TEST_F(CounterRateOrchTest, PollIntervalIsPerGroup)
+    {
+        addName(COUNTERS_RIF_NAME_MAP, "Ethernet0", rif1);
+        addName(COUNTERS_TRAP_NAME_MAP, "bgp", trap1);
+        setRifCounters(rif1, 100, 1);
+        setTrapCounters(trap1, 10);
+        setAlpha("RIF", "0.5");
+        setAlpha("TRAP", "0.5");
+
+        m_rateOrch->setGroupPollInterval("RIF", "1");
+        m_rateOrch->setGroupPollInterval("FLOW_CNT_TRAP", "60000");
+        /* Ignored, the last valid interval stays */
+        m_rateOrch->setGroupPollInterval("RIF", "0");
+        poll("RIF");
+        poll("FLOW_CNT_TRAP");
+
+        /* Unchanged counters are only taken as idle after two poll intervals */
+        usleep(10000);
+        poll("RIF");
+        poll("FLOW_CNT_TRAP");
+        ASSERT_EQ(state(rif1, "RIF"), "DONE");
+        ASSERT_EQ(rate(rif1, "RX_BPS"), "0");
+        ASSERT_EQ(state(trap1, "TRAP"), "COUNTERS_LAST");
+    }
+
+    TEST_F(CounterRateOrchTest, RifNameMapChangesFromIntfsOrch)
+    {
+        setAlpha("RIF", "0.5");
+        gIntfsOrch->addRifToFlexCounter(rif1, "Ethernet0", "SAI_ROUTER_INTERFACE_TYPE_PORT");
+        poll("RIF");
+        ASSERT_EQ(objects("RIF"), vector<string>({ rif1 }));
+
+        /* The name map is only read again once an orch marks it changed */
+        swss::Table(m_counters_db.get(), COUNTERS_RIF_NAME_MAP).hset("", "Ethernet8", rif2);
+        poll("RIF");
+        ASSERT_EQ(objects("RIF"), vector<string>({ rif1 }));
+
+        gIntfsOrch->removeRifFromFlexCounter(rif1, "Ethernet0");
+        poll("RIF");
+        ASSERT_EQ(objects("RIF"), vector<string>({ rif2 }));
+    }
+
+    TEST_F(CounterRateOrchTest, TunnelNameMapChangesFromVxlanOrch)
+    {
+        setAlpha("TUNNEL", "0.5");
+        sai_object_id_t tunnel = 0x2a000000000001;
+        string tunnelOid = "oid:0x2a000000000001";
+
+        m_VxlanTunnelOrch->addTunnelToFlexCounter(tunnel, "vtep1");
+        poll("TUNNEL");
+        ASSERT_TRUE(objects("TUNNEL").empty());
+
+        /* Registered on the next flex counter update */
+        swss::SelectableTimer timer(timespec { .tv_sec = 1, .tv_nsec = 0 });
+        static_cast<Orch *>(m_VxlanTunnelOrch)->doTask(timer);
+        poll("TUNNEL");
+        ASSERT_EQ(objects("TUNNEL"), vector<string>({ tunnelOid }));
+
+        m_VxlanTunnelOrch->removeTunnelFromFlexCounter(tunnel, "vtep1");
+        poll("TUNNEL");
+        ASSERT_TRUE(objects("TUNNEL").empty());
+    }
+
+    TEST_F(CounterRateOrchTest, TrapNameMapChangesFromCoppOrch)
+    {
+        setAlpha("TRAP", "0.5");
+        auto coppOrch = make_shared<CoppOrch>(m_app_db.get(), APP_COPP_TABLE_NAME);
+        poll("FLOW_CNT_TRAP");
+        ASSERT_TRUE(objects("FLOW_CNT_TRAP").empty());
+
+        /* Trap flow counters enabled */
+        coppOrch->generateHostIfTrapCounterIdList();
+        vector<swss::FieldValueTuple> names;
+        swss::Table(m_counters_db.get(), COUNTERS_TRAP_NAME_MAP).get("", names);
+        ASSERT_FALSE(names.empty());
+
+        poll("FLOW_CNT_TRAP");
+        auto trapObjects = objects("FLOW_CNT_TRAP");
+        ASSERT_EQ(trapObjects.size(), names.size());
+        for (const auto &fv : names)
+        {
+            ASSERT_NE(find(trapObjects.begin(), trapObjects.end(), fvValue(fv)), trapObjects.end()) << fvField(fv);
+        }
+
+        coppOrch->clearHostIfTrapCounterIdList();
+        poll("FLOW_CNT_TRAP");
+        ASSERT_TRUE(objects("FLOW_CNT_TRAP").empty());
+    }
+}
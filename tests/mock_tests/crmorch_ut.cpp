@@ -0,0 +1,260 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+extern sai_object_id_t gSwitchId;
+extern sai_switch_api_t *sai_switch_api;
+
+namespace crmorch_test
+{
+    using namespace std;
+
+    // Mirror CRM_EXCEEDED_MSG_MAX and CRM_FULL_REWRITE_INTERVAL_SEC in crmorch.cpp
+    const uint32_t exceededMsgMax = 10;
+    const chrono::seconds fullRewriteInterval(5 * 60);
+
+    sai_switch_api_t ut_sai_switch_api;
+    sai_switch_api_t *pold_sai_switch_api;
+
+    map<sai_attr_id_t, uint32_t> availableEntries;
+    uint32_t batchedGetCount;
+    bool failBatchedGets;
+
+    sai_status_t _ut_stub_sai_get_switch_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        if (attr_count > 1)
+        {
+            batchedGetCount++;
+            if (failBatchedGets)
+            {
+                return SAI_STATUS_FAILURE;
+            }
+        }
+
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            auto it = availableEntries.find(attr_list[i].id);
+            if (it != availableEntries.end())
+            {
+                attr_list[i].value.u32 = it->second;
+                continue;
+            }
+
+            auto status = pold_sai_switch_api->get_switch_attribute(switch_id, 1, &attr_list[i]);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class CrmOrchTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+            ASSERT_EQ(ut_helper::initSaiApi(profile), SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+            ASSERT_EQ(sai_switch_api->create_switch(&gSwitchId, 1, &attr), SAI_STATUS_SUCCESS);
+
+            availableEntries = {
+                { SAI_SWITCH_ATTR_AVAILABLE_IPV4_NEXTHOP_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_MEMBER_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_IPMC_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_SNAT_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_DNAT_ENTRY, 100 },
+                { SAI_SWITCH_ATTR_AVAILABLE_TWAMP_SESSION, 100 }
+            };
+            batchedGetCount = 0;
+            failBatchedGets = false;
+
+            ut_sai_switch_api = *sai_switch_api;
+            pold_sai_switch_api = sai_switch_api;
+            ut_sai_switch_api.get_switch_attribute = _ut_stub_sai_get_switch_attribute;
+            sai_switch_api = &ut_sai_switch_api;
+
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            m_counters_table = make_unique<swss::Table>(m_counters_db.get(), COUNTERS_CRM_TABLE);
+            m_crmOrch = make_unique<CrmOrch>(m_config_db.get(), CFG_CRM_TABLE_NAME);
+        }
+
+        void TearDown() override
+        {
+            m_crmOrch.reset();
+
+            sai_switch_api = pold_sai_switch_api;
+
+            ASSERT_EQ(sai_switch_api->remove_switch(gSwitchId), SAI_STATUS_SUCCESS);
+            gSwitchId = SAI_NULL_OBJECT_ID;
+            ASSERT_EQ(ut_helper::uninitSaiApi(), SAI_STATUS_SUCCESS);
+
+            ::testing_db::reset();
+        }
+
+        const CrmOrch::CrmResourceCounter &ipv4Nexthop()
+        {
+            return Portal::CrmOrchInternal::getResourceMap(m_crmOrch.get()).at(CrmResourceType::CRM_IPV4_NEXTHOP).countersMap.at("STATS");
+        }
+
+        bool hasStat(const string &field, string &value)
+        {
+            return m_counters_table->hget("STATS", field, value);
+        }
+
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_counters_db;
+        unique_ptr<swss::Table> m_counters_table;
+        unique_ptr<CrmOrch> m_crmOrch;
+    };
+
+    TEST_F(CrmOrchTest, UnchangedCountersWriteNothing)
+    {
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+
+        string value;
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_used", value));
+        ASSERT_EQ(value, "1");
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_available", value));
+        ASSERT_EQ(value, "100");
+
+        /* Nothing changed, the removed key is not written again */
+        m_counters_table->del("STATS");
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_FALSE(hasStat("crm_stats_ipv4_nexthop_used", value));
+
+        /* Only the changed counter is written */
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_used", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_FALSE(hasStat("crm_stats_ipv4_nexthop_available", value));
+        ASSERT_FALSE(hasStat("crm_stats_ipv6_nexthop_used", value));
+    }
+
+    TEST_F(CrmOrchTest, FullRewrite)
+    {
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        m_counters_table->del("STATS");
+
+        string value;
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_FALSE(hasStat("crm_stats_ipv4_nexthop_available", value));
+
+        /* Almost the interval since the last full rewrite, still only changes */
+        auto &lastFullRewrite = Portal::CrmOrchInternal::getLastFullRewrite(m_crmOrch.get());
+        lastFullRewrite -= fullRewriteInterval - chrono::seconds(10);
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_FALSE(hasStat("crm_stats_ipv4_nexthop_available", value));
+
+        /* All counters are written again, changed or not */
+        lastFullRewrite -= chrono::seconds(10);
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_used", value));
+        ASSERT_EQ(value, "0");
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_available", value));
+        ASSERT_EQ(value, "100");
+        ASSERT_TRUE(hasStat("crm_stats_ipv6_nexthop_available", value));
+    }
+
+    TEST_F(CrmOrchTest, ThresholdChangeRechecks)
+    {
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+
+        /* 2 used of 102 is below the default thresholds */
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, 0u);
+
+        /* The counters are unchanged, the new threshold is checked anyway */
+        Portal::CrmOrchInternal::handleSetCommand(m_crmOrch.get(), "Config", {
+            { "ipv4_nexthop_low_threshold", "0" },
+            { "ipv4_nexthop_high_threshold", "1" }
+        });
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, 1u);
+
+        /* A new threshold type starts the exceeded messages over */
+        Portal::CrmOrchInternal::handleSetCommand(m_crmOrch.get(), "Config", {
+            { "ipv4_nexthop_threshold_type", "used" }
+        });
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, 0u);
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, 1u);
+
+        /* Back under the low threshold clears it */
+        Portal::CrmOrchInternal::handleSetCommand(m_crmOrch.get(), "Config", {
+            { "ipv4_nexthop_low_threshold", "5" },
+            { "ipv4_nexthop_high_threshold", "10" }
+        });
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, 0u);
+    }
+
+    TEST_F(CrmOrchTest, ExceededMessageRepeats)
+    {
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        Portal::CrmOrchInternal::handleSetCommand(m_crmOrch.get(), "Config", {
+            { "ipv4_nexthop_threshold_type", "used" },
+            { "ipv4_nexthop_low_threshold", "0" },
+            { "ipv4_nexthop_high_threshold", "1" }
+        });
+
+        /* Unchanged counters still repeat the message on every poll, up to the maximum */
+        for (uint32_t i = 1; i <= exceededMsgMax; i++)
+        {
+            Portal::CrmOrchInternal::poll(m_crmOrch.get());
+            ASSERT_EQ(ipv4Nexthop().exceededLogCounter, i);
+        }
+
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(ipv4Nexthop().exceededLogCounter, exceededMsgMax);
+    }
+
+    TEST_F(CrmOrchTest, BatchedSwitchAttrGetFallsBack)
+    {
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(batchedGetCount, 1u);
+        ASSERT_EQ(ipv4Nexthop().availableCounter, 100u);
+
+        /* A failed batched get reads each resource on its own */
+        failBatchedGets = true;
+        availableEntries[SAI_SWITCH_ATTR_AVAILABLE_IPV4_NEXTHOP_ENTRY] = 50;
+        availableEntries[SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY] = 60;
+        Portal::CrmOrchInternal::poll(m_crmOrch.get());
+        ASSERT_EQ(batchedGetCount, 2u);
+        ASSERT_EQ(ipv4Nexthop().availableCounter, 50u);
+
+        const auto &resources = Portal::CrmOrchInternal::getResourceMap(m_crmOrch.get());
+        const auto &ipv6Nexthop = resources.at(CrmResourceType::CRM_IPV6_NEXTHOP);
+        ASSERT_EQ(ipv6Nexthop.resStatus, CrmResourceStatus::CRM_RES_SUPPORTED);
+        ASSERT_EQ(ipv6Nexthop.countersMap.at("STATS").availableCounter, 60u);
+
+        string value;
+        ASSERT_TRUE(hasStat("crm_stats_ipv4_nexthop_available", value));
+        ASSERT_EQ(value, "50");
+    }
+}
@@ -25,7 +25,7 @@ namespace dashenifwdorch_ut
               MOCK_METHOD(bool, findVnetTunnel, (const std::string&, std::string&), (override));
               MOCK_METHOD(sai_object_id_t, createNextHopTunnel, (std::string, IpAddress), (override));
               MOCK_METHOD(bool, removeNextHopTunnel, (std::string, IpAddress), (override));
-              MOCK_METHOD((std::map<std::string, Port>&), getAllPorts, (), (override));
+              MOCK_METHOD((const std::map<std::string, Port>&), getAllPorts, (), (override));
        };
 
        class DashEniFwdOrchTest : public Test
@@ -75,17 +75,6 @@ const std::string WarmStartHelper::printKFV(const std::string &key,
     return "";
 }
 
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &left,
-                                   const std::vector<FieldValueTuple> &right)
-{
-    return false;
-}
-
-bool WarmStartHelper::compareOneFV(const std::string &v1, const std::string &v2)
-{
-    return false;
-}
-
 }
 
 // Test utility function to reset mock state between tests
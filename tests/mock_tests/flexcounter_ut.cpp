@@ -534,8 +534,7 @@ namespace flexcounter_test
         ASSERT_TRUE(checkFlexCounterGroup(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                           {
                                               {STATS_MODE_FIELD, STATS_MODE_READ},
-                                              {POLL_INTERVAL_FIELD, "1000"},
-                                              {RIF_PLUGIN_FIELD, ""},
+                                              {POLL_INTERVAL_FIELD, "1000"}
                                           }));
 
         Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -0,0 +1,154 @@
+#include "fpmsyncd/flushpolicy.h"
+
+#include <gtest/gtest.h>
+
+using namespace swss;
+using namespace std::chrono;
+
+namespace
+{
+    std::string getStat(const std::vector<FieldValueTuple> &fvs, const std::string &field)
+    {
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == field)
+            {
+                return fvValue(fv);
+            }
+        }
+        return "";
+    }
+}
+
+TEST(FlushPolicyTest, NothingPending)
+{
+    FlushPolicy policy;
+
+    EXPECT_EQ(policy.evaluate(0, 0, FlushPolicy::Clock::now()), FlushPolicy::NO_TIMEOUT);
+}
+
+TEST(FlushPolicyTest, SingleUpdateIsFlushedImmediately)
+{
+    FlushPolicy policy;
+
+    EXPECT_EQ(policy.evaluate(1, 0, FlushPolicy::Clock::now()), 0);
+}
+
+TEST(FlushPolicyTest, BacklogDefersFlushUntilDeadline)
+{
+    FlushPolicy policy;
+    policy.setLatencyTarget(100);
+
+    auto start = FlushPolicy::Clock::now();
+
+    // FPM messages still queued: keep batching within the latency budget
+    EXPECT_EQ(policy.evaluate(50, 10, start), 100);
+    EXPECT_EQ(policy.evaluate(80, 10, start + milliseconds(40)), 60);
+
+    // Deadline reached for the oldest entry
+    EXPECT_EQ(policy.evaluate(90, 10, start + milliseconds(100)), 0);
+    policy.onFlush(90, start + milliseconds(100));
+
+    std::vector<FieldValueTuple> fvs;
+    policy.dumpStats(fvs);
+    EXPECT_EQ(getStat(fvs, "flushes"), "1");
+    EXPECT_EQ(getStat(fvs, "flush_deadline"), "1");
+    EXPECT_EQ(getStat(fvs, "batch_le_100"), "1");
+    EXPECT_EQ(getStat(fvs, "p99_latency_ms"), "100");
+}
+
+TEST(FlushPolicyTest, MaxBatchForcesFlush)
+{
+    FlushPolicy policy;
+    policy.setMaxBatch(1000);
+
+    auto now = FlushPolicy::Clock::now();
+
+    EXPECT_EQ(policy.evaluate(1000, 100, now), 0);
+    policy.onFlush(1000, now);
+
+    std::vector<FieldValueTuple> fvs;
+    policy.dumpStats(fvs);
+    EXPECT_EQ(getStat(fvs, "flush_batch"), "1");
+    EXPECT_EQ(getStat(fvs, "batch_le_1000"), "1");
+    EXPECT_EQ(getStat(fvs, "flushed_entries"), "1000");
+}
+
+TEST(FlushPolicyTest, HighArrivalRateDefersFlush)
+{
+    FlushPolicy policy;
+    policy.setLatencyTarget(200);
+
+    auto now = FlushPolicy::Clock::now();
+    size_t pending = 0;
+
+    // Sustained load of 10 entries/ms with an empty FPM queue
+    for (int i = 0; i < 5; i++)
+    {
+        now += milliseconds(100);
+        pending += 1000;
+        int timeout = policy.evaluate(pending, 0, now);
+        if (timeout == 0)
+        {
+            policy.onFlush(pending, now);
+            pending = 0;
+        }
+    }
+
+    // The rate estimate now predicts more arrivals before the deadline
+    EXPECT_GT(policy.evaluate(pending + 1, 0, now + milliseconds(1)), 0);
+}
+
+TEST(FlushPolicyTest, IdleGapForgetsBurstRate)
+{
+    FlushPolicy policy;
+    policy.setLatencyTarget(200);
+
+    auto now = FlushPolicy::Clock::now();
+    size_t pending = 0;
+
+    // Burst of 10 entries/ms
+    for (int i = 0; i < 5; i++)
+    {
+        now += milliseconds(100);
+        pending += 1000;
+        if (policy.evaluate(pending, 0, now) == 0)
+        {
+            policy.onFlush(pending, now);
+            pending = 0;
+        }
+    }
+    if (pending)
+    {
+        now += milliseconds(200);
+        EXPECT_EQ(policy.evaluate(pending, 0, now), 0);
+        policy.onFlush(pending, now);
+    }
+
+    std::vector<FieldValueTuple> fvs;
+    policy.dumpStats(fvs);
+    auto idle = std::stoul(getStat(fvs, "flush_idle"));
+
+    // A single route after a long idle gap is flushed as idle right away
+    now += seconds(10);
+    EXPECT_EQ(policy.evaluate(1, 0, now), 0);
+    policy.onFlush(1, now);
+
+    fvs.clear();
+    policy.dumpStats(fvs);
+    EXPECT_EQ(std::stoul(getStat(fvs, "flush_idle")), idle + 1);
+}
+
+TEST(FlushPolicyTest, ApplyConfig)
+{
+    FlushPolicy policy;
+
+    policy.applyConfig({{"latency_target_ms", "20"}, {"max_batch", "300"}});
+    EXPECT_EQ(policy.getLatencyTarget(), 20);
+    EXPECT_EQ(policy.getMaxBatch(), 300);
+
+    // Invalid values are ignored
+    policy.applyConfig({{"latency_target_ms", "abc"}, {"max_batch", "0"}});
+    EXPECT_EQ(policy.getLatencyTarget(), 20);
+    EXPECT_EQ(policy.getMaxBatch(), 300);
+}
@@ -0,0 +1,115 @@
+#include <arpa/inet.h>
+#include <assert.h>
+
+#include "fpmsyncd/fpmcapture.h"
+#include "fpm/fpm.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+using namespace swss;
+
+namespace
+{
+    std::vector<char> createFpmMessage(size_t payloadLen, char fill)
+    {
+        size_t len = fpm_msg_align(FPM_MSG_HDR_LEN + payloadLen);
+        std::vector<char> msg(len, fill);
+        fpm_msg_hdr_t hdr = {};
+
+        hdr.version = FPM_PROTO_VERSION;
+        hdr.msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr.msg_len = htons(static_cast<uint16_t>(len));
+        memcpy(msg.data(), &hdr, sizeof(hdr));
+
+        return msg;
+    }
+
+    class FpmCaptureTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            char path[] = "/tmp/fpmcaptureXXXXXX";
+            int fd = mkstemp(path);
+            ASSERT_GE(fd, 0);
+            close(fd);
+            m_path = path;
+        }
+
+        void TearDown() override
+        {
+            unlink(m_path.c_str());
+        }
+
+        std::string m_path;
+    };
+}
+
+TEST_F(FpmCaptureTest, RoundTrip)
+{
+    auto msg1 = createFpmMessage(20, 'a');
+    auto msg2 = createFpmMessage(40, 'b');
+    std::vector<char> chunk(msg1);
+    chunk.insert(chunk.end(), msg2.begin(), msg2.end());
+
+    {
+        FpmCaptureWriter writer(m_path);
+        writer.write(msg1.data(), msg1.size(), 100);
+        writer.write(chunk.data(), chunk.size(), 2000);
+        EXPECT_EQ(writer.getRecords(), 2);
+        EXPECT_EQ(writer.getBytes(), msg1.size() + chunk.size());
+    }
+
+    FpmCaptureReader reader(m_path);
+    FpmCaptureReader::Record record;
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.timestampNs, 100);
+    EXPECT_EQ(record.data, msg1);
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.timestampNs, 2000);
+    EXPECT_EQ(record.data, chunk);
+
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(FpmCaptureTest, RejectsInvalidFile)
+{
+    {
+        std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+        file << "not a capture file";
+    }
+
+    EXPECT_THROW(FpmCaptureReader reader(m_path), std::runtime_error);
+    EXPECT_THROW(FpmCaptureReader reader("/nonexistent/fpm.cap"), std::runtime_error);
+}
+
+TEST_F(FpmCaptureTest, RejectsTruncatedOrMalformedRecord)
+{
+    auto msg = createFpmMessage(20, 'a');
+
+    {
+        FpmCaptureWriter writer(m_path);
+        /* A partial message must never end up in a record */
+        writer.write(msg.data(), msg.size() - 4, 0);
+    }
+
+    FpmCaptureReader reader(m_path);
+    FpmCaptureReader::Record record;
+    EXPECT_THROW(reader.next(record), std::runtime_error);
+
+    {
+        FpmCaptureWriter writer(m_path);
+        writer.write(msg.data(), msg.size(), 0);
+    }
+    truncate(m_path.c_str(), 16 + 12 + 4);
+
+    FpmCaptureReader truncated(m_path);
+    EXPECT_THROW(truncated.next(record), std::runtime_error);
+}
@@ -0,0 +1,105 @@
+#include "fpmsyncd/fpmqueue.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace swss;
+
+namespace
+{
+    std::string getStat(const std::vector<FieldValueTuple> &fvs, const std::string &field)
+    {
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == field)
+            {
+                return fvValue(fv);
+            }
+        }
+        return "";
+    }
+}
+
+TEST(FpmMsgQueueTest, PushPopPreservesOrder)
+{
+    FpmMsgQueue queue(4);
+    std::atomic<bool> stop{false};
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), 4);
+
+    for (char c = 'a'; c < 'd'; c++)
+    {
+        ASSERT_TRUE(queue.push(FpmMsgQueue::Chunk(2, c), stop));
+    }
+    EXPECT_EQ(queue.depth(), 3);
+
+    FpmMsgQueue::Chunk chunk;
+    for (char c = 'a'; c < 'd'; c++)
+    {
+        ASSERT_TRUE(queue.pop(chunk));
+        ASSERT_EQ(chunk.size(), 2);
+        EXPECT_EQ(chunk[0], c);
+    }
+    EXPECT_FALSE(queue.pop(chunk));
+    EXPECT_TRUE(queue.empty());
+
+    std::vector<FieldValueTuple> fvs;
+    queue.dumpStats(fvs);
+    EXPECT_EQ(getStat(fvs, "pushed"), "3");
+    EXPECT_EQ(getStat(fvs, "popped"), "3");
+    EXPECT_EQ(getStat(fvs, "bytes"), "6");
+    EXPECT_EQ(getStat(fvs, "high_watermark"), "3");
+    EXPECT_EQ(getStat(fvs, "full_events"), "0");
+}
+
+TEST(FpmMsgQueueTest, PushGivesUpOnStopWhenFull)
+{
+    FpmMsgQueue queue(1);
+    std::atomic<bool> stop{false};
+
+    ASSERT_TRUE(queue.push(FpmMsgQueue::Chunk(1), stop));
+
+    stop = true;
+    EXPECT_FALSE(queue.push(FpmMsgQueue::Chunk(1), stop));
+    EXPECT_EQ(queue.depth(), 1);
+
+    std::vector<FieldValueTuple> fvs;
+    queue.dumpStats(fvs);
+    EXPECT_EQ(getStat(fvs, "full_events"), "1");
+}
+
+TEST(FpmMsgQueueTest, ProducerWaitsForConsumer)
+{
+    const int count = 10000;
+    FpmMsgQueue queue(8);
+    std::atomic<bool> stop{false};
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++)
+        {
+            FpmMsgQueue::Chunk chunk(sizeof(int));
+            memcpy(chunk.data(), &i, sizeof(int));
+            ASSERT_TRUE(queue.push(std::move(chunk), stop));
+        }
+    });
+
+    int expected = 0;
+    FpmMsgQueue::Chunk chunk;
+    while (expected < count)
+    {
+        if (!queue.pop(chunk))
+        {
+            continue;
+        }
+        int value;
+        memcpy(&value, chunk.data(), sizeof(int));
+        ASSERT_EQ(value, expected);
+        expected++;
+    }
+
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,114 @@
+#include "fpmsyncd/routestatecache.h"
+
+#include <gtest/gtest.h>
+
+using namespace swss;
+
+namespace
+{
+    std::string getStat(const std::vector<FieldValueTuple> &fvs, const std::string &field)
+    {
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == field)
+            {
+                return fvValue(fv);
+            }
+        }
+        return "";
+    }
+}
+
+TEST(RouteStateCacheTest, SuppressesIdenticalUpdate)
+{
+    RouteStateCache cache;
+    std::vector<FieldValueTuple> fvs = {{"protocol", "bgp"}, {"nexthop", "10.0.0.1"}, {"ifname", "Ethernet0"}};
+
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    EXPECT_TRUE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+
+    // Changed nexthop is published and becomes the new state
+    fvs[1].second = "10.0.0.2";
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    EXPECT_TRUE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+
+    // Same content under another key is a different route
+    EXPECT_FALSE(cache.checkAndUpdate("Vrf1:1.1.1.0/24", fvs));
+
+    std::vector<FieldValueTuple> stats;
+    cache.dumpStats(stats);
+    EXPECT_EQ(getStat(stats, "entries"), "2");
+    EXPECT_EQ(getStat(stats, "published"), "3");
+    EXPECT_EQ(getStat(stats, "suppressed"), "2");
+}
+
+TEST(RouteStateCacheTest, FieldBoundariesAreHashed)
+{
+    EXPECT_NE(RouteStateCache::hashFields({{"ab", "c"}}), RouteStateCache::hashFields({{"a", "bc"}}));
+    EXPECT_NE(RouteStateCache::hashFields({{"nexthop", "1"}, {"ifname", ""}}),
+              RouteStateCache::hashFields({{"nexthop", "1"}}));
+}
+
+TEST(RouteStateCacheTest, EraseRepublishes)
+{
+    RouteStateCache cache;
+    std::vector<FieldValueTuple> fvs = {{"protocol", "static"}, {"blackhole", "true"}};
+
+    EXPECT_FALSE(cache.checkAndUpdate("2.2.2.0/24", fvs));
+    cache.erase("2.2.2.0/24");
+    EXPECT_FALSE(cache.checkAndUpdate("2.2.2.0/24", fvs));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.checkAndUpdate("2.2.2.0/24", fvs));
+}
+
+TEST(RouteStateCacheTest, BoundedSize)
+{
+    RouteStateCache cache(2);
+    std::vector<FieldValueTuple> fvs = {{"protocol", "bgp"}};
+
+    EXPECT_FALSE(cache.checkAndUpdate("1.0.0.0/8", fvs));
+    EXPECT_FALSE(cache.checkAndUpdate("2.0.0.0/8", fvs));
+    EXPECT_FALSE(cache.checkAndUpdate("3.0.0.0/8", fvs));
+    EXPECT_EQ(cache.size(), 2);
+
+    // Untracked route is never suppressed
+    EXPECT_FALSE(cache.checkAndUpdate("3.0.0.0/8", fvs));
+    EXPECT_TRUE(cache.checkAndUpdate("1.0.0.0/8", fvs));
+
+    std::vector<FieldValueTuple> stats;
+    cache.dumpStats(stats);
+    EXPECT_EQ(getStat(stats, "untracked"), "2");
+}
+
+TEST(RouteStateCacheTest, AckRequired)
+{
+    RouteStateCache cache;
+    cache.setAckRequired(true);
+    std::vector<FieldValueTuple> fvs = {{"protocol", "bgp"}, {"nexthop", "10.0.0.1"}};
+
+    // Pending until orchagent answers, a resend is written again
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+
+    // With two writes outstanding, the first response does not confirm
+    cache.ack("1.1.1.0/24", true);
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    cache.ack("1.1.1.0/24", true);
+    cache.ack("1.1.1.0/24", true);
+    EXPECT_TRUE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+
+    // A failure forgets the route
+    fvs[1].second = "10.0.0.2";
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    cache.ack("1.1.1.0/24", false);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+    cache.ack("1.1.1.0/24", true);
+    EXPECT_TRUE(cache.checkAndUpdate("1.1.1.0/24", fvs));
+
+    std::vector<FieldValueTuple> stats;
+    cache.dumpStats(stats);
+    EXPECT_EQ(getStat(stats, "failed"), "1");
+}
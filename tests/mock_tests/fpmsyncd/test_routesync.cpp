@@ -908,6 +908,80 @@ TEST_F(FpmSyncdResponseTest, TestRouteMsgWithNHG)
 }
 
 
+TEST_F(FpmSyncdResponseTest, TestNextHopGroupBatchedUpdate)
+{
+    Table nexthop_group_table(m_db.get(), APP_NEXTHOP_GROUP_TABLE_NAME);
+
+    auto sendNextHop = [&](int32_t ifindex, const char* gateway, uint32_t id) {
+        struct nlmsghdr* nlh = createNewNextHopMsgHdr(ifindex, gateway, id);
+        m_mockRouteSync.onNextHopMsg(nlh, (int)(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(struct nhmsg))));
+        free(nlh);
+    };
+    auto sendGroup = [&](const vector<pair<uint32_t, uint8_t>>& members, uint32_t id) {
+        struct nlmsghdr* nlh = createNewNextHopMsgHdr(members, id);
+        m_mockRouteSync.onNextHopMsg(nlh, (int)(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(struct nhmsg))));
+        free(nlh);
+    };
+    auto getField = [&](const string& key, const string& field) {
+        vector<FieldValueTuple> fvs;
+        nexthop_group_table.get(key, fvs);
+        for (const auto& fv : fvs)
+        {
+            if (fvField(fv) == field)
+            {
+                return fvValue(fv);
+            }
+        }
+        return string();
+    };
+
+    EXPECT_CALL(m_mockRouteSync, getIfName(_, _, _))
+        .WillRepeatedly(DoAll(
+            [](int32_t ifindex, char* ifname, size_t size) {
+                snprintf(ifname, size, "Ethernet%d", ifindex);
+            },
+            Return(true)
+        ));
+
+    sendNextHop(1, test_gateway, 1);
+    sendNextHop(2, test_gateway_, 2);
+    sendGroup({{1, 1}, {2, 1}}, 10);
+    sendGroup({{1, 1}}, 11);
+
+    // Installing writes right away, ahead of the route referencing the group
+    m_mockRouteSync.installNextHopGroup(10);
+    m_mockRouteSync.installNextHopGroup(11);
+    EXPECT_EQ(getField("10", "nexthop"), "192.168.1.1,192.168.1.2");
+    EXPECT_EQ(getField("11", "nexthop"), "192.168.1.1");
+
+    // Member change and group change are only written on flush
+    sendNextHop(3, test_gateway__, 1);
+    sendGroup({{1, 2}, {2, 1}}, 10);
+    EXPECT_EQ(getField("10", "nexthop"), "192.168.1.1,192.168.1.2");
+    EXPECT_EQ(getField("11", "ifname"), "Ethernet1");
+    EXPECT_EQ(m_mockRouteSync.m_nh_groups_pending.size(), 2);
+
+    m_mockRouteSync.flushNextHopGroups();
+    EXPECT_TRUE(m_mockRouteSync.m_nh_groups_pending.empty());
+    EXPECT_EQ(getField("10", "nexthop"), "192.168.1.3,192.168.1.2");
+    EXPECT_EQ(getField("10", "ifname"), "Ethernet3,Ethernet2");
+    EXPECT_EQ(getField("10", "weight"), "2,1");
+    EXPECT_EQ(getField("11", "nexthop"), "192.168.1.3");
+    EXPECT_EQ(getField("11", "ifname"), "Ethernet3");
+
+    // Unchanged group is not queued again
+    sendGroup({{1, 2}, {2, 1}}, 10);
+    EXPECT_TRUE(m_mockRouteSync.m_nh_groups_pending.empty());
+
+    // A deleted group drops its pending update and its member references
+    sendGroup({{2, 1}}, 11);
+    m_mockRouteSync.deleteNextHopGroup(11);
+    EXPECT_TRUE(m_mockRouteSync.m_nh_groups_pending.empty());
+    EXPECT_EQ(m_mockRouteSync.m_nh_group_refs[2].count(11), 0);
+    vector<FieldValueTuple> fvs;
+    EXPECT_FALSE(nexthop_group_table.get("11", fvs));
+}
+
 TEST_F(FpmSyncdResponseTest, RouteResponseOnNoProto)
 {
     // Expect the message to zebra is sent
@@ -1236,3 +1310,81 @@ TEST_F(WarmRestartRouteSyncTest, TestRouteDeleteHandlingWarmRestartInProgress)
     EXPECT_TRUE(routeTable.get("192.168.12.0/24", result));
 
 }
+
+TEST_F(WarmRestartRouteSyncTest, TestUnchangedRouteIsSuppressed)
+{
+    auto route = create_route("192.168.13.0/24");
+    rtnl_route_set_type(route.get(), RTN_BLACKHOLE);
+    rtnl_route_set_protocol(route.get(), RTPROT_BGP);
+
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+
+    Table routeTable(m_db.get(), APP_ROUTE_TABLE_NAME);
+    vector<FieldValueTuple> result;
+    EXPECT_TRUE(routeTable.get("192.168.13.0/24", result));
+
+    // Remove the entry behind fpmsyncd's back to observe whether the resend is written
+    routeTable.del("192.168.13.0/24");
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_FALSE(routeTable.get("192.168.13.0/24", result));
+
+    // A change of the route is published
+    rtnl_route_set_protocol(route.get(), RTPROT_STATIC);
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_TRUE(routeTable.get("192.168.13.0/24", result));
+
+    // After a delete the same route is published again
+    m_testRouteSync.onRouteMsg(RTM_DELROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_FALSE(routeTable.get("192.168.13.0/24", result));
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_TRUE(routeTable.get("192.168.13.0/24", result));
+
+    vector<FieldValueTuple> stats;
+    m_testRouteSync.getRouteStateCache().dumpStats(stats);
+    for (const auto& fv : stats)
+    {
+        if (fvField(fv) == "suppressed")
+        {
+            EXPECT_EQ(fvValue(fv), "1");
+        }
+    }
+}
+
+TEST_F(WarmRestartRouteSyncTest, TestResendAfterFailureIsPublished)
+{
+    MockFpm mockFpm{&m_testRouteSync};
+    m_testRouteSync.setSuppressionEnabled(true);
+
+    auto route = create_route("192.168.14.0/24");
+    rtnl_route_set_type(route.get(), RTN_BLACKHOLE);
+    rtnl_route_set_protocol(route.get(), RTPROT_BGP);
+
+    Table routeTable(m_db.get(), APP_ROUTE_TABLE_NAME);
+    vector<FieldValueTuple> result;
+    const vector<FieldValueTuple> failure = {{"err_str", "SWSS_RC_TABLE_FULL"}, {"protocol", "bgp"}};
+    const vector<FieldValueTuple> success = {{"err_str", "SWSS_RC_SUCCESS"}, {"protocol", "bgp"}};
+
+    // Two success responses and the resend of the confirmed route
+    EXPECT_CALL(mockFpm, send(_)).Times(3).WillRepeatedly(Return(true));
+
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_TRUE(routeTable.get("192.168.14.0/24", result));
+
+    // orchagent failed the route: the resend is written again
+    m_testRouteSync.onRouteResponse("192.168.14.0/24", failure);
+    routeTable.del("192.168.14.0/24");
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_TRUE(routeTable.get("192.168.14.0/24", result));
+
+    // Still pending: written again, zebra is not answered by fpmsyncd
+    routeTable.del("192.168.14.0/24");
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_TRUE(routeTable.get("192.168.14.0/24", result));
+
+    // Once confirmed, the resend is suppressed and answered directly
+    m_testRouteSync.onRouteResponse("192.168.14.0/24", success);
+    m_testRouteSync.onRouteResponse("192.168.14.0/24", success);
+    routeTable.del("192.168.14.0/24");
+    m_testRouteSync.onRouteMsg(RTM_NEWROUTE, (struct nl_object*)route.get(), nullptr);
+    EXPECT_FALSE(routeTable.get("192.168.14.0/24", result));
+}
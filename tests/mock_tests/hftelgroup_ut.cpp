@@ -0,0 +1,36 @@
+#include "high_frequency_telemetry/hftelgroup.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+namespace hftelgroup_test
+{
+    using namespace std;
+
+    TEST(HFTelGroup, LabelsAreStable)
+    {
+        HFTelGroup group("PORT");
+
+        group.updateObjects({ "Ethernet0", "Ethernet4", "Ethernet8" });
+        ASSERT_EQ(group.getObjects().at("Ethernet0"), 1);
+        ASSERT_EQ(group.getObjects().at("Ethernet4"), 2);
+        ASSERT_EQ(group.getObjects().at("Ethernet8"), 3);
+
+        /* Objects staying keep their label, the free one is reused */
+        group.updateObjects({ "Ethernet0", "Ethernet8", "Ethernet12" });
+        ASSERT_EQ(group.getObjects().size(), 3);
+        ASSERT_EQ(group.getObjects().at("Ethernet0"), 1);
+        ASSERT_EQ(group.getObjects().at("Ethernet8"), 3);
+        ASSERT_EQ(group.getObjects().at("Ethernet12"), 2);
+        ASSERT_FALSE(group.isObjectInGroup("Ethernet4"));
+
+        group.updateObjects({ "Ethernet8", "Ethernet12", "Ethernet16", "Ethernet20" });
+        ASSERT_EQ(group.getObjects().at("Ethernet8"), 3);
+        ASSERT_EQ(group.getObjects().at("Ethernet12"), 2);
+        ASSERT_EQ(group.getObjects().at("Ethernet16"), 1);
+        ASSERT_EQ(group.getObjects().at("Ethernet20"), 4);
+        ASSERT_TRUE(group.isSameObjects({ "Ethernet8", "Ethernet12", "Ethernet16", "Ethernet20" }));
+    }
+}
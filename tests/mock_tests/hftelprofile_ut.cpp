@@ -0,0 +1,346 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "high_frequency_telemetry/hftelprofile.h"
+
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+extern sai_object_id_t gSwitchId;
+extern sai_tam_api_t *sai_tam_api;
+
+namespace hftelprofile_test
+{
+    using namespace std;
+
+    const sai_object_id_t tamObj = 0x6b000000000001;
+    const sai_object_id_t tamCollectorObj = 0x6c000000000001;
+    const sai_object_id_t ethernet0 = 0x1000000000001;
+    const sai_object_id_t ethernet4 = 0x1000000000002;
+    const sai_object_id_t ethernet8 = 0x1000000000003;
+
+    sai_tam_api_t ut_sai_tam_api;
+    sai_tam_api_t *pold_sai_tam_api;
+
+    struct Subscription
+    {
+        sai_object_id_t object;
+        sai_stat_id_t stat;
+    };
+
+    sai_object_id_t nextOid;
+    map<sai_object_id_t, Subscription> subscriptions;
+    uint32_t createdSubscriptions;
+    uint32_t removedSubscriptions;
+    map<sai_object_id_t, int32_t> telTypeStates;
+    vector<int32_t> transitions;
+    bool rejectStartToCreateConfig;
+
+    sai_status_t _ut_stub_create_object(
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        *object_id = ++nextOid;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_object(
+        _In_ sai_object_id_t object_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_set_attribute(
+        _In_ sai_object_id_t object_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* The TAM and telemetry object lists */
+    sai_status_t _ut_stub_get_object_list(
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        attr_list[0].value.objlist.count = 0;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_tam_tel_type(
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        *object_id = ++nextOid;
+        telTypeStates[*object_id] = SAI_TAM_TEL_TYPE_STATE_STOP_STREAM;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_set_tam_tel_type_attribute(
+        _In_ sai_object_id_t object_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        if (attr->id != SAI_TAM_TEL_TYPE_ATTR_STATE)
+        {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        if (rejectStartToCreateConfig &&
+            telTypeStates[object_id] == SAI_TAM_TEL_TYPE_STATE_START_STREAM &&
+            attr->value.s32 == SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        telTypeStates[object_id] = attr->value.s32;
+        transitions.push_back(attr->value.s32);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_get_tam_tel_type_attribute(
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        if (attr_list[0].id == SAI_TAM_TEL_TYPE_ATTR_IPFIX_TEMPLATES)
+        {
+            attr_list[0].value.u8list.count = 4;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_tam_counter_subscription(
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        Subscription subscription = {};
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_OBJECT_ID)
+            {
+                subscription.object = attr_list[i].value.oid;
+            }
+            else if (attr_list[i].id == SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_STAT_ID)
+            {
+                subscription.stat = static_cast<sai_stat_id_t>(attr_list[i].value.oid);
+            }
+        }
+
+        *object_id = ++nextOid;
+        subscriptions[*object_id] = subscription;
+        createdSubscriptions++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_tam_counter_subscription(
+        _In_ sai_object_id_t object_id)
+    {
+        subscriptions.erase(object_id);
+        removedSubscriptions++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class HFTelProfileTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            nextOid = 0x6d000000000000;
+            subscriptions.clear();
+            createdSubscriptions = 0;
+            removedSubscriptions = 0;
+            telTypeStates.clear();
+            transitions.clear();
+            rejectStartToCreateConfig = false;
+
+            ut_sai_tam_api = {};
+            ut_sai_tam_api.get_tam_attribute = _ut_stub_get_object_list;
+            ut_sai_tam_api.set_tam_attribute = _ut_stub_set_attribute;
+            ut_sai_tam_api.create_tam_telemetry = _ut_stub_create_object;
+            ut_sai_tam_api.remove_tam_telemetry = _ut_stub_remove_object;
+            ut_sai_tam_api.get_tam_telemetry_attribute = _ut_stub_get_object_list;
+            ut_sai_tam_api.set_tam_telemetry_attribute = _ut_stub_set_attribute;
+            ut_sai_tam_api.create_tam_report = _ut_stub_create_object;
+            ut_sai_tam_api.remove_tam_report = _ut_stub_remove_object;
+            ut_sai_tam_api.set_tam_report_attribute = _ut_stub_set_attribute;
+            ut_sai_tam_api.create_tam_tel_type = _ut_stub_create_tam_tel_type;
+            ut_sai_tam_api.remove_tam_tel_type = _ut_stub_remove_object;
+            ut_sai_tam_api.set_tam_tel_type_attribute = _ut_stub_set_tam_tel_type_attribute;
+            ut_sai_tam_api.get_tam_tel_type_attribute = _ut_stub_get_tam_tel_type_attribute;
+            ut_sai_tam_api.create_tam_counter_subscription = _ut_stub_create_tam_counter_subscription;
+            ut_sai_tam_api.remove_tam_counter_subscription = _ut_stub_remove_tam_counter_subscription;
+            pold_sai_tam_api = sai_tam_api;
+            sai_tam_api = &ut_sai_tam_api;
+
+            m_cache[SAI_OBJECT_TYPE_PORT] = {
+                { "Ethernet0", ethernet0 },
+                { "Ethernet4", ethernet4 },
+                { "Ethernet8", ethernet8 }
+            };
+            m_profile = make_unique<HFTelProfile>("test", tamObj, tamCollectorObj, m_cache);
+        }
+
+        void TearDown() override
+        {
+            m_profile.reset();
+            sai_tam_api = pold_sai_tam_api;
+        }
+
+        /* Streams IF_IN_OCTETS and IF_OUT_OCTETS of Ethernet0 and Ethernet4 */
+        void startStream()
+        {
+            m_profile->setStreamState(SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+            m_profile->setStatsIDs("PORT", { "IF_IN_OCTETS", "IF_OUT_OCTETS" });
+            m_profile->setObjectNames("PORT", { "Ethernet0", "Ethernet4" });
+            ASSERT_TRUE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+            ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG);
+            m_profile->notifyConfigReady(SAI_OBJECT_TYPE_PORT);
+            ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+            ASSERT_EQ(createdSubscriptions, 4u);
+            ASSERT_EQ(m_profile->getReconfigStats(SAI_OBJECT_TYPE_PORT).count, 1u);
+        }
+
+        /* The stats subscribed for each object */
+        map<sai_object_id_t, set<sai_stat_id_t>> subscribed()
+        {
+            map<sai_object_id_t, set<sai_stat_id_t>> stats;
+            for (const auto &subscription : subscriptions)
+            {
+                stats[subscription.second.object].insert(subscription.second.stat);
+            }
+            return stats;
+        }
+
+        CounterNameCache m_cache;
+        unique_ptr<HFTelProfile> m_profile;
+    };
+
+    TEST_F(HFTelProfileTest, UnchangedSubscriptionsStay)
+    {
+        startStream();
+        auto before = subscriptions;
+
+        m_profile->setStatsIDs("PORT", { "IF_OUT_OCTETS", "IF_IN_OCTETS" });
+        m_profile->setObjectNames("PORT", { "Ethernet4", "Ethernet0" });
+        m_profile->setObjectSAIID(SAI_OBJECT_TYPE_PORT, "Ethernet0", ethernet0);
+        ASSERT_EQ(createdSubscriptions, 4u);
+        ASSERT_EQ(removedSubscriptions, 0u);
+        ASSERT_EQ(subscriptions.size(), before.size());
+
+        /* Nothing pending, the stream goes on as it is */
+        auto count = transitions.size();
+        ASSERT_TRUE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+        ASSERT_EQ(transitions.size(), count);
+        ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+        ASSERT_EQ(m_profile->getReconfigStats(SAI_OBJECT_TYPE_PORT).count, 1u);
+    }
+
+    TEST_F(HFTelProfileTest, CounterChangesOnlyTouchTheirSubscriptions)
+    {
+        startStream();
+        auto before = subscriptions;
+
+        m_profile->setStatsIDs("PORT", { "IF_IN_OCTETS", "IF_IN_UCAST_PKTS" });
+        ASSERT_EQ(removedSubscriptions, 2u);
+        ASSERT_EQ(createdSubscriptions, 6u);
+        for (const auto &subscription : before)
+        {
+            /* The IF_IN_OCTETS ones are the same SAI objects */
+            ASSERT_EQ(subscriptions.count(subscription.first), subscription.second.stat == SAI_PORT_STAT_IF_IN_OCTETS ? 1u : 0u);
+        }
+        set<sai_stat_id_t> stats = { SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_IN_UCAST_PKTS };
+        ASSERT_EQ(subscribed(), (map<sai_object_id_t, set<sai_stat_id_t>>({ { ethernet0, stats }, { ethernet4, stats } })));
+
+        Portal::HFTelProfileInternal::undeployCounterSubscriptions(*m_profile, SAI_OBJECT_TYPE_PORT, { SAI_PORT_STAT_IF_IN_UCAST_PKTS });
+        ASSERT_EQ(removedSubscriptions, 4u);
+        stats = { SAI_PORT_STAT_IF_IN_OCTETS };
+        ASSERT_EQ(subscribed(), (map<sai_object_id_t, set<sai_stat_id_t>>({ { ethernet0, stats }, { ethernet4, stats } })));
+    }
+
+    TEST_F(HFTelProfileTest, ObjectChangesOnlyTouchTheirSubscriptions)
+    {
+        startStream();
+
+        m_profile->setObjectNames("PORT", { "Ethernet4", "Ethernet8" });
+        ASSERT_EQ(removedSubscriptions, 2u);
+        ASSERT_EQ(createdSubscriptions, 6u);
+        set<sai_stat_id_t> stats = { SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_OUT_OCTETS };
+        ASSERT_EQ(subscribed(), (map<sai_object_id_t, set<sai_stat_id_t>>({ { ethernet4, stats }, { ethernet8, stats } })));
+    }
+
+    TEST_F(HFTelProfileTest, StreamingGroupReconfiguresWithoutStopping)
+    {
+        startStream();
+        ASSERT_EQ(transitions, vector<int32_t>({ SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG, SAI_TAM_TEL_TYPE_STATE_START_STREAM }));
+
+        m_profile->setStatsIDs("PORT", { "IF_IN_OCTETS" });
+        ASSERT_TRUE(m_profile->canBeUpdated(SAI_OBJECT_TYPE_PORT));
+        ASSERT_TRUE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+        ASSERT_EQ(transitions.back(), SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG);
+        ASSERT_EQ(transitions.size(), 3u);
+        ASSERT_FALSE(m_profile->canBeUpdated(SAI_OBJECT_TYPE_PORT));
+
+        usleep(2000);
+        m_profile->notifyConfigReady(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(transitions.back(), SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+
+        auto stats = m_profile->getReconfigStats(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(stats.count, 2u);
+        ASSERT_GE(stats.last_reconfig_us, 2000u);
+        ASSERT_EQ(stats.last_stream_gap_us, 0u);
+    }
+
+    TEST_F(HFTelProfileTest, RejectedStartToCreateConfigStopsTheStream)
+    {
+        rejectStartToCreateConfig = true;
+        startStream();
+
+        m_profile->setStatsIDs("PORT", { "IF_IN_OCTETS" });
+        ASSERT_TRUE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+        ASSERT_EQ(transitions, vector<int32_t>({
+            SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG, SAI_TAM_TEL_TYPE_STATE_START_STREAM,
+            SAI_TAM_TEL_TYPE_STATE_STOP_STREAM, SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG }));
+        ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG);
+
+        usleep(2000);
+        m_profile->notifyConfigReady(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+
+        auto stats = m_profile->getReconfigStats(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(stats.count, 2u);
+        ASSERT_GE(stats.last_stream_gap_us, 2000u);
+    }
+
+    TEST_F(HFTelProfileTest, RemovedObjectStopsTheStream)
+    {
+        startStream();
+
+        m_profile->delObjectSAIID(SAI_OBJECT_TYPE_PORT, "Ethernet0");
+        ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
+        ASSERT_EQ(removedSubscriptions, 2u);
+        ASSERT_FALSE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+
+        usleep(2000);
+        const sai_object_id_t newEthernet0 = 0x1000000000010;
+        m_profile->setObjectSAIID(SAI_OBJECT_TYPE_PORT, "Ethernet0", newEthernet0);
+        ASSERT_EQ(createdSubscriptions, 6u);
+        ASSERT_TRUE(m_profile->tryCommitConfig(SAI_OBJECT_TYPE_PORT));
+        m_profile->notifyConfigReady(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(m_profile->getStreamState(SAI_OBJECT_TYPE_PORT), SAI_TAM_TEL_TYPE_STATE_START_STREAM);
+
+        auto stats = m_profile->getReconfigStats(SAI_OBJECT_TYPE_PORT);
+        ASSERT_EQ(stats.count, 2u);
+        ASSERT_GE(stats.last_reconfig_us, 2000u);
+        ASSERT_GE(stats.last_stream_gap_us, 2000u);
+    }
+}
@@ -1,16 +1,111 @@
 #include <stdlib.h>
+#include <string.h>
 #include <hiredis/hiredis.h>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mock_table.h"
 
 // Add a global redisReply for user to mock
 redisReply *mockReply = nullptr;
 
+namespace testing_db
+{
+    struct Connection
+    {
+        int dbId;
+        std::deque<std::string> commands;
+    };
+
+    std::map<const redisContext *, Connection> gConnections;
+
+    void setContextDbId(const redisContext *c, int dbId)
+    {
+        gConnections[c] = Connection{ dbId, {} };
+    }
+
+    // Splits a command in the RESP format hiredis formats it in
+    static std::vector<std::string> parseCommand(const std::string &cmd)
+    {
+        std::vector<std::string> argv;
+        size_t pos = cmd.find("\r\n");
+        while (pos != std::string::npos && pos + 3 < cmd.size() && cmd[pos + 2] == '$')
+        {
+            size_t lenEnd = cmd.find("\r\n", pos + 3);
+            if (lenEnd == std::string::npos)
+            {
+                break;
+            }
+            size_t len = std::stoul(cmd.substr(pos + 3, lenEnd - pos - 3));
+            argv.push_back(cmd.substr(lenEnd + 2, len));
+            pos = lenEnd + 2 + len;
+        }
+        return argv;
+    }
+
+    static redisReply *newReply(int type)
+    {
+        auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+        reply->type = type;
+        return reply;
+    }
+
+    // An HMGET of "<table><separator><key>" answered from the mocked DB
+    static redisReply *hmget(int dbId, const std::vector<std::string> &argv)
+    {
+        const std::string &name = argv[1];
+        size_t separator = name.find_first_of(":|");
+        std::string table = separator == std::string::npos ? name : name.substr(0, separator);
+        std::string key = separator == std::string::npos ? "" : name.substr(separator + 1);
+
+        auto reply = newReply(REDIS_REPLY_ARRAY);
+        reply->elements = argv.size() - 2;
+        reply->element = (redisReply **)calloc(sizeof(redisReply *), reply->elements);
+        for (size_t i = 0; i < reply->elements; i++)
+        {
+            std::string value;
+            if (swss::_hget(dbId, table, key, argv[i + 2], value))
+            {
+                reply->element[i] = newReply(REDIS_REPLY_STRING);
+                reply->element[i]->str = strdup(value.c_str());
+                reply->element[i]->len = value.size();
+            }
+            else
+            {
+                reply->element[i] = newReply(REDIS_REPLY_NIL);
+            }
+        }
+        return reply;
+    }
+}
+
 int redisGetReply(redisContext *c, void **reply)
 {
+    std::string command;
+    int dbId = 0;
+    auto it = testing_db::gConnections.find(c);
+    if (it != testing_db::gConnections.end() && !it->second.commands.empty())
+    {
+        command = it->second.commands.front();
+        it->second.commands.pop_front();
+        dbId = it->second.dbId;
+    }
+
     if (mockReply == nullptr)
     {
-        *reply = calloc(sizeof(redisReply), 1);
-        ((redisReply *)*reply)->type = 3;
+        auto argv = testing_db::parseCommand(command);
+        if (argv.size() > 2 && argv[0] == "HMGET")
+        {
+            *reply = testing_db::hmget(dbId, argv);
+        }
+        else
+        {
+            *reply = calloc(sizeof(redisReply), 1);
+            ((redisReply *)*reply)->type = 3;
+        }
     }
     else
     {
@@ -21,6 +116,11 @@ int redisGetReply(redisContext *c, void **reply)
 
 int redisAppendFormattedCommand(redisContext *c, const char *cmd, size_t len)
 {
+    auto it = testing_db::gConnections.find(c);
+    if (it != testing_db::gConnections.end())
+    {
+        it->second.commands.emplace_back(cmd, len);
+    }
     return 0;
 }
 
@@ -5,7 +5,17 @@
 // Use this field in the mock test to simulate an exception during hget.
 #define HGET_THROW_EXCEPTION_FIELD_NAME "hget_throw_exception"
 
+struct redisContext;
+
+namespace swss
+{
+    bool _hget(int dbId, const std::string &tableName, const std::string &key, const std::string &field, std::string &value);
+}
+
 namespace testing_db
 {
     void reset();
+
+    // HMGETs sent on the context are answered from the tables of dbId
+    void setContextDbId(const redisContext *c, int dbId);
 }
@@ -6,6 +6,7 @@
 #undef protected
 #define private public
 #include "routeorch.h"
+#include "neighorch.h"
 #undef private
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
@@ -19,16 +20,25 @@ namespace neighorch_test
     DEFINE_SAI_API_MOCK(neighbor);
     using namespace std;
     using namespace mock_orch_test;
+    using ::testing::_;
+    using ::testing::DoAll;
+    using ::testing::DoDefault;
     using ::testing::Return;
+    using ::testing::SetArrayArgument;
     using ::testing::Throw;
 
     static const string TEST_IP = "10.10.10.10";
+    static const string TEST_IP2 = "10.10.10.11";
+    static const string TEST_IP3 = "10.10.10.12";
     static const string VRF_3000 = "Vrf3000";
     static const NeighborEntry VLAN1000_NEIGH = NeighborEntry(TEST_IP, VLAN_1000);
     static const NeighborEntry VLAN2000_NEIGH = NeighborEntry(TEST_IP, VLAN_2000);
     static const NeighborEntry VLAN3000_NEIGH = NeighborEntry(TEST_IP, VLAN_3000);
     static const NeighborEntry VLAN4000_NEIGH = NeighborEntry(TEST_IP, VLAN_4000);
 
+    sai_bulk_create_neighbor_entry_fn old_create_neighbor_entries;
+    sai_bulk_remove_neighbor_entry_fn old_remove_neighbor_entries;
+
     class NeighOrchTest : public MockOrchTest
     {
     protected:
@@ -49,6 +59,29 @@ namespace neighorch_test
             neigh_table.del(key);
         }
 
+        void ApplyNeighborOps(const string &op, const vector<pair<string, string>> &neighbors, const string &mac = MAC1)
+        {
+            auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            for (const auto &neighbor : neighbors)
+            {
+                vector<FieldValueTuple> fvs;
+                if (op == SET_COMMAND)
+                {
+                    fvs = { { "neigh", mac }, { "family", "IPv4" } };
+                }
+                entries.push_back({ neighbor.first + ":" + neighbor.second, op, fvs });
+            }
+            consumer->addToSync(entries);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+        }
+
+        size_t PendingNeighborOps()
+        {
+            auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+            return consumer->m_toSync.size();
+        }
+
         void ApplyInitialConfigs()
         {
             Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -181,28 +214,34 @@ namespace neighorch_test
         {
             INIT_SAI_API_MOCK(neighbor);
             MockSaiApis();
+            old_create_neighbor_entries = gNeighOrch->gNeighBulker.create_entries;
+            old_remove_neighbor_entries = gNeighOrch->gNeighBulker.remove_entries;
+            gNeighOrch->gNeighBulker.create_entries = mock_create_neighbor_entries;
+            gNeighOrch->gNeighBulker.remove_entries = mock_remove_neighbor_entries;
         }
 
         void PreTearDown() override
         {
             RestoreSaiApis();
+            gNeighOrch->gNeighBulker.create_entries = old_create_neighbor_entries;
+            gNeighOrch->gNeighBulker.remove_entries = old_remove_neighbor_entries;
         }
     };
 
     TEST_F(NeighOrchTest, MultiVlanDuplicateNeighbor)
     {
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_1000, TEST_IP, MAC1);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
 
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry);
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_2000, TEST_IP, MAC2);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 0);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN2000_NEIGH), 1);
 
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry);
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_1000, TEST_IP, MAC3);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN2000_NEIGH), 0);
@@ -210,14 +249,14 @@ namespace neighorch_test
 
     TEST_F(NeighOrchTest, MultiVlanUnableToRemoveNeighbor)
     {
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_1000, TEST_IP, MAC1);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
         NextHopKey nexthop = { TEST_IP, VLAN_1000 };
         gNeighOrch->m_syncdNextHops[nexthop].ref_count = 1;
 
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry).Times(0);
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(0);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries).Times(0);
         LearnNeighbor(VLAN_2000, TEST_IP, MAC2);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN2000_NEIGH), 0);
@@ -225,11 +264,11 @@ namespace neighorch_test
 
     TEST_F(NeighOrchTest, MultiVlanDifferentVrfDuplicateNeighbor)
     {
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_1000, TEST_IP, MAC1);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
 
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry).Times(0);
         LearnNeighbor(VLAN_3000, TEST_IP, MAC4);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN1000_NEIGH), 1);
@@ -238,12 +277,12 @@ namespace neighorch_test
 
     TEST_F(NeighOrchTest, MultiVlanSameVrfDuplicateNeighbor)
     {
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_3000, TEST_IP, MAC4);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN3000_NEIGH), 1);
 
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry);
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries);
         LearnNeighbor(VLAN_4000, TEST_IP, MAC5);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN3000_NEIGH), 0);
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(VLAN4000_NEIGH), 1);
@@ -253,7 +292,7 @@ namespace neighorch_test
     {
         LearnNeighbor(VLAN_1000, TEST_IP, MAC1);
 
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(0);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries).Times(0);
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry).Times(0);
         gPortsOrch->m_portList.erase(VLAN_1000);
         LearnNeighbor(VLAN_2000, TEST_IP, MAC2);
@@ -263,9 +302,117 @@ namespace neighorch_test
     {
         LearnNeighbor(VLAN_1000, TEST_IP, MAC1);
 
-        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(0);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries).Times(0);
         EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry).Times(0);
         gPortsOrch->m_portList.erase(VLAN_2000);
         LearnNeighbor(VLAN_2000, TEST_IP, MAC2);
     }
+
+    TEST_F(NeighOrchTest, BulkNeighborAddRemove)
+    {
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries(3, _, _, _, _, _));
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(0);
+        ApplyNeighborOps(SET_COMMAND, { { VLAN_1000, TEST_IP }, { VLAN_1000, TEST_IP2 }, { VLAN_1000, TEST_IP3 } });
+        ASSERT_EQ(PendingNeighborOps(), 0);
+        for (const auto &ip : { TEST_IP, TEST_IP2, TEST_IP3 })
+        {
+            ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(ip, VLAN_1000)), 1);
+            ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(ip, VLAN_1000)));
+        }
+
+        EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entries(3, _, _, _));
+        EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entry).Times(0);
+        ApplyNeighborOps(DEL_COMMAND, { { VLAN_1000, TEST_IP }, { VLAN_1000, TEST_IP2 }, { VLAN_1000, TEST_IP3 } });
+        ASSERT_EQ(PendingNeighborOps(), 0);
+        for (const auto &ip : { TEST_IP, TEST_IP2, TEST_IP3 })
+        {
+            ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(ip, VLAN_1000)), 0);
+            ASSERT_FALSE(gNeighOrch->hasNextHop(NextHopKey(ip, VLAN_1000)));
+        }
+    }
+
+    TEST_F(NeighOrchTest, BulkNeighborAddNotExecutedRetried)
+    {
+        std::vector<sai_status_t> exp_status{ SAI_STATUS_SUCCESS, SAI_STATUS_NOT_EXECUTED };
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries)
+            .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)))
+            .WillOnce(DoDefault());
+        ApplyNeighborOps(SET_COMMAND, { { VLAN_1000, TEST_IP }, { VLAN_1000, TEST_IP2 } });
+
+        /* The entry left out of the bulk is kept for retry, without a next hop */
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(TEST_IP, VLAN_1000)), 1);
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(TEST_IP, VLAN_1000)));
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(TEST_IP2, VLAN_1000)), 0);
+        ASSERT_FALSE(gNeighOrch->hasNextHop(NextHopKey(TEST_IP2, VLAN_1000)));
+        ASSERT_EQ(PendingNeighborOps(), 1);
+
+        static_cast<Orch *>(gNeighOrch)->doTask();
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(TEST_IP2, VLAN_1000)), 1);
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(TEST_IP2, VLAN_1000)));
+        ASSERT_EQ(PendingNeighborOps(), 0);
+    }
+
+    TEST_F(NeighOrchTest, NextHopTableKeysSharingIpAndAlias)
+    {
+        NextHopTable table;
+        NextHopKey plain(TEST_IP, VLAN_1000);
+        NextHopKey mpls("push100+" + TEST_IP + "@" + VLAN_1000);
+        NextHopKey overlay(IpAddress(TEST_IP), VLAN_1000, MacAddress(MAC1), 1000, true);
+
+        ASSERT_EQ(NextHopKeyHash()(plain), NextHopKeyHash()(mpls));
+        table[plain].next_hop_id = 1;
+        table[mpls].next_hop_id = 2;
+        table[overlay].next_hop_id = 3;
+
+        ASSERT_EQ(table.size(), 3);
+        ASSERT_EQ(table[NextHopKey(TEST_IP, VLAN_1000)].next_hop_id, 1);
+        ASSERT_EQ(table[NextHopKey("push100+" + TEST_IP + "@" + VLAN_1000)].next_hop_id, 2);
+        ASSERT_EQ(table.count(NextHopKey(TEST_IP, VLAN_2000)), 0);
+    }
+
+    /*
+     * Lookup cost of the next hop table at 100k neighbors, against the ordered
+     * map it replaced. Run with --gtest_also_run_disabled_tests.
+     */
+    TEST_F(NeighOrchTest, DISABLED_NextHopLookupBenchmark)
+    {
+        const uint32_t count = 100000;
+        const int rounds = 10;
+        vector<NextHopKey> keys;
+        map<NextHopKey, NextHopEntry> ordered;
+        NextHopTable hashed;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            IpAddress ip(htonl(0x0a000000 + i));
+            keys.emplace_back(ip, i % 2 ? VLAN_1000 : VLAN_2000);
+            NextHopEntry entry = { i + 1, 0, 0 };
+            ordered[keys.back()] = entry;
+            hashed[keys.back()] = entry;
+        }
+
+        auto measure = [&](const string &name, const function<bool(const NextHopKey &)> &lookup)
+        {
+            auto start = chrono::steady_clock::now();
+            for (int r = 0; r < rounds; r++)
+            {
+                for (const auto &key : keys)
+                {
+                    ASSERT_TRUE(lookup(key));
+                }
+            }
+            auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            cout << name << ": " << ns / (count * rounds) << " ns/lookup" << endl;
+        };
+
+        measure("map", [&](const NextHopKey &key) { return ordered.find(key) != ordered.end(); });
+        measure("unordered_map", [&](const NextHopKey &key) { return hashed.find(key) != hashed.end(); });
+
+        gNeighOrch->m_syncdNextHops.swap(hashed);
+        measure("NeighOrch::hasNextHop", [&](const NextHopKey &key) { return gNeighOrch->hasNextHop(key); });
+        measure("NeighOrch::getLocalNextHopId", [&](const NextHopKey &key) {
+            return gNeighOrch->getLocalNextHopId(key) != SAI_NULL_OBJECT_ID;
+        });
+        gNeighOrch->m_syncdNextHops.swap(hashed);
+    }
 }
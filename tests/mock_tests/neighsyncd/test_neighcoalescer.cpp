@@ -0,0 +1,159 @@
+#include "neighsyncd/neighcoalescer.h"
+#include "mock_table.h"
+
+#include <gtest/gtest.h>
+
+using namespace swss;
+
+namespace
+{
+    std::string getStat(const std::vector<FieldValueTuple> &fvs, const std::string &field)
+    {
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == field)
+            {
+                return fvValue(fv);
+            }
+        }
+        return "";
+    }
+
+    std::vector<FieldValueTuple> neighFields(const std::string &mac)
+    {
+        return { { "neigh", mac }, { "family", "IPv4" } };
+    }
+
+    class NeighCoalescerTest : public ::testing::Test
+    {
+    protected:
+        NeighCoalescerTest() :
+            m_db("APPL_DB", 0),
+            m_pipeline(&m_db),
+            m_producer(&m_pipeline, APP_NEIGH_TABLE_NAME),
+            m_table(&m_db, APP_NEIGH_TABLE_NAME)
+        {
+        }
+
+        void SetUp() override
+        {
+            testing_db::reset();
+        }
+
+        bool getMac(const std::string &key, std::string &mac)
+        {
+            return m_table.hget(key, "neigh", mac);
+        }
+
+        std::string getStat(NeighCoalescer &coalescer, const std::string &field)
+        {
+            std::vector<FieldValueTuple> fvs;
+            coalescer.dumpStats(fvs);
+            return ::getStat(fvs, field);
+        }
+
+        DBConnector m_db;
+        RedisPipeline m_pipeline;
+        ProducerStateTable m_producer;
+        Table m_table;
+    };
+}
+
+TEST_F(NeighCoalescerTest, WritesLastUpdateAfterWindow)
+{
+    NeighCoalescer coalescer(&m_producer, 50);
+    std::string mac;
+
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:02"));
+    coalescer.set("Vlan1000:10.0.0.2", neighFields("00:00:00:00:00:03"));
+
+    /* Nothing is written before the window expires */
+    int timeout = coalescer.run();
+    EXPECT_GT(timeout, 0);
+    EXPECT_LE(timeout, 50);
+    EXPECT_FALSE(getMac("Vlan1000:10.0.0.1", mac));
+    EXPECT_EQ(coalescer.pending(), 2);
+
+    EXPECT_EQ(coalescer.run(NeighCoalescer::Clock::now() + std::chrono::milliseconds(50)), -1);
+    EXPECT_EQ(coalescer.pending(), 0);
+    ASSERT_TRUE(getMac("Vlan1000:10.0.0.1", mac));
+    EXPECT_EQ(mac, "00:00:00:00:00:02");
+    ASSERT_TRUE(getMac("Vlan1000:10.0.0.2", mac));
+    EXPECT_EQ(mac, "00:00:00:00:00:03");
+
+    EXPECT_EQ(getStat(coalescer, "events"), "3");
+    EXPECT_EQ(getStat(coalescer, "coalesced"), "1");
+    EXPECT_EQ(getStat(coalescer, "sets"), "2");
+    EXPECT_EQ(getStat(coalescer, "flushes"), "1");
+    EXPECT_EQ(coalescer.run(), -1);
+}
+
+TEST_F(NeighCoalescerTest, SuppressesUnchangedAndFlaps)
+{
+    NeighCoalescer coalescer(&m_producer, 50);
+    std::string mac;
+
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.flush();
+
+    /* State transitions re-send the same entry */
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.flush();
+
+    /* A delete and add back within the window leaves APPL_DB as it is */
+    coalescer.del("Vlan1000:10.0.0.1");
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.flush();
+
+    EXPECT_EQ(getStat(coalescer, "sets"), "1");
+    EXPECT_EQ(getStat(coalescer, "dels"), "0");
+    EXPECT_EQ(getStat(coalescer, "suppressed"), "2");
+    ASSERT_TRUE(getMac("Vlan1000:10.0.0.1", mac));
+
+    /* A MAC change is written */
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:02"));
+    coalescer.flush();
+    ASSERT_TRUE(getMac("Vlan1000:10.0.0.1", mac));
+    EXPECT_EQ(mac, "00:00:00:00:00:02");
+    EXPECT_EQ(getStat(coalescer, "sets"), "2");
+}
+
+TEST_F(NeighCoalescerTest, DeletesAreAlwaysWritten)
+{
+    NeighCoalescer coalescer(&m_producer, 50);
+    std::string mac;
+
+    /* An entry left in APPL_DB by a previous run is still removed */
+    m_producer.set("Vlan1000:10.0.0.9", neighFields("00:00:00:00:00:09"));
+    coalescer.del("Vlan1000:10.0.0.9");
+    coalescer.flush();
+    EXPECT_FALSE(getMac("Vlan1000:10.0.0.9", mac));
+
+    /* Once deleted, adding the same entry back is written again */
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.flush();
+    coalescer.del("Vlan1000:10.0.0.1");
+    coalescer.flush();
+    EXPECT_FALSE(getMac("Vlan1000:10.0.0.1", mac));
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    coalescer.flush();
+    EXPECT_TRUE(getMac("Vlan1000:10.0.0.1", mac));
+
+    EXPECT_EQ(getStat(coalescer, "dels"), "2");
+    EXPECT_EQ(getStat(coalescer, "sets"), "2");
+    EXPECT_EQ(getStat(coalescer, "suppressed"), "0");
+}
+
+TEST_F(NeighCoalescerTest, MaxPendingWritesEarly)
+{
+    NeighCoalescer coalescer(&m_producer, 1000, 2);
+    std::string mac;
+
+    coalescer.set("Vlan1000:10.0.0.1", neighFields("00:00:00:00:00:01"));
+    EXPECT_GT(coalescer.run(), 0);
+    coalescer.set("Vlan1000:10.0.0.2", neighFields("00:00:00:00:00:02"));
+    EXPECT_EQ(coalescer.run(), -1);
+    EXPECT_TRUE(getMac("Vlan1000:10.0.0.1", mac));
+    EXPECT_TRUE(getMac("Vlan1000:10.0.0.2", mac));
+}
@@ -0,0 +1,608 @@
+#include "pfcwddetector.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pfcwddetector_test
+{
+    using namespace std;
+    using namespace swss;
+
+    // 200 ms detection and restoration times polled every 100 ms, in microseconds
+    const uint64_t DETECTION_TIME = 200000;
+    const uint64_t RESTORATION_TIME = 200000;
+    const double POLL = 100000;
+
+    struct Sample
+    {
+        uint64_t occupancy = 0;
+        uint64_t packets = 0;
+        uint64_t pfcRx = 0;
+        uint64_t pfcDuration = 0;
+        uint64_t pfcOn2Off = 0;
+        uint16_t flags = PfcWdDetector::HAS_OCCUPANCY | PfcWdDetector::HAS_PACKETS |
+                         PfcWdDetector::HAS_PFC_RX | PfcWdDetector::HAS_DURATION |
+                         PfcWdDetector::HAS_ON2OFF | PfcWdDetector::HAS_PAUSE |
+                         PfcWdDetector::OPERATIONAL;
+    };
+
+    // Drives a detector with one queue the way PfcWdSwOrch does
+    struct OneQueue
+    {
+        OneQueue(const string &platform, bool alert = false, bool statHistory = false) :
+            detector(*PfcWdDetectionRules::get(platform))
+        {
+            PfcWdDetector::QueueConfig config;
+            config.queue = "oid:0x15000000000001";
+            config.port = "oid:0x1000000000001";
+            config.index = 3;
+            config.detectionTime = DETECTION_TIME;
+            config.restorationTime = RESTORATION_TIME;
+            config.alert = alert;
+            config.statHistory = statHistory;
+            detector.addQueue(config);
+        }
+
+        // Returns the event of the sample, the clock moves one poll interval
+        PfcWdDetector::Event poll(const Sample &sample, double counterIntervalUs = 0)
+        {
+            PfcWdDetector::Samples samples;
+            samples.reset(1);
+            samples.flags[0] = sample.flags;
+            samples.occupancy[0] = sample.occupancy;
+            samples.packets[0] = sample.packets;
+            samples.pfcRx[0] = sample.pfcRx;
+            samples.pfcDuration[0] = sample.pfcDuration;
+            samples.pfcOn2Off[0] = sample.pfcOn2Off;
+
+            timestamp += static_cast<uint64_t>(POLL);
+            results.clear();
+            detector.evaluate(samples, POLL, timestamp, counterIntervalUs, results);
+            if (results.empty())
+            {
+                return PfcWdDetector::NONE;
+            }
+
+            EXPECT_EQ(results.size(), 1);
+            EXPECT_EQ(results[0].queue, "oid:0x15000000000001");
+            return results[0].event;
+        }
+
+        double detectionLeft()
+        {
+            return detector.getDetectionTimeLeft("oid:0x15000000000001");
+        }
+
+        double restorationLeft()
+        {
+            return detector.getRestorationTimeLeft("oid:0x15000000000001");
+        }
+
+        PfcWdDetector detector;
+        uint64_t timestamp = 1700000000000000;
+        vector<PfcWdDetector::Result> results;
+    };
+
+    Sample stuck(uint64_t pfcRx, uint64_t pfcDuration = 0)
+    {
+        Sample sample;
+        sample.occupancy = 1000;
+        sample.packets = 100;
+        sample.pfcRx = pfcRx;
+        sample.pfcDuration = pfcDuration;
+        return sample;
+    }
+
+    Sample stormed(Sample sample)
+    {
+        sample.flags &= static_cast<uint16_t>(~PfcWdDetector::OPERATIONAL);
+        return sample;
+    }
+
+    TEST(PfcWdDetector, Rules)
+    {
+        ASSERT_EQ(PfcWdDetectionRules::get("vs")->condition, PfcWdDetectionRules::Condition::RX_OR_PAUSED);
+        ASSERT_EQ(PfcWdDetectionRules::get("marvell_teralynx"), PfcWdDetectionRules::get("marvell-teralynx"));
+        ASSERT_EQ(PfcWdDetectionRules::get("mellanox")->durationSuffix, "_RX_PAUSE_DURATION_US");
+        ASSERT_EQ(PfcWdDetectionRules::get("barefoot")->durationSuffix, "_RX_PAUSE_DURATION");
+        /* No pfc_detect_<platform>.lua, no detection */
+        ASSERT_EQ(PfcWdDetectionRules::get("broadcom-dnx"), nullptr);
+        ASSERT_EQ(PfcWdDetectionRules::get(""), nullptr);
+    }
+
+    typedef PfcWdDetectionRules Rules;
+
+    // The platforms of the pfc_detect_<platform>.lua scripts kept in pfcwd_lua/
+    const vector<string> c_scriptPlatforms = {
+        "barefoot", "broadcom", "cisco-8000", "marvell_prestera",
+        "marvell_teralynx", "mellanox", "nephos", "vs",
+    };
+
+    // The rule constants found in the text of a pfc_detect_<platform>.lua
+    // script: counter names, threshold, storm condition and which values it
+    // saves. The script is only matched as text, it is not run.
+    Rules parseScriptConstants(const string &platform)
+    {
+        ifstream file("./pfcwd_lua/pfc_detect_" + platform + ".lua");
+        EXPECT_TRUE(file.good()) << platform;
+
+        /* Commented out code does not count */
+        string script;
+        string line;
+        while (getline(file, line))
+        {
+            if (line.find_first_not_of(" \t") != string::npos &&
+                line.compare(line.find_first_not_of(" \t"), 2, "--") == 0)
+            {
+                continue;
+            }
+            script += line + "\n";
+        }
+
+        auto has = [&script](const string &text)
+        {
+            return script.find(text) != string::npos;
+        };
+
+        Rules rules;
+        rules.platform = platform;
+
+        smatch match;
+        if (regex_search(script, match, regex("'SAI_PORT_STAT_PFC_' \\.\\. \\w+ \\.\\. '(_RX_PAUSE_DURATION\\w*)'")))
+        {
+            rules.durationSuffix = match[1];
+        }
+        rules.noDuration = rules.durationSuffix.empty() || has("local pfc_duration = \"0\"");
+        rules.durationThreshold = 0;
+        if (regex_search(script, match, regex("poll_time \\* (0\\.[0-9]+)")))
+        {
+            rules.durationThreshold = stod(match[1]);
+        }
+
+        if (has("pfc_on2off - pfc_on2off_last == 0"))
+        {
+            rules.condition = Rules::Condition::PAUSED_WITHOUT_XON;
+        }
+        else if (has("if (queue_pause_status == 'true')"))
+        {
+            rules.condition = Rules::Condition::PAUSE_STATUS;
+        }
+        else if (has("packets - packets_last == 0 and pfc_rx_packets - pfc_rx_packets_last > 0)"))
+        {
+            rules.condition = Rules::Condition::RX_OR_PAUSED;
+        }
+        else if (has("pfc_rx_packets - pfc_rx_packets_last > 0 and (pfc_duration - pfc_duration_last) > poll_time"))
+        {
+            rules.condition = Rules::Condition::RX_AND_PAUSED;
+        }
+        else
+        {
+            EXPECT_TRUE(has("packets - packets_last == 0 and storm_condition)")) << platform;
+            rules.condition = Rules::Condition::PAUSED;
+        }
+
+        /* The port last values are dropped with the storm, or only saved without one */
+        if (has("redis.call('HDEL', counters_table_name .. ':' .. port_id, pfc_rx_pkt_key .. '_last')"))
+        {
+            rules.portLastOnStorm = Rules::PortLastOnStorm::RESET;
+        }
+        else if (has("if is_deadlock == false then"))
+        {
+            rules.portLastOnStorm = Rules::PortLastOnStorm::KEEP;
+        }
+        else
+        {
+            rules.portLastOnStorm = Rules::PortLastOnStorm::UPDATE;
+        }
+
+        rules.measuredPollTime = has("PFC_WD_Port_Counter_time_stamp");
+        rules.stormInfo = has("\"storm\",' ..");
+
+        return rules;
+    }
+
+    /* A constant check only, the detection itself is covered by the table driven tests */
+    TEST(PfcWdDetector, RulesMatchScriptConstants)
+    {
+        for (const auto &platform : c_scriptPlatforms)
+        {
+            SCOPED_TRACE(platform);
+
+            Rules expected = parseScriptConstants(platform);
+            const Rules *rules = PfcWdDetectionRules::get(platform);
+            ASSERT_NE(rules, nullptr);
+
+            EXPECT_EQ(rules->condition, expected.condition);
+            EXPECT_EQ(rules->durationSuffix, expected.durationSuffix);
+            EXPECT_EQ(rules->noDuration, expected.noDuration);
+            EXPECT_DOUBLE_EQ(rules->durationThreshold, expected.durationThreshold);
+            EXPECT_EQ(rules->portLastOnStorm, expected.portLastOnStorm);
+            EXPECT_EQ(rules->measuredPollTime, expected.measuredPollTime);
+            EXPECT_EQ(rules->stormInfo, expected.stormInfo);
+        }
+    }
+
+    /* An empty or stuck queue paused for just more or just less than the threshold */
+    TEST(PfcWdDetector, DurationThresholds)
+    {
+        for (const auto &platform : c_scriptPlatforms)
+        {
+            SCOPED_TRACE(platform);
+
+            const Rules &rules = *PfcWdDetectionRules::get(platform);
+            if (rules.durationThreshold <= 0)
+            {
+                continue;
+            }
+
+            Sample sample;
+            sample.packets = 100;
+            /* The mellanox condition needs a stuck queue, the teralynx one PFC frames */
+            sample.occupancy = rules.condition == Rules::Condition::PAUSED ? 1000 : 0;
+            uint64_t rxStep = rules.condition == Rules::Condition::RX_AND_PAUSED ? 5 : 0;
+            auto threshold = static_cast<uint64_t>(rules.durationThreshold * POLL);
+
+            OneQueue q(platform);
+            ASSERT_EQ(q.poll(sample), PfcWdDetector::NONE);
+
+            sample.pfcRx += rxStep;
+            sample.pfcDuration += threshold + 1;
+            ASSERT_EQ(q.poll(sample), PfcWdDetector::NONE);
+            /* marvell-prestera never read the pause duration */
+            ASSERT_DOUBLE_EQ(q.detectionLeft(), rules.noDuration ? DETECTION_TIME : DETECTION_TIME - POLL);
+
+            sample.pfcRx += rxStep;
+            sample.pfcDuration += threshold;
+            ASSERT_EQ(q.poll(sample), PfcWdDetector::NONE);
+            ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+        }
+    }
+
+    /* Storm on a stuck queue, then a sample without new PFC frames */
+    TEST(PfcWdDetector, PortLastOnStormAllPlatforms)
+    {
+        for (const auto &platform : c_scriptPlatforms)
+        {
+            SCOPED_TRACE(platform);
+
+            const Rules &rules = *PfcWdDetectionRules::get(platform);
+            if (rules.condition == Rules::Condition::PAUSE_STATUS)
+            {
+                continue;
+            }
+
+            /* Paused for the whole interval, no XON */
+            auto storming = [](uint64_t step)
+            {
+                Sample sample = stuck(5 * step, step * static_cast<uint64_t>(POLL));
+                sample.flags |= PfcWdDetector::PAUSED;
+                return sample;
+            };
+
+            OneQueue q(platform);
+            ASSERT_EQ(q.poll(storming(1)), PfcWdDetector::NONE);
+            ASSERT_EQ(q.poll(storming(2)), PfcWdDetector::NONE);
+            ASSERT_EQ(q.poll(storming(3)), PfcWdDetector::STORM);
+
+            ASSERT_EQ(q.poll(stormed(storming(3))), PfcWdDetector::NONE);
+            switch (rules.portLastOnStorm)
+            {
+                case Rules::PortLastOnStorm::UPDATE:
+                    /* Compared against the storm sample */
+                    ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME - POLL);
+                    break;
+                case Rules::PortLastOnStorm::KEEP:
+                    /* Compared against the sample before the storm */
+                    ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+                    ASSERT_EQ(q.poll(stormed(storming(3))), PfcWdDetector::NONE);
+                    ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME - POLL);
+                    break;
+                case Rules::PortLastOnStorm::RESET:
+                    /* Only recorded */
+                    ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+                    ASSERT_EQ(q.poll(stormed(storming(3))), PfcWdDetector::NONE);
+                    ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME - POLL);
+                    break;
+            }
+        }
+    }
+
+    /* Follows pfc_detect_vs.lua and pfc_restore.lua */
+    TEST(PfcWdDetector, VsStormAndRestore)
+    {
+        OneQueue q("vs");
+
+        /* First run only saves the counters */
+        ASSERT_EQ(q.poll(stuck(5)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+
+        /* Stuck queue receiving PFC frames, counted down by the poll interval */
+        ASSERT_EQ(q.poll(stuck(10)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        ASSERT_EQ(q.poll(stuck(15)), PfcWdDetector::STORM);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+        ASSERT_EQ(q.results[0].latencyUs, 2 * POLL);
+        ASSERT_TRUE(q.results[0].info.empty());
+
+        /* The port last values were dropped, restoration starts over */
+        ASSERT_EQ(q.poll(stormed(stuck(20))), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+        ASSERT_EQ(q.poll(stormed(stuck(20))), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME - POLL);
+
+        /* PFC frames again */
+        ASSERT_EQ(q.poll(stormed(stuck(25))), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+
+        ASSERT_EQ(q.poll(stormed(stuck(25))), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stormed(stuck(25))), PfcWdDetector::RESTORE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+
+        /* The pause duration was dropped with the storm, so it is recorded again */
+        ASSERT_EQ(q.poll(stuck(30)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+        ASSERT_EQ(q.poll(stuck(35)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        /* Traffic moves, the count down restarts */
+        Sample moving = stuck(40);
+        moving.packets = 200;
+        ASSERT_EQ(q.poll(moving), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+
+        /* Empty queue paused for more than 80% of the interval */
+        Sample paused = moving;
+        paused.occupancy = 0;
+        paused.pfcDuration = 80001;
+        ASSERT_EQ(q.poll(paused), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+        paused.pfcDuration += 80000;
+        ASSERT_EQ(q.poll(paused), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+    }
+
+    TEST(PfcWdDetector, DebugStormAndAlert)
+    {
+        OneQueue q("vs", true);
+
+        Sample idle = stuck(5);
+        ASSERT_EQ(q.poll(idle), PfcWdDetector::NONE);
+
+        idle.flags |= PfcWdDetector::DEBUG_STORM;
+        ASSERT_EQ(q.poll(idle), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(idle), PfcWdDetector::STORM);
+
+        /* Alert queues keep running detection and restore from it */
+        ASSERT_EQ(q.poll(stormed(idle)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stormed(idle)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        idle.flags &= static_cast<uint16_t>(~PfcWdDetector::DEBUG_STORM);
+        ASSERT_EQ(q.poll(stormed(idle)), PfcWdDetector::RESTORE);
+        ASSERT_EQ(q.poll(idle), PfcWdDetector::NONE);
+    }
+
+    /* Follows pfc_detect_nephos.lua and pfc_detect_marvell_teralynx.lua */
+    TEST(PfcWdDetector, PortLastOnStorm)
+    {
+        /* nephos keeps updating the port counters */
+        OneQueue nephos("nephos");
+        ASSERT_EQ(nephos.poll(stuck(5)), PfcWdDetector::NONE);
+        ASSERT_EQ(nephos.poll(stuck(10)), PfcWdDetector::NONE);
+        ASSERT_EQ(nephos.poll(stuck(15)), PfcWdDetector::STORM);
+        ASSERT_EQ(nephos.poll(stormed(stuck(15))), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(nephos.restorationLeft(), RESTORATION_TIME - POLL);
+
+        /* teralynx needs a pause duration with the frames, and keeps the last values of a storm */
+        OneQueue teralynx("marvell-teralynx");
+        ASSERT_EQ(teralynx.poll(stuck(5, 0)), PfcWdDetector::NONE);
+        ASSERT_EQ(teralynx.poll(stuck(10, 0)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(teralynx.detectionLeft(), DETECTION_TIME);
+        ASSERT_EQ(teralynx.poll(stuck(15, 90000)), PfcWdDetector::NONE);
+        ASSERT_EQ(teralynx.poll(stuck(20, 180000)), PfcWdDetector::STORM);
+        /* Compared against the counters before the storm */
+        ASSERT_EQ(teralynx.poll(stormed(stuck(15))), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(teralynx.restorationLeft(), RESTORATION_TIME - POLL);
+    }
+
+    /* Follows pfc_detect_mellanox.lua */
+    TEST(PfcWdDetector, MellanoxMeasuredPollTime)
+    {
+        OneQueue q("mellanox");
+
+        ASSERT_EQ(q.poll(stuck(5, 0)), PfcWdDetector::NONE);
+
+        /* Paused for 99% of the 150 ms between the counter polls */
+        ASSERT_EQ(q.poll(stuck(5, 148501), 150000), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - 150000);
+        ASSERT_EQ(q.poll(stuck(5, 297002), 150000), PfcWdDetector::STORM);
+
+        map<string, string> info;
+        for (const auto &fv : q.results[0].info)
+        {
+            info[fvField(fv)] = fvValue(fv);
+        }
+        ASSERT_EQ(info["occupancy"], "1000");
+        ASSERT_EQ(info["packets_last"], "100");
+        ASSERT_EQ(info["pfc_duration"], "297002");
+        ASSERT_EQ(info["pfc_duration_last"], "148501");
+        ASSERT_EQ(info["effective_poll_time"], "150000");
+
+        /* Without counter timestamps, the time between samples */
+        OneQueue measured("mellanox");
+        ASSERT_EQ(measured.poll(stuck(5, 0)), PfcWdDetector::NONE);
+        ASSERT_EQ(measured.poll(stuck(5, 99000)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(measured.detectionLeft(), DETECTION_TIME);
+        ASSERT_EQ(measured.poll(stuck(5, 198001)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(measured.detectionLeft(), DETECTION_TIME - POLL);
+    }
+
+    /* Follows pfc_detect_broadcom.lua */
+    TEST(PfcWdDetector, BroadcomPauseHistory)
+    {
+        OneQueue q("broadcom", false, true);
+
+        auto paused = [](uint64_t pfcRx, uint64_t on2Off, bool pause)
+        {
+            Sample sample = stuck(pfcRx);
+            sample.flags &= static_cast<uint16_t>(~PfcWdDetector::HAS_DURATION);
+            sample.pfcOn2Off = on2Off;
+            if (pause)
+            {
+                sample.flags |= PfcWdDetector::PAUSED;
+            }
+            return sample;
+        };
+
+        ASSERT_EQ(q.poll(paused(5, 1, false)), PfcWdDetector::NONE);
+
+        /* Frames and XON: not a storm, but a new pause period */
+        ASSERT_EQ(q.poll(paused(10, 2, true)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+
+        vector<KeyOpFieldsValuesTuple> updates;
+        q.detector.getUpdates(updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(kfvKey(updates[0]), "oid:0x1000000000001");
+        map<string, string> fields;
+        for (const auto &fv : kfvFieldsValues(updates[0]))
+        {
+            fields[fvField(fv)] = fvValue(fv);
+        }
+        ASSERT_EQ(fields["EST_PORT_STAT_PFC_3_RECENT_PAUSE_TIMESTAMP"], to_string(q.timestamp - static_cast<uint64_t>(POLL)));
+        ASSERT_EQ(fields["EST_PORT_STAT_PFC_3_RECENT_PAUSE_TIME_US"], "100000");
+        ASSERT_EQ(fields["EST_PORT_STAT_PFC_3_RX_PAUSE_DURATION_US"], "100000");
+
+        /* Frames with no XON on a paused queue */
+        ASSERT_EQ(q.poll(paused(15, 2, true)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(paused(20, 2, true)), PfcWdDetector::STORM);
+
+        updates.clear();
+        q.detector.getUpdates(updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(fvValue(kfvFieldsValues(updates[0]).back()), "300000");
+    }
+
+    /* Follows pfc_detect_cisco-8000.lua and pfc_restore_cisco-8000.lua */
+    TEST(PfcWdDetector, CiscoPauseStatus)
+    {
+        OneQueue q("cisco-8000");
+
+        Sample sample;
+        sample.flags = PfcWdDetector::HAS_PACKETS | PfcWdDetector::HAS_PAUSE |
+                       PfcWdDetector::PAUSED | PfcWdDetector::OPERATIONAL;
+
+        /* No first run */
+        ASSERT_EQ(q.poll(sample), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(sample), PfcWdDetector::STORM);
+
+        ASSERT_EQ(q.poll(stormed(sample)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+
+        sample.flags &= static_cast<uint16_t>(~PfcWdDetector::PAUSED);
+        ASSERT_EQ(q.poll(stormed(sample)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stormed(sample)), PfcWdDetector::RESTORE);
+
+        /* A missing pause status is not a restoration */
+        sample.flags &= static_cast<uint16_t>(~PfcWdDetector::HAS_PAUSE);
+        ASSERT_EQ(q.poll(stormed(sample)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.restorationLeft(), RESTORATION_TIME);
+    }
+
+    TEST(PfcWdDetector, MissingCountersAndQueues)
+    {
+        OneQueue q("vs");
+
+        Sample sample = stuck(5);
+        sample.flags &= static_cast<uint16_t>(~PfcWdDetector::HAS_DURATION);
+        ASSERT_EQ(q.poll(sample), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stuck(10)), PfcWdDetector::NONE);
+        /* Nothing was recorded from the incomplete sample */
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+
+        PfcWdDetector::QueueConfig config;
+        config.queue = "oid:0x15000000000002";
+        config.detectionTime = DETECTION_TIME;
+        q.detector.addQueue(config);
+        ASSERT_EQ(q.detector.getQueues().size(), 2);
+
+        q.detector.removeQueue("oid:0x15000000000001");
+        ASSERT_EQ(q.detector.getQueues().size(), 1);
+        ASSERT_EQ(q.detector.getQueues()[0].queue, "oid:0x15000000000002");
+        ASSERT_DOUBLE_EQ(q.detector.getDetectionTimeLeft("oid:0x15000000000002"), DETECTION_TIME);
+    }
+
+    TEST(PfcWdDetector, StaleSamplesDeferred)
+    {
+        OneQueue q("vs");
+        q.detector.setDeferStaleSamples(true);
+
+        ASSERT_EQ(q.poll(stuck(5)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stuck(10)), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        /* Read before the counters were polled again, not an idle interval */
+        ASSERT_EQ(q.poll(stuck(10)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.detector.getStats().deferred, 1);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        /* The next sample covers both intervals */
+        ASSERT_EQ(q.poll(stuck(20)), PfcWdDetector::STORM);
+        ASSERT_EQ(q.results[0].latencyUs, 3 * POLL);
+
+        /* Only once in a row */
+        ASSERT_EQ(q.poll(stuck(25)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stuck(25)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stuck(25)), PfcWdDetector::NONE);
+        ASSERT_EQ(q.detector.getStats().deferred, 0);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME);
+    }
+
+    /* The counters after a deferred sample cover one counter interval, not both */
+    TEST(PfcWdDetector, StaleSamplesDeferredPauseDuration)
+    {
+        OneQueue q("mellanox");
+        q.detector.setDeferStaleSamples(true);
+
+        ASSERT_EQ(q.poll(stuck(5, 0), POLL), PfcWdDetector::NONE);
+        ASSERT_EQ(q.poll(stuck(5, 99500), POLL), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(q.detectionLeft(), DETECTION_TIME - POLL);
+
+        /* The counter timestamp did not move either */
+        ASSERT_EQ(q.poll(stuck(5, 99500), 0), PfcWdDetector::NONE);
+        ASSERT_EQ(q.detector.getStats().deferred, 1);
+
+        /* Paused for 99.5% of the measured interval, the deferred time only counts down */
+        ASSERT_EQ(q.poll(stuck(5, 199000), POLL), PfcWdDetector::STORM);
+        ASSERT_EQ(q.results[0].latencyUs, 3 * POLL);
+
+        map<string, string> info;
+        for (const auto &fv : q.results[0].info)
+        {
+            info[fvField(fv)] = fvValue(fv);
+        }
+        ASSERT_EQ(info["effective_poll_time"], "100000");
+
+        /* Same for an empty queue on the configured interval */
+        Sample sample;
+        sample.packets = 100;
+
+        OneQueue vs("vs");
+        vs.detector.setDeferStaleSamples(true);
+        ASSERT_EQ(vs.poll(sample), PfcWdDetector::NONE);
+        sample.pfcDuration = 81000;
+        ASSERT_EQ(vs.poll(sample), PfcWdDetector::NONE);
+        ASSERT_DOUBLE_EQ(vs.detectionLeft(), DETECTION_TIME - POLL);
+        ASSERT_EQ(vs.poll(sample), PfcWdDetector::NONE);
+        ASSERT_EQ(vs.detector.getStats().deferred, 1);
+        sample.pfcDuration = 162000;
+        ASSERT_EQ(vs.poll(sample), PfcWdDetector::STORM);
+    }
+}
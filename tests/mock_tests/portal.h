@@ -8,6 +8,9 @@
 #include "copporch.h"
 #include "sfloworch.h"
 #include "twamporch.h"
+#include "watermarkorch.h"
+#include "flex_counter/counterrateorch.h"
+#include "high_frequency_telemetry/hftelprofile.h"
 #include "directory.h"
 
 #undef protected
@@ -62,6 +65,21 @@ struct Portal
         {
             crmOrch->getResAvailableCounters();
         }
+
+        static void handleSetCommand(CrmOrch *crmOrch, const std::string &key, const std::vector<swss::FieldValueTuple> &data)
+        {
+            crmOrch->handleSetCommand(key, data);
+        }
+
+        static void poll(CrmOrch *crmOrch)
+        {
+            crmOrch->doTask(*crmOrch->m_timer);
+        }
+
+        static std::chrono::steady_clock::time_point &getLastFullRewrite(CrmOrch *crmOrch)
+        {
+            return crmOrch->m_lastFullRewrite;
+        }
     };
 
     struct CoppOrchInternal
@@ -125,6 +143,40 @@ struct Portal
         }
     };
 
+    struct WatermarkOrchInternal
+    {
+        static void collect(WatermarkOrch &obj)
+        {
+            obj.doTask(*obj.m_collectionTimer);
+        }
+
+        static const std::vector<std::string> &getObjects(const WatermarkOrch &obj, WatermarkAggregator::Group group)
+        {
+            return obj.m_aggregator.getObjects(group);
+        }
+    };
+
+    struct CounterRateOrchInternal
+    {
+        static void poll(CounterRateOrch &obj, const std::string &key)
+        {
+            obj.doTask(*obj.m_groups.at(key).timer);
+        }
+
+        static const CounterRateEngine &getEngine(const CounterRateOrch &obj, const std::string &key)
+        {
+            return obj.m_groups.at(key).engine;
+        }
+    };
+
+    struct HFTelProfileInternal
+    {
+        static void undeployCounterSubscriptions(HFTelProfile &obj, sai_object_type_t object_type, const std::set<sai_stat_id_t> &stats_ids)
+        {
+            obj.undeployCounterSubscriptions(object_type, stats_ids);
+        }
+    };
+
     struct DirectoryInternal
     {
         template <typename T>
@@ -86,6 +86,111 @@ namespace portsorch_test
         return status;
     }
 
+    sai_status_t _ut_stub_sai_get_ports_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_get_port_attribute(object_id[i], attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_get_ports_attribute_not_implemented(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+
+    sai_vlan_api_t *pold_sai_vlan_api;
+    uint32_t _sai_create_vlan_members_count;
+    uint32_t _sai_create_vlan_member_count;
+    sai_status_t _sai_create_vlan_members_status = SAI_STATUS_SUCCESS;
+
+    sai_status_t _ut_stub_sai_create_vlan_member(
+        _Out_ sai_object_id_t *vlan_member_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        _sai_create_vlan_member_count++;
+        return pold_sai_vlan_api->create_vlan_member(vlan_member_id, switch_id, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_stub_sai_create_vlan_members(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _sai_create_vlan_members_count++;
+        if (_sai_create_vlan_members_status != SAI_STATUS_SUCCESS)
+        {
+            object_statuses[0] = _sai_create_vlan_members_status;
+            for (uint32_t i = 1; i < object_count; i++)
+            {
+                object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+            }
+            return SAI_STATUS_FAILURE;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = pold_sai_vlan_api->create_vlan_member(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_remove_vlan_members(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = pold_sai_vlan_api->remove_vlan_member(object_id[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    void _hook_sai_vlan_api()
+    {
+        _sai_create_vlan_members_count = 0;
+        _sai_create_vlan_member_count = 0;
+        _sai_create_vlan_members_status = SAI_STATUS_SUCCESS;
+        pold_sai_vlan_api = sai_vlan_api;
+        sai_vlan_api = new sai_vlan_api_t();
+        memcpy(sai_vlan_api, pold_sai_vlan_api, sizeof(*sai_vlan_api));
+        sai_vlan_api->create_vlan_member = _ut_stub_sai_create_vlan_member;
+        sai_vlan_api->create_vlan_members = _ut_stub_sai_create_vlan_members;
+        sai_vlan_api->remove_vlan_members = _ut_stub_sai_remove_vlan_members;
+    }
+
+    void _unhook_sai_vlan_api()
+    {
+        delete sai_vlan_api;
+        sai_vlan_api = pold_sai_vlan_api;
+    }
+
     uint32_t _sai_set_pfc_mode_count;
     uint32_t _sai_set_admin_state_up_count;
     uint32_t _sai_set_admin_state_down_count;
@@ -261,6 +366,7 @@ namespace portsorch_test
         ut_sai_port_api = *sai_port_api;
         pold_sai_port_api = sai_port_api;
         ut_sai_port_api.get_port_attribute = _ut_stub_sai_get_port_attribute;
+        ut_sai_port_api.get_ports_attribute = _ut_stub_sai_get_ports_attribute;
         ut_sai_port_api.set_port_attribute = _ut_stub_sai_set_port_attribute;
         sai_port_api = &ut_sai_port_api;
     }
@@ -2504,6 +2610,130 @@ namespace portsorch_test
         _unhook_sai_port_api();
     }
 
+    /*
+     * Test case: port capabilities are fetched in bulk at init and the init phases are exported to STATE_DB
+     **/
+    TEST_F(PortsOrchTest, PortInitCapabilitiesBulk)
+    {
+        _hook_sai_port_api();
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table statePortTable = Table(m_state_db.get(), STATE_PORT_TABLE_NAME);
+        Table timelineTable = Table(m_state_db.get(), "PORT_INIT_TIMELINE");
+
+        not_support_fetching_fec = false;
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            ASSERT_EQ(gPortsOrch->m_portSupportedFecModes.count(port.m_port_id), 1);
+            ASSERT_TRUE(gPortsOrch->m_portSupportedFecModes[port.m_port_id].supported);
+            ASSERT_EQ(gPortsOrch->m_portSupportedFecModes[port.m_port_id].data.size(), mock_port_fec_modes.size());
+            ASSERT_EQ(gPortsOrch->m_portSupportedSpeeds.count(port.m_port_id), 1);
+
+            std::string fecs;
+            ASSERT_TRUE(statePortTable.hget(it.first, "supported_fecs", fecs));
+            ASSERT_NE(fecs.find("rs"), std::string::npos);
+        }
+
+        for (const auto &phase : { "initialize", "capabilities", "register", "post_init" })
+        {
+            std::string count;
+            ASSERT_TRUE(timelineTable.hget(phase, "ports", count));
+            ASSERT_EQ(count, to_string(ports.size()));
+            ASSERT_TRUE(timelineTable.hget(phase, "duration_ms", count));
+        }
+
+        _unhook_sai_port_api();
+    }
+
+    /*
+     * Test case: queue and PG counter maps of all ports are written together
+     **/
+    TEST_F(PortsOrchTest, QueueAndPgCounterMapsAreBatched)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table queueNameTable = Table(m_counters_db.get(), COUNTERS_QUEUE_NAME_MAP);
+        Table queuePortTable = Table(m_counters_db.get(), COUNTERS_QUEUE_PORT_MAP);
+        Table pgNameTable = Table(m_counters_db.get(), COUNTERS_PG_NAME_MAP);
+        Table pgPortTable = Table(m_counters_db.get(), COUNTERS_PG_PORT_MAP);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        size_t queueCount = 0;
+        size_t pgCount = 0;
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            queueCount += port.m_queue_ids.size();
+            pgCount += port.m_priority_group_ids.size();
+        }
+        ASSERT_GT(queueCount, 0);
+        ASSERT_GT(pgCount, 0);
+
+        queueNameTable.del("");
+        queuePortTable.del("");
+        pgNameTable.del("");
+        pgPortTable.del("");
+        gPortsOrch->m_isQueueMapGenerated = false;
+        gPortsOrch->m_isPriorityGroupMapGenerated = false;
+
+        gPortsOrch->generateQueueMap({ { createAllAvailableBuffersStr, FlexCounterQueueStates(0) } });
+        gPortsOrch->generatePriorityGroupMap({ { createAllAvailableBuffersStr, FlexCounterPgStates(0) } });
+
+        std::vector<FieldValueTuple> fields;
+        queueNameTable.get("", fields);
+        ASSERT_EQ(fields.size(), queueCount);
+        queuePortTable.get("", fields);
+        ASSERT_EQ(fields.size(), queueCount);
+        pgNameTable.get("", fields);
+        ASSERT_EQ(fields.size(), pgCount);
+        pgPortTable.get("", fields);
+        ASSERT_EQ(fields.size(), pgCount);
+
+        std::string oid;
+        ASSERT_TRUE(queueNameTable.hget("", "Ethernet0:0", oid));
+        std::string portOid;
+        ASSERT_TRUE(queuePortTable.hget("", oid, portOid));
+        Port port;
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet0", port));
+        ASSERT_EQ(portOid, sai_serialize_object_id(port.m_port_id));
+    }
+
     /*
      * Test case: Fetching SAI_PORT_ATTR_OPER_PORT_FEC_MODE
      **/
@@ -3486,11 +3716,12 @@ namespace portsorch_test
 
         bool lagMemberCreateCalled = false;
 
-        auto lagSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_member);
-        lagSpy->callFake([&](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t * attrs) -> sai_status_t
+        auto lagSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_members);
+        lagSpy->callFake([&](sai_object_id_t swoid, uint32_t count, const uint32_t *attr_count, const sai_attribute_t **attrs,
+                             sai_bulk_op_error_mode_t mode, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t
             {
                 lagMemberCreateCalled = true;
-                return orig_lag_api->create_lag_member(oid, swoid, count, attrs);
+                return orig_lag_api->create_lag_members(swoid, count, attr_count, attrs, mode, oids, statuses);
             }
         );
 
@@ -3548,6 +3779,9 @@ namespace portsorch_test
         sai_port_api = new sai_port_api_t();
         memcpy(sai_port_api, orig_port_api, sizeof(*sai_port_api));
 
+        // bulk get is not available, so oper attributes are read one by one
+        sai_port_api->get_ports_attribute = _ut_stub_sai_get_ports_attribute_not_implemented;
+
         // mock SAI API sai_port_api->get_port_attribute
         auto portSpy = SpyOn<SAI_API_PORT, SAI_OBJECT_TYPE_PORT>(&sai_port_api->get_port_attribute);
         portSpy->callFake([&](sai_object_id_t oid, uint32_t count, sai_attribute_t * attrs) -> sai_status_t {
@@ -3752,7 +3986,7 @@ namespace portsorch_test
     * allPortsReady(), so we can guaranty they won't be created if PortsOrch can process ports, lags,
     * vlans in single doTask().
     * If objects are created in PortsOrch, like bridge port, we will spy on SAI API to verify they are
-    * not called before create_lag_member.
+    * not called before create_lag_members.
     * This is done like this because of limitation on Mellanox platform that does not allow to create objects
     * on LAG before at least one LAG members is added in warm reboot. Later this will be fixed.
     *
@@ -3822,12 +4056,13 @@ namespace portsorch_test
         bool bridgePortCalled = false;
         bool bridgePortCalledBeforeLagMember = false;
 
-        auto lagSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_member);
-        lagSpy->callFake([&](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t * attrs) -> sai_status_t {
+        auto lagSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_members);
+        lagSpy->callFake([&](sai_object_id_t swoid, uint32_t count, const uint32_t *attr_count, const sai_attribute_t **attrs,
+                             sai_bulk_op_error_mode_t mode, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t {
                 if (bridgePortCalled) {
                     bridgePortCalledBeforeLagMember = true;
                 }
-                return orig_lag_api->create_lag_member(oid, swoid, count, attrs);
+                return orig_lag_api->create_lag_members(swoid, count, attr_count, attrs, mode, oids, statuses);
             }
         );
 
@@ -3860,6 +4095,236 @@ namespace portsorch_test
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
 
+    /*
+     * LAG members of one drain are created with a single bulk call, and a port
+     * that leaves a LAG and joins another in the same drain ends up in the new one.
+     */
+    TEST_F(PortsOrchTest, LagMembersAreCreatedInBulk)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table lagTable = Table(m_app_db.get(), APP_LAG_TABLE_NAME);
+        Table lagMemberTable = Table(m_app_db.get(), APP_LAG_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        lagTable.set("PortChannel0001", { {"admin_status", "up"}, {"mtu", "9100"} });
+        lagTable.set("PortChannel0002", { {"admin_status", "up"}, {"mtu", "9100"} });
+
+        vector<string> members;
+        for (const auto &it : ports)
+        {
+            if (members.size() == 4)
+            {
+                break;
+            }
+            members.push_back(it.first);
+            lagMemberTable.set(
+                std::string("PortChannel0001") + lagMemberTable.getTableNameSeparator() + it.first,
+                { {"status", members.size() == 1 ? "disabled" : "enabled"} });
+        }
+
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&lagTable);
+        gPortsOrch->addExistingData(&lagMemberTable);
+
+        // save original api since we will spy
+        auto orig_lag_api = sai_lag_api;
+        sai_lag_api = new sai_lag_api_t();
+        memcpy(sai_lag_api, orig_lag_api, sizeof(*sai_lag_api));
+
+        uint32_t bulkCreateCount = 0;
+        uint32_t createCount = 0;
+
+        auto bulkSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_members);
+        bulkSpy->callFake([&](sai_object_id_t swoid, uint32_t count, const uint32_t *attr_count, const sai_attribute_t **attrs,
+                              sai_bulk_op_error_mode_t mode, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t {
+                bulkCreateCount++;
+                return orig_lag_api->create_lag_members(swoid, count, attr_count, attrs, mode, oids, statuses);
+            }
+        );
+        auto createSpy = SpyOn<SAI_API_LAG, SAI_OBJECT_TYPE_LAG_MEMBER>(&sai_lag_api->create_lag_member);
+        createSpy->callFake([&](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t *attrs) -> sai_status_t {
+                createCount++;
+                return orig_lag_api->create_lag_member(oid, swoid, count, attrs);
+            }
+        );
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(bulkCreateCount, 1);
+        ASSERT_EQ(createCount, 0);
+
+        Port lag;
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0001", lag));
+        ASSERT_EQ(lag.m_members.size(), members.size());
+        for (const auto &alias : members)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+            ASSERT_EQ(port.m_lag_id, lag.m_lag_id);
+            ASSERT_NE(port.m_lag_member_id, SAI_NULL_OBJECT_ID);
+        }
+
+        // The disabled member is created with collection and distribution off
+        Port port;
+        ASSERT_TRUE(gPortsOrch->getPort(members[0], port));
+        sai_attribute_t attr;
+        attr.id = SAI_LAG_MEMBER_ATTR_EGRESS_DISABLE;
+        ASSERT_EQ(orig_lag_api->get_lag_member_attribute(port.m_lag_member_id, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_TRUE(attr.value.booldata);
+
+        // Move the first member from PortChannel0001 to PortChannel0002 in one drain
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_LAG_MEMBER_TABLE_NAME));
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"PortChannel0001:" + members[0], "DEL", { {} }});
+        entries.push_back({"PortChannel0002:" + members[0], "SET", { {"status", "enabled"} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(bulkCreateCount, 2);
+        ASSERT_EQ(createCount, 0);
+
+        Port newLag;
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0001", lag));
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0002", newLag));
+        ASSERT_EQ(lag.m_members.count(members[0]), 0);
+        ASSERT_EQ(newLag.m_members.count(members[0]), 1);
+        ASSERT_TRUE(gPortsOrch->getPort(members[0], port));
+        ASSERT_EQ(port.m_lag_id, newLag.m_lag_id);
+
+        sai_lag_api = orig_lag_api;
+
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+    }
+
+    /*
+     * VLAN members of one drain are created with a single bulk call. A port
+     * that leaves a VLAN and joins another in the same drain keeps its bridge
+     * port, and a bridge port created for members that all failed is removed.
+     */
+    TEST_F(PortsOrchTest, VlanMembersAreCreatedInBulk)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+        Table vlanMemberTable = Table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        vlanTable.set("Vlan10", { {"admin_status", "up"}, {"mtu", "9100"} });
+        vlanTable.set("Vlan20", { {"admin_status", "up"}, {"mtu", "9100"} });
+
+        vector<string> members;
+        for (const auto &it : ports)
+        {
+            if (members.size() == 8)
+            {
+                break;
+            }
+            members.push_back(it.first);
+            vlanMemberTable.set(
+                std::string("Vlan10") + vlanMemberTable.getTableNameSeparator() + it.first,
+                { {"tagging_mode", "tagged"} });
+        }
+
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&vlanTable);
+        gPortsOrch->addExistingData(&vlanMemberTable);
+
+        _hook_sai_vlan_api();
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(_sai_create_vlan_members_count, 1);
+        ASSERT_EQ(_sai_create_vlan_member_count, 0);
+
+        Port vlan;
+        ASSERT_TRUE(gPortsOrch->getPort("Vlan10", vlan));
+        ASSERT_EQ(vlan.m_members.size(), members.size());
+        for (const auto &alias : members)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+            ASSERT_NE(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+            ASSERT_EQ(gPortsOrch->m_portVlanMember[alias].count(10), 1);
+        }
+
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_VLAN_MEMBER_TABLE_NAME));
+
+        // Move the first member from Vlan10 to Vlan20 in one drain
+        Port port;
+        ASSERT_TRUE(gPortsOrch->getPort(members[0], port));
+        auto bridgePortId = port.m_bridge_port_id;
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Vlan10:" + members[0], "DEL", { {} }});
+        entries.push_back({"Vlan20:" + members[0], "SET", { {"tagging_mode", "untagged"} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_TRUE(gPortsOrch->getPort(members[0], port));
+        ASSERT_EQ(port.m_bridge_port_id, bridgePortId);
+        ASSERT_EQ(gPortsOrch->m_portVlanMember[members[0]].count(10), 0);
+        ASSERT_EQ(gPortsOrch->m_portVlanMember[members[0]].count(20), 1);
+
+        // A failed bulk leaves the member pending and rolls back its new bridge port
+        string alias;
+        for (const auto &it : ports)
+        {
+            if (find(members.begin(), members.end(), it.first) == members.end())
+            {
+                alias = it.first;
+                break;
+            }
+        }
+
+        _sai_create_vlan_members_status = SAI_STATUS_INSUFFICIENT_RESOURCES;
+        entries.clear();
+        entries.push_back({"Vlan20:" + alias, "SET", { {"tagging_mode", "tagged"} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+        ASSERT_EQ(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_EQ(ts.size(), 1);
+
+        // The retry succeeds once the resources are back
+        _sai_create_vlan_members_status = SAI_STATUS_SUCCESS;
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+        ASSERT_NE(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(gPortsOrch->m_portVlanMember[alias].count(20), 1);
+        ts.clear();
+        consumer->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+
+        _unhook_sai_vlan_api();
+    }
+
     struct PostPortInitTests : PortsOrchTest
     {
     };
@@ -0,0 +1,124 @@
+#include "port/porttable.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace porttable_test
+{
+    using namespace std;
+    using namespace swss;
+
+    TEST(PortTable, IndexFollowsInsertAndErase)
+    {
+        PortTable ports;
+
+        ports["Ethernet4"].m_port_id = 4;
+        ports.emplace("Ethernet0", Port("Ethernet0", Port::PHY));
+        ports.insert({ "PortChannel0001", Port("PortChannel0001", Port::LAG) });
+
+        ASSERT_EQ(ports.size(), 3);
+        ASSERT_EQ(ports.begin()->first, "Ethernet0");
+        ASSERT_EQ(ports.find("Ethernet4")->second.m_port_id, 4);
+        ASSERT_EQ(ports.find("PortChannel0001")->second.m_type, Port::LAG);
+        ASSERT_EQ(ports.count("Ethernet8"), 0);
+        ASSERT_TRUE(ports.find("Ethernet8") == ports.end());
+
+        /* References stay valid while other ports come and go */
+        Port &port = ports["Ethernet4"];
+        for (int i = 8; i < 512; i += 4)
+        {
+            ports["Ethernet" + to_string(i)];
+        }
+        ports.erase("Ethernet0");
+        ASSERT_EQ(&port, &ports.find("Ethernet4")->second);
+
+        ports.erase(ports.find("Ethernet4"));
+        ASSERT_TRUE(ports.find("Ethernet4") == ports.end());
+        ASSERT_EQ(ports.erase("Ethernet4"), 0);
+
+        /* The read-only view sees the same ports in alias order */
+        const auto &view = ports.getPorts();
+        ASSERT_EQ(view.size(), ports.size());
+        ASSERT_EQ(view.begin()->first, ports.begin()->first);
+        ASSERT_TRUE(view.find("Ethernet4") == view.end());
+
+        PortTable copy = ports;
+        ports.clear();
+        ASSERT_TRUE(ports.find("Ethernet8") == ports.end());
+        ASSERT_TRUE(copy.find("Ethernet8") != copy.end());
+        ASSERT_EQ(copy.find("PortChannel0001")->second.m_alias, "PortChannel0001");
+    }
+
+    /*
+     * Per call cost of port lookups by alias and by OID, at 512 ports with one
+     * sub-interface each and 64 LAGs, against the ordered map PortsOrch used.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST(PortTable, DISABLED_LookupBenchmark)
+    {
+        const int rounds = 1000;
+        PortTable indexed;
+        map<string, Port> ordered;
+        unordered_map<sai_object_id_t, string> oidToAlias;
+        vector<string> aliases;
+        vector<sai_object_id_t> oids;
+
+        auto addPort = [&](const string &alias, Port::Type type)
+        {
+            Port port(alias, type);
+            port.m_port_id = 0x1000000000000 + aliases.size();
+            indexed[alias] = port;
+            ordered[alias] = port;
+            oidToAlias[port.m_port_id] = alias;
+            aliases.push_back(alias);
+            oids.push_back(port.m_port_id);
+        };
+
+        for (int i = 0; i < 512; i++)
+        {
+            addPort("Ethernet" + to_string(i * 8), Port::PHY);
+            addPort("Ethernet" + to_string(i * 8) + ".10", Port::SUBPORT);
+        }
+        for (int i = 1; i <= 64; i++)
+        {
+            addPort("PortChannel" + to_string(1000 + i), Port::LAG);
+        }
+
+        auto measure = [&](const string &name, const function<bool(size_t)> &lookup)
+        {
+            auto start = chrono::steady_clock::now();
+            for (int r = 0; r < rounds; r++)
+            {
+                for (size_t i = 0; i < aliases.size(); i++)
+                {
+                    ASSERT_TRUE(lookup(i));
+                }
+            }
+            auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            cout << name << ": " << ns / (rounds * aliases.size()) << " ns/call" << endl;
+        };
+
+        /* getPort(alias) and getPort(oid) as they were: find, then operator[] */
+        measure("map alias", [&](size_t i) {
+            return ordered.find(aliases[i]) != ordered.end() && ordered[aliases[i]].m_port_id == oids[i];
+        });
+        measure("map oid", [&](size_t i) {
+            const string &alias = oidToAlias.find(oids[i])->second;
+            return ordered.find(alias) != ordered.end() && ordered[alias].m_port_id == oids[i];
+        });
+
+        measure("indexed alias", [&](size_t i) {
+            auto it = indexed.find(aliases[i]);
+            return it != indexed.end() && it->second.m_port_id == oids[i];
+        });
+        measure("indexed oid", [&](size_t i) {
+            auto it = indexed.find(oidToAlias.find(oids[i])->second);
+            return it != indexed.end() && it->second.m_port_id == oids[i];
+        });
+    }
+}
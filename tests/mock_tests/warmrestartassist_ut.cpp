@@ -61,4 +61,36 @@ namespace warmrestartassist_test
         ASSERT_EQ(fvField(fvVector[0]), "field");
         ASSERT_EQ(fvValue(fvVector[0]), "value1");
     }
+
+    TEST_F(WarmrestartassistTest, warmRestartAssistReconcileStates)
+    {
+        Table testTable = Table(m_app_db.get(), APP_WRA_TEST_TABLE_NAME);
+        testTable.set("same", {{"field1", "a"}, {"field2", "b"}});
+        testTable.set("stale", {{"field", "value"}});
+        testTable.set("deleted", {{"field", "value"}});
+
+        appRestartAssist->m_warmStartInProgress = true;
+        appRestartAssist->readTablesToMap();
+        ASSERT_EQ(appRestartAssist->getReconcileStats().restored, 4);
+
+        /* Field order does not matter */
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "same", {{"field2", "b"}, {"field1", "a"}}, false);
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "deleted", {}, true);
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "key", {{"field", "value0"}}, false);
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "new", {{"field", "value"}}, false);
+        appRestartAssist->reconcile();
+
+        const auto &stats = appRestartAssist->getReconcileStats();
+        ASSERT_EQ(stats.unchanged, 2);
+        ASSERT_EQ(stats.deleted, 2);
+        ASSERT_EQ(stats.updated, 1);
+
+        vector<FieldValueTuple> fvVector;
+        ASSERT_TRUE(testTable.get("same", fvVector));
+        ASSERT_TRUE(testTable.get("key", fvVector));
+        ASSERT_TRUE(testTable.get("new", fvVector));
+        ASSERT_FALSE(testTable.get("stale", fvVector));
+        ASSERT_FALSE(testTable.get("deleted", fvVector));
+        ASSERT_FALSE(appRestartAssist->isWarmStartInProgress());
+    }
 }
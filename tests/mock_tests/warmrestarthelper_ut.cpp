@@ -103,4 +103,83 @@ namespace wrhelper_test
         m_routeTable->hget("1.2.0.0/24", "protocol", val);
         ASSERT_EQ(val, "kernel");
     }
+
+    TEST_F(WRHelperTest, testDigestIgnoresOrder)
+    {
+        auto d1 = swss::WarmRestartDigest::digest({{"nexthop", "10.1.1.1,10.1.1.2"}, {"ifname", "eth1,eth2"}}, true);
+        auto d2 = swss::WarmRestartDigest::digest({{"ifname", "eth2,eth1"}, {"nexthop", "10.1.1.2,10.1.1.1"}}, true);
+        auto d3 = swss::WarmRestartDigest::digest({{"ifname", "eth2,eth1"}, {"nexthop", "10.1.1.2,10.1.1.1"}}, false);
+        auto d4 = swss::WarmRestartDigest::digest({{"ifname", "eth1,eth2"}, {"nexthop", "10.1.1.1,10.1.1.3"}}, true);
+        auto d5 = swss::WarmRestartDigest::digest({{"ifnam", "eeth1,eth2"}, {"nexthop", "10.1.1.1,10.1.1.2"}}, true);
+
+        ASSERT_EQ(d1, d2);
+        ASSERT_NE(d1, d3);
+        ASSERT_NE(d1, d4);
+        ASSERT_NE(d1, d5);
+    }
+
+    TEST_F(WRHelperTest, testReconciliationBatches)
+    {
+        wrHelper->setState(WarmStart::INITIALIZED);
+
+        /* Old-life entries */
+        m_routeTable->set("1.0.0.0/24",
+                        {
+                            {"ifname", "eth1,eth2"},
+                            {"nexthop", "2.0.0.1,2.0.0.2"}
+                        });
+        m_routeTable->set("1.1.0.0/24",
+                        {
+                            {"ifname", "eth1"},
+                            {"nexthop", "2.1.0.0"}
+                        });
+        m_routeTable->set("1.2.0.0/24",
+                        {
+                            {"ifname", "eth1"},
+                            {"nexthop", "2.2.0.0"}
+                        });
+        ASSERT_TRUE(wrHelper->runRestoration());
+        ASSERT_EQ(wrHelper->getReconcileStats().restored, 3);
+
+        /* Same content in a different order */
+        wrHelper->insertRefreshMap({
+                                    "1.0.0.0/24",
+                                    "SET",
+                                    {
+                                        {"nexthop", "2.0.0.2,2.0.0.1"},
+                                        {"ifname", "eth2,eth1"}
+                                    }
+                                });
+        /* Explicit delete */
+        wrHelper->insertRefreshMap({"1.1.0.0/24", "DEL", {}});
+        /* Delete of an entry which was never in AppDB */
+        wrHelper->insertRefreshMap({"1.3.0.0/24", "DEL", {}});
+        /* Brand-new entry, 1.2.0.0/24 is stale */
+        wrHelper->insertRefreshMap({
+                                    "1.4.0.0/24",
+                                    "SET",
+                                    {
+                                        {"ifname", "eth4"},
+                                        {"nexthop", "2.4.0.0"}
+                                    }
+                                });
+        wrHelper->reconcile();
+        ASSERT_EQ(wrHelper->getState(), WarmStart::RECONCILED);
+
+        const auto &stats = wrHelper->getReconcileStats();
+        ASSERT_EQ(stats.refreshed, 4);
+        ASSERT_EQ(stats.unchanged, 1);
+        ASSERT_EQ(stats.updated, 0);
+        ASSERT_EQ(stats.added, 1);
+        ASSERT_EQ(stats.deleted, 2);
+
+        std::string val;
+        ASSERT_TRUE(m_routeTable->hget("1.0.0.0/24", "nexthop", val));
+        ASSERT_EQ(val, "2.0.0.1,2.0.0.2");
+        ASSERT_FALSE(m_routeTable->hget("1.1.0.0/24", "nexthop", val));
+        ASSERT_FALSE(m_routeTable->hget("1.2.0.0/24", "nexthop", val));
+        ASSERT_FALSE(m_routeTable->hget("1.3.0.0/24", "nexthop", val));
+        ASSERT_TRUE(m_routeTable->hget("1.4.0.0/24", "nexthop", val));
+        ASSERT_EQ(val, "2.4.0.0");
+    }
 }
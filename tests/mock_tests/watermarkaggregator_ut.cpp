@@ -0,0 +1,221 @@
+#include "watermarkaggregator.h"
+#include "counter_updates.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace watermarkaggregator_test
+{
+    using namespace std;
+    using namespace swss;
+
+    typedef CountersTable WatermarksTable;
+
+    const string queueShared = "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES";
+    const string pgShared = "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES";
+    const string pgHeadroom = "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES";
+
+    // One table per view
+    void apply(WatermarkAggregator &aggregator, WatermarksTable (&views)[WatermarkAggregator::VIEW_COUNT])
+    {
+        for (uint8_t v = 0; v < WatermarkAggregator::VIEW_COUNT; v++)
+        {
+            vector<KeyOpFieldsValuesTuple> updates;
+            aggregator.getUpdates(static_cast<WatermarkAggregator::View>(v), updates);
+            CounterUpdates::apply(updates, views[v]);
+        }
+    }
+
+    size_t countUpdates(WatermarkAggregator &aggregator, WatermarkAggregator::View view)
+    {
+        vector<KeyOpFieldsValuesTuple> updates;
+        aggregator.getUpdates(view, updates);
+        return updates.size();
+    }
+
+    void addObjects(WatermarkAggregator &aggregator, WatermarkAggregator::Group group, const vector<string> &oids)
+    {
+        vector<string> added;
+        aggregator.setObjects(group, oids, added);
+    }
+
+    TEST(WatermarkAggregator, ViewsKeepMaximum)
+    {
+        WatermarkAggregator aggregator;
+        WatermarksTable views[WatermarkAggregator::VIEW_COUNT];
+
+        addObjects(aggregator, WatermarkAggregator::QUEUE, { "oid:0x15000000000001", "oid:0x15000000000002" });
+        aggregator.setPollInterval(WatermarkAggregator::QUEUE, 60000);
+
+        /* The first reading is taken as is, missing ones are not written */
+        aggregator.update(WatermarkAggregator::QUEUE, { 100, 0 }, { 1, 0 }, 0);
+        apply(aggregator, views);
+        for (const auto &view : views)
+        {
+            ASSERT_EQ(view.at("oid:0x15000000000001").at(queueShared), "100");
+            ASSERT_EQ(view.count("oid:0x15000000000002"), 0);
+        }
+
+        /* Lower readings leave the views as they are */
+        aggregator.update(WatermarkAggregator::QUEUE, { 50, 20 }, { 1, 1 }, 30000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x15000000000001"][queueShared], "100");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x15000000000002"][queueShared], "20");
+
+        aggregator.update(WatermarkAggregator::QUEUE, { 300, 20 }, { 1, 1 }, 60000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::PERIODIC]["oid:0x15000000000001"][queueShared], "300");
+
+        /* Nothing changed, nothing is written */
+        aggregator.update(WatermarkAggregator::QUEUE, { 300, 20 }, { 1, 1 }, 90000);
+        for (uint8_t v = 0; v < WatermarkAggregator::VIEW_COUNT; v++)
+        {
+            ASSERT_EQ(countUpdates(aggregator, static_cast<WatermarkAggregator::View>(v)), 0);
+        }
+
+        uint64_t value;
+        ASSERT_TRUE(aggregator.getWatermark(WatermarkAggregator::PERSISTENT, WatermarkAggregator::QUEUE,
+                                            "oid:0x15000000000001", queueShared, value));
+        ASSERT_EQ(value, 300);
+        ASSERT_FALSE(aggregator.getWatermark(WatermarkAggregator::PERSISTENT, WatermarkAggregator::QUEUE,
+                                             "oid:0x15000000000003", queueShared, value));
+    }
+
+    TEST(WatermarkAggregator, ClearResetsOneView)
+    {
+        WatermarkAggregator aggregator;
+        WatermarksTable views[WatermarkAggregator::VIEW_COUNT];
+
+        addObjects(aggregator, WatermarkAggregator::PG, { "oid:0x1a000000000001" });
+        aggregator.setPollInterval(WatermarkAggregator::PG, 60000);
+
+        aggregator.update(WatermarkAggregator::PG, { 500, 40 }, { 1, 1 }, 0);
+        apply(aggregator, views);
+
+        aggregator.clear(WatermarkAggregator::USER, WatermarkAggregator::PG, pgShared, { "oid:0x1a000000000001" }, 1000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgShared], "0");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgHeadroom], "40");
+        ASSERT_EQ(views[WatermarkAggregator::PERSISTENT]["oid:0x1a000000000001"][pgShared], "500");
+
+        /* The reading from before the clear is not folded again until syncd polls */
+        aggregator.update(WatermarkAggregator::PG, { 500, 40 }, { 1, 1 }, 30000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgShared], "0");
+
+        /* A new reading is folded */
+        aggregator.update(WatermarkAggregator::PG, { 200, 40 }, { 1, 1 }, 45000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgShared], "200");
+
+        /* As is a reading equal to the last one once a poll interval went by */
+        aggregator.clear(WatermarkAggregator::USER, WatermarkAggregator::PG, pgShared, { "oid:0x1a000000000001" }, 50000);
+        aggregator.update(WatermarkAggregator::PG, { 200, 40 }, { 1, 1 }, 80000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgShared], "0");
+        aggregator.update(WatermarkAggregator::PG, { 200, 40 }, { 1, 1 }, 110000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x1a000000000001"][pgShared], "200");
+
+        /* Unknown objects and fields are ignored */
+        aggregator.clear(WatermarkAggregator::USER, WatermarkAggregator::PG, pgShared, { "oid:0x1a000000000002" }, 120000);
+        aggregator.clear(WatermarkAggregator::USER, WatermarkAggregator::PG, queueShared, { "oid:0x1a000000000001" }, 120000);
+        ASSERT_EQ(countUpdates(aggregator, WatermarkAggregator::USER), 0);
+    }
+
+    TEST(WatermarkAggregator, PeriodicClear)
+    {
+        WatermarkAggregator aggregator;
+        WatermarksTable views[WatermarkAggregator::VIEW_COUNT];
+
+        addObjects(aggregator, WatermarkAggregator::QUEUE, { "oid:0x15000000000001" });
+        addObjects(aggregator, WatermarkAggregator::BUFFER_POOL, { "oid:0x18000000000001" });
+
+        aggregator.update(WatermarkAggregator::QUEUE, { 100 }, { 1 }, 0);
+        aggregator.update(WatermarkAggregator::BUFFER_POOL, { 1000, 10 }, { 1, 1 }, 0);
+        apply(aggregator, views);
+
+        /* Every field of every object, published in the same batch */
+        aggregator.clear(WatermarkAggregator::PERIODIC, 1000);
+        ASSERT_EQ(countUpdates(aggregator, WatermarkAggregator::USER), 0);
+        apply(aggregator, views);
+        auto &periodic = views[WatermarkAggregator::PERIODIC];
+        ASSERT_EQ(periodic["oid:0x15000000000001"][queueShared], "0");
+        ASSERT_EQ(periodic["oid:0x18000000000001"]["SAI_BUFFER_POOL_STAT_WATERMARK_BYTES"], "0");
+        ASSERT_EQ(periodic["oid:0x18000000000001"]["SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES"], "0");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x15000000000001"][queueShared], "100");
+
+        aggregator.update(WatermarkAggregator::QUEUE, { 60 }, { 1 }, 2000);
+        apply(aggregator, views);
+        ASSERT_EQ(periodic["oid:0x15000000000001"][queueShared], "60");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:0x15000000000001"][queueShared], "100");
+    }
+
+    TEST(WatermarkAggregator, ObjectsKeepViews)
+    {
+        WatermarkAggregator aggregator;
+        WatermarksTable views[WatermarkAggregator::VIEW_COUNT];
+        vector<string> added;
+
+        aggregator.setObjects(WatermarkAggregator::QUEUE, { "oid:1" }, added);
+        ASSERT_EQ(added, vector<string>({ "oid:1" }));
+
+        /* Published values are where the views start from */
+        aggregator.seed(WatermarkAggregator::PERSISTENT, WatermarkAggregator::QUEUE, "oid:1",
+                        { { queueShared, "700" }, { "OTHER", "1" } });
+        aggregator.update(WatermarkAggregator::QUEUE, { 500 }, { 1 }, 0);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::PERSISTENT].count("oid:1"), 0);
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:1"][queueShared], "500");
+
+        /* oid:1 moves to another position */
+        added.clear();
+        aggregator.setObjects(WatermarkAggregator::QUEUE, { "oid:2", "oid:1" }, added);
+        ASSERT_EQ(added, vector<string>({ "oid:2" }));
+
+        aggregator.update(WatermarkAggregator::QUEUE, { 10, 800 }, { 1, 1 }, 1000);
+        apply(aggregator, views);
+        ASSERT_EQ(views[WatermarkAggregator::PERSISTENT]["oid:1"][queueShared], "800");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:1"][queueShared], "800");
+        ASSERT_EQ(views[WatermarkAggregator::USER]["oid:2"][queueShared], "10");
+
+        /* A sample of the wrong size is dropped */
+        aggregator.update(WatermarkAggregator::QUEUE, { 900 }, { 1 }, 2000);
+        ASSERT_EQ(countUpdates(aggregator, WatermarkAggregator::USER), 0);
+
+        aggregator.setObjects(WatermarkAggregator::QUEUE, { "oid:2" }, added);
+        ASSERT_EQ(aggregator.getObjects(WatermarkAggregator::QUEUE).size(), 1);
+    }
+
+    TEST(WatermarkAggregator, MissedPolls)
+    {
+        WatermarkAggregator aggregator;
+
+        addObjects(aggregator, WatermarkAggregator::PG, { "oid:0x1a000000000001" });
+        aggregator.setPollInterval(WatermarkAggregator::PG, 10000);
+
+        /* Read at half the poll interval, or up to one interval apart */
+        aggregator.update(WatermarkAggregator::PG, { 1, 1 }, { 1, 1 }, 0);
+        aggregator.update(WatermarkAggregator::PG, { 1, 1 }, { 1, 1 }, 5000);
+        aggregator.update(WatermarkAggregator::PG, { 1, 1 }, { 1, 1 }, 15000);
+        ASSERT_EQ(aggregator.getMissedPolls(WatermarkAggregator::PG), 0);
+
+        /* 25 s without a reading: up to two polls were overwritten */
+        aggregator.update(WatermarkAggregator::PG, { 1, 1 }, { 1, 1 }, 40000);
+        ASSERT_EQ(aggregator.getMissedPolls(WatermarkAggregator::PG), 2);
+
+        /* Kept across object changes */
+        addObjects(aggregator, WatermarkAggregator::PG, { "oid:0x1a000000000001", "oid:0x1a000000000002" });
+        aggregator.update(WatermarkAggregator::PG, { 1, 1, 1, 1 }, { 1, 1, 1, 1 }, 55000);
+        ASSERT_EQ(aggregator.getMissedPolls(WatermarkAggregator::PG), 3);
+        ASSERT_EQ(aggregator.getMissedPolls(WatermarkAggregator::QUEUE), 0);
+
+        /* Not counted over a time the group was not read on purpose */
+        aggregator.resetUpdateTime(WatermarkAggregator::PG);
+        aggregator.update(WatermarkAggregator::PG, { 1, 1, 1, 1 }, { 1, 1, 1, 1 }, 500000);
+        ASSERT_EQ(aggregator.getMissedPolls(WatermarkAggregator::PG), 3);
+    }
+}
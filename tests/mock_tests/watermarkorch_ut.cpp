@@ -0,0 +1,102 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "mock_orch_test.h"
+#include "watermarkorch.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace watermarkorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    class WatermarkOrchTest : public MockOrchTest
+    {
+    protected:
+        void PostSetUp() override
+        {
+            vector<string> tables = { CFG_WATERMARK_TABLE_NAME, CFG_FLEX_COUNTER_TABLE_NAME };
+            m_wmOrch = new WatermarkOrch(m_config_db.get(), tables);
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            swss::Table(m_counters_db.get(), COUNTERS_QUEUE_TYPE_MAP).del("");
+            swss::Table(m_counters_db.get(), COUNTERS_PG_INDEX_MAP).del("");
+
+            m_wmOrch->handleFcConfigUpdate("QUEUE_WATERMARK", { { "FLEX_COUNTER_STATUS", "enable" } });
+            m_wmOrch->handleFcConfigUpdate("PG_WATERMARK", { { "FLEX_COUNTER_STATUS", "enable" } });
+        }
+
+        void PreTearDown() override
+        {
+            delete m_wmOrch;
+            m_wmOrch = nullptr;
+        }
+
+        /* Written the way portsorch writes them */
+        void setQueue(const string &oid, const string &type)
+        {
+            swss::Table(m_counters_db.get(), COUNTERS_QUEUE_TYPE_MAP).hset("", oid, type);
+            CounterNameMapUpdater::markChanged(COUNTERS_QUEUE_TYPE_MAP);
+        }
+
+        void setPg(const string &oid, const string &index)
+        {
+            swss::Table(m_counters_db.get(), COUNTERS_PG_INDEX_MAP).hset("", oid, index);
+            CounterNameMapUpdater::markChanged(COUNTERS_PG_INDEX_MAP);
+        }
+
+        vector<string> objects(WatermarkAggregator::Group group)
+        {
+            return Portal::WatermarkOrchInternal::getObjects(*m_wmOrch, group);
+        }
+
+        WatermarkOrch *m_wmOrch = nullptr;
+        shared_ptr<swss::DBConnector> m_counters_db;
+    };
+
+    TEST_F(WatermarkOrchTest, ObjectsAddedAfterFirstPoll)
+    {
+        setQueue("oid:0x15000000000001", "SAI_QUEUE_TYPE_UNICAST");
+        setPg("oid:0x1a000000000001", "0");
+
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+        ASSERT_EQ(objects(WatermarkAggregator::QUEUE), vector<string>({ "oid:0x15000000000001" }));
+        ASSERT_EQ(objects(WatermarkAggregator::PG), vector<string>({ "oid:0x1a000000000001" }));
+
+        /* A port broken out later adds its queues and PGs */
+        setQueue("oid:0x15000000000002", "SAI_QUEUE_TYPE_MULTICAST");
+        setPg("oid:0x1a000000000002", "3");
+
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+        ASSERT_EQ(objects(WatermarkAggregator::QUEUE),
+                  vector<string>({ "oid:0x15000000000001", "oid:0x15000000000002" }));
+        ASSERT_EQ(objects(WatermarkAggregator::PG),
+                  vector<string>({ "oid:0x1a000000000001", "oid:0x1a000000000002" }));
+
+        /* And removes them */
+        swss::Table(m_counters_db.get(), COUNTERS_QUEUE_TYPE_MAP).hdel("", "oid:0x15000000000001");
+        CounterNameMapUpdater::markChanged(COUNTERS_QUEUE_TYPE_MAP);
+
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+        ASSERT_EQ(objects(WatermarkAggregator::QUEUE), vector<string>({ "oid:0x15000000000002" }));
+        ASSERT_EQ(objects(WatermarkAggregator::PG).size(), 2u);
+    }
+
+    TEST_F(WatermarkOrchTest, MapsOnlyReadWhenChanged)
+    {
+        setQueue("oid:0x15000000000001", "SAI_QUEUE_TYPE_UNICAST");
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+
+        /* Not reported as changed, the maps are not read again */
+        swss::Table(m_counters_db.get(), COUNTERS_QUEUE_TYPE_MAP).hset("", "oid:0x15000000000002", "SAI_QUEUE_TYPE_UNICAST");
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+        ASSERT_EQ(objects(WatermarkAggregator::QUEUE).size(), 1u);
+
+        /* A name map change is enough */
+        CounterNameMapUpdater::markChanged(COUNTERS_QUEUE_NAME_MAP);
+        Portal::WatermarkOrchInternal::collect(*m_wmOrch);
+        ASSERT_EQ(objects(WatermarkAggregator::QUEUE).size(), 2u);
+    }
+}
@@ -1,5 +1,6 @@
 #include <string>
 #include <algorithm>
+#include <chrono>
 #include "logger.h"
 #include "schema.h"
 #include "warm_restart.h"
@@ -97,26 +98,6 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
-{
-    fvVector.back().second = cacheStateMap.at(state);
-}
-
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
-{
-    for (auto &iter : cacheStateMap)
-    {
-        if (fvVector.back().second == iter.second)
-        {
-            return iter.first;
-        }
-    }
-    throw std::logic_error("cache entry state is invalid");
-}
-
 void AppRestartAssist::appDataReplayed()
 {
     WarmStart::setWarmStartState(m_appName, WarmStart::REPLAYED);
@@ -127,40 +108,50 @@ void AppRestartAssist::warmStartDisabled()
     WarmStart::setWarmStartState(m_appName, WarmStart::WSDISABLED);
 }
 
-// Read table(s) from APPDB and append stale flag then insert to cachemap
+static uint64_t elapsedUs(chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - start).count());
+}
+
+// Read table(s) from APPDB and insert their digests to cachemap with stale flag
 void AppRestartAssist::readTablesToMap()
 {
-    vector<string> keys;
+    auto start = chrono::steady_clock::now();
+
+    m_reconcileStats = ReconcileStats();
 
     for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
     {
-        (it->second)->getKeys(keys);
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
+        vector<KeyOpFieldsValuesTuple> entries;
+        vector<EntryDigest> digests;
 
-        for (const auto &key: keys)
-        {
-            vector<FieldValueTuple> fv;
+        (it->second)->getContent(entries);
+        WarmRestartDigest::digestAll(entries, false, digests);
+
+        auto &cache = appTableCacheMap[it->first];
+        cache.reserve(cache.size() + entries.size());
 
-                // if the fieldvalue is empty, skip
-            if (!(it->second)->get(key, fv))
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            // if the fieldvalue is empty, skip
+            if (kfvFieldsValues(entries[i]).empty())
             {
                 continue;
             }
 
-            fv.push_back(state);
-            setCacheEntryState(fv, STALE);
-
-            string s = joinVectorString(fv);
-
-            SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-                   "%s", (it->first).c_str(), key.c_str(), s.c_str());
+            SWSS_LOG_INFO("write to cachemap: %s, key: %s",
+                          (it->first).c_str(), kfvKey(entries[i]).c_str());
 
             // insert to the cache map
-            appTableCacheMap[it->first][key] = fv;
+            cache[kfvKey(entries[i])] = CacheEntry{digests[i], STALE, {}};
+            m_reconcileStats.restored++;
         }
         WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
         SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map", (it->first).c_str());
     }
+
+    m_reconcileStats.restoreUs = elapsedUs(start);
     return;
 }
 
@@ -178,71 +169,68 @@ void AppRestartAssist::readTablesToMap()
  */
 void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldValueTuple> fvVector, bool delete_key)
 {
-    SWSS_LOG_INFO("Received message %s, key: %s, "
-            "%s, delete = %d", tableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
+    SWSS_LOG_INFO("Received message %s, key: %s, delete = %d",
+                  tableName.c_str(), key.c_str(), delete_key);
+
+    auto &cache = appTableCacheMap[tableName];
+    auto found = cache.find(key);
 
-    auto found = appTableCacheMap[tableName].find(key);
+    m_reconcileStats.refreshed++;
 
     if (delete_key)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", tableName.c_str(), key.c_str());
         /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap[tableName].end())
+        if (found != cache.end())
         {
-            setCacheEntryState(found->second, DELETE);
+            found->second.state = DELETE;
+            found->second.fvVector.clear();
         }
+        return;
     }
-    else if (found != appTableCacheMap[tableName].end())
+
+    EntryDigest digest = WarmRestartDigest::digest(fvVector, false);
+
+    if (found != cache.end())
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(! contains(found->second, fvVector))
+        if (found->second.digest != digest)
         {
-            SWSS_LOG_NOTICE("%s, found key: %s, new value ", tableName.c_str(), key.c_str());
-
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
+            SWSS_LOG_NOTICE("%s, found key: %s, new value %s", tableName.c_str(), key.c_str(),
+                            joinVectorString(fvVector).c_str());
 
             // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[tableName][key] = fvVector;
+            found->second = CacheEntry{digest, NEW, std::move(fvVector)};
+        }
+        /*
+         * In case an entry has been updated for more than once with the same value but different from the stored one,
+         * keep the state as NEW.
+         * Eg.
+         * Assume the entry's value that is restored from last warm reboot is V0.
+         * 1. The first update with value V1 is received and handled by the above branch,
+         *    - state is set to NEW
+         *    - value is updated to V1
+         * 2. The second update with the same value V1 is received and handled by this branch
+         *    - Originally, state was set to SAME, which is wrong because V1 is different from the stored value V0
+         *    - The correct logic should be: set the state to same only if the state is not NEW
+         * This is a very rare case because in most of times the entry won't be updated for multiple times
+         */
+        else if (found->second.state == NEW)
+        {
+            SWSS_LOG_NOTICE("%s, found key: %s, it has been updated for the second time, keep state as NEW",
+                            tableName.c_str(), key.c_str());
         }
         else
         {
-            auto state = getCacheEntryState(found->second);
-            /*
-             * In case an entry has been updated for more than once with the same value but different from the stored one,
-             * keep the state as NEW.
-             * Eg.
-             * Assume the entry's value that is restored from last warm reboot is V0.
-             * 1. The first update with value V1 is received and handled by the above `if (found != appTableCacheMap[tableName].end())` branch,
-             *    - state is set to NEW
-             *    - value is updated to V1
-             * 2. The second update with the same value V1 is received and handled by this branch
-             *    - Originally, state was set to SAME, which is wrong because V1 is different from the stored value V0
-             *    - The correct logic should be: set the state to same only if the state is not NEW
-             * This is a very rare case because in most of times the entry won't be updated for multiple times
-             */
-            if (state == NEW)
-            {
-                SWSS_LOG_NOTICE("%s, found key: %s, it has been updated for the second time, keep state as NEW",
-                                tableName.c_str(), key.c_str());
-            }
-            else
-            {
-                SWSS_LOG_INFO("%s, found key: %s, same value", tableName.c_str(), key.c_str());
-                // mark as SAME flag
-                setCacheEntryState(found->second, SAME);
-            }
+            SWSS_LOG_INFO("%s, found key: %s, same value", tableName.c_str(), key.c_str());
+            // mark as SAME flag
+            found->second.state = SAME;
         }
     }
     else
     {
         // not found, mark the entry as NEW and insert to map
         SWSS_LOG_NOTICE("%s, not found key: %s, new", tableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[tableName][key] = fvVector;
+        cache.emplace(key, CacheEntry{digest, NEW, std::move(fvVector)});
     }
     return;
 }
@@ -254,52 +242,82 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
  *  if has "STALE/DELETE" flag, delete it from appDB.
  *  else if "NEW" flag,  add it to appDB
  *  else, throw (should never happen)
+ * The deletions and additions of each table are pushed to appDB as one batch each.
  */
 void AppRestartAssist::reconcile()
 {
     std::string tableName;
 
     SWSS_LOG_ENTER();
+
+    uint64_t diffUs = 0;
+    uint64_t applyUs = 0;
+
     for (auto tableIter = appTableCacheMap.begin(); tableIter != appTableCacheMap.end(); ++tableIter)
     {
+        auto start = chrono::steady_clock::now();
+
+        vector<KeyOpFieldsValuesTuple> setBatch;
+        vector<string> delBatch;
+
         tableName = tableIter->first;
         for (auto it = (tableIter->second).begin(); it != (tableIter->second).end(); ++it)
         {
-            string s = joinVectorString(it->second);
-            auto state = getCacheEntryState(it->second);
+            auto state = it->second.state;
 
             if (state == SAME)
             {
-                SWSS_LOG_INFO("%s SAME, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_INFO("%s SAME, key: %s", tableName.c_str(), it->first.c_str());
+                m_reconcileStats.unchanged++;
                 continue;
             }
             else if (state == STALE || state == DELETE)
             {
-                SWSS_LOG_NOTICE("%s STALE/DELETE, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_NOTICE("%s %s, key: %s", tableName.c_str(),
+                                cacheStateMap.at(state).c_str(), it->first.c_str());
 
                 //delete from appDB
-                m_psTables[tableName]->del(it->first);
+                delBatch.push_back(it->first);
+                m_reconcileStats.deleted++;
             }
             else if (state == NEW)
             {
                 SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                        tableName.c_str(), it->first.c_str(), joinVectorString(it->second.fvVector).c_str());
 
-                //add to appDB, exclude the state
-                it->second.pop_back();
-                m_psTables[tableName]->set(it->first, it->second);
+                //add to appDB
+                setBatch.emplace_back(it->first, SET_COMMAND, std::move(it->second.fvVector));
+                m_reconcileStats.updated++;
             }
             else
             {
                 throw std::logic_error("cache entry state is invalid");
             }
         }
+
+        diffUs += elapsedUs(start);
+        start = chrono::steady_clock::now();
+
+        if (!delBatch.empty())
+        {
+            m_psTables[tableName]->del(delBatch);
+        }
+        if (!setBatch.empty())
+        {
+            m_psTables[tableName]->set(setBatch);
+        }
+
+        applyUs += elapsedUs(start);
+
         // reconcile finished, clear the map, mark the warmstart state
         appTableCacheMap[tableName].clear();
     }
     appTableCacheMap.clear();
+
+    m_reconcileStats.diffUs = diffUs;
+    m_reconcileStats.applyUs = applyUs;
+    SWSS_LOG_NOTICE("%s reconciliation: %s", m_appName.c_str(), m_reconcileStats.toString().c_str());
+
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
     return;
@@ -335,18 +353,3 @@ bool AppRestartAssist::checkReconcileTimer(Selectable *s)
     }
     return false;
 }
-
-// check if left vector contains all elements of right vector
-bool AppRestartAssist::contains(const std::vector<FieldValueTuple>& left,
-              const std::vector<FieldValueTuple>& right)
-{
-    for (auto const& rv : right)
-    {
-        if (std::find(left.begin(), left.end(), rv) == left.end())
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
@@ -8,6 +8,7 @@
 #include "producerstatetable.h"
 #include "selectabletimer.h"
 #include "select.h"
+#include "warmRestartDigest.h"
 
 namespace swss {
 
@@ -88,13 +89,16 @@ public:
     {
         return m_warmStartInProgress;
     }
+    const ReconcileStats &getReconcileStats(void) const
+    {
+        return m_reconcileStats;
+    }
     void registerAppTable(const std::string &tableName, ProducerStateTable *psTable);
 
 private:
     typedef std::map<cache_state_t, std::string> cache_state_map;
     // Enum to string translation map
     static const cache_state_map cacheStateMap;
-    const std::string CACHE_STATE_FIELD = "cache-state";
 
     /*
      * Default timer to be 5 seconds
@@ -102,7 +106,18 @@ private:
      * Precedence ascent order: Default -> loading class with value -> configuration
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
-    typedef std::map<std::string, std::unordered_map<std::string, std::vector<swss::FieldValueTuple>>> AppTableMap;
+
+    /*
+     * Cached entry: restored entries only keep the digest of their field-values,
+     * the field-values are kept for NEW entries which have to be pushed to appDB.
+     */
+    struct CacheEntry
+    {
+        EntryDigest digest;
+        cache_state_t state;
+        std::vector<swss::FieldValueTuple> fvVector;
+    };
+    typedef std::map<std::string, std::unordered_map<std::string, CacheEntry>> AppTableMap;
 
     // cache map to store temporary application table
     AppTableMap appTableCacheMap;
@@ -116,13 +131,9 @@ private:
     bool m_warmStartInProgress;       // indicate if warm start is in progress
     time_t m_reconcileTimer;          // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
+    ReconcileStats m_reconcileStats;  // outcome of the last reconciliation
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
-    bool contains(const std::vector<FieldValueTuple>& left,
-                  const std::vector<FieldValueTuple>& right);
 };
 
 }
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "tokenize.h"
+#include "warmRestartDigest.h"
+
+
+using namespace swss;
+
+
+/* Entries handled per worker thread before another one is worth spawning */
+#define DIGEST_ENTRIES_PER_THREAD 16384
+#define DIGEST_MAX_THREADS        8
+
+/* FNV-1a, 128-bit variant */
+typedef unsigned __int128 uint128_t;
+
+static const uint128_t fnvOffsetBasis =
+    (static_cast<uint128_t>(0x6c62272e07bb0142ULL) << 64) | 0x62b821756295c58dULL;
+static const uint128_t fnvPrime =
+    (static_cast<uint128_t>(0x0000000001000000ULL) << 64) | 0x000000000000013bULL;
+
+/* Separators which can not be confused with field or value content */
+static const char fieldSeparator = '\0';
+static const char entrySeparator = '\1';
+
+
+static inline void fnvUpdate(uint128_t &hash, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= fnvPrime;
+    }
+}
+
+
+static inline void fnvUpdate(uint128_t &hash, const std::string &s)
+{
+    fnvUpdate(hash, s.data(), s.size());
+}
+
+
+EntryDigest WarmRestartDigest::digest(const std::vector<FieldValueTuple> &fvs,
+                                      bool                                unorderedLists)
+{
+    std::vector<const FieldValueTuple *> sorted;
+    sorted.reserve(fvs.size());
+
+    for (const auto &fv : fvs)
+    {
+        sorted.push_back(&fv);
+    }
+
+    std::sort(sorted.begin(), sorted.end(),
+              [](const FieldValueTuple *a, const FieldValueTuple *b)
+              {
+                  return fvField(*a) < fvField(*b);
+              });
+
+    uint128_t hash = fnvOffsetBasis;
+
+    for (const auto *fv : sorted)
+    {
+        fnvUpdate(hash, fvField(*fv));
+        fnvUpdate(hash, &fieldSeparator, 1);
+
+        const std::string &value = fvValue(*fv);
+
+        if (unorderedLists && value.find(',') != std::string::npos)
+        {
+            std::vector<std::string> items = tokenize(value, ',');
+            std::sort(items.begin(), items.end());
+
+            for (const auto &item : items)
+            {
+                fnvUpdate(hash, item);
+                fnvUpdate(hash, ",", 1);
+            }
+        }
+        else
+        {
+            fnvUpdate(hash, value);
+        }
+
+        fnvUpdate(hash, &entrySeparator, 1);
+    }
+
+    return EntryDigest{static_cast<uint64_t>(hash >> 64), static_cast<uint64_t>(hash)};
+}
+
+
+void WarmRestartDigest::digestAll(const std::vector<KeyOpFieldsValuesTuple> &entries,
+                                  bool                                       unorderedLists,
+                                  std::vector<EntryDigest>                  &digests)
+{
+    digests.resize(entries.size());
+
+    parallelFor(entries.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            digests[i] = digest(kfvFieldsValues(entries[i]), unorderedLists);
+        }
+    });
+}
+
+
+void WarmRestartDigest::parallelFor(size_t                                     count,
+                                    const std::function<void(size_t, size_t)> &fn)
+{
+    size_t threads = std::min<size_t>(count / DIGEST_ENTRIES_PER_THREAD,
+                                      std::min<size_t>(std::thread::hardware_concurrency(),
+                                                       DIGEST_MAX_THREADS));
+
+    if (threads <= 1)
+    {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+
+    /* The calling thread takes the first range itself */
+    for (size_t begin = chunk; begin < count; begin += chunk)
+    {
+        workers.emplace_back(fn, begin, std::min(begin + chunk, count));
+    }
+
+    fn(0, std::min(chunk, count));
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+
+const std::string ReconcileStats::toString() const
+{
+    std::ostringstream oss;
+
+    oss << "restored " << restored
+        << ", refreshed " << refreshed
+        << ", unchanged " << unchanged
+        << ", updated " << updated
+        << ", added " << added
+        << ", deleted " << deleted
+        << "; restore " << restoreUs / 1000 << " ms"
+        << ", diff " << diffUs / 1000 << " ms"
+        << ", apply " << applyUs / 1000 << " ms";
+
+    return oss.str();
+}
@@ -0,0 +1,79 @@
+#ifndef __WARMRESTART_DIGEST__
+#define __WARMRESTART_DIGEST__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "table.h"
+
+namespace swss {
+
+/*
+ * 128-bit digest of the field/value set of a table entry. Warm-restart
+ * reconciliation keeps only this digest for every restored entry, instead of
+ * a copy of all its field-value tuples.
+ */
+struct EntryDigest
+{
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const EntryDigest &other) const
+    {
+        return high == other.high && low == other.low;
+    }
+
+    bool operator!=(const EntryDigest &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/* Outcome and cost of one reconciliation run */
+struct ReconcileStats
+{
+    size_t restored = 0;
+    size_t refreshed = 0;
+    size_t unchanged = 0;
+    size_t updated = 0;
+    size_t added = 0;
+    size_t deleted = 0;
+
+    /* Time spent digesting restored state, diffing and pushing the result */
+    uint64_t restoreUs = 0;
+    uint64_t diffUs = 0;
+    uint64_t applyUs = 0;
+
+    const std::string toString() const;
+};
+
+class WarmRestartDigest
+{
+  public:
+
+    /*
+     * Digest of the entry's fields, independent of the order of the fields.
+     * With unorderedLists, comma separated values are also treated as
+     * unordered lists, so "10.1.1.1,10.1.1.2" and "10.1.1.2,10.1.1.1" match.
+     */
+    static EntryDigest digest(const std::vector<FieldValueTuple> &fvs,
+                              bool                                unorderedLists);
+
+    /* Digest all entries, spreading large inputs over worker threads */
+    static void digestAll(const std::vector<KeyOpFieldsValuesTuple> &entries,
+                          bool                                       unorderedLists,
+                          std::vector<EntryDigest>                  &digests);
+
+    /*
+     * Call fn(begin, end) over disjoint ranges covering [0, count). Small
+     * inputs are processed on the calling thread.
+     */
+    static void parallelFor(size_t                                     count,
+                            const std::function<void(size_t, size_t)> &fn);
+};
+
+}
+
+#endif
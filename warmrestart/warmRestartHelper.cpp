@@ -1,4 +1,5 @@
 #include <cassert>
+#include <chrono>
 #include <sstream>
 
 #include "warmRestartHelper.h"
@@ -7,6 +8,13 @@
 using namespace swss;
 
 
+static uint64_t elapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+
 WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  ProducerStateTable *syncTable,
                                  const std::string  &syncTableName,
@@ -65,7 +73,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
+    m_restorationMap.clear();
     m_refreshMap.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
@@ -104,13 +112,16 @@ bool WarmStartHelper::runRestoration()
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    auto start = std::chrono::steady_clock::now();
+
+    kfvVector restorationVector;
+    m_restorationTable.getContent(restorationVector);
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!restorationVector.size())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -120,9 +131,26 @@ bool WarmStartHelper::runRestoration()
         return false;
     }
 
+    /*
+     * Only a digest of each restored element is kept until reconciliation,
+     * the refreshed state is what gets pushed down when they differ.
+     */
+    std::vector<EntryDigest> digests;
+    WarmRestartDigest::digestAll(restorationVector, true, digests);
+
+    m_restorationMap.reserve(restorationVector.size());
+    for (size_t i = 0; i < restorationVector.size(); i++)
+    {
+        m_restorationMap.emplace(std::move(kfvKey(restorationVector[i])), digests[i]);
+    }
+
+    m_reconcileStats = ReconcileStats();
+    m_reconcileStats.restored = m_restorationMap.size();
+    m_reconcileStats.restoreUs = elapsedUs(start);
+
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
                     "application.",
-                    m_restorationVector.size(),
+                    m_restorationMap.size(),
                     m_appName.c_str());
 
     setState(WarmStart::RESTORED);
@@ -148,6 +176,11 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
  * generated by the application once it completes its restart cycle. If a
  * state-diff is found between these two, we will be honoring the refreshed
  * one received from the application, and will proceed to push it down to AppDB.
+ *
+ * Elements are compared through their digests, which ignore the order of the
+ * fields and of the items within comma separated values. Refreshed elements
+ * are digested in parallel, and the resulting updates and deletions are pushed
+ * down to AppDB as a single batch each.
  */
 void WarmStartHelper::reconcile(void)
 {
@@ -156,194 +189,141 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
+    enum Action
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
-
-        auto iter = m_refreshMap.find(restoredKey);
-
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+        ACTION_NONE,
+        ACTION_SET,
+        ACTION_DEL,
+    };
 
-            m_syncTable->del(restoredKey);
-            continue;
-        }
+    auto start = std::chrono::steady_clock::now();
 
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+    std::vector<const KeyOpFieldsValuesTuple *> refreshed;
+    refreshed.reserve(m_refreshMap.size());
+    for (const auto &kfv : m_refreshMap)
+    {
+        refreshed.push_back(&kfv.second);
+    }
 
-            m_syncTable->del(restoredKey);
-        }
+    std::vector<Action> actions(refreshed.size(), ACTION_NONE);
 
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
-        else
+    WarmRestartDigest::parallelFor(refreshed.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
-
-            if (compareAllFV(restoredFV, refreshedFV))
+            const auto &kfv = *refreshed[i];
+            auto iter = m_restorationMap.find(kfvKey(kfv));
+
+            /*
+             * During warm-reboot, apps could receive an 'add' and a 'delete' for an
+             * entry that does not exist in AppDB. In these cases we must prevent the
+             * 'delete' from being pushed down to AppDB.
+             */
+            if (kfvOp(kfv) == DEL_COMMAND)
             {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
-
-                m_syncTable->set(refreshedKey, refreshedFV);
+                actions[i] = (iter == m_restorationMap.end()) ? ACTION_NONE : ACTION_DEL;
             }
-            else
+            else if (iter == m_restorationMap.end() ||
+                     iter->second != WarmRestartDigest::digest(kfvFieldsValues(kfv), true))
             {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
+                actions[i] = ACTION_SET;
             }
         }
+    });
 
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
+    std::vector<KeyOpFieldsValuesTuple> setBatch;
+    std::vector<std::string>            delBatch;
 
-    /*
-     * Iterate through all the entries left in the refreshMap, which correspond
-     * to brand-new entries to be pushed down to AppDB.
-     */
-    for (auto &kfv : m_refreshMap)
+    m_reconcileStats.refreshed = refreshed.size();
+
+    for (size_t i = 0; i < refreshed.size(); i++)
     {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
-
-        /*
-         * During warm-reboot, apps could receive an 'add' and a 'delete' for an
-         * entry that does not exist in AppDB. In these cases we must prevent the
-         * 'delete' from being pushed down to AppDB, so we are handling this case
-         * differently than the 'add' one.
-         */
-        if(refreshedOp == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
-                            " entry %s\n",
-                            refreshedKey.c_str());
-        }
-        else
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: introducing new entry %s",
-                            printKFV(refreshedKey, refreshedFV).c_str());
+        const auto &kfv = *refreshed[i];
+        const auto &key = kfvKey(kfv);
+        bool restored = (m_restorationMap.find(key) != m_restorationMap.end());
 
-            m_syncTable->set(refreshedKey, refreshedFV);
+        switch (actions[i])
+        {
+            case ACTION_SET:
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: %s entry %s",
+                                restored ? "updating" : "introducing new",
+                                printKFV(key, kfvFieldsValues(kfv)).c_str());
+
+                setBatch.emplace_back(key, SET_COMMAND, kfvFieldsValues(kfv));
+                if (restored)
+                {
+                    m_reconcileStats.updated++;
+                }
+                else
+                {
+                    m_reconcileStats.added++;
+                }
+                break;
+
+            case ACTION_DEL:
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
+                                key.c_str());
+
+                delBatch.push_back(key);
+                m_reconcileStats.deleted++;
+                break;
+
+            default:
+                if (restored)
+                {
+                    m_reconcileStats.unchanged++;
+                }
+                else
+                {
+                    SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
+                                    " entry %s", key.c_str());
+                }
+                break;
         }
     }
 
-    /* Clearing pending kfv's from refreshMap */
-    m_refreshMap.clear();
-
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
-
-    setState(WarmStart::RECONCILED);
-
-    SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
-                    "application.", m_appName.c_str());
-}
-
-
-/*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2, protocol: kernel, weight: 1}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
-{
-    /* Size mismatch implies a diff */
-    if (v1.size() != v2.size())
-    {
-        return true;
-    }
-
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
+    /*
+     * Restored elements not found in the refreshMap are stale, we must push a
+     * delete operation for them.
+     */
+    for (const auto &restoredElem : m_restorationMap)
     {
-        auto v1Iter = v1Map.find(v2fv.first);
-
-        /* Return true when v2 has a new field */
-        if (v1Iter == v1Map.end())
+        if (m_refreshMap.find(restoredElem.first) == m_refreshMap.end())
         {
-            return true;
-        }
+            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
+                            restoredElem.first.c_str());
 
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
+            delBatch.push_back(restoredElem.first);
+            m_reconcileStats.deleted++;
         }
     }
 
-    return false;
-}
-
+    m_reconcileStats.diffUs = elapsedUs(start);
+    start = std::chrono::steady_clock::now();
 
-/*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
- *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
- *
- * Returns:
- *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
-{
-    if (s1.size() != s2.size())
+    if (!delBatch.empty())
     {
-        return true;
+        m_syncTable->del(delBatch);
     }
 
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
+    if (!setBatch.empty())
     {
-        return true;
+        m_syncTable->set(setBatch);
     }
 
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
+    m_reconcileStats.applyUs = elapsedUs(start);
 
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
-    {
-        if (splitValuesS1[i] != splitValuesS2[i])
-        {
-            return true;
-        }
-    }
+    /* Clearing pending kfv's from refreshMap */
+    m_refreshMap.clear();
+
+    /* Clearing restored digests */
+    m_restorationMap.clear();
 
-    return false;
+    setState(WarmStart::RECONCILED);
+
+    SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
+                    "application: %s", m_appName.c_str(),
+                    m_reconcileStats.toString().c_str());
 }
 
 
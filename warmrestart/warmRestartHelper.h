@@ -13,6 +13,7 @@
 #include "table.h"
 #include "tokenize.h"
 #include "warm_restart.h"
+#include "warmRestartDigest.h"
 
 
 namespace swss {
@@ -32,6 +33,9 @@ class WarmStartHelper {
     /* fvVector type to be used to host AppDB restored elements */
     using kfvVector = std::vector<KeyOpFieldsValuesTuple>;
 
+    /* Digest of every restored element, keyed by the element's key */
+    using digestMap = std::unordered_map<std::string, EntryDigest>;
+
     /*
      * kfvMap type to be utilized to store all the new/refresh state coming
      * from the restarting applications.
@@ -56,20 +60,21 @@ class WarmStartHelper {
 
     void reconcile(void);
 
+    const ReconcileStats &getReconcileStats(void) const
+    {
+        return m_reconcileStats;
+    }
+
     const std::string printKFV(const std::string                  &key,
                                const std::vector<FieldValueTuple> &fv);
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
-
-    bool compareOneFV(const std::string &v1, const std::string &v2);
-
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
+    digestMap                 m_restorationMap;    // digests of the old state
     kfvMap                    m_refreshMap;        // buffer struct to hold new state
+    ReconcileStats            m_reconcileStats;    // outcome of the last reconciliation
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status
     std::string               m_syncTableName;     // producer-table-name to sync/push state to